@@ -190,7 +190,7 @@ int TYPE6139( double &time,  // the simulation time
 		double externalSimTime =
 			backend->getCurrentCommunicationPoint()	+ backend->getCommunicationStepSize();
 		double trnsysSimTime = hoursToSeconds * getSimulationTime();
-		if ( externalSimTime != trnsysSimTime )
+		if ( ( externalSimTime != trnsysSimTime ) && ( true == backend->isLoggingOn() ) )
 		{
 			std::stringstream message;
 			message << "TRNSYS simulation time (" << trnsysSimTime << ") does not match with "
@@ -62,7 +62,9 @@ fmiStatus fmiGetReal( fmiComponent c, const fmiValueReference vr[], size_t nvr,
 
 	for ( size_t i = 0; i < nvr; ++i )
 	{
-		if ( fmiOK != fe->getReal( vr[i], value[i] ) ) result = fmiWarning;
+		fmiStatus status = fe->getReal( vr[i], value[i] );
+		if ( fmiFatal == status ) return fmiFatal; // Inter-process communication with slave has failed.
+		if ( fmiOK != status ) result = fmiWarning;
 	}
 
 	return result;
@@ -80,7 +82,9 @@ fmiStatus fmiGetInteger( fmiComponent c, const fmiValueReference vr[], size_t nv
 
 	for ( size_t i = 0; i < nvr; ++i )
 	{
-		if ( fmiOK != fe->getInteger( vr[i], value[i] ) ) result = fmiWarning;
+		fmiStatus status = fe->getInteger( vr[i], value[i] );
+		if ( fmiFatal == status ) return fmiFatal; // Inter-process communication with slave has failed.
+		if ( fmiOK != status ) result = fmiWarning;
 	}
 
 	return result;
@@ -98,7 +102,9 @@ fmiStatus fmiGetBoolean( fmiComponent c, const fmiValueReference vr[], size_t nv
 
 	for ( size_t i = 0; i < nvr; ++i )
 	{
-		if ( fmiOK != fe->getBoolean( vr[i], value[i] ) ) result = fmiWarning;
+		fmiStatus status = fe->getBoolean( vr[i], value[i] );
+		if ( fmiFatal == status ) return fmiFatal; // Inter-process communication with slave has failed.
+		if ( fmiOK != status ) result = fmiWarning;
 	}
 
 	return result;
@@ -116,7 +122,9 @@ fmiStatus fmiGetString( fmiComponent c, const fmiValueReference vr[], size_t nvr
 
 	for ( size_t i = 0; i < nvr; ++i )
 	{
-		if ( fmiOK != fe->getString( vr[i], value[i] ) ) result = fmiWarning;
+		fmiStatus status = fe->getString( vr[i], value[i] );
+		if ( fmiFatal == status ) return fmiFatal; // Inter-process communication with slave has failed.
+		if ( fmiOK != status ) result = fmiWarning;
 	}
 
 	return result;
@@ -134,7 +142,9 @@ fmiStatus fmiSetReal( fmiComponent c, const fmiValueReference vr[], size_t nvr,
 
 	for ( size_t i = 0; i < nvr; ++i )
 	{
-		if ( fmiOK != fe->setReal( vr[i], value[i] ) ) result = fmiWarning;
+		fmiStatus status = fe->setReal( vr[i], value[i] );
+		if ( fmiFatal == status ) return fmiFatal; // Inter-process communication with slave has failed.
+		if ( fmiOK != status ) result = fmiWarning;
 	}
 
 	return result;
@@ -152,7 +162,9 @@ fmiStatus fmiSetInteger( fmiComponent c, const fmiValueReference vr[], size_t nv
 
 	for ( size_t i = 0; i < nvr; ++i )
 	{
-		if ( fmiOK != fe->setInteger( vr[i], value[i] ) ) result = fmiWarning;
+		fmiStatus status = fe->setInteger( vr[i], value[i] );
+		if ( fmiFatal == status ) return fmiFatal; // Inter-process communication with slave has failed.
+		if ( fmiOK != status ) result = fmiWarning;
 	}
 
 	return result;
@@ -170,7 +182,9 @@ fmiStatus fmiSetBoolean( fmiComponent c, const fmiValueReference vr[], size_t nv
 
 	for ( size_t i = 0; i < nvr; ++i )
 	{
-		if ( fmiOK != fe->setBoolean( vr[i], value[i] ) ) result = fmiWarning;
+		fmiStatus status = fe->setBoolean( vr[i], value[i] );
+		if ( fmiFatal == status ) return fmiFatal; // Inter-process communication with slave has failed.
+		if ( fmiOK != status ) result = fmiWarning;
 	}
 
 	return result;
@@ -188,7 +202,9 @@ fmiStatus fmiSetString( fmiComponent c, const fmiValueReference vr[], size_t nvr
 
 	for ( size_t i = 0; i < nvr; ++i )
 	{
-		if ( fmiOK != fe->setString( vr[i], value[i] ) ) result = fmiWarning;
+		fmiStatus status = fe->setString( vr[i], value[i] );
+		if ( fmiFatal == status ) return fmiFatal; // Inter-process communication with slave has failed.
+		if ( fmiOK != status ) result = fmiWarning;
 	}
 
 	return result;
@@ -27,6 +27,17 @@
  * It is intended to be incorporated within the slave application as part of a dedicated simulation
  * component, referred to as the FMI adapter. The back end interface is designed to make the connection
  * with the front end as simple as possible, focusing on synchronization and data exchange.
+ *
+ * The front end keeps track of the inputs it changes (see class ScalarVariableChangeLog). Functions
+ * getChanged...Inputs(...) copy only these inputs, which is cheap if nothing (or little) has changed.
+ * Outputs are only written if their values differ from the values already in shared memory.
+ *
+ * Several instances of an FMU may share one slave application (see vendor annotation
+ * "instancesPerProcess" of FMIComponentFrontEnd). In this case, the application creates one back
+ * end per instance (see #getNumberOfInstances) and serves them in a single event loop (see
+ * #waitForAnyMaster). The back ends are connected upfront (see #connect), which does not wait for
+ * their masters. A back end is initialized (see #startInitialization) as soon as the event loop
+ * reports the first signal of its master, i.e., when its instance is initialized.
  */ 
 class __FMI_DLL FMIComponentBackEnd
 {
@@ -38,8 +49,28 @@ public:
 
 	///
 	/// Start initialization of the backend (connect/sync with master).
+	/// After the front end has requested a reset (see #isResetRequested), call this method
+	/// again to acknowledge the reset and to wait for the master to initialize the slave anew.
+	/// In case the application serves several instances of an FMU, the index of the instance
+	/// (between 0 and #getNumberOfInstances - 1) has to be specified. In case the back end has
+	/// been connected beforehand (see #connect), the signal of the master has to be received
+	/// before calling this method (see #waitForAnyMaster), otherwise it waits for the signal.
+	/// In the former case, this method does not wait for the master after a reset either, the
+	/// next signal of the master then indicates that it initializes the slave anew.
+	///
+	fmiStatus startInitialization( unsigned int instance = 0 );
+
+	///
+	/// Connect the backend to the inter-process communication of an instance (see
+	/// #startInitialization) without waiting for its master.
+	///
+	fmiStatus connect( unsigned int instance = 0 );
+
+	///
+	/// Get the number of FMU instances the application is supposed to serve (1 unless the
+	/// application is shared by several instances).
 	///
-	fmiStatus startInitialization();
+	static unsigned int getNumberOfInstances();
 
 	///
 	/// End initialization of the backend (connect/sync with master).
@@ -100,6 +131,42 @@ public:
 	///
 	void waitForMaster() const;
 
+	///
+	/// Check for a signal from master without blocking. Returns true if the signal has been
+	/// received, i.e., the slave may proceed as after #waitForMaster.
+	///
+	bool tryWaitForMaster() const;
+
+	///
+	/// Check if the back end has been connected to its front end (see #connect).
+	///
+	bool isConnected() const;
+
+	///
+	/// Check if the back end has been initialized (see #startInitialization).
+	///
+	bool isInitialized() const;
+
+	///
+	/// Wait for a signal from the master of any of the given back ends, returns the index of
+	/// the back end whose master has signaled (event loop for applications that serve several
+	/// instances of an FMU). Blocks until any master has signaled. Back ends are checked in turn,
+	/// starting at index next (which is updated), hence none of them can starve. The back end at
+	/// index k serves instance k. All back ends have to be connected (see #connect). In case a
+	/// back end has not been initialized yet, the signal indicates that its instance is being
+	/// initialized (call #startInitialization). Only shared memory is supported in this case.
+	///
+	static unsigned int waitForAnyMaster( const std::vector<FMIComponentBackEnd*>& backends, unsigned int& next );
+
+	///
+	/// Check if the front end has requested to reset the slave (see FMIComponentFrontEnd::resetSlave()).
+	/// In this case, the slave application is supposed to reset its internal state and to call
+	/// #startInitialization and #endInitialization again (without initializing inputs and outputs).
+	/// In case of an event loop (see #connect), #endInitialization is called upon the next signal
+	/// of the master. Call this method only between calls to #waitForMaster and #signalToMaster.
+	///
+	bool isResetRequested() const;
+
 	///
 	/// Send signal to master to proceed with execution.
 	/// Do not read/write shared data until #waitForMaster unblocks.
@@ -164,6 +231,87 @@ public:
 	///
 	fmiStatus getStringInputs( std::string* inputs, size_t nInputs );
 
+	///
+	/// Read values only from those real inputs that have been changed by the front end since the
+	/// last call (or since the initialization of the inputs). The number of copied values is
+	/// returned in nChanged, the other inputs are left unchanged.
+	/// Inputs are assumed to be in the same order as specified by #initializeRealInputs.
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	///
+	fmiStatus getChangedRealInputs( std::vector<fmiReal*>& inputs, size_t& nChanged );
+
+	///
+	/// Read values only from those real inputs that have been changed by the front end since the
+	/// last call (or since the initialization of the inputs). The number of copied values is
+	/// returned in nChanged, the other inputs are left unchanged.
+	/// Inputs are assumed to be in the same order as specified by #initializeRealInputs.
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	///
+	fmiStatus getChangedRealInputs( fmiReal* inputs, size_t nInputs, size_t& nChanged );
+
+	///
+	/// Read values only from those integer inputs that have been changed by the front end since the
+	/// last call (or since the initialization of the inputs). The number of copied values is
+	/// returned in nChanged, the other inputs are left unchanged.
+	/// Inputs are assumed to be in the same order as specified by #initializeIntegerInputs.
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	///
+	fmiStatus getChangedIntegerInputs( std::vector<fmiInteger*>& inputs, size_t& nChanged );
+
+	///
+	/// Read values only from those integer inputs that have been changed by the front end since the
+	/// last call (or since the initialization of the inputs). The number of copied values is
+	/// returned in nChanged, the other inputs are left unchanged.
+	/// Inputs are assumed to be in the same order as specified by #initializeIntegerInputs.
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	///
+	fmiStatus getChangedIntegerInputs( fmiInteger* inputs, size_t nInputs, size_t& nChanged );
+
+	///
+	/// Read values only from those boolean inputs that have been changed by the front end since the
+	/// last call (or since the initialization of the inputs). The number of copied values is
+	/// returned in nChanged, the other inputs are left unchanged.
+	/// Inputs are assumed to be in the same order as specified by #initializeBoolInputs.
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	///
+	fmiStatus getChangedBooleanInputs( std::vector<fmiBoolean*>& inputs, size_t& nChanged );
+
+	///
+	/// Read values only from those boolean inputs that have been changed by the front end since the
+	/// last call (or since the initialization of the inputs). The number of copied values is
+	/// returned in nChanged, the other inputs are left unchanged.
+	/// Inputs are assumed to be in the same order as specified by #initializeBoolInputs.
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	///
+	fmiStatus getChangedBooleanInputs( fmiBoolean* inputs, size_t nInputs, size_t& nChanged );
+
+	///
+	/// Read values only from those string inputs that have been changed by the front end since the
+	/// last call (or since the initialization of the inputs). The number of copied values is
+	/// returned in nChanged, the other inputs are left unchanged.
+	/// Inputs are assumed to be in the same order as specified by #initializeBoolInputs.
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	/// Attention: Uses std::string instead of fmiString!
+	///
+	fmiStatus getChangedStringInputs( std::vector<std::string*>& inputs, size_t& nChanged );
+
+	///
+	/// Read values only from those string inputs that have been changed by the front end since the
+	/// last call (or since the initialization of the inputs). The number of copied values is
+	/// returned in nChanged, the other inputs are left unchanged.
+	/// Inputs are assumed to be in the same order as specified by #initializeBoolInputs.
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	/// Attention: Uses std::string instead of fmiString!
+	///
+	fmiStatus getChangedStringInputs( std::string* inputs, size_t nInputs, size_t& nChanged );
+
+	///
+	/// Check if any input has been changed by the front end since the last call to one of
+	/// the functions for reading inputs (or since the initialization of the inputs).
+	/// Call this method only between calls to #waitForMaster and #signalToMaster.
+	///
+	bool hasChangedInputs() const;
+
 	///
 	/// Write values to real outputs.
 	/// Inputs are assumed to be in the same order as specified by #initializeRealOutputs.
@@ -210,7 +358,8 @@ public:
 	/// Write values to string outputs.
 	/// Inputs are assumed to be in the same order as specified by #initializeStringOutputs.
 	/// Call this method only between calls to #waitForMaster and #signalToMaster.
-	/// Attention: Uses std::string instead of fmiString!
+	/// Attention: Uses std::string instead of fmiString! Strings longer than
+	/// SCALAR_VARIABLE_MAX_STRING_LENGTH - 1 characters are truncated (returns fmiWarning).
 	///
 	fmiStatus setStringOutputs( const std::vector<std::string*>& outputs );
 
@@ -218,7 +367,8 @@ public:
 	/// Write values to string outputs.
 	/// Inputs are assumed to be in the same order as specified by #initializeStringOutputs.
 	/// Call this method only between calls to #waitForMaster and #signalToMaster.
-	/// Attention: Uses std::string instead of fmiString!
+	/// Attention: Uses std::string instead of fmiString! Strings longer than
+	/// SCALAR_VARIABLE_MAX_STRING_LENGTH - 1 characters are truncated (returns fmiWarning).
 	///
 	fmiStatus setStringOutputs( const std::string* outputs, size_t nOutputs );
 
@@ -236,10 +386,17 @@ public:
 
 
 	///
-	/// Call the internal logger.
+	/// Call the internal logger. Messages are written to the log file and forwarded to the front end.
+	/// Messages with status fmiOK are discarded if logging is off (see #isLoggingOn).
 	///
 	void logger( fmiStatus status, const std::string& category, const std::string& msg );
 
+	///
+	/// Check if logging has been turned on by the front end. Use this to avoid
+	/// composing debug messages that would be discarded anyway.
+	///
+	bool isLoggingOn() const;
+
 	///
 	/// Get current communication point from the front end.
 	/// Call this method only before #endInitialization or between calls to #waitForMaster and #signalToMaster.
@@ -304,12 +461,27 @@ private:
 
 	///
 	/// Internal helper function for initialization of inputs/outputs.
+	/// For inputs, the positions of the inputs are stored (indexed by the scalar variables) and
+	/// all inputs are marked as changed.
 	///
 	template<typename Type>
 	fmiStatus initializeVariables( std::vector<Type*>& variablePointers,
 				       const std::string& scalarCollection,
 				       const std::vector<std::string>& scalarNames,
-				       const ScalarVariableAttributes::Causality causality );
+				       const ScalarVariableAttributes::Causality causality,
+				       std::vector<int>* positions = 0,
+				       ScalarVariableChangeLog* changes = 0 );
+
+	///
+	/// Internal helper function for reading changed inputs.
+	///
+	template<typename Type, typename Inputs>
+	fmiStatus getChangedInputs( const std::vector<Type*>& variablePointers,
+				    const std::vector<int>& positions,
+				    ScalarVariableChangeLog& changes,
+				    Inputs& inputs,
+				    size_t nInputs,
+				    size_t& nChanged );
 
 	///
 	/// Internal helper function for retrieving variable names.
@@ -358,6 +530,16 @@ private:
 	/// Flag for logging on/off.
 	///
 	bool* loggingOn_;
+
+	///
+	/// Flag indicating that the front end has requested to reset the slave.
+	///
+	bool* resetSlave_;
+
+	///
+	/// Flag indicating that the signals of the master are received by an event loop (see #connect).
+	///
+	bool servedByEventLoop_;
 	
 	///
 	/// Internal pointers to real-valued inputs.
@@ -375,10 +557,9 @@ private:
 	std::vector<fmiBoolean*> booleanInputs_;
 
 	///
-	/// Internal pointers to string-valued inputs.
-	/// Attention: Uses std::string instead of fmiString!
+	/// Internal pointers to string-valued inputs (fixed-capacity slots in shared memory).
 	///
-	std::vector<std::string*> stringInputs_;
+	std::vector<ScalarVariableString*> stringInputs_;
 
 	///
 	/// Internal pointers to real-valued outputs.
@@ -396,10 +577,25 @@ private:
 	std::vector<fmiBoolean*> booleanOutputs_;
 
 	///
-	/// Internal pointers to string-valued outputs.
-	/// Attention: Uses std::string instead of fmiString!
+	/// Internal pointers to string-valued outputs (fixed-capacity slots in shared memory).
+	///
+	std::vector<ScalarVariableString*> stringOutputs_;
+
+	///
+	/// Change logs of the scalar variables (in shared memory), used for reading only changed inputs.
 	///
-	std::vector<std::string*> stringOutputs_;
+	ScalarVariableChangeLog realChanges_;
+	ScalarVariableChangeLog integerChanges_;
+	ScalarVariableChangeLog booleanChanges_;
+	ScalarVariableChangeLog stringChanges_;
+
+	///
+	/// Positions of the inputs (indexed by the scalar variables, -1 for scalar variables that are no inputs).
+	///
+	std::vector<int> realInputPositions_;
+	std::vector<int> integerInputPositions_;
+	std::vector<int> booleanInputPositions_;
+	std::vector<int> stringInputPositions_;
 };
 
 
@@ -408,7 +604,9 @@ template<typename Type>
 fmiStatus FMIComponentBackEnd::initializeVariables( std::vector<Type*>& variablePointers,
 						    const std::string& scalarCollection,
 						    const std::vector<std::string>& scalarNames,
-						    const ScalarVariableAttributes::Causality causality )
+						    const ScalarVariableAttributes::Causality causality,
+						    std::vector<int>* positions,
+						    ScalarVariableChangeLog* changes )
 {
 	fmiStatus result = fmiOK;
 
@@ -422,20 +620,23 @@ fmiStatus FMIComponentBackEnd::initializeVariables( std::vector<Type*>& variable
 	variablePointers.reserve( scalarNames.size() );
 
 	// Retrieve scalars from master.
-	std::vector< ScalarVariable<Type>* > scalars;
-	ipcSlave_->retrieveScalars( scalarCollection, scalars );
-
-	// Fill map between scalar names and instance pointers
-	std::map< std::string, ScalarVariable<Type>* > scalarMap;
-	typename std::vector< ScalarVariable<Type>* >::iterator itScalar = scalars.begin();
-	typename std::vector< ScalarVariable<Type>* >::iterator endScalars = scalars.end();
-	for ( ; itScalar != endScalars; ++itScalar ) {
-		scalarMap[(*itScalar)->name_] = *itScalar;
+	unsigned int nScalars = 0;
+	const ScalarVariableMetadata* metadata = 0;
+	Type* values = 0;
+	ipcSlave_->retrieveScalars( scalarCollection, nScalars, metadata, values );
+
+	// Fill map between scalar names and indices.
+	std::map<std::string, unsigned int> scalarMap;
+	for ( unsigned int i = 0; i < nScalars; ++i ) {
+		scalarMap[metadata[i].name_] = i;
 	}
 
+	// Reset positions of inputs.
+	if ( 0 != positions ) positions->assign( nScalars, -1 );
+
 	// Iterators needed for searching the map.
-	typename std::map< std::string, ScalarVariable<Type>* >::const_iterator itFind;
-	typename std::map< std::string, ScalarVariable<Type>* >::const_iterator itFindEnd = scalarMap.end();
+	std::map<std::string, unsigned int>::const_iterator itFind;
+	std::map<std::string, unsigned int>::const_iterator itFindEnd = scalarMap.end();
 
 	// Loop through the input names, chack their causality and store pointer.
 	typename std::vector<std::string>::const_iterator itName = scalarNames.begin();
@@ -454,18 +655,25 @@ fmiStatus FMIComponentBackEnd::initializeVariables( std::vector<Type*>& variable
 			result = fmiFatal;
 			break;
 		} else {
-			if ( causality != itFind->second->causality_ ) {
+			if ( causality != metadata[itFind->second].causality_ ) {
 				std::stringstream err;
 				err << "scalar variable '" << *itName << "' has wrong causality: "
-				    << itFind->second->causality_ << " instead of " << causality;
+				    << metadata[itFind->second].causality_ << " instead of " << causality;
 				ipcLogger_->logger( fmiFatal, "ABORT", err.str() );
 				result = fmiWarning;
 			}
 
 			/// \FIXME What about variability of scalar variable?
 
-			// Get value.
-			variablePointers.push_back( &itFind->second->value_ );
+			// Store position of input and mark it as changed (the first call to a function for
+			// reading changed inputs returns all inputs).
+			if ( 0 != positions ) {
+				( *positions )[itFind->second] = static_cast<int>( variablePointers.size() );
+				if ( ( 0 != changes ) && ( true == changes->isAttached() ) ) changes->mark( itFind->second );
+			}
+
+			// Get pointer to value.
+			variablePointers.push_back( &values[itFind->second] );
 		}
 	}
 
@@ -482,15 +690,15 @@ void FMIComponentBackEnd::getScalarNames( std::vector<std::string>& scalarNames,
 	scalarNames.clear();
 
 	// Retrieve scalars from master.
-	std::vector< ScalarVariable<Type>* > scalars;
-	ipcSlave_->retrieveScalars( scalarCollection, scalars );
+	unsigned int nScalars = 0;
+	const ScalarVariableMetadata* metadata = 0;
+	Type* values = 0;
+	ipcSlave_->retrieveScalars( scalarCollection, nScalars, metadata, values );
 
 	// Fill vector with scalar names.
-	typename std::vector< ScalarVariable<Type>* >::iterator itScalar = scalars.begin();
-	typename std::vector< ScalarVariable<Type>* >::iterator endScalars = scalars.end();
-	for ( ; itScalar != endScalars; ++itScalar ) {
-		if ( causality == (*itScalar)->causality_ )
-			scalarNames.push_back( (*itScalar)->name_ );
+	for ( unsigned int i = 0; i < nScalars; ++i ) {
+		if ( causality == metadata[i].causality_ )
+			scalarNames.push_back( metadata[i].name_ );
 	}
 }
 
@@ -9,11 +9,16 @@
 #include <map>
 #include <vector>
 
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
 #include "export/include/FMIComponentFrontEndBase.h"
+#include "export/include/ScalarVariable.h"
+#include "export/include/IPCLogger.h"
 
 class IPCMaster;
-class IPCLogger;
-template<class T> class ScalarVariable;
+class IPCMasterLogger;
 class ModelDescription;
 
 
@@ -26,6 +31,26 @@ class ModelDescription;
  * Its interface is designed such that it can be easily used as an FMI component (FMI model type
  * fmiComponent), implementing functionalities close to the requirements of the FMI specification,
  * e.g., functions initializeSlave(...), doStep(...) or setReal(...).
+ *
+ * If the vendor annotations request it ("pipelineDoStep"), the model description declares the capability
+ * canRunAsynchronuously and the master provides the callback function stepFinished(...), doStep(...) is
+ * pipelined: it hands the step over to the slave and returns immediately with status fmiPending. The step
+ * is finished by a worker thread (started once per front end), which calls stepFinished(...) with the final
+ * status. This way, a master can let several slaves work in parallel. Functions for data exchange and the
+ * next call to doStep(...) block until a pending step has been finished.
+ *
+ * Function resetSlave() restores the start values and lets the external application start over
+ * without restarting it (see FMIComponentBackEnd::startInitialization()). If the vendor annotations
+ * specify a "processPoolSize", the application is reset and kept alive when the front end is freed.
+ * The next instance of the same FMU then takes over the waiting application (see SlaveProcessPool)
+ * instead of launching a new one.
+ *
+ * If the vendor annotations specify "instancesPerProcess" (greater than 1), up to this number of
+ * instances of the same FMU share one application. The first instance launches the application,
+ * the following ones join it. Each instance uses a region of one shared memory segment (planned for
+ * all instances by the first one), which is served by a dedicated back end within the application
+ * (see FMIComponentBackEnd::getNumberOfInstances()).
+ * The application is terminated when the last instance sharing it is freed.
  */
 
 
@@ -86,28 +111,40 @@ public:
 	
 private:
 
-	typedef ScalarVariable<fmiReal> RealScalar;
-	typedef ScalarVariable<fmiInteger> IntegerScalar;
-	typedef ScalarVariable<fmiBoolean> BooleanScalar;
-	typedef ScalarVariable<std::string> StringScalar; // Attention: We do not use fmiString here!!!
-
-	typedef std::vector<RealScalar*> RealCollection;
-	typedef std::vector<IntegerScalar*> IntegerCollection;
-	typedef std::vector<BooleanScalar*> BooleanCollection;
-	typedef std::vector<StringScalar*> StringCollection;
-
-	typedef std::map<fmiValueReference, RealScalar*> RealMap;
-	typedef std::map<fmiValueReference, IntegerScalar*> IntegerMap;
-	typedef std::map<fmiValueReference, BooleanScalar*> BooleanMap;
-	typedef std::map<fmiValueReference, StringScalar*> StringMap;
-
-	RealMap realScalarMap_;
-	IntegerMap integerScalarMap_;
-	BooleanMap booleanScalarMap_;
-	StringMap stringScalarMap_;
+	/// Maps value references to the indices of the scalar variables in shared memory.
+	typedef std::map<fmiValueReference, unsigned int> ScalarMap;
+
+	ScalarMap realScalarMap_;
+	ScalarMap integerScalarMap_;
+	ScalarMap booleanScalarMap_;
+	ScalarMap stringScalarMap_;
+
+	/// Tables with the metadata of the scalar variables (in shared memory).
+	ScalarVariableMetadata* realMetadata_;
+	ScalarVariableMetadata* integerMetadata_;
+	ScalarVariableMetadata* booleanMetadata_;
+	ScalarVariableMetadata* stringMetadata_;
+
+	/// Dense arrays with the values of the scalar variables (in shared memory).
+	fmiReal* realValues_;
+	fmiInteger* integerValues_;
+	fmiBoolean* booleanValues_;
+	ScalarVariableString* stringValues_; // Attention: We do not use fmiString here!!!
+
+	/// Change logs of the scalar variables (in shared memory), inputs are marked when their values change.
+	ScalarVariableChangeLog realChanges_;
+	ScalarVariableChangeLog integerChanges_;
+	ScalarVariableChangeLog booleanChanges_;
+	ScalarVariableChangeLog stringChanges_;
+
+	/// Start values of the scalar variables (restored when the slave is reset).
+	std::vector<fmiReal> realStartValues_;
+	std::vector<fmiInteger> integerStartValues_;
+	std::vector<fmiBoolean> booleanStartValues_;
+	std::vector<ScalarVariableString> stringStartValues_;
 
 	IPCMaster* ipcMaster_;
-	IPCLogger* ipcLogger_;
+	IPCMasterLogger* ipcLogger_;
 
 	fmiReal* currentCommunicationPoint_;
 	fmiReal* communicationStepSize_;
@@ -116,6 +153,13 @@ private:
 	bool* rejectStep_;
 
 	bool* slaveHasTerminated_;
+	bool* slaveLoggingOn_;
+
+	/// Flag telling the slave to start over (see resetSlave()).
+	bool* resetSlave_;
+
+	/// Log messages from the slave (in shared memory), forwarded to the FMU logger.
+	IPCLogChannel slaveLog_;
 
 	std::string instanceName_;
 
@@ -126,6 +170,24 @@ private:
 	pid_t pid_;
 #endif
 
+	/// Identifies the FMU (location and GUID) in the process pool.
+	std::string processPoolKey_;
+
+	/// Maximum number of idle applications of this FMU that are kept alive (see SlaveProcessPool).
+	unsigned int processPoolSize_;
+
+	/// Maximum number of instances of this FMU that share one application (see SlaveProcessPool).
+	unsigned int instancesPerProcess_;
+
+	/// Index of this instance among the instances sharing the application (0 if the application
+	/// has been started by this instance).
+	unsigned int instance_;
+
+	/// Start external simulator application and set up inter-process communication.
+	fmiStatus launchApplication( const ModelDescription* modelDescription,
+				     const std::string& mimeType,
+				     const std::string& fmuLocation );
+
 	/// Start external simulator application in a separate thread.
 	bool startApplication( const ModelDescription* modelDescription,
 			       const std::string& mimeType,
@@ -135,12 +197,80 @@ private:
 	/// Kill external simulator application.
 	void killApplication();
 
+	/// Parse options for the inter-process communication (type of communication, TCP host
+	/// and port, options for the shared memory segment) from the vendor annotations.
+	void parseIPCOptions( const ModelDescription* modelDescription,
+			      std::string& ipc,
+			      std::string& host,
+			      unsigned int& port,
+			      bool& hugePages,
+			      bool& lockMemory ) const;
+
+	/// Parse the size of the process pool and the number of instances per application from the vendor annotations.
+	void parseProcessOptions( const ModelDescription* modelDescription,
+				  unsigned int& processPoolSize,
+				  unsigned int& instancesPerProcess ) const;
+
+	/// Parse from the vendor annotations whether calls to doStep(...) should be pipelined.
+	void parseStepOptions( const ModelDescription* modelDescription,
+			       bool& pipelineDoStep ) const;
+
+	/// Exchange the external simulator application (process and inter-process communication) with another front end.
+	void swapProcess( FMIComponentFrontEnd& other );
+
+	/// Reset the slave and put the application into the process pool (if the pool is not full).
+	void releaseProcess();
+
 	/// Initialize internal variables in shared memory
-	void initializeVariables( const ModelDescription* modelDescription,
-				  RealCollection& realScalars,
-				  IntegerCollection& integerScalars,
-				  BooleanCollection& booleanScalars,
-				  StringCollection& stringScalars );
+	void initializeVariables( const ModelDescription* modelDescription );
+
+	/// Synchronize with the slave to finish a step, advance time and call stepFinished(...).
+	fmiStatus finishStep( fmiReal stepSize );
+
+	/// Check if the inter-process communication with the slave still works (logs an error otherwise).
+	bool isSlaveConnected();
+
+	/// Block until a pending step (see pipelinedDoStep_) has been finished.
+	void waitForPendingStep();
+
+	/// Main loop of the worker thread, finishes the steps handed over by doStep(...).
+	void runStepThread();
+
+	/// Forward log messages from the slave to the FMU logger. Call this method only after
+	/// taking control back from the slave.
+	void forwardSlaveLog();
+
+	/// Flag indicating that doStep(...) returns fmiPending and finishes the step in a separate thread.
+	bool pipelinedDoStep_;
+
+	/// Worker thread finishing pending steps (only in case steps are pipelined).
+	boost::thread* stepThread_;
+
+	/// Protects the status of the current step (stepPending_, lastStepStatus_, lastSuccessfulTime_)
+	/// and the requests to the worker thread (stepRequested_, requestedStepSize_, stopStepThread_).
+	mutable boost::mutex stepMutex_;
+
+	/// Notifies the worker thread of new requests and waiting threads of finished steps.
+	boost::condition_variable stepCondition_;
+
+	/// Flag indicating that a step has been handed over to the worker thread and is not yet finished
+	/// (including the call to stepFinished(...)).
+	bool stepRequested_;
+
+	/// Size of the step handed over to the worker thread.
+	fmiReal requestedStepSize_;
+
+	/// Flag indicating that the worker thread should terminate.
+	bool stopStepThread_;
+
+	/// Flag indicating that a step is pending.
+	bool stepPending_;
+
+	/// Status of the last finished step.
+	fmiStatus lastStepStatus_;
+
+	/// Time of the last successfully finished step.
+	fmiReal lastSuccessfulTime_;
 
 };
 
@@ -41,6 +41,10 @@ namespace HelperFunctions
 	/// Convert an URL to an OS-specific path.
 	bool getPathFromUrl( const std::string& inputFileUrl, std::string& outputFilePath );
 
+	/// Set an environment variable of the current process (inherited by child
+	/// processes). An empty value removes the variable.
+	bool setEnvironmentVariable( const std::string& name, const std::string& value );
+
 }
 
 
@@ -12,9 +12,18 @@
  */ 
 
 #include <string>
+#include <cstring>
 
 #include "common/fmi_v1.0/fmiModelTypes.h"
 
+
+/// Maximum length of the category of a log record (including the terminating null character).
+#define IPC_LOG_MAX_CATEGORY_LENGTH 32
+
+/// Maximum length of the message of a log record (including the terminating null character).
+#define IPC_LOG_MAX_MESSAGE_LENGTH 512
+
+
 /**
  * \class IPCLogger IPCLogger.h
  * Abstract base class for loggers to be used by the components responsible for IPC.
@@ -33,4 +42,92 @@ public:
 };
 
 
+/**
+ * \class IPCLogRecord IPCLogger.h
+ * Log message with fixed-capacity storage.
+ *
+ * Log records are plain data, hence they can be passed through lock-free queues and placed in
+ * shared memory. Categories and messages that do not fit are truncated.
+ */
+class IPCLogRecord
+{
+
+public:
+
+	fmiStatus status_;
+	char category_[IPC_LOG_MAX_CATEGORY_LENGTH];
+	char message_[IPC_LOG_MAX_MESSAGE_LENGTH];
+
+	/// Set status, category and message.
+	void set( fmiStatus status, const std::string& category, const std::string& msg ) {
+		status_ = status;
+		copy( category_, IPC_LOG_MAX_CATEGORY_LENGTH, category );
+		copy( message_, IPC_LOG_MAX_MESSAGE_LENGTH, msg );
+	}
+
+private:
+
+	static void copy( char* dest, std::size_t capacity, const std::string& src ) {
+		std::size_t length = ( src.size() < capacity ) ? src.size() : capacity - 1;
+		if ( 0 != length ) std::memcpy( dest, src.data(), length );
+		dest[length] = '\0';
+	}
+
+};
+
+
+
+/**
+ * \class IPCLogChannel IPCLogger.h
+ * Carries log records from the slave to the master.
+ *
+ * The channel operates on an array of log records and a counter in shared memory, see
+ * IPCMaster::createLogChannel(...). The slave appends records while it has control (i.e.,
+ * before signaling to the master), the master forwards and clears them after it has taken
+ * control back. Hence, no further synchronization is needed and checking for new records
+ * only costs a single comparison.
+ */
+class IPCLogChannel
+{
+
+public:
+
+	IPCLogChannel() : numRecords_( 0 ), records_( 0 ), count_( 0 ) {}
+
+	/// Operate on the given array of log records and counter.
+	void attach( unsigned int numRecords, IPCLogRecord* records, unsigned int* count ) {
+		numRecords_ = numRecords; records_ = records; count_ = count;
+	}
+
+	/// Check if the channel operates on an array.
+	bool isAttached() const { return 0 != records_; }
+
+	/// Check if the channel is full (or not attached).
+	bool isFull() const { return ( 0 == records_ ) || ( *count_ >= numRecords_ ); }
+
+	/// Append a log record, returns false if the channel is full.
+	bool put( const IPCLogRecord& record ) {
+		if ( true == isFull() ) return false;
+		records_[( *count_ )++] = record;
+		return true;
+	}
+
+	/// Get the number of log records in the channel.
+	unsigned int getNumberOfRecords() const { return ( 0 != count_ ) ? *count_ : 0; }
+
+	/// Get the k-th log record.
+	const IPCLogRecord& getRecord( unsigned int k ) const { return records_[k]; }
+
+	/// Remove all log records.
+	void clear() { if ( ( 0 != count_ ) && ( 0 != *count_ ) ) *count_ = 0; }
+
+private:
+
+	unsigned int numRecords_;
+	IPCLogRecord* records_;
+	unsigned int* count_;
+
+};
+
+
 #endif // _FMIPP_IPCLOGGER_H
@@ -11,7 +11,8 @@
 
 #include "export/include/IPCLogger.h"
 
-template<class T> class ScalarVariable;
+class ScalarVariableMetadata;
+class ScalarVariableString;
 
 
 /**
@@ -65,36 +66,62 @@ public:
 				     const bool& val = false ) = 0;
 
 	///
-	/// Create internally double scalar variables and retrieve pointers to it.
+	/// Create internally double scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
 	///
 	virtual bool createScalars( const std::string& id,
 				    unsigned int numObj,
-				    std::vector<ScalarVariable<double>*>& vars ) = 0;
+				    ScalarVariableMetadata*& metadata,
+				    double*& values ) = 0;
 
 	///
-	/// Create internally integer scalar variables and retrieve pointers to it.
+	/// Create internally integer scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
 	///
 	virtual bool createScalars( const std::string& id,
 				    unsigned int numObj,
-				    std::vector<ScalarVariable<int>*>& vars ) = 0;
+				    ScalarVariableMetadata*& metadata,
+				    int*& values ) = 0;
 
 	///
-	/// Create internally char (fmiBoolean) scalar variables and retrieve pointers to it.
+	/// Create internally char (fmiBoolean) scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
 	///
 	virtual bool createScalars( const std::string& id,
 				    unsigned int numObj,
-				    std::vector<ScalarVariable<char>*>& vars ) = 0;
+				    ScalarVariableMetadata*& metadata,
+				    char*& values ) = 0;
 
 	///
-	/// Create internally string scalar variables and retrieve pointers to it.
+	/// Create internally string scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
 	///
 	virtual bool createScalars( const std::string& id,
 				    unsigned int numObj,
-				    std::vector<ScalarVariable<std::string>*>& vars ) = 0;
+				    ScalarVariableMetadata*& metadata,
+				    ScalarVariableString*& values ) = 0;
+
+	///
+	/// Create internally the change log of a collection of scalar variables
+	/// (see class ScalarVariableChangeLog) and retrieve pointer to it.
+	///
+	virtual bool createChangeLog( const std::string& id,
+				      unsigned int numObj,
+				      unsigned int*& log ) = 0;
+
+	///
+	/// Create internally a channel for log records from the slave (an array of
+	/// log records and a counter, see class IPCLogChannel) and retrieve pointers to it.
+	///
+	virtual bool createLogChannel( const std::string& id,
+				       unsigned int numRecords,
+				       IPCLogRecord*& records,
+				       unsigned int*& count ) = 0;
 
 	///
 	/// Wait for signal from slave to resume execution.
-	/// Blocks until signal from slave is received.
+	/// Blocks until signal from slave is received. In case the communication
+	/// with the slave fails, isOperational() returns false afterwards.
 	///
 	virtual void waitForSlave() = 0;
 
@@ -167,6 +194,12 @@ namespace IPCMasterFactory {
 	template<typename Type, typename Param1, typename Param2, typename Param3>
 	IPCMaster* createIPCMaster( Param1 p1, Param2 p2, Param3 p3 ) { return new Type( p1, p2, p3 ); }
 
+	///
+	/// Helper function to create an instance of IPC master (5 arguments).
+	///
+	template<typename Type, typename Param1, typename Param2, typename Param3, typename Param4, typename Param5>
+	IPCMaster* createIPCMaster( Param1 p1, Param2 p2, Param3 p3, Param4 p4, Param5 p5 ) { return new Type( p1, p2, p3, p4, p5 ); }
+
 #endif
 
 }
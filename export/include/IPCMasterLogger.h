@@ -32,6 +32,9 @@ public:
 	/// Destructor.
 	virtual ~IPCMasterLogger();
 
+	/// Forward messages to another front end component (or discard them if fe is null).
+	void setFrontEnd( FMIComponentFrontEndBase* fe ) { frontend_ = fe; }
+
 	/// Call FMU logger.
 	virtual void logger( fmiStatus status, const std::string& category, const std::string& msg );
 
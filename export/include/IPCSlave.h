@@ -11,7 +11,8 @@
 
 #include "export/include/IPCLogger.h"
 
-template<class T> class ScalarVariable;
+class ScalarVariableMetadata;
+class ScalarVariableString;
 
 /**
  * \file IPCSlave.h
@@ -60,28 +61,53 @@ public:
 				       bool*& var ) const = 0;
 
 	///
-	/// Retrieve vector of pointers to double scalar variables.
+	/// Retrieve pointers to the metadata table and the array of values of double scalar variables.
 	///
 	virtual bool retrieveScalars( const std::string& id,
-				      std::vector<ScalarVariable<double>*>& vars ) const = 0;
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      double*& values ) const = 0;
 
 	///
-	/// Retrieve vector of pointers to integer scalar variables.
+	/// Retrieve pointers to the metadata table and the array of values of integer scalar variables.
 	///
 	virtual bool retrieveScalars( const std::string& id,
-				      std::vector<ScalarVariable<int>*>& vars ) const = 0;
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      int*& values ) const = 0;
 
 	///
-	/// Retrieve vector of pointers to char (fmiBoolean) scalar variables.
+	/// Retrieve pointers to the metadata table and the array of values of char (fmiBoolean) scalar variables.
 	///
 	virtual bool retrieveScalars( const std::string& id,
-				      std::vector<ScalarVariable<char>*>& vars ) const = 0;
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      char*& values ) const = 0;
 
 	///
-	/// Retrieve vector of pointers to string scalar variables.
+	/// Retrieve pointers to the metadata table and the array of values of string scalar variables.
 	///
 	virtual bool retrieveScalars( const std::string& id,
-				      std::vector<ScalarVariable<std::string>*>& vars ) const = 0;
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      ScalarVariableString*& values ) const = 0;
+
+	///
+	/// Retrieve pointer to the change log of a collection of scalar variables
+	/// (see class ScalarVariableChangeLog).
+	///
+	virtual bool retrieveChangeLog( const std::string& id,
+					unsigned int& numObj,
+					unsigned int*& log ) const = 0;
+
+	///
+	/// Retrieve pointers to the channel for log records to the master
+	/// (see class IPCLogChannel).
+	///
+	virtual bool retrieveLogChannel( const std::string& id,
+					 unsigned int& numRecords,
+					 IPCLogRecord*& records,
+					 unsigned int*& count ) const = 0;
 
 	///
 	/// Wait for signal from master to resume execution.
@@ -89,6 +115,19 @@ public:
 	///
 	virtual void waitForMaster() = 0;
 
+	///
+	/// Check for a signal from master without blocking. Returns true if a signal
+	/// has been received, i.e., the slave may resume execution as after waitForMaster().
+	///
+	virtual bool tryWaitForMaster() = 0;
+
+	///
+	/// Block until the master of any instance of an application shared by several instances
+	/// has signaled (see FMIComponentBackEnd::waitForAnyMaster(...)). The signal itself is not
+	/// consumed, use tryWaitForMaster() to find out which master has signaled.
+	///
+	virtual void waitForAnyMaster() = 0;
+
 	///
 	/// Send signal to master to proceed with execution.
 	/// Do not alter shared data until waitForMaster() unblocks.
@@ -157,6 +196,12 @@ namespace IPCSlaveFactory {
 	template<typename Type, typename Param1, typename Param2, typename Param3>
 	IPCSlave* createIPCSlave( Param1 p1, Param2 p2, Param3 p3 ) { return new Type( p1, p2, p3 ); }
 
+	///
+	/// Helper function to create an instance of IPC slave (4 arguments).
+	///
+	template<typename Type, typename Param1, typename Param2, typename Param3, typename Param4>
+	IPCSlave* createIPCSlave( Param1 p1, Param2 p2, Param3 p3, Param4 p4 ) { return new Type( p1, p2, p3, p4 ); }
+
 #endif
 
 
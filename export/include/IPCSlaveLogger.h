@@ -14,38 +14,99 @@
 
 #include <fstream>
 
+#include <boost/cstdint.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/thread/thread.hpp>
+
 #include "export/include/IPCLogger.h"
 
 
 /**
  * \class IPCSlaveLogger IPSlaveCLogger.h
  * Logger to be used by the IPCSlave (and its components). Writes log messages to file.
- */ 
+ *
+ * Calling the logger does not block: log records are put into a bounded lock-free queue
+ * (multiple threads may log concurrently) and written to file by a background thread, which is
+ * started with the first log record and sleeps until further records arrive. In case the queue
+ * is full, records are dropped (and the number of dropped records is reported
+ * in the log file). Optionally, log records are also forwarded to the master via a log channel
+ * (see attachChannel(...) and forwardRecords()).
+ */
 class IPCSlaveLogger : public IPCLogger
 {
 
 public:
 
 	/// Constructor.
-	IPCSlaveLogger( const std::string& fileName );
+	IPCSlaveLogger( const std::string& fileName, unsigned int queueCapacity = 1024 );
 
-	/// Destructor.
+	/// Destructor. Writes all remaining log records to file.
 	virtual ~IPCSlaveLogger();
 
 	/// Call logger.
 	virtual void logger( fmiStatus status, const std::string& category, const std::string& msg );
 
+	/// Block until all log records have been written to file.
+	void flush() const;
+
+	/// Forward all log records from now on to the master via the given log channel.
+	void attachChannel( const IPCLogChannel& channel );
+
+	/// Move log records waiting to be forwarded into the log channel (as long as it is
+	/// not full). Call this method only before signaling to the master.
+	void forwardRecords();
+
+	/// Get the number of log records that have been dropped because the queue was full.
+	unsigned int getNumberOfDroppedRecords() const;
+
 	/// Get full path of log messages file.
 	std::string getLogFileName() const;
-	
+
 private:
 
+	typedef boost::lockfree::queue< IPCLogRecord, boost::lockfree::fixed_sized<true> > Queue;
+
 	/// Default constructor is private to prevent usage.
 	IPCSlaveLogger();
 
+	/// Start the background thread (only once, by the first caller).
+	void startWriter();
+
+	/// Main loop of the background thread.
+	void writeRecords();
+
+	/// Write all queued log records to file, returns the number of written records.
+	unsigned int drain();
+
 	const std::string fileName_;
 	std::ofstream* out_;
 
+	/// Log records waiting to be written to file.
+	Queue* queue_;
+
+	/// Log records waiting to be forwarded to the master (only used if a channel is attached).
+	Queue* forwardQueue_;
+
+	IPCLogChannel channel_;
+
+	/// Background thread writing to file (started with the first log record).
+	boost::thread* writer_;
+
+	/// Posted for every queued log record (and to stop the background thread).
+	boost::interprocess::interprocess_semaphore recordsQueued_;
+
+	/// Counters and flags, accessed atomically.
+	mutable volatile boost::uint32_t enqueued_;
+	mutable volatile boost::uint32_t written_;
+	mutable volatile boost::uint32_t dropped_;
+	volatile boost::uint32_t forwarding_;
+	volatile boost::uint32_t started_;
+	volatile boost::uint32_t stop_;
+
+	/// Number of dropped records that have already been reported in the log file.
+	boost::uint32_t reportedDropped_;
+
 };
 
 
@@ -19,6 +19,7 @@
 #include <boost/interprocess/containers/vector.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
 #include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/cstdint.hpp>
 
 // Project includes.
 #include "export/include/IPCLogger.h"
@@ -28,6 +29,22 @@
  * \file SHMManager.h
  * \class SHMManager SHMManager.h
  * Used by classes SHMMaster and SHMSlave to establish proper shared memory access.
+ *
+ * The master/slave handshake is implemented with the help of a counter (stored in shared memory)
+ * and a semaphore for each direction, similar to a lightweight semaphore: signaling increments
+ * the counter and posts to the semaphore only in case the other side is already blocked. By
+ * default, waiting immediately blocks on the semaphore in case no signal is pending. In the
+ * spin-then-block mode, the counter is polled for a limited number of iterations before falling
+ * back to the semaphore, which avoids kernel calls and scheduler wake-up latencies in case the
+ * other side responds quickly. The number of iterations adapts to how often spinning succeeds.
+ * Both modes are compatible, i.e., master and slave may use different modes.
+ *
+ * A segment may be divided into several regions, each of them used by a master/slave pair of
+ * its own (see FMIComponentFrontEnd, vendor annotation "instancesPerProcess"). The objects of
+ * a region are distinguished by a prefix of their names (see getRegionPrefix(...)), region 0
+ * uses no prefix. In this case, every signal to a slave is also counted by an additional counter
+ * and semaphore, which lets a slave serving several regions block until any master has signaled
+ * (see slaveWaitForAnyMaster()).
  */
 
 
@@ -68,6 +85,24 @@ public:
 	///
 	void slaveWaitForMaster();
 
+	///
+	/// Check for a signal from master without blocking, to be used by slave.
+	/// Returns true if a signal has been received (i.e., the slave may resume execution).
+	///
+	bool slaveTryWaitForMaster();
+
+	///
+	/// Wait for a signal from the master of any region of the segment, to be used by a slave
+	/// serving several regions. The signal itself is not consumed (see slaveTryWaitForMaster()),
+	/// hence this function may also return for signals that have already been consumed.
+	///
+	void slaveWaitForAnyMaster();
+
+	///
+	/// Get the prefix of the names of all objects of a region of a segment.
+	///
+	static std::string getRegionPrefix( unsigned int region );
+
 	///
 	/// Send signal to slave to proceed with execution, to be used by master.
 	/// Do not alter shared data until masterWaitForSlave() unblocks.
@@ -131,29 +166,109 @@ public:
 	bool retrieveVector( const std::string& id,
 			     std::vector<Type*> &vector ) const;
 
+	///
+	/// Create an array of data objects in shared memory and retrieve pointer to its
+	/// first element. The elements are stored contiguously and are value-initialized.
+	///
+	template<typename Type>
+	bool createArray( const std::string& id,
+			  unsigned int numObj,
+			  Type* &array );
+
+	///
+	/// Retrieve pointer to the first element of an array of data objects in shared memory.
+	///
+	template<typename Type>
+	bool retrieveArray( const std::string& id,
+			    Type* &array,
+			    unsigned int &numObj ) const;
+
 	///
 	/// Check if shared memory data exchange/syncing is working.
 	///
 	bool isOperational() const { return operational_; }
 
 	///
-	/// Create new shared memory segment.
+	/// Create new shared memory segment (divided into the given number of regions).
+	/// Objects are created in region 0.
 	///
 	void createSHMSegment( const std::string& segmentId,
-			       const long unsigned int segmentSize );
+			       const long unsigned int segmentSize,
+			       unsigned int nRegions = 1 );
 
 	///
-	/// Open existing shared memory segment.
+	/// Open existing shared memory segment. Objects are created and retrieved in the given region.
 	///
-	void openSHMSegment( const std::string& segmentId );
+	void openSHMSegment( const std::string& segmentId,
+			     unsigned int region = 0 );
+
+	///
+	/// Turn the removal of the shared memory segment in the destructor on/off (on by default).
+	///
+	void setRemoveSegment( bool flag ) { removeSegment_ = flag; }
 
 	///
 	/// Stop execution for ms milliseconds.
 	///
 	void sleep( unsigned int ms ) const;
 
+	///
+	/// Get the number of free bytes in the shared memory segment.
+	///
+	long unsigned int getFreeMemory() const;
+
+	///
+	/// Advise the operating system to back the shared memory segment with huge pages.
+	/// Returns false in case this is not supported (a warning is logged).
+	///
+	bool adviseHugePages();
+
+	///
+	/// Lock the shared memory segment in physical memory (prevents paging).
+	/// Returns false in case this is not possible (a warning is logged).
+	///
+	bool lockMemory();
+
+	///
+	/// Turn spinning before blocking when waiting for a signal on/off.
+	///
+	void setSpinThenBlock( bool flag ) { spinThenBlock_ = flag; }
+
+	///
+	/// Check if spinning before blocking is turned on.
+	///
+	bool getSpinThenBlock() const { return spinThenBlock_; }
+
 private:
 
+	///
+	/// Wait for a signal (decrement the counter, block on the semaphore if no signal is pending).
+	///
+	void wait( volatile boost::uint32_t* count,
+		   boost::interprocess::interprocess_semaphore* semaphore );
+
+	///
+	/// Send a signal (increment the counter, post to the semaphore if the other side is blocked).
+	///
+	void post( volatile boost::uint32_t* count,
+		   boost::interprocess::interprocess_semaphore* semaphore );
+
+	///
+	/// Get the range of whole pages covered by the shared memory segment.
+	///
+	void getPageAlignedRange( char*& begin, std::size_t& length ) const;
+
+	///
+	/// Retrieve the objects used for syncing in the region of the segment.
+	///
+	bool findSyncObjects();
+
+	///
+	/// Find an object used for syncing (logs an error in case it does not exist).
+	///
+	template<typename Type>
+	bool findSyncObject( const std::string& name, Type*& object ) const;
+
 	/// Default constructor is private to prevent usage.
 	SHMManager();
 
@@ -165,6 +280,12 @@ private:
 	// call "shared_memory_object::remove" in the destructor.
 	std::string segmentId_;
 
+	// Prefix of the names of all objects in the region of the segment used by this manager.
+	std::string regionPrefix_;
+
+	// Flag indicating that the segment is removed in the destructor.
+	bool removeSegment_;
+
 #ifdef WIN32
 	boost::interprocess::managed_windows_shared_memory *segment_;
 #else
@@ -175,6 +296,20 @@ private:
 	boost::interprocess::interprocess_semaphore *semaphoreMaster_;
 	boost::interprocess::interprocess_semaphore *semaphoreSlave_;
 
+	// Counters of pending signals (negative values indicate a blocked waiter).
+	volatile boost::uint32_t *countMaster_;
+	volatile boost::uint32_t *countSlave_;
+
+	// Semaphore and counter of signals to the slaves of all regions (only for segments with several regions).
+	boost::interprocess::interprocess_semaphore *semaphoreAny_;
+	volatile boost::uint32_t *countAny_;
+
+	// Flag indicating that waiting starts with spinning.
+	bool spinThenBlock_;
+
+	// Current number of spin iterations before blocking (adapted at runtime).
+	unsigned int spinLimit_;
+
 };
 
 
@@ -192,7 +327,7 @@ bool SHMManager::createObject( const std::string& id,
 		return false;
 	}
 
-	object = segment_->construct<Type>( id.c_str(), std::nothrow )( params... );
+	object = segment_->construct<Type>( ( regionPrefix_ + id ).c_str(), std::nothrow )( params... );
 	return ( 0 == object ) ? false : true;
 }
 
@@ -225,7 +360,7 @@ bool SHMManager::createVector( const std::string& id,
 	typedef boost::interprocess::vector<Type, SHMAllocator> SHMVector;
 
 	const SHMAllocator allocInst( segment_->get_segment_manager() );
-	SHMVector *shmVector = segment_->construct<SHMVector>( id.c_str(), std::nothrow )( allocInst );
+	SHMVector *shmVector = segment_->construct<SHMVector>( ( regionPrefix_ + id ).c_str(), std::nothrow )( allocInst );
 
 	if ( 0 == shmVector ) return false;
 
@@ -258,7 +393,7 @@ bool SHMManager::createObject( const std::string& id,
 		return false;
 	}
 
-	object = segment_->construct<Type>( id.c_str(), std::nothrow )( p1 );
+	object = segment_->construct<Type>( ( regionPrefix_ + id ).c_str(), std::nothrow )( p1 );
 	return ( 0 == object ) ? false : true;
 }
 
@@ -285,7 +420,7 @@ bool SHMManager::createVector( const std::string& id,
 	typedef boost::interprocess::vector<Type, SHMAllocator> SHMVector;
 
 	const SHMAllocator allocInst( segment_->get_segment_manager() );
-	SHMVector *shmVector = segment_->construct<SHMVector>( id.c_str(), std::nothrow )( allocInst );
+	SHMVector *shmVector = segment_->construct<SHMVector>( ( regionPrefix_ + id ).c_str(), std::nothrow )( allocInst );
 
 	if ( 0 == shmVector ) return false;
 
@@ -324,7 +459,7 @@ bool SHMManager::retrieveObject( const std::string& id,
 	std::pair<Type*, boost::interprocess::managed_shared_memory::size_type> res;
 #endif
 
-	res = segment_->find<Type>( id.c_str() );
+	res = segment_->find<Type>( ( regionPrefix_ + id ).c_str() );
 	object = ( res.second == 1 ) ? res.first : 0;
 
 	return ( 0 == object ) ? false : true;
@@ -362,7 +497,7 @@ bool SHMManager::retrieveVector( const std::string& id,
 	std::pair<SHMVector*, boost::interprocess::managed_shared_memory::size_type> res;
 #endif
 
-	res = segment_->find<SHMVector>( id.c_str() );
+	res = segment_->find<SHMVector>( ( regionPrefix_ + id ).c_str() );
 
 	if ( res.second == 1 ) {
 
@@ -383,4 +518,47 @@ bool SHMManager::retrieveVector( const std::string& id,
 }
 
 
+template<typename Type>
+bool SHMManager::createArray( const std::string& id,
+			      unsigned int numObj,
+			      Type* &array )
+{
+	if ( !segment_ ) {
+		std::stringstream err;
+		err << "shared memory segment not initialized: " << segmentId_;
+		logger_->logger( fmiFatal, "ABORT", err.str() );
+		return false;
+	}
+
+	array = segment_->construct<Type>( ( regionPrefix_ + id ).c_str(), std::nothrow )[numObj]();
+	return ( 0 == array ) ? false : true;
+}
+
+
+template<typename Type>
+bool SHMManager::retrieveArray( const std::string& id,
+				Type* &array,
+				unsigned int &numObj ) const
+{
+	if ( !segment_ ) {
+		std::stringstream err;
+		err << "shared memory segment not initialized: " << segmentId_;
+		logger_->logger( fmiFatal, "ABORT", err.str() );
+		return false;
+	}
+
+#ifdef WIN32
+	std::pair<Type*, boost::interprocess::managed_windows_shared_memory::size_type> res;
+#else
+	std::pair<Type*, boost::interprocess::managed_shared_memory::size_type> res;
+#endif
+
+	res = segment_->find<Type>( ( regionPrefix_ + id ).c_str() );
+	array = res.first;
+	numObj = ( 0 == array ) ? 0 : static_cast<unsigned int>( res.second );
+
+	return ( 0 == array ) ? false : true;
+}
+
+
 #endif // _FMIPP_SHMMANAGER_H
@@ -28,10 +28,26 @@ public:
 
 	///
 	/// Implementation of class IPCMaster using shared memory and semaphores.
+	/// If spinThenBlock is true, waiting for the slave starts with a bounded
+	/// spin on a counter in shared memory before blocking on the semaphore.
 	///
 	SHMMaster( const std::string& shmSegmentId,
 		   const long unsigned int& shmSegmentSize,
-		   IPCLogger* logger );
+		   IPCLogger* logger,
+		   bool spinThenBlock = false );
+
+	///
+	/// Implementation of class IPCMaster using a region of a shared memory segment that is
+	/// divided into nRegions regions (see class SHMManager), e.g., one for each instance of a
+	/// slave application shared by several instances. The master of region 0 creates the
+	/// segment, the masters of the other regions open it. Since the segment is used by all
+	/// masters, it is not removed by the destructor (see setRemoveSegment(...)).
+	///
+	SHMMaster( const std::string& shmSegmentId,
+		   const long unsigned int& shmSegmentSize,
+		   IPCLogger* logger,
+		   unsigned int region,
+		   unsigned int nRegions );
 
 	virtual ~SHMMaster();
 
@@ -67,32 +83,57 @@ public:
 				     const bool& val = false );
 
 	///
-	/// Create internally double scalar variables and retrieve pointers to it.
+	/// Create internally double scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
 	///
 	virtual bool createScalars( const std::string& id,
 				    unsigned int numObj,
-				    std::vector<ScalarVariable<double>*>& vars );
+				    ScalarVariableMetadata*& metadata,
+				    double*& values );
 
 	///
-	/// Create internally integer scalar variables and retrieve pointers to it.
+	/// Create internally integer scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
 	///
 	virtual bool createScalars( const std::string& id,
 				    unsigned int numObj,
-				    std::vector<ScalarVariable<int>*>& vars );
+				    ScalarVariableMetadata*& metadata,
+				    int*& values );
 
 	///
-	/// Create internally char (fmiBoolean) scalar variables and retrieve pointers to it.
+	/// Create internally char (fmiBoolean) scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
 	///
 	virtual bool createScalars( const std::string& id,
 				    unsigned int numObj,
-				    std::vector<ScalarVariable<char>*>& vars );
+				    ScalarVariableMetadata*& metadata,
+				    char*& values );
 
 	///
-	/// Create internally string scalar variables and retrieve pointers to it.
+	/// Create internally string scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
 	///
 	virtual bool createScalars( const std::string& id,
 				    unsigned int numObj,
-				    std::vector<ScalarVariable<std::string>*>& vars );
+				    ScalarVariableMetadata*& metadata,
+				    ScalarVariableString*& values );
+
+	///
+	/// Create internally the change log of a collection of scalar variables
+	/// (see class ScalarVariableChangeLog) and retrieve pointer to it.
+	///
+	virtual bool createChangeLog( const std::string& id,
+				      unsigned int numObj,
+				      unsigned int*& log );
+
+	///
+	/// Create internally a channel for log records from the slave (an array of
+	/// log records and a counter, see class IPCLogChannel) and retrieve pointers to it.
+	///
+	virtual bool createLogChannel( const std::string& id,
+				       unsigned int numRecords,
+				       IPCLogRecord*& records,
+				       unsigned int*& count );
 
 	///
 	/// Wait for signal from slave to resume execution.
@@ -111,11 +152,45 @@ public:
 	///
 	void sleep( unsigned int ms ) const;
 
+	///
+	/// Advise the operating system to back the shared memory segment with huge pages.
+	///
+	bool adviseHugePages();
+
+	///
+	/// Lock the shared memory segment in physical memory.
+	///
+	bool lockMemory();
+
+	///
+	/// Get the number of free bytes in the shared memory segment.
+	///
+	long unsigned int getFreeMemory() const;
+
+	///
+	/// Turn spinning before blocking when waiting for the slave on/off.
+	///
+	void setSpinThenBlock( bool flag );
+
+	///
+	/// Check if spinning before blocking is turned on.
+	///
+	bool getSpinThenBlock() const;
+
+	///
+	/// Turn the removal of the shared memory segment in the destructor on/off.
+	///
+	void setRemoveSegment( bool flag );
+
 private:
 
 	const std::string shmSegmentId_;
 	const long unsigned int shmSegmentSize_;
 
+	/// Region of the segment used by this master and number of regions of the segment.
+	const unsigned int region_;
+	const unsigned int nRegions_;
+
 	SHMManager* shmManager_;
 
 };
@@ -0,0 +1,141 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+#ifndef _FMIPP_SHMSEGMENTPLAN_H
+#define _FMIPP_SHMSEGMENTPLAN_H
+
+// Standard includes.
+#include <string>
+#include <vector>
+
+// Boost includes.
+#include <boost/type_traits/alignment_of.hpp>
+
+
+class ScalarVariableMetadata;
+
+
+/**
+ * \file SHMSegmentPlan.h
+ * \class SHMSegmentPlan SHMSegmentPlan.h
+ * Computes the size of a shared memory segment before it is created.
+ *
+ * All objects that will be created in the segment (see SHMManager::createObject(...),
+ * SHMManager::createArray(...), SHMMaster::createScalars(...), SHMMaster::createChangeLog(...)
+ * and SHMMaster::createLogChannel(...)) have to be added to the plan, including their names.
+ * The objects used by SHMManager for the master/slave handshake are added automatically.
+ * Objects whose names are already part of the plan are ignored (named objects can only be
+ * created once). In case the segment is divided into several regions (see SHMManager), each
+ * object is planned once per region.
+ *
+ * The required size is determined by placing all planned objects in a process-local buffer
+ * that is managed by the same allocation algorithm and index as the shared memory segment.
+ * The result therefore includes all alignment padding and bookkeeping overhead of the named
+ * objects. It is rounded up to a multiple of the page size (or the huge page size), which is
+ * the granularity at which the operating system provides shared memory anyway.
+ */
+
+
+class SHMSegmentPlan
+{
+
+public:
+
+	///
+	/// Constructor. Adds the objects used for syncing (in all regions) to the plan.
+	///
+	SHMSegmentPlan( const std::string& segmentId, unsigned int nRegions = 1 );
+
+	///
+	/// Add a data object (see SHMManager::createObject(...)).
+	///
+	template<typename Type>
+	void addObject( const std::string& id ) { addArray<Type>( id, 1 ); }
+
+	///
+	/// Add an array of data objects (see SHMManager::createArray(...)).
+	///
+	template<typename Type>
+	void addArray( const std::string& id, unsigned int numObj );
+
+	///
+	/// Add metadata table and array of values of scalar variables (see SHMMaster::createScalars(...)).
+	///
+	template<typename Type>
+	void addScalars( const std::string& id, unsigned int numObj );
+
+	///
+	/// Add change log of scalar variables (see SHMMaster::createChangeLog(...)).
+	///
+	void addChangeLog( const std::string& id, unsigned int numObj );
+
+	///
+	/// Add channel for log records from the slave (see SHMMaster::createLogChannel(...)).
+	///
+	void addLogChannel( const std::string& id, unsigned int numRecords );
+
+	///
+	/// Get the sum of the sizes of all planned objects (without any overhead).
+	///
+	long unsigned int getPayloadSize() const;
+
+	///
+	/// Get the size of the shared memory segment that is required to create all planned
+	/// objects. If hugePages is true, the size is rounded up to a multiple of the huge page size.
+	///
+	long unsigned int getSegmentSize( bool hugePages = false ) const;
+
+	///
+	/// Get the size of huge pages (as assumed for rounding the segment size).
+	///
+	static long unsigned int getHugePageSize();
+
+private:
+
+	/// Information about a planned object.
+	struct PlannedObject
+	{
+		std::string id_;
+		std::size_t bytes_;
+		std::size_t alignment_;
+	};
+
+	/// Add an object to the plan (once per region).
+	void add( const std::string& id, std::size_t bytes, std::size_t alignment );
+
+	/// Add a single object to the plan.
+	void addOnce( const std::string& id, std::size_t bytes, std::size_t alignment );
+
+	/// Place all planned objects in a local buffer of the given size and return the number of used bytes.
+	bool rehearse( std::size_t bufferSize, std::size_t& usedSize ) const;
+
+	/// All planned objects.
+	std::vector<PlannedObject> objects_;
+
+	/// Number of regions of the segment.
+	unsigned int nRegions_;
+
+};
+
+
+template<typename Type>
+void SHMSegmentPlan::addArray( const std::string& id, unsigned int numObj )
+{
+	add( id, sizeof( Type )*numObj, boost::alignment_of<Type>::value );
+}
+
+
+template<typename Type>
+void SHMSegmentPlan::addScalars( const std::string& id, unsigned int numObj )
+{
+	// No data is created for empty collections of scalars.
+	if ( 0 == numObj ) return;
+
+	addArray<ScalarVariableMetadata>( id + "_metadata", numObj );
+	addArray<Type>( id + "_values", numObj );
+}
+
+
+#endif // _FMIPP_SHMSEGMENTPLAN_H
@@ -26,9 +26,15 @@ public:
 
 	///
 	/// Implementation of class IPCSlave using shared memory and semaphores.
+	/// If spinThenBlock is true, waiting for the master starts with a bounded
+	/// spin on a counter in shared memory before blocking on the semaphore.
+	/// In case the segment is divided into several regions (see class SHMManager),
+	/// the slave uses the given region.
 	///
 	SHMSlave( const std::string& shmSegmentId,
-		  IPCLogger* logger );
+		  IPCLogger* logger,
+		  bool spinThenBlock = false,
+		  unsigned int region = 0 );
 
 	virtual ~SHMSlave();
 
@@ -61,28 +67,53 @@ public:
 				       bool*& var ) const;
 
 	///
-	/// Retrieve vector of pointers to double scalar variables.
+	/// Retrieve pointers to the metadata table and the array of values of double scalar variables.
 	///
 	virtual bool retrieveScalars( const std::string& id,
-				      std::vector<ScalarVariable<double>*>& vars ) const;
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      double*& values ) const;
 
 	///
-	/// Retrieve vector of pointers to integer scalar variables.
+	/// Retrieve pointers to the metadata table and the array of values of integer scalar variables.
 	///
 	virtual bool retrieveScalars( const std::string& id,
-				      std::vector<ScalarVariable<int>*>& vars ) const;
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      int*& values ) const;
 
 	///
-	/// Retrieve vector of pointers to char (fmiBoolean) scalar variables.
+	/// Retrieve pointers to the metadata table and the array of values of char (fmiBoolean) scalar variables.
 	///
 	virtual bool retrieveScalars( const std::string& id,
-				      std::vector<ScalarVariable<char>*>& vars ) const;
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      char*& values ) const;
 
 	///
-	/// Retrieve vector of pointers to string scalar variables.
+	/// Retrieve pointers to the metadata table and the array of values of string scalar variables.
 	///
 	virtual bool retrieveScalars( const std::string& id,
-				      std::vector<ScalarVariable<std::string>*>& vars ) const;
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      ScalarVariableString*& values ) const;
+
+	///
+	/// Retrieve pointer to the change log of a collection of scalar variables
+	/// (see class ScalarVariableChangeLog).
+	///
+	virtual bool retrieveChangeLog( const std::string& id,
+					unsigned int& numObj,
+					unsigned int*& log ) const;
+
+	///
+	/// Retrieve pointers to the channel for log records to the master
+	/// (see class IPCLogChannel).
+	///
+	virtual bool retrieveLogChannel( const std::string& id,
+					 unsigned int& numRecords,
+					 IPCLogRecord*& records,
+					 unsigned int*& count ) const;
 
 	///
 	/// Wait for signal from master to resume execution.
@@ -90,6 +121,18 @@ public:
 	///
 	virtual void waitForMaster();
 
+	///
+	/// Check for a signal from master without blocking. Returns true if a signal
+	/// has been received, i.e., the slave may resume execution as after waitForMaster().
+	///
+	virtual bool tryWaitForMaster();
+
+	///
+	/// Block until the master of any region of the segment has signaled. The signal
+	/// itself is not consumed, use tryWaitForMaster() to find out which master has signaled.
+	///
+	virtual void waitForAnyMaster();
+
 	///
 	/// Send signal to master to proceed with execution.
 	/// Do not alter shared data until waitForMaster() unblocks.
@@ -101,6 +144,16 @@ public:
 	///
 	void sleep( unsigned int ms ) const;
 
+	///
+	/// Turn spinning before blocking when waiting for the master on/off.
+	///
+	void setSpinThenBlock( bool flag );
+
+	///
+	/// Check if spinning before blocking is turned on.
+	///
+	bool getSpinThenBlock() const;
+
 private:
 
 	///  Default contructor is private to prevent usage;
@@ -108,6 +161,9 @@ private:
 
 	const std::string shmSegmentId_;
 
+	/// Region of the segment used by this slave.
+	const unsigned int region_;
+
 	SHMManager* shmManager_;
 };
 
@@ -15,9 +15,10 @@
 #include "common/fmi_v1.0/fmiModelTypes.h"
 
 #define SCALAR_VARIABLE_MAX_NAME_LENGTH 128
+#define SCALAR_VARIABLE_MAX_STRING_LENGTH 1024
 
 
-/// Contains helper functions to handle struct ScalarVariable.
+/// Contains helper functions to handle struct ScalarVariableMetadata.
 namespace ScalarVariableAttributes
 {
 	enum Variability { constant, discrete, continuous };
@@ -29,21 +30,22 @@ namespace ScalarVariableAttributes
 
 
 /**
- * \class ScalarVariable ScalarVariable.h
- * Structure for storing information about FMI model variables.
+ * \class ScalarVariableMetadata ScalarVariable.h
+ * Structure for storing static information about FMI model variables.
  *
- * Includes information about name, type, value reference, causality and variability.
+ * Includes information about name, value reference, causality and variability. The values of
+ * the variables are not stored here, but in separate dense arrays (one per type), such that the
+ * data exchanged at every step is compact. The metadata of all variables of one type is written
+ * once to shared memory when the slave is instantiated and only read afterwards. It is a plain
+ * data structure (no pointers) and can therefore be shared across processes.
  */
-template<class T>
-class ScalarVariable
+class ScalarVariableMetadata
 {
 
 public:
 
 	char name_[SCALAR_VARIABLE_MAX_NAME_LENGTH];
 
-	T value_;
-
 	fmiValueReference valueReference_;
 
 	ScalarVariableAttributes::Causality causality_;
@@ -69,5 +71,96 @@ public:
 };
 
 
+/**
+ * \class ScalarVariableString ScalarVariable.h
+ * Fixed-capacity storage for the value of a string variable.
+ *
+ * In contrast to std::string, the characters are stored in place, hence string values can be
+ * placed in shared memory and accessed from different processes. Strings longer than
+ * SCALAR_VARIABLE_MAX_STRING_LENGTH - 1 characters are truncated.
+ */
+class ScalarVariableString
+{
+
+public:
+
+	char value_[SCALAR_VARIABLE_MAX_STRING_LENGTH];
+
+	/// Set the value, returns false in case the string had to be truncated.
+	bool set( const std::string& value ) {
+		return set( value.c_str() );
+	}
+
+	/// Set the value, returns false in case the string had to be truncated.
+	bool set( const char* value ) {
+		std::size_t length = ( 0 != value ) ? std::strlen( value ) : 0;
+		bool result = ( length < SCALAR_VARIABLE_MAX_STRING_LENGTH );
+		if ( false == result ) length = SCALAR_VARIABLE_MAX_STRING_LENGTH - 1;
+		if ( 0 != length ) std::memcpy( &value_[0], value, length );
+		value_[length] = '\0';
+		return result;
+	}
+
+	/// Get the value as C-style string.
+	const char* c_str() const { return &value_[0]; }
+
+};
+
+
+
+/**
+ * \class ScalarVariableChangeLog ScalarVariable.h
+ * Keeps track of the scalar variables of one type whose values have changed (dirty bits).
+ *
+ * The change log operates on an array of getSize( n ) unsigned integers in shared memory (for n
+ * scalar variables), see IPCMaster::createChangeLog(...). The first element holds the number of
+ * changed variables, followed by the indices of the changed variables (in the order in which they
+ * have been marked) and one flag per variable. Marking a variable and checking whether anything
+ * has changed are O(1), retrieving and clearing the changes is linear in the number of changes.
+ */
+class ScalarVariableChangeLog
+{
+
+public:
+
+	ScalarVariableChangeLog() : numObj_( 0 ), data_( 0 ) {}
+
+	/// Get the number of elements of the array needed for n scalar variables.
+	static unsigned int getSize( unsigned int numObj ) { return 2*numObj + 1; }
+
+	/// Operate on the given array (with getSize( numObj ) elements).
+	void attach( unsigned int numObj, unsigned int* data ) { numObj_ = numObj; data_ = data; }
+
+	/// Check if the change log operates on an array.
+	bool isAttached() const { return 0 != data_; }
+
+	/// Mark the scalar variable with the given index as changed.
+	void mark( unsigned int i ) {
+		unsigned int& flag = data_[numObj_ + 1 + i];
+		if ( 0 != flag ) return;
+		flag = 1;
+		data_[++data_[0]] = i;
+	}
+
+	/// Get the number of changed scalar variables.
+	unsigned int getNumberOfChanges() const { return ( 0 != data_ ) ? data_[0] : 0; }
+
+	/// Get the index of the k-th changed scalar variable.
+	unsigned int getChange( unsigned int k ) const { return data_[k + 1]; }
+
+	/// Reset the change log.
+	void clear() {
+		if ( ( 0 == data_ ) || ( 0 == data_[0] ) ) return;
+		for ( unsigned int k = 1; k <= data_[0]; ++k ) data_[numObj_ + 1 + data_[k]] = 0;
+		data_[0] = 0;
+	}
+
+private:
+
+	unsigned int numObj_;
+	unsigned int* data_;
+
+};
+
 
 #endif // _FMIPP_SCALARVARIABLE_H
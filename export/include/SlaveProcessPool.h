@@ -0,0 +1,128 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+#ifndef _FMIPP_SLAVEPROCESSPOOL_H
+#define _FMIPP_SLAVEPROCESSPOOL_H
+
+// Standard includes.
+#include <string>
+#include <map>
+#include <vector>
+
+// Boost includes.
+#include <boost/thread/mutex.hpp>
+
+// Project includes.
+#include "common/FMIPPConfig.h"
+
+class FMIComponentFrontEnd;
+
+
+/**
+ * \file SlaveProcessPool.h
+ * \class SlaveProcessPool SlaveProcessPool.h
+ * Keeps external simulator applications alive after the front end components using them have
+ * been freed, such that later instances of the same FMU can skip the startup of the application.
+ *
+ * Each idle application is owned by a front end component that has not been instantiated itself,
+ * see FMIComponentFrontEnd::releaseProcess(). Idle applications have been reset, i.e., they are
+ * connected to the inter-process communication and wait to be initialized. They are identified by
+ * the location and GUID of their FMU. Applications that remain in the pool are terminated by
+ * clear(), which is called at the latest when the library is unloaded.
+ *
+ * In addition, the pool keeps track of applications that are shared by several instances of
+ * an FMU (see share(...), join(...) and leave(...)). Each instance is assigned an index, which
+ * identifies its region of the shared memory segment. Indices are not re-used, since the back
+ * end of the application that served a freed instance remains connected to its region.
+ */
+
+
+class __FMI_DLL SlaveProcessPool
+{
+
+public:
+
+	///
+	/// Take an idle application of an FMU from the pool. Returns the front end component owning
+	/// the application (the caller takes ownership) or null if no application is available.
+	///
+	static FMIComponentFrontEnd* acquire( const std::string& key );
+
+	///
+	/// Put an idle application of an FMU into the pool (the pool takes ownership of the owning front
+	/// end component). Returns false if the pool already holds maxIdle applications of this FMU.
+	///
+	static bool release( const std::string& key, FMIComponentFrontEnd* idle, unsigned int maxIdle );
+
+	///
+	/// Get the number of idle applications of an FMU.
+	///
+	static unsigned int getNumberOfIdleProcesses( const std::string& key );
+
+	///
+	/// Get the number of idle applications of all FMUs.
+	///
+	static unsigned int getNumberOfIdleProcesses();
+
+	///
+	/// Terminate all idle applications.
+	///
+	static void clear();
+
+	///
+	/// Register an application that has been started by instance 0 of an FMU and that can serve
+	/// up to maxInstances instances of this FMU.
+	///
+	static void share( const std::string& key, long pid, unsigned int maxInstances );
+
+	///
+	/// Join an application of an FMU that can serve another instance. Returns false if no
+	/// such application is available, otherwise its process ID and the index of the instance.
+	///
+	static bool join( const std::string& key, long& pid, unsigned int& instance );
+
+	///
+	/// Leave an application shared by several instances of an FMU. Returns true if this was
+	/// the last instance served by the application, i.e., the application can be terminated.
+	///
+	static bool leave( const std::string& key, long pid );
+
+	///
+	/// Get the number of applications that are currently shared by instances of any FMU.
+	///
+	static unsigned int getNumberOfSharedProcesses();
+
+private:
+
+	typedef std::multimap<std::string, FMIComponentFrontEnd*> IdleProcesses;
+
+	/// Application shared by several instances of an FMU.
+	struct SharedProcess
+	{
+		std::string key_;
+		long pid_;
+		unsigned int maxInstances_;
+		unsigned int nextInstance_; ///< Index of the next instance to join.
+		unsigned int activeInstances_; ///< Number of instances that have not left yet.
+	};
+
+	SlaveProcessPool() {}
+
+	/// The destructor terminates all idle applications.
+	~SlaveProcessPool();
+
+	/// Get the one and only pool.
+	static SlaveProcessPool& getInstance();
+
+	IdleProcesses idle_;
+
+	std::vector<SharedProcess> shared_;
+
+	boost::mutex mutex_;
+
+};
+
+
+#endif // _FMIPP_SLAVEPROCESSPOOL_H
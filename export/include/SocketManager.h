@@ -0,0 +1,262 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+#ifndef _FMIPP_SOCKETMANAGER_H
+#define _FMIPP_SOCKETMANAGER_H
+
+// Standard includes.
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+
+// Boost includes.
+#include <boost/asio.hpp>
+#include <boost/cstdint.hpp>
+
+// Project includes.
+#include "export/include/IPCLogger.h"
+
+
+/**
+ * \file SocketManager.h
+ * \class SocketManager SocketManager.h
+ * Used by classes SocketMaster and SocketSlave to exchange data via a stream socket.
+ *
+ * Supported addresses are "tcp://<host>:<port>" (a port number of 0 lets the master choose
+ * a free port, see getAddress()) and, on POSIX systems, "unix://<path>" for Unix domain sockets.
+ *
+ * In contrast to shared memory, each side holds its own copy of all data objects. The objects
+ * are created by the master and announced to the slave (name, element size, number of
+ * elements and current contents) with the next message. Afterwards, only the elements that
+ * have changed since the last message are sent. Sending a message corresponds to signaling
+ * the other side, receiving a message corresponds to waiting for a signal.
+ *
+ * Each message is framed as follows (all integers are uint32 in host byte order, i.e., both
+ * sides are expected to use the same byte order and type sizes):
+ *
+ *  - message size in bytes (excluding this field)
+ *  - number of announced objects, number of updates
+ *  - announced objects: length of name, name, element size, number of elements, contents
+ *  - updates: object index (in the order of announcement), index of the first element,
+ *    number of elements, contents of these elements
+ */
+
+
+class SocketManager
+{
+
+public:
+
+	///
+	/// Constructor.
+	///
+	SocketManager( IPCLogger* logger );
+
+	~SocketManager();
+
+	///
+	/// Listen for a connection at the given address, to be used by master.
+	///
+	void listen( const std::string& address );
+
+	///
+	/// Accept a connection (blocks until a slave connects), to be used by master.
+	///
+	bool accept();
+
+	///
+	/// Connect to a master listening at the given address, to be used by slave.
+	///
+	void connect( const std::string& address );
+
+	///
+	/// Check if data exchange/syncing is working.
+	///
+	bool isOperational() const { return operational_; }
+
+	///
+	/// Check if a connection has been established.
+	///
+	bool isConnected() const;
+
+	///
+	/// Get the address (in case of TCP with the actual port number).
+	///
+	const std::string& getAddress() const { return address_; }
+
+	///
+	/// Create a data object and retrieve pointer to it.
+	///
+	template<typename Type>
+	bool createObject( const std::string& id,
+			   Type* &object,
+			   const Type& value );
+
+	///
+	/// Create an array of data objects and retrieve pointer to its first element.
+	/// The elements are stored contiguously and are zero-initialized. Only plain data
+	/// types (no pointers) can be exchanged.
+	///
+	template<typename Type>
+	bool createArray( const std::string& id,
+			  unsigned int numObj,
+			  Type* &array );
+
+	///
+	/// Retrieve pointer to the first element of an array of data objects.
+	///
+	template<typename Type>
+	bool retrieveArray( const std::string& id,
+			    Type* &array,
+			    unsigned int &numObj ) const;
+
+	///
+	/// Send new objects and all changes since the last message to the other side.
+	///
+	bool send();
+
+	///
+	/// Wait for a message from the other side and apply it.
+	///
+	bool receive();
+
+	///
+	/// Check if a message from the other side has (at least partially) arrived.
+	///
+	bool isMessagePending();
+
+	///
+	/// Get the size of the last message sent (in bytes, including the size field).
+	///
+	std::size_t getLastMessageSize() const { return lastMessageSize_; }
+
+	///
+	/// Stop execution for ms milliseconds.
+	///
+	void sleep( unsigned int ms ) const;
+
+private:
+
+	typedef boost::asio::generic::stream_protocol Protocol;
+
+	/// Local copy of a data object.
+	struct Object
+	{
+		std::string id_;
+		std::size_t elementSize_;
+		unsigned int numElements_;
+		char* data_; ///< Current contents.
+		char* shadow_; ///< Contents at the time of the last message.
+		bool announced_; ///< Flag indicating that the object is known to the other side.
+	};
+
+	///
+	/// Add a new object (contents are zero-initialized).
+	///
+	Object* addObject( const std::string& id, std::size_t elementSize, unsigned int numElements );
+
+	///
+	/// Find an object.
+	///
+	const Object* findObject( const std::string& id ) const;
+
+	///
+	/// Parse an address and translate it to an endpoint.
+	///
+	bool resolve( const std::string& address, Protocol::endpoint& endpoint, bool& isTCP );
+
+	///
+	/// Configure a newly connected socket.
+	///
+	void configureSocket();
+
+	///
+	/// Close the connection and the acceptor.
+	///
+	void close();
+
+	///
+	/// Log an error and render the manager inoperational.
+	///
+	void fail( const std::string& msg, const boost::system::error_code& ec );
+
+	/// Default constructor is private to prevent usage.
+	SocketManager();
+
+	IPCLogger* logger_;
+
+	bool operational_;
+
+	std::string address_;
+
+	/// Path of the Unix domain socket (to be removed when closing).
+	std::string socketPath_;
+
+	bool isTCP_;
+
+	boost::asio::io_service ioService_;
+	boost::asio::basic_socket_acceptor<Protocol>* acceptor_;
+	Protocol::socket* socket_;
+
+	std::vector<Object> objects_;
+	std::map<std::string, std::size_t> objectIndices_;
+
+	/// Buffer for composing and parsing messages.
+	std::vector<char> buffer_;
+
+	std::size_t lastMessageSize_;
+
+};
+
+
+template<typename Type>
+bool SocketManager::createObject( const std::string& id,
+				  Type* &object,
+				  const Type& value )
+{
+	if ( false == createArray( id, 1, object ) ) return false;
+	*object = value;
+	return true;
+}
+
+
+template<typename Type>
+bool SocketManager::createArray( const std::string& id,
+				 unsigned int numObj,
+				 Type* &array )
+{
+	Object* object = addObject( id, sizeof( Type ), numObj );
+	if ( 0 == object ) {
+		array = 0;
+		return false;
+	}
+
+	array = reinterpret_cast<Type*>( object->data_ );
+	return true;
+}
+
+
+template<typename Type>
+bool SocketManager::retrieveArray( const std::string& id,
+				   Type* &array,
+				   unsigned int &numObj ) const
+{
+	const Object* object = findObject( id );
+
+	// The element size serves as (weak) type check.
+	if ( ( 0 == object ) || ( sizeof( Type ) != object->elementSize_ ) ) {
+		array = 0;
+		numObj = 0;
+		return false;
+	}
+
+	array = reinterpret_cast<Type*>( object->data_ );
+	numObj = object->numElements_;
+	return true;
+}
+
+
+#endif // _FMIPP_SOCKETMANAGER_H
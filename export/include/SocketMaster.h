@@ -0,0 +1,164 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+#ifndef _FMIPP_SOCKETMASTER_H
+#define _FMIPP_SOCKETMASTER_H
+
+
+#include "export/include/IPCMaster.h"
+
+
+class SocketManager;
+class IPCLogger;
+
+
+/**
+ * \file SocketMaster.h
+ * \class SocketMaster SocketMaster.h
+ * Implements data exchange via a stream socket (TCP or Unix domain socket) based on class IPCMaster.
+ * This is an alternative to class SHMMaster, e.g., for slaves that cannot use shared memory.
+ */
+
+
+class SocketMaster: public IPCMaster
+{
+
+public:
+
+	///
+	/// Implementation of class IPCMaster using a stream socket. The master listens
+	/// at the given address ("tcp://<host>:<port>" or "unix://<path>") and accepts
+	/// the connection of the slave with the first call to waitForSlave().
+	///
+	SocketMaster( const std::string& address,
+		      IPCLogger* logger );
+
+	virtual ~SocketMaster();
+
+	///
+	/// Re-initialize the master.
+	///
+	virtual void reinitialize();
+
+	///
+	/// Check if data exchange/syncing is working.
+	///
+	virtual bool isOperational();
+
+	///
+	/// Create internally a double data object and retrieve pointer to it.
+	///
+	virtual bool createVariable( const std::string& id,
+				     double*& var,
+				     const double& val = 0. );
+
+	///
+	/// Create internally an integer data object and retrieve pointer to it.
+	///
+	virtual bool createVariable( const std::string& id,
+				     int*& var,
+				     const int& val = 0 );
+
+	///
+	/// Create internally a bool data object and retrieve pointer to it.
+	///
+	virtual bool createVariable( const std::string& id,
+				     bool*& var,
+				     const bool& val = false );
+
+	///
+	/// Create internally double scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
+	///
+	virtual bool createScalars( const std::string& id,
+				    unsigned int numObj,
+				    ScalarVariableMetadata*& metadata,
+				    double*& values );
+
+	///
+	/// Create internally integer scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
+	///
+	virtual bool createScalars( const std::string& id,
+				    unsigned int numObj,
+				    ScalarVariableMetadata*& metadata,
+				    int*& values );
+
+	///
+	/// Create internally char (fmiBoolean) scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
+	///
+	virtual bool createScalars( const std::string& id,
+				    unsigned int numObj,
+				    ScalarVariableMetadata*& metadata,
+				    char*& values );
+
+	///
+	/// Create internally string scalar variables, i.e., a table with their
+	/// metadata and a dense array with their values, and retrieve pointers to it.
+	///
+	virtual bool createScalars( const std::string& id,
+				    unsigned int numObj,
+				    ScalarVariableMetadata*& metadata,
+				    ScalarVariableString*& values );
+
+	///
+	/// Create internally the change log of a collection of scalar variables
+	/// (see class ScalarVariableChangeLog) and retrieve pointer to it.
+	///
+	virtual bool createChangeLog( const std::string& id,
+				      unsigned int numObj,
+				      unsigned int*& log );
+
+	///
+	/// Create internally a channel for log records from the slave (an array of
+	/// log records and a counter, see class IPCLogChannel) and retrieve pointers to it.
+	///
+	virtual bool createLogChannel( const std::string& id,
+				       unsigned int numRecords,
+				       IPCLogRecord*& records,
+				       unsigned int*& count );
+
+	///
+	/// Wait for signal from slave to resume execution.
+	/// Blocks until signal from slave is received. The first call blocks until
+	/// the slave has connected.
+	///
+	virtual void waitForSlave();
+
+	///
+	/// Send signal to slave to proceed with execution.
+	/// Do not alter shared data until waitForSlave() unblocks.
+	///
+	virtual void signalToSlave();
+
+	///
+	/// Stop execution for ms milliseconds.
+	///
+	void sleep( unsigned int ms ) const;
+
+	///
+	/// Get the address the slave has to connect to (in case of TCP with the actual port number).
+	///
+	const std::string& getAddress() const;
+
+	///
+	/// Get the size of the last message sent to the slave (in bytes).
+	///
+	std::size_t getLastMessageSize() const;
+
+private:
+
+	const std::string address_;
+
+	SocketManager* socketManager_;
+
+	/// Flag indicating that the slave has connected.
+	bool connected_;
+
+};
+
+
+#endif // _FMIPP_SOCKETMASTER_H
@@ -0,0 +1,156 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+#ifndef _FMIPP_SOCKETSLAVE_H
+#define _FMIPP_SOCKETSLAVE_H
+
+
+#include "export/include/IPCSlave.h"
+
+
+class SocketManager;
+
+/**
+ * \file SocketSlave.h
+ * \class SocketSlave SocketSlave.h
+ * Implements data exchange via a stream socket (TCP or Unix domain socket) based on class IPCSlave.
+ * This is the counterpart of class SocketMaster.
+ */
+
+
+class SocketSlave: public IPCSlave
+{
+
+public:
+
+	///
+	/// Implementation of class IPCSlave using a stream socket. The slave connects to
+	/// the master listening at the given address ("tcp://<host>:<port>" or "unix://<path>").
+	/// The data objects created by the master become available with the first call to
+	/// waitForMaster().
+	///
+	SocketSlave( const std::string& address,
+		     IPCLogger* logger );
+
+	virtual ~SocketSlave();
+
+	///
+	/// Re-initialize the slave, i.e., try to connect again.
+	///
+	virtual void reinitialize();
+
+	///
+	/// Check if data exchange/syncing is working.
+	///
+	virtual bool isOperational();
+
+	///
+	/// Retrieve pointer to a double data object.
+	///
+	virtual bool retrieveVariable( const std::string& id,
+				       double*& var ) const;
+
+	///
+	/// Retrieve pointer to a integer data object.
+	///
+	virtual bool retrieveVariable( const std::string& id,
+				       int*& var ) const;
+
+	///
+	/// Retrieve pointer to a boolean data object.
+	///
+	virtual bool retrieveVariable( const std::string& id,
+				       bool*& var ) const;
+
+	///
+	/// Retrieve pointers to the metadata table and the array of values of double scalar variables.
+	///
+	virtual bool retrieveScalars( const std::string& id,
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      double*& values ) const;
+
+	///
+	/// Retrieve pointers to the metadata table and the array of values of integer scalar variables.
+	///
+	virtual bool retrieveScalars( const std::string& id,
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      int*& values ) const;
+
+	///
+	/// Retrieve pointers to the metadata table and the array of values of char (fmiBoolean) scalar variables.
+	///
+	virtual bool retrieveScalars( const std::string& id,
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      char*& values ) const;
+
+	///
+	/// Retrieve pointers to the metadata table and the array of values of string scalar variables.
+	///
+	virtual bool retrieveScalars( const std::string& id,
+				      unsigned int& numObj,
+				      const ScalarVariableMetadata*& metadata,
+				      ScalarVariableString*& values ) const;
+
+	///
+	/// Retrieve pointer to the change log of a collection of scalar variables
+	/// (see class ScalarVariableChangeLog).
+	///
+	virtual bool retrieveChangeLog( const std::string& id,
+					unsigned int& numObj,
+					unsigned int*& log ) const;
+
+	///
+	/// Retrieve pointers to the channel for log records to the master
+	/// (see class IPCLogChannel).
+	///
+	virtual bool retrieveLogChannel( const std::string& id,
+					 unsigned int& numRecords,
+					 IPCLogRecord*& records,
+					 unsigned int*& count ) const;
+
+	///
+	/// Wait for signal from master to resume execution.
+	/// Blocks until signal from master is received.
+	///
+	virtual void waitForMaster();
+
+	///
+	/// Check for a signal from master without blocking. Returns true if a signal
+	/// has been received, i.e., the slave may resume execution as after waitForMaster().
+	///
+	virtual bool tryWaitForMaster();
+
+	///
+	/// Sockets do not support applications shared by several instances, hence there is
+	/// no other master to wait for and this function returns immediately.
+	///
+	virtual void waitForAnyMaster();
+
+	///
+	/// Send signal to master to proceed with execution.
+	/// Do not alter shared data until waitForMaster() unblocks.
+	///
+	virtual void signalToMaster();
+
+	///
+	/// Stop execution for ms milliseconds.
+	///
+	void sleep( unsigned int ms ) const;
+
+private:
+
+	///  Default contructor is private to prevent usage;
+	SocketSlave();
+
+	const std::string address_;
+
+	SocketManager* socketManager_;
+};
+
+
+#endif // _FMIPP_SOCKETSLAVE_H
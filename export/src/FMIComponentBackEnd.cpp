@@ -13,6 +13,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 
 #include <boost/lexical_cast.hpp>
 
@@ -20,12 +21,57 @@
 #include "export/include/FMIComponentBackEnd.h"
 #include "export/include/ScalarVariable.h"
 #include "export/include/SHMSlave.h"
+#include "export/include/SocketSlave.h"
 #include "export/include/IPCSlaveLogger.h"
 
 
 using namespace std;
 
 
+namespace {
+
+	// Copy the value of a scalar variable.
+	template<typename Type>
+	inline void copyValue( Type& to, const Type& from ) { to = from; }
+
+	// Copy the value of a string variable.
+	inline void copyValue( string& to, const ScalarVariableString& from ) { to = from.c_str(); }
+
+	// Mark all inputs as changed.
+	void markInputs( const vector<int>& positions, ScalarVariableChangeLog& changes )
+	{
+		if ( false == changes.isAttached() ) return;
+
+		for ( unsigned int i = 0; i < positions.size(); ++i )
+			if ( 0 <= positions[i] ) changes.mark( i );
+	}
+
+	// Access the elements of arrays and of vectors of pointers in the same way.
+	template<typename Type>
+	inline Type& element( Type* values, size_t i ) { return values[i]; }
+
+	template<typename Type>
+	inline Type& element( vector<Type*>& values, size_t i ) { return *values[i]; }
+
+	// Process ID of this application.
+	string getProcessId()
+	{
+#ifdef WIN32
+		return boost::lexical_cast<string>( GetCurrentProcessId() );
+#else
+		return boost::lexical_cast<string>( getpid() );
+#endif
+	}
+
+	// Identifier of an instance served by this application (used to distinguish the log files).
+	string getInstanceId( unsigned int instance )
+	{
+		string pid = getProcessId();
+		return ( 0 == instance ) ? pid : pid + string( "_" ) + boost::lexical_cast<string>( instance );
+	}
+}
+
+
 FMIComponentBackEnd::FMIComponentBackEnd() :
 	ipcSlave_( 0 ),
 	ipcLogger_( 0 ),
@@ -34,16 +80,19 @@ FMIComponentBackEnd::FMIComponentBackEnd() :
 	enforceTimeStep_( 0 ),
 	rejectStep_( 0 ),
 	slaveHasTerminated_( 0 ),
-	loggingOn_( 0 )
+	loggingOn_( 0 ),
+	resetSlave_( 0 ),
+	servedByEventLoop_( false )
 {}
 
 
 FMIComponentBackEnd::~FMIComponentBackEnd()
 {
 	if ( 0 != ipcSlave_ ) {
-		// Notify frontend that the backend has been terminated.
-		*slaveHasTerminated_ = true;
+		// Notify frontend that the backend has been terminated (if it has been initialized).
+		if ( 0 != slaveHasTerminated_ ) *slaveHasTerminated_ = true;
 
+		ipcLogger_->forwardRecords();
 		ipcSlave_->signalToMaster();
 		delete ipcSlave_;
 	}
@@ -56,29 +105,44 @@ FMIComponentBackEnd::~FMIComponentBackEnd()
 /// Start initialization of the backend (connect/sync with master).
 ///
 fmiStatus
-FMIComponentBackEnd::startInitialization()
+FMIComponentBackEnd::startInitialization( unsigned int instance )
 {
-	
-#ifdef WIN32
-	string pid = boost::lexical_cast<string>( GetCurrentProcessId() );
-#else
-	string pid = boost::lexical_cast<string>( getpid() );
-#endif
+	// The backend has already been initialized, start over after a reset.
+	if ( true == isInitialized() )
+	{
+		if ( false == *resetSlave_ ) {
+			ipcLogger_->logger( fmiFatal, "ABORT", "backend has already been initialized" );
+			return fmiFatal;
+		}
+
+		// Acknowledge the reset. The front end has restored the start values of all inputs.
+		*resetSlave_ = false;
+		markInputs( realInputPositions_, realChanges_ );
+		markInputs( integerInputPositions_, integerChanges_ );
+		markInputs( booleanInputPositions_, booleanChanges_ );
+		markInputs( stringInputPositions_, stringChanges_ );
+
+		ipcLogger_->forwardRecords();
+		ipcSlave_->signalToMaster();
 
-	string shmSegmentName = string( "FMI_SEGMENT_PID" ) + pid;
-	string loggerFileName = string( "fmibackend_pid" ) + pid + string( ".log" );
+		// Wait for the master to initialize the slave (unless the event loop receives the signal).
+		if ( false == servedByEventLoop_ ) ipcSlave_->waitForMaster();
 
-	ipcLogger_ = new IPCSlaveLogger( loggerFileName );
-	ipcSlave_ = IPCSlaveFactory::createIPCSlave< SHMSlave >( shmSegmentName, ipcLogger_ );
-	
-	while ( false == ipcSlave_->isOperational() ) {
-		ipcLogger_->logger( fmiWarning, "WARNING", "IPC interface not operational" );
-		ipcSlave_->sleep( 3000 ); /// \FIXME waiting time should be configurable
-		ipcLogger_->logger( fmiWarning, "WARNING", "retry to initialize IPC interface" );
-		ipcSlave_->reinitialize();
+		if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "FMI component backend has been reset." );
+
+		return fmiOK;
 	}
 
-	ipcSlave_->waitForMaster();
+	// Connect and wait for the master to initialize the slave. Otherwise, the back end has been
+	// connected beforehand and the event loop has already received the signal of the master.
+	servedByEventLoop_ = isConnected();
+	if ( false == servedByEventLoop_ )
+	{
+		fmiStatus status = connect( instance );
+		if ( fmiOK != status ) return status;
+
+		ipcSlave_->waitForMaster();
+	}
 
 	if ( false == ipcSlave_->retrieveVariable( "current_comm_point", currentCommunicationPoint_ ) ) {
 		ipcLogger_->logger( fmiFatal, "ABORT", "unable to create internal variable 'current_comm_point'" );
@@ -110,12 +174,81 @@ FMIComponentBackEnd::startInitialization()
 		return fmiFatal;
 	}
 
+	if ( false == ipcSlave_->retrieveVariable( "reset_slave", resetSlave_ ) ) {
+		ipcLogger_->logger( fmiFatal, "ABORT", "unable to create internal variable 'reset_slave'" );
+		return fmiFatal;
+	}
+
+	// Retrieve change logs (only available for non-empty collections of scalar variables).
+	unsigned int numObj = 0;
+	unsigned int* log = 0;
+	if ( true == ipcSlave_->retrieveChangeLog( "real_scalars", numObj, log ) ) realChanges_.attach( numObj, log );
+	if ( true == ipcSlave_->retrieveChangeLog( "integer_scalars", numObj, log ) ) integerChanges_.attach( numObj, log );
+	if ( true == ipcSlave_->retrieveChangeLog( "boolean_scalars", numObj, log ) ) booleanChanges_.attach( numObj, log );
+	if ( true == ipcSlave_->retrieveChangeLog( "string_scalars", numObj, log ) ) stringChanges_.attach( numObj, log );
+
+	// Forward log messages to the front end.
+	IPCLogChannel logChannel;
+	unsigned int numRecords = 0;
+	IPCLogRecord* records = 0;
+	unsigned int* count = 0;
+	if ( true == ipcSlave_->retrieveLogChannel( "slave_log", numRecords, records, count ) ) {
+		logChannel.attach( numRecords, records, count );
+		ipcLogger_->attachChannel( logChannel );
+	}
+
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "FMI component backend initialized successfully." );
 
 	return fmiOK;
 }
 
 
+fmiStatus
+FMIComponentBackEnd::connect( unsigned int instance )
+{
+	if ( true == isConnected() ) return fmiOK;
+
+	// Instances sharing the application use regions of the same shared memory segment.
+	string shmSegmentName = string( "FMI_SEGMENT_PID" ) + getProcessId();
+	string loggerFileName = string( "fmibackend_pid" ) + getInstanceId( instance ) + string( ".log" );
+
+	ipcLogger_ = new IPCSlaveLogger( loggerFileName );
+
+	// The front end provides an address in case sockets are used instead of shared memory.
+	const char* ipcAddress = getenv( "FMIPP_IPC_ADDRESS" );
+	if ( ( 0 != ipcAddress ) && ( 0 != *ipcAddress ) ) {
+		if ( 0 != instance ) {
+			ipcLogger_->logger( fmiFatal, "ABORT", "sockets do not support applications shared by several instances" );
+			return fmiFatal;
+		}
+		ipcSlave_ = IPCSlaveFactory::createIPCSlave< SocketSlave >( string( ipcAddress ), ipcLogger_ );
+	} else {
+		ipcSlave_ = IPCSlaveFactory::createIPCSlave< SHMSlave >( shmSegmentName, ipcLogger_, false, instance );
+	}
+	
+	while ( false == ipcSlave_->isOperational() ) {
+		ipcLogger_->logger( fmiWarning, "WARNING", "IPC interface not operational" );
+		ipcSlave_->sleep( 3000 ); /// \FIXME waiting time should be configurable
+		ipcLogger_->logger( fmiWarning, "WARNING", "retry to initialize IPC interface" );
+		ipcSlave_->reinitialize();
+	}
+
+	return fmiOK;
+}
+
+
+unsigned int
+FMIComponentBackEnd::getNumberOfInstances()
+{
+	// The front end provides the number of instances in case the application is shared.
+	const char* instances = getenv( "FMIPP_INSTANCES" );
+	if ( ( 0 == instances ) || ( 0 == *instances ) ) return 1;
+
+	unsigned int nInstances = static_cast<unsigned int>( atoi( instances ) );
+	return ( 0 == nInstances ) ? 1 : nInstances;
+}
+
+
 ///
 /// End initialization of the backend (connect/sync with master).
 ///
@@ -124,6 +257,7 @@ FMIComponentBackEnd::endInitialization()
 {
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function endInitialization" );
 
+	ipcLogger_->forwardRecords();
 	ipcSlave_->signalToMaster(); /// \FIXME is there a way to check whether everthing went fine?
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "endInitialization done" );
@@ -137,7 +271,8 @@ FMIComponentBackEnd::initializeRealInputs( const vector<string>& names )
 {
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "calling function initializeRealInputs" );
 
-	return initializeVariables( realInputs_, "real_scalars", names, ScalarVariableAttributes::input );
+	return initializeVariables( realInputs_, "real_scalars", names, ScalarVariableAttributes::input,
+				    &realInputPositions_, &realChanges_ );
 }
 
 
@@ -146,7 +281,8 @@ FMIComponentBackEnd::initializeIntegerInputs( const vector<string>& names )
 {
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "calling function initializeIntegerInputs" );
 
-	return initializeVariables( integerInputs_, "integer_scalars", names, ScalarVariableAttributes::input );
+	return initializeVariables( integerInputs_, "integer_scalars", names, ScalarVariableAttributes::input,
+				    &integerInputPositions_, &integerChanges_ );
 }
 
 
@@ -155,7 +291,8 @@ FMIComponentBackEnd::initializeBooleanInputs( const vector<string>& names )
 {
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "calling function initializeBooleanInputs" );
 
-	return initializeVariables( booleanInputs_, "boolean_scalars", names, ScalarVariableAttributes::input );
+	return initializeVariables( booleanInputs_, "boolean_scalars", names, ScalarVariableAttributes::input,
+				    &booleanInputPositions_, &booleanChanges_ );
 }
 
 
@@ -164,7 +301,8 @@ FMIComponentBackEnd::initializeStringInputs( const vector<string>& names )
 {
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "calling function initializeStringInputs" );
 
-	return initializeVariables( stringInputs_, "string_scalars", names, ScalarVariableAttributes::input );
+	return initializeVariables( stringInputs_, "string_scalars", names, ScalarVariableAttributes::input,
+				    &stringInputPositions_, &stringChanges_ );
 }
 
 
@@ -216,6 +354,9 @@ FMIComponentBackEnd::getRealInputs( vector<fmiReal*>& inputs )
 	vector<fmiReal*>::iterator itCopyEnd = realInputs_.end();
 	for ( ; itCopy != itCopyEnd; ++itCopy, ++itInput ) **itInput = **itCopy;
 
+	// All inputs are up to date.
+	realChanges_.clear();
+
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getRealInputs done" );
 
 	return fmiOK;
@@ -233,6 +374,9 @@ FMIComponentBackEnd::getRealInputs( fmiReal* inputs, size_t nInputs )
 	vector<fmiReal*>::iterator itCopyEnd = realInputs_.end();
 	for ( ; itCopy != itCopyEnd; ++itCopy, ++inputs ) *inputs = **itCopy;
 
+	// All inputs are up to date.
+	realChanges_.clear();
+
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getRealInputs done" );
 
 	return fmiOK;
@@ -251,6 +395,9 @@ FMIComponentBackEnd::getIntegerInputs( vector<fmiInteger*>& inputs )
 	vector<fmiInteger*>::iterator itCopyEnd = integerInputs_.end();
 	for ( ; itCopy != itCopyEnd; ++itCopy, ++itInput ) **itInput = **itCopy;
 
+	// All inputs are up to date.
+	integerChanges_.clear();
+
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getIntegerInputs done" );
 
 	return fmiOK;
@@ -268,6 +415,9 @@ FMIComponentBackEnd::getIntegerInputs( fmiInteger* inputs, size_t nInputs )
 	vector<fmiInteger*>::iterator itCopyEnd = integerInputs_.end();
 	for ( ; itCopy != itCopyEnd; ++itCopy, ++inputs ) *inputs = **itCopy;
 
+	// All inputs are up to date.
+	integerChanges_.clear();
+
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getIntegerInputs done" );
 
 	return fmiOK;
@@ -286,6 +436,9 @@ FMIComponentBackEnd::getBooleanInputs( vector<fmiBoolean*>& inputs )
 	vector<fmiBoolean*>::iterator itCopyEnd = booleanInputs_.end();
 	for ( ; itCopy != itCopyEnd; ++itCopy, ++itInput ) **itInput = **itCopy;
 
+	// All inputs are up to date.
+	booleanChanges_.clear();
+
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getBooleanInputs done" );
 
 	return fmiOK;
@@ -303,6 +456,9 @@ FMIComponentBackEnd::getBooleanInputs( fmiBoolean* inputs, size_t nInputs )
 	vector<fmiBoolean*>::iterator itCopyEnd = booleanInputs_.end();
 	for ( ; itCopy != itCopyEnd; ++itCopy, ++inputs ) *inputs = **itCopy;
 
+	// All inputs are up to date.
+	booleanChanges_.clear();
+
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getBooleanInputs done" );
 
 	return fmiOK;
@@ -317,9 +473,12 @@ FMIComponentBackEnd::getStringInputs( vector<string*>& inputs )
 	if ( inputs.size() != stringInputs_.size() ) return fmiFatal;
 
 	vector<string*>::iterator itInput = inputs.begin();
-	vector<string*>::iterator itCopy = stringInputs_.begin();
-	vector<string*>::iterator itCopyEnd = stringInputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++itInput ) **itInput = **itCopy;
+	vector<ScalarVariableString*>::iterator itCopy = stringInputs_.begin();
+	vector<ScalarVariableString*>::iterator itCopyEnd = stringInputs_.end();
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++itInput ) **itInput = (*itCopy)->c_str();
+
+	// All inputs are up to date.
+	stringChanges_.clear();
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getStringInputs done" );
 
@@ -334,9 +493,12 @@ FMIComponentBackEnd::getStringInputs( string* inputs, size_t nInputs )
 
 	if ( nInputs != stringInputs_.size() ) return fmiFatal;
 
-	vector<string*>::iterator itCopy = stringInputs_.begin();
-	vector<string*>::iterator itCopyEnd = stringInputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++inputs ) *inputs = **itCopy;
+	vector<ScalarVariableString*>::iterator itCopy = stringInputs_.begin();
+	vector<ScalarVariableString*>::iterator itCopyEnd = stringInputs_.end();
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++inputs ) *inputs = (*itCopy)->c_str();
+
+	// All inputs are up to date.
+	stringChanges_.clear();
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getStringInputs done" );
 
@@ -344,6 +506,158 @@ FMIComponentBackEnd::getStringInputs( string* inputs, size_t nInputs )
 }
 
 
+fmiStatus
+FMIComponentBackEnd::getChangedRealInputs( vector<fmiReal*>& inputs, size_t& nChanged )
+{
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function getChangedRealInputs" );
+
+	fmiStatus result = getChangedInputs( realInputs_, realInputPositions_, realChanges_, inputs, inputs.size(), nChanged );
+
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getChangedRealInputs done" );
+
+	return result;
+}
+
+
+fmiStatus
+FMIComponentBackEnd::getChangedRealInputs( fmiReal* inputs, size_t nInputs, size_t& nChanged )
+{
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function getChangedRealInputs" );
+
+	fmiStatus result = getChangedInputs( realInputs_, realInputPositions_, realChanges_, inputs, nInputs, nChanged );
+
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getChangedRealInputs done" );
+
+	return result;
+}
+
+
+fmiStatus
+FMIComponentBackEnd::getChangedIntegerInputs( vector<fmiInteger*>& inputs, size_t& nChanged )
+{
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function getChangedIntegerInputs" );
+
+	fmiStatus result = getChangedInputs( integerInputs_, integerInputPositions_, integerChanges_, inputs, inputs.size(), nChanged );
+
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getChangedIntegerInputs done" );
+
+	return result;
+}
+
+
+fmiStatus
+FMIComponentBackEnd::getChangedIntegerInputs( fmiInteger* inputs, size_t nInputs, size_t& nChanged )
+{
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function getChangedIntegerInputs" );
+
+	fmiStatus result = getChangedInputs( integerInputs_, integerInputPositions_, integerChanges_, inputs, nInputs, nChanged );
+
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getChangedIntegerInputs done" );
+
+	return result;
+}
+
+
+fmiStatus
+FMIComponentBackEnd::getChangedBooleanInputs( vector<fmiBoolean*>& inputs, size_t& nChanged )
+{
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function getChangedBooleanInputs" );
+
+	fmiStatus result = getChangedInputs( booleanInputs_, booleanInputPositions_, booleanChanges_, inputs, inputs.size(), nChanged );
+
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getChangedBooleanInputs done" );
+
+	return result;
+}
+
+
+fmiStatus
+FMIComponentBackEnd::getChangedBooleanInputs( fmiBoolean* inputs, size_t nInputs, size_t& nChanged )
+{
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function getChangedBooleanInputs" );
+
+	fmiStatus result = getChangedInputs( booleanInputs_, booleanInputPositions_, booleanChanges_, inputs, nInputs, nChanged );
+
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getChangedBooleanInputs done" );
+
+	return result;
+}
+
+
+fmiStatus
+FMIComponentBackEnd::getChangedStringInputs( vector<string*>& inputs, size_t& nChanged )
+{
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function getChangedStringInputs" );
+
+	fmiStatus result = getChangedInputs( stringInputs_, stringInputPositions_, stringChanges_, inputs, inputs.size(), nChanged );
+
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getChangedStringInputs done" );
+
+	return result;
+}
+
+
+fmiStatus
+FMIComponentBackEnd::getChangedStringInputs( string* inputs, size_t nInputs, size_t& nChanged )
+{
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function getChangedStringInputs" );
+
+	fmiStatus result = getChangedInputs( stringInputs_, stringInputPositions_, stringChanges_, inputs, nInputs, nChanged );
+
+	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "getChangedStringInputs done" );
+
+	return result;
+}
+
+
+bool
+FMIComponentBackEnd::hasChangedInputs() const
+{
+	return ( 0 != realChanges_.getNumberOfChanges() ) || ( 0 != integerChanges_.getNumberOfChanges() ) ||
+		( 0 != booleanChanges_.getNumberOfChanges() ) || ( 0 != stringChanges_.getNumberOfChanges() );
+}
+
+
+template<typename Type, typename Inputs>
+fmiStatus
+FMIComponentBackEnd::getChangedInputs( const vector<Type*>& variablePointers,
+				       const vector<int>& positions,
+				       ScalarVariableChangeLog& changes,
+				       Inputs& inputs,
+				       size_t nInputs,
+				       size_t& nChanged )
+{
+	nChanged = 0;
+
+	if ( nInputs != variablePointers.size() ) return fmiFatal;
+
+	// Without change log (no scalar variables of this type), all inputs are copied.
+	if ( false == changes.isAttached() ) {
+		for ( ; nChanged < nInputs; ++nChanged ) copyValue( element( inputs, nChanged ), *variablePointers[nChanged] );
+		return fmiOK;
+	}
+
+	// Nothing to do if no input has changed.
+	unsigned int nChanges = changes.getNumberOfChanges();
+	if ( 0 == nChanges ) return fmiOK;
+
+	for ( unsigned int k = 0; k < nChanges; ++k )
+	{
+		unsigned int i = changes.getChange( k );
+
+		// Ignore changes of scalar variables that have not been initialized as inputs.
+		if ( ( i >= positions.size() ) || ( 0 > positions[i] ) ) continue;
+
+		copyValue( element( inputs, positions[i] ), *variablePointers[positions[i]] );
+		++nChanged;
+	}
+
+	changes.clear();
+
+	return fmiOK;
+}
+
+
 fmiStatus
 FMIComponentBackEnd::setRealOutputs( const vector<fmiReal*>& outputs )
 {
@@ -354,7 +668,9 @@ FMIComponentBackEnd::setRealOutputs( const vector<fmiReal*>& outputs )
 	vector<fmiReal*>::const_iterator itOutput = outputs.begin();
 	vector<fmiReal*>::iterator itCopy = realOutputs_.begin();
 	vector<fmiReal*>::iterator itCopyEnd = realOutputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++itOutput ) **itCopy = **itOutput;
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++itOutput ) {
+		if ( **itCopy != **itOutput ) **itCopy = **itOutput;
+	}
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "setRealOutputs done" );
 
@@ -371,7 +687,9 @@ FMIComponentBackEnd::setRealOutputs( const fmiReal* outputs, size_t nOutputs )
 
 	vector<fmiReal*>::iterator itCopy = realOutputs_.begin();
 	vector<fmiReal*>::iterator itCopyEnd = realOutputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++outputs ) **itCopy = *outputs;
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++outputs ) {
+		if ( **itCopy != *outputs ) **itCopy = *outputs;
+	}
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "setRealOutputs done" );
 
@@ -389,7 +707,9 @@ FMIComponentBackEnd::setIntegerOutputs( const vector<fmiInteger*>& outputs )
 	vector<fmiInteger*>::const_iterator itOutput = outputs.begin();
 	vector<fmiInteger*>::iterator itCopy = integerOutputs_.begin();
 	vector<fmiInteger*>::iterator itCopyEnd = integerOutputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++itOutput ) **itCopy = **itOutput;
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++itOutput ) {
+		if ( **itCopy != **itOutput ) **itCopy = **itOutput;
+	}
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "setIntegerOutputs done" );
 
@@ -406,7 +726,9 @@ FMIComponentBackEnd::setIntegerOutputs( const fmiInteger* outputs, size_t nOutpu
 
 	vector<fmiInteger*>::iterator itCopy = integerOutputs_.begin();
 	vector<fmiInteger*>::iterator itCopyEnd = integerOutputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++outputs ) **itCopy = *outputs;
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++outputs ) {
+		if ( **itCopy != *outputs ) **itCopy = *outputs;
+	}
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "setIntegerOutputs done" );
 
@@ -424,7 +746,9 @@ FMIComponentBackEnd::setBooleanOutputs( const vector<fmiBoolean*>& outputs )
 	vector<fmiBoolean*>::const_iterator itOutput = outputs.begin();
 	vector<fmiBoolean*>::iterator itCopy = booleanOutputs_.begin();
 	vector<fmiBoolean*>::iterator itCopyEnd = booleanOutputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++itOutput ) **itCopy = **itOutput;
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++itOutput ) {
+		if ( **itCopy != **itOutput ) **itCopy = **itOutput;
+	}
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "setBooleanOutputs done" );
 
@@ -441,7 +765,9 @@ FMIComponentBackEnd::setBooleanOutputs( const fmiBoolean* outputs, size_t nOutpu
 
 	vector<fmiBoolean*>::iterator itCopy = booleanOutputs_.begin();
 	vector<fmiBoolean*>::iterator itCopyEnd = booleanOutputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++outputs ) **itCopy = *outputs;
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++outputs ) {
+		if ( **itCopy != *outputs ) **itCopy = *outputs;
+	}
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "setBooleanOutputs done" );
 
@@ -456,14 +782,21 @@ FMIComponentBackEnd::setStringOutputs( const vector<string*>& outputs )
 
 	if ( outputs.size() != stringOutputs_.size() ) return fmiFatal;
 
+	fmiStatus result = fmiOK;
+
 	vector<string*>::const_iterator itOutput = outputs.begin();
-	vector<string*>::iterator itCopy = stringOutputs_.begin();
-	vector<string*>::iterator itCopyEnd = stringOutputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++itOutput ) **itCopy = **itOutput;
+	vector<ScalarVariableString*>::iterator itCopy = stringOutputs_.begin();
+	vector<ScalarVariableString*>::iterator itCopyEnd = stringOutputs_.end();
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++itOutput ) {
+		if ( **itOutput == (*itCopy)->c_str() ) continue;
+		if ( false == (*itCopy)->set( **itOutput ) ) result = fmiWarning;
+	}
+
+	if ( fmiWarning == result ) ipcLogger_->logger( fmiWarning, "WARNING", "string output has been truncated" );
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "setStringOutputs done" );
 
-	return fmiOK;
+	return result;
 }
 
 
@@ -474,13 +807,20 @@ FMIComponentBackEnd::setStringOutputs( const string* outputs, size_t nOutputs )
 
 	if ( nOutputs != stringOutputs_.size() ) return fmiFatal;
 
-	vector<string*>::iterator itCopy = stringOutputs_.begin();
-	vector<string*>::iterator itCopyEnd = stringOutputs_.end();
-	for ( ; itCopy != itCopyEnd; ++itCopy, ++outputs ) **itCopy = *outputs;
+	fmiStatus result = fmiOK;
+
+	vector<ScalarVariableString*>::iterator itCopy = stringOutputs_.begin();
+	vector<ScalarVariableString*>::iterator itCopyEnd = stringOutputs_.end();
+	for ( ; itCopy != itCopyEnd; ++itCopy, ++outputs ) {
+		if ( *outputs == (*itCopy)->c_str() ) continue;
+		if ( false == (*itCopy)->set( *outputs ) ) result = fmiWarning;
+	}
+
+	if ( fmiWarning == result ) ipcLogger_->logger( fmiWarning, "WARNING", "string output has been truncated" );
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "setStringOutputs done" );
 
-	return fmiOK;
+	return result;
 }
 
 
@@ -499,6 +839,68 @@ FMIComponentBackEnd::waitForMaster() const
 }
 
 
+bool
+FMIComponentBackEnd::isConnected() const
+{
+	return 0 != ipcSlave_;
+}
+
+
+bool
+FMIComponentBackEnd::isInitialized() const
+{
+	return 0 != resetSlave_;
+}
+
+
+bool
+FMIComponentBackEnd::tryWaitForMaster() const
+{
+	return ipcSlave_->tryWaitForMaster();
+}
+
+
+unsigned int
+FMIComponentBackEnd::waitForAnyMaster( const vector<FMIComponentBackEnd*>& backends, unsigned int& next )
+{
+	const unsigned int nBackends = static_cast<unsigned int>( backends.size() );
+	if ( 0 == nBackends ) return 0;
+
+	// Without other instances, there is nothing else to wait for.
+	if ( 1 == nBackends ) {
+		backends[0]->ipcSlave_->waitForMaster();
+		next = 0;
+		return 0;
+	}
+
+	while ( true )
+	{
+		// All masters also signal via the same semaphore, hence blocking on it suffices.
+		backends[0]->ipcSlave_->waitForAnyMaster();
+
+		// Start where the previous call left off, so that all back ends are served in turn. In
+		// case the signal has already been consumed otherwise (e.g., by waitForMaster()), no back
+		// end is ready and the loop starts over.
+		for ( unsigned int k = 0; k < nBackends; ++k )
+		{
+			unsigned int i = ( next + k ) % nBackends;
+
+			if ( ( true == backends[i]->isConnected() ) && ( true == backends[i]->tryWaitForMaster() ) ) {
+				next = ( i + 1 ) % nBackends;
+				return i;
+			}
+		}
+	}
+}
+
+
+bool
+FMIComponentBackEnd::isResetRequested() const
+{
+	return ( 0 != resetSlave_ ) && ( true == *resetSlave_ );
+}
+
+
 ///
 /// Send signal to master to proceed with execution.
 /// Do not alter shared data until waitForMaster() unblocks.
@@ -508,6 +910,7 @@ FMIComponentBackEnd::signalToMaster() const
 {
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "entering function signalToMaster" );
 
+	ipcLogger_->forwardRecords();
 	ipcSlave_->signalToMaster();
 
 	if ( true == *loggingOn_ ) ipcLogger_->logger( fmiOK, "DEBUG", "signalToMaster done" );
@@ -576,7 +979,16 @@ FMIComponentBackEnd::getLogFileName() const
 void
 FMIComponentBackEnd::logger( fmiStatus status, const std::string& category, const std::string& msg )
 {
-	ipcLogger_->logger( fmiWarning, category, msg );
+	if ( ( fmiOK == status ) && ( false == isLoggingOn() ) ) return;
+
+	ipcLogger_->logger( status, category, msg );
+}
+
+
+bool
+FMIComponentBackEnd::isLoggingOn() const
+{
+	return ( 0 != loggingOn_ ) && ( true == *loggingOn_ );
 }
 
 
@@ -596,7 +1008,7 @@ FMIComponentBackEnd::getRealInputNames( std::vector<std::string>& names ) const
 void
 FMIComponentBackEnd::getIntegerInputNames( std::vector<std::string>& names ) const
 {
-	getScalarNames<fmiReal>( names, "integer_scalars", ScalarVariableAttributes::input );
+	getScalarNames<fmiInteger>( names, "integer_scalars", ScalarVariableAttributes::input );
 }
 
 
@@ -606,7 +1018,7 @@ FMIComponentBackEnd::getIntegerInputNames( std::vector<std::string>& names ) con
 void
 FMIComponentBackEnd::getBooleanInputNames( std::vector<std::string>& names ) const
 {
-	getScalarNames<fmiReal>( names, "boolean_scalars", ScalarVariableAttributes::input );
+	getScalarNames<fmiBoolean>( names, "boolean_scalars", ScalarVariableAttributes::input );
 }
 
 
@@ -616,7 +1028,7 @@ FMIComponentBackEnd::getBooleanInputNames( std::vector<std::string>& names ) con
 void
 FMIComponentBackEnd::getStringInputNames( std::vector<std::string>& names ) const
 {
-	getScalarNames<fmiReal>( names, "string_scalars", ScalarVariableAttributes::input );
+	getScalarNames<ScalarVariableString>( names, "string_scalars", ScalarVariableAttributes::input );
 }
 
 
@@ -636,7 +1048,7 @@ FMIComponentBackEnd::getRealOutputNames( std::vector<std::string>& names ) const
 void
 FMIComponentBackEnd::getIntegerOutputNames( std::vector<std::string>& names ) const
 {
-	getScalarNames<fmiReal>( names, "integer_scalars", ScalarVariableAttributes::output );
+	getScalarNames<fmiInteger>( names, "integer_scalars", ScalarVariableAttributes::output );
 }
 
 
@@ -646,7 +1058,7 @@ FMIComponentBackEnd::getIntegerOutputNames( std::vector<std::string>& names ) co
 void
 FMIComponentBackEnd::getBooleanOutputNames( std::vector<std::string>& names ) const
 {
-	getScalarNames<fmiReal>( names, "boolean_scalars", ScalarVariableAttributes::output );
+	getScalarNames<fmiBoolean>( names, "boolean_scalars", ScalarVariableAttributes::output );
 }
 
 
@@ -656,5 +1068,5 @@ FMIComponentBackEnd::getBooleanOutputNames( std::vector<std::string>& names ) co
 void
 FMIComponentBackEnd::getStringOutputNames( std::vector<std::string>& names ) const
 {
-	getScalarNames<fmiReal>( names, "string_scalars", ScalarVariableAttributes::output );
+	getScalarNames<ScalarVariableString>( names, "string_scalars", ScalarVariableAttributes::output );
 }
@@ -18,15 +18,21 @@
 // Standard includes.
 #include <sstream>
 #include <stdexcept>
+#include <cstring>
+#include <algorithm>
 
 // Boost includes.
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
+#include <boost/filesystem.hpp>
 
 // Project-specific include files.
 #include "export/include/FMIComponentFrontEnd.h"
 #include "export/include/SHMMaster.h"
+#include "export/include/SHMSegmentPlan.h"
+#include "export/include/SocketMaster.h"
+#include "export/include/SlaveProcessPool.h"
 #include "export/include/ScalarVariable.h"
 #include "export/include/HelperFunctions.h"
 #include "export/include/IPCMasterLogger.h"
@@ -35,27 +41,90 @@
 
 using namespace std;
 
+
+namespace {
+
+	// Read the start value of a scalar variable.
+	template<typename T>
+	void getStartValue( const ModelDescription::Properties& properties, T& value )
+	{
+		value = properties.get<T>( "start" );
+	}
+
+	// Read the start value of a string variable.
+	void getStartValue( const ModelDescription::Properties& properties, ScalarVariableString& value )
+	{
+		value.set( properties.get<string>( "start" ) );
+	}
+
+	// Write the value of a string variable to a stream.
+	ostream& operator<<( ostream& stream, const ScalarVariableString& value )
+	{
+		return stream << value.c_str();
+	}
+
+	// Maximum number of log records the slave can forward to the front end per synchronization.
+	const unsigned int slaveLogCapacity = 64;
+}
+
+
 // Forward declaration.
 template<typename T>
-void initializeScalar( ScalarVariable<T>* scalar,
-					const ModelDescription::Properties* description,
-					const string& xmlTypeTag,
-					FMIComponentFrontEnd* frontend );
+void initializeScalar( ScalarVariableMetadata* metadata,
+		       T* value,
+		       const ModelDescription::Properties* description,
+		       const string& xmlTypeTag,
+		       FMIComponentFrontEnd* frontend );
 
 
 
 FMIComponentFrontEnd::FMIComponentFrontEnd() :
+	realMetadata_( 0 ), integerMetadata_( 0 ),
+	booleanMetadata_( 0 ), stringMetadata_( 0 ),
+	realValues_( 0 ), integerValues_( 0 ),
+	booleanValues_( 0 ), stringValues_( 0 ),
 	ipcMaster_( 0 ), ipcLogger_( 0 ),
 	currentCommunicationPoint_( 0 ), communicationStepSize_( 0 ),
 	enforceTimeStep_( 0 ), rejectStep_( 0 ),
-	slaveHasTerminated_( 0 ), pid_( 0 )
+	slaveHasTerminated_( 0 ), slaveLoggingOn_( 0 ),
+	resetSlave_( 0 ), pid_( 0 ), processPoolSize_( 0 ),
+	instancesPerProcess_( 1 ), instance_( 0 ),
+	pipelinedDoStep_( false ), stepThread_( 0 ),
+	stepRequested_( false ), requestedStepSize_( 0. ), stopStepThread_( false ),
+	stepPending_( false ), lastStepStatus_( fmiOK ),
+	lastSuccessfulTime_( 0. )
 {}
 
 
 FMIComponentFrontEnd::~FMIComponentFrontEnd()
 {
+	// The master has to wait for a pending step to be finished before freeing the slave.
+	waitForPendingStep();
+
+	if ( stepThread_ ) {
+		{
+			boost::mutex::scoped_lock lock( stepMutex_ );
+			stopStepThread_ = true;
+		}
+		stepCondition_.notify_all();
+
+		stepThread_->join();
+		delete stepThread_;
+	}
+
+	// Keep the application alive for later use by another instance of this FMU (if enabled).
+	if ( ( 0 != ipcMaster_ ) && ( 0 != processPoolSize_ ) ) releaseProcess();
+
 	if ( ipcMaster_ ) {
-		if ( false == *slaveHasTerminated_ ) killApplication();
+		// An application shared by several instances is terminated together with the last of them.
+		bool lastInstance = ( 1 == instancesPerProcess_ ) ||
+			SlaveProcessPool::leave( processPoolKey_, static_cast<long>( pid_ ) );
+
+		if ( ( true == lastInstance ) && ( false == *slaveHasTerminated_ ) ) killApplication();
+
+		// The segment shared by several instances is removed together with the last of them.
+		if ( 1 < instancesPerProcess_ ) static_cast<SHMMaster*>( ipcMaster_ )->setRemoveSegment( lastInstance );
+
 		delete ipcMaster_;
 	}
 
@@ -66,8 +135,14 @@ FMIComponentFrontEnd::~FMIComponentFrontEnd()
 fmiStatus
 FMIComponentFrontEnd::setReal( const fmiValueReference& ref, const fmiReal& val )
 {
+	// Data must not be accessed while a step is pending.
+	waitForPendingStep();
+
+	// The data is stale in case the inter-process communication with the slave has failed.
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
 	// Search for value reference.
-	RealMap::iterator itFind = realScalarMap_.find( ref );
+	ScalarMap::const_iterator itFind = realScalarMap_.find( ref );
 
 	// Check if scalar according to the value reference exists.
 	if ( itFind == realScalarMap_.end() )
@@ -79,7 +154,7 @@ FMIComponentFrontEnd::setReal( const fmiValueReference& ref, const fmiReal& val
 	}
 
 	// Check if scalar is defined as input.
-	if ( itFind->second->causality_ != ScalarVariableAttributes::input )
+	if ( realMetadata_[itFind->second].causality_ != ScalarVariableAttributes::input )
 	{
 		stringstream err;
 		err << "variable is not an input variable: " << ref;
@@ -87,8 +162,11 @@ FMIComponentFrontEnd::setReal( const fmiValueReference& ref, const fmiReal& val
 		return fmiWarning;
 	}
 
-	// Set value.
-	itFind->second->value_ = val;
+	// Set value and keep track of the change (values that do not change are not marked).
+	if ( val != realValues_[itFind->second] ) {
+		realValues_[itFind->second] = val;
+		realChanges_.mark( itFind->second );
+	}
 
 	return fmiOK;
 }
@@ -97,8 +175,14 @@ FMIComponentFrontEnd::setReal( const fmiValueReference& ref, const fmiReal& val
 fmiStatus
 FMIComponentFrontEnd::setInteger( const fmiValueReference& ref, const fmiInteger& val )
 {
+	// Data must not be accessed while a step is pending.
+	waitForPendingStep();
+
+	// The data is stale in case the inter-process communication with the slave has failed.
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
 	// Search for value reference.
-	IntegerMap::iterator itFind = integerScalarMap_.find( ref );
+	ScalarMap::const_iterator itFind = integerScalarMap_.find( ref );
 
 	// Check if scalar according to the value reference exists.
 	if ( itFind == integerScalarMap_.end() )
@@ -110,7 +194,7 @@ FMIComponentFrontEnd::setInteger( const fmiValueReference& ref, const fmiInteger
 	}
 
 	// Check if scalar is defined as input.
-	if ( itFind->second->causality_ != ScalarVariableAttributes::input )
+	if ( integerMetadata_[itFind->second].causality_ != ScalarVariableAttributes::input )
 	{
 		stringstream err;
 		err << "variable is not an input variable: " << ref;
@@ -118,8 +202,11 @@ FMIComponentFrontEnd::setInteger( const fmiValueReference& ref, const fmiInteger
 		return fmiWarning;
 	}
 
-	// Set value.
-	itFind->second->value_ = val;
+	// Set value and keep track of the change (values that do not change are not marked).
+	if ( val != integerValues_[itFind->second] ) {
+		integerValues_[itFind->second] = val;
+		integerChanges_.mark( itFind->second );
+	}
 
 	return fmiOK;
 }
@@ -128,8 +215,14 @@ FMIComponentFrontEnd::setInteger( const fmiValueReference& ref, const fmiInteger
 fmiStatus
 FMIComponentFrontEnd::setBoolean( const fmiValueReference& ref, const fmiBoolean& val )
 {
+	// Data must not be accessed while a step is pending.
+	waitForPendingStep();
+
+	// The data is stale in case the inter-process communication with the slave has failed.
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
 	// Search foreach value reference.
-	BooleanMap::iterator itFind = booleanScalarMap_.find( ref );
+	ScalarMap::const_iterator itFind = booleanScalarMap_.find( ref );
 
 	// Check if scalar according to the value reference exists.
 	if ( itFind == booleanScalarMap_.end() )
@@ -141,7 +234,7 @@ FMIComponentFrontEnd::setBoolean( const fmiValueReference& ref, const fmiBoolean
 	}
 
 	// Check if scalar is defined as input.
-	if ( itFind->second->causality_ != ScalarVariableAttributes::input )
+	if ( booleanMetadata_[itFind->second].causality_ != ScalarVariableAttributes::input )
 	{
 		stringstream err;
 		err << "variable is not an input variable: " << ref;
@@ -149,8 +242,11 @@ FMIComponentFrontEnd::setBoolean( const fmiValueReference& ref, const fmiBoolean
 		return fmiWarning;
 	}
 
-	// Set value.
-	itFind->second->value_ = val;
+	// Set value and keep track of the change (values that do not change are not marked).
+	if ( val != booleanValues_[itFind->second] ) {
+		booleanValues_[itFind->second] = val;
+		booleanChanges_.mark( itFind->second );
+	}
 
 	return fmiOK;
 }
@@ -159,8 +255,14 @@ FMIComponentFrontEnd::setBoolean( const fmiValueReference& ref, const fmiBoolean
 fmiStatus
 FMIComponentFrontEnd::setString( const fmiValueReference& ref, const fmiString& val )
 {
+	// Data must not be accessed while a step is pending.
+	waitForPendingStep();
+
+	// The data is stale in case the inter-process communication with the slave has failed.
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
 	// Search for value reference.
-	StringMap::iterator itFind = stringScalarMap_.find( ref );
+	ScalarMap::const_iterator itFind = stringScalarMap_.find( ref );
 
 	// Check if scalar according to the value reference exists.
 	if ( itFind == stringScalarMap_.end() )
@@ -172,7 +274,7 @@ FMIComponentFrontEnd::setString( const fmiValueReference& ref, const fmiString&
 	}
 
 	// Check if scalar is defined as input.
-	if ( itFind->second->causality_ != ScalarVariableAttributes::input )
+	if ( stringMetadata_[itFind->second].causality_ != ScalarVariableAttributes::input )
 	{
 		stringstream err;
 		err << "variable is not an input variable: " << ref;
@@ -180,8 +282,20 @@ FMIComponentFrontEnd::setString( const fmiValueReference& ref, const fmiString&
 		return fmiWarning;
 	}
 
-	// Set value.
-	itFind->second->value_ = val; // Attention: fmiString <-> std::string!!!
+	// Values that do not change are not marked.
+	if ( ( 0 != val ) && ( 0 == strcmp( val, stringValues_[itFind->second].c_str() ) ) ) return fmiOK;
+
+	stringChanges_.mark( itFind->second );
+
+	// Set value (copied to a fixed-capacity string slot).
+	if ( false == stringValues_[itFind->second].set( val ) )
+	{
+		stringstream err;
+		err << "string value has been truncated to " << SCALAR_VARIABLE_MAX_STRING_LENGTH - 1
+		    << " characters: " << ref;
+		logger( fmiWarning, "WARNING", err.str() );
+		return fmiWarning;
+	}
 
 	return fmiOK;
 }
@@ -190,8 +304,14 @@ FMIComponentFrontEnd::setString( const fmiValueReference& ref, const fmiString&
 fmiStatus
 FMIComponentFrontEnd::getReal( const fmiValueReference& ref, fmiReal& val )
 {
+	// Data must not be accessed while a step is pending.
+	waitForPendingStep();
+
+	// The data is stale in case the inter-process communication with the slave has failed.
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
 	// Search for value reference.
-	RealMap::const_iterator itFind = realScalarMap_.find( ref );
+	ScalarMap::const_iterator itFind = realScalarMap_.find( ref );
 
 	// Check if scalar according to the value reference exists.
 	if ( itFind == realScalarMap_.end() )
@@ -204,7 +324,7 @@ FMIComponentFrontEnd::getReal( const fmiValueReference& ref, fmiReal& val )
 	}
 
 	// Get value.
-	val = itFind->second->value_;
+	val = realValues_[itFind->second];
 
 	return fmiOK;
 }
@@ -213,8 +333,14 @@ FMIComponentFrontEnd::getReal( const fmiValueReference& ref, fmiReal& val )
 fmiStatus
 FMIComponentFrontEnd::getInteger( const fmiValueReference& ref, fmiInteger& val )
 {
+	// Data must not be accessed while a step is pending.
+	waitForPendingStep();
+
+	// The data is stale in case the inter-process communication with the slave has failed.
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
 	// Search for value reference.
-	IntegerMap::const_iterator itFind = integerScalarMap_.find( ref );
+	ScalarMap::const_iterator itFind = integerScalarMap_.find( ref );
 
 	// Check if scalar according to the value reference exists.
 	if ( itFind == integerScalarMap_.end() )
@@ -227,7 +353,7 @@ FMIComponentFrontEnd::getInteger( const fmiValueReference& ref, fmiInteger& val
 	}
 
 	// Get value.
-	val = itFind->second->value_;
+	val = integerValues_[itFind->second];
 
 	return fmiOK;
 }
@@ -236,8 +362,14 @@ FMIComponentFrontEnd::getInteger( const fmiValueReference& ref, fmiInteger& val
 fmiStatus
 FMIComponentFrontEnd::getBoolean( const fmiValueReference& ref, fmiBoolean& val )
 {
+	// Data must not be accessed while a step is pending.
+	waitForPendingStep();
+
+	// The data is stale in case the inter-process communication with the slave has failed.
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
 	// Search for value reference.
-	BooleanMap::const_iterator itFind = booleanScalarMap_.find( ref );
+	ScalarMap::const_iterator itFind = booleanScalarMap_.find( ref );
 
 	// Check if scalar according to the value reference exists.
 	if ( itFind == booleanScalarMap_.end() )
@@ -250,7 +382,7 @@ FMIComponentFrontEnd::getBoolean( const fmiValueReference& ref, fmiBoolean& val
 	}
 
 	// Get value.
-	val = itFind->second->value_;
+	val = booleanValues_[itFind->second];
 
 	return fmiOK;
 }
@@ -259,8 +391,14 @@ FMIComponentFrontEnd::getBoolean( const fmiValueReference& ref, fmiBoolean& val
 fmiStatus
 FMIComponentFrontEnd::getString( const fmiValueReference& ref, fmiString& val )
 {
+	// Data must not be accessed while a step is pending.
+	waitForPendingStep();
+
+	// The data is stale in case the inter-process communication with the slave has failed.
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
 	// Search for value reference.
-	StringMap::const_iterator itFind = stringScalarMap_.find( ref );
+	ScalarMap::const_iterator itFind = stringScalarMap_.find( ref );
 
 	// Check if scalar according to the value reference exists.
 	if ( itFind == stringScalarMap_.end() )
@@ -273,7 +411,7 @@ FMIComponentFrontEnd::getString( const fmiValueReference& ref, fmiString& val )
 	}
 
 	// Get value.
-	val = itFind->second->value_.c_str(); // Attention: fmiString <-> std::string!!!
+	val = stringValues_[itFind->second].c_str();
 
 	return fmiOK;
 }
@@ -323,44 +461,195 @@ FMIComponentFrontEnd::instantiateSlave( const string& instanceName, const string
 		return fmiFatal;
 	}
 
-	size_t nRealScalars;
-	RealCollection realScalars;
+	// Re-use an external application that has been kept alive after another instance of this
+	// FMU has been freed or join an application shared with other instances of this FMU (see
+	// SlaveProcessPool), otherwise launch a new one.
+	parseProcessOptions( &modelDescription, processPoolSize_, instancesPerProcess_ );
+	processPoolKey_ = fmuLocationTrimmed + string( "#" ) + fmuGUID;
 
-	size_t nIntegerScalars;
-	IntegerCollection integerScalars;
+	if ( ( 1 < instancesPerProcess_ ) && ( 0 != processPoolSize_ ) ) {
+		logger( fmiWarning, "WARNING", "applications shared by several instances are not kept in the process pool" );
+		processPoolSize_ = 0;
+	}
 
-	size_t nBooleanScalars;
-	BooleanCollection booleanScalars;
+	FMIComponentFrontEnd* idle = ( 0 != processPoolSize_ ) ? SlaveProcessPool::acquire( processPoolKey_ ) : 0;
+
+	long sharedPid = 0;
+	if ( ( 1 < instancesPerProcess_ ) && ( true == SlaveProcessPool::join( processPoolKey_, sharedPid, instance_ ) ) )
+		pid_ = sharedPid;
+
+	if ( 0 != idle )
+	{
+		swapProcess( *idle );
+		delete idle;
 
+		*slaveLoggingOn_ = ( fmiTrue == loggingOn_ );
+
+		stringstream info;
+		info << "re-using external application. PID = " << pid_;
+		logger( fmiOK, "DEBUG", info.str() );
+	}
+	else
+	{
+		fmiStatus status = launchApplication( &modelDescription, mimeType, fmuLocationTrimmed );
+		if ( fmiOK != status ) return status;
+
+		if ( ( 1 < instancesPerProcess_ ) && ( 0 == instance_ ) )
+			SlaveProcessPool::share( processPoolKey_, static_cast<long>( pid_ ), instancesPerProcess_ );
+	}
+
+	initializeVariables( &modelDescription );
+
+	// Pipeline calls to doStep(...) only if explicitly requested, the slave may run asynchronously and the
+	// master provides a callback function to be notified about finished steps. Importers commonly provide a
+	// stepFinished(...) function that does nothing, hence this alone does not suffice to return fmiPending.
+	bool pipelineDoStep = false;
+	parseStepOptions( &modelDescription, pipelineDoStep );
+	pipelinedDoStep_ = ( true == pipelineDoStep ) &&
+		( true == modelDescription.canRunAsynchronuously() ) && ( 0 != functions_->stepFinished );
+	if ( true == pipelinedDoStep_ ) {
+		logger( fmiOK, "DEBUG", "doStep(...) returns fmiPending, steps are finished asynchronously" );
+		stepThread_ = new boost::thread( &FMIComponentFrontEnd::runStepThread, this );
+	}
+
+	return fmiOK;
+}
+
+
+fmiStatus
+FMIComponentFrontEnd::launchApplication( const ModelDescription* modelDescription,
+					 const string& mimeType,
+					 const string& fmuLocation )
+{
+	size_t nRealScalars;
+	size_t nIntegerScalars;
+	size_t nBooleanScalars;
 	size_t nStringScalars;
-	StringCollection stringScalars;
 
 	// Parse number of model variables from model description.
-	modelDescription.getNumberOfVariables( nRealScalars, nIntegerScalars, nBooleanScalars, nStringScalars );
+	modelDescription->getNumberOfVariables( nRealScalars, nIntegerScalars, nBooleanScalars, nStringScalars );
+
+	// Optionally, use sockets instead of shared memory or use huge pages and lock the
+	// shared memory segment in memory (see vendor annotations).
+	string ipc;
+	string ipcHost;
+	unsigned int ipcPort = 0;
+	bool shmHugePages = false;
+	bool shmLockMemory = false;
+	parseIPCOptions( modelDescription, ipc, ipcHost, ipcPort, shmHugePages, shmLockMemory );
+
+	// Instances sharing an application communicate via regions of one shared memory segment.
+	if ( ( 1 < instancesPerProcess_ ) && ( ( "tcp" == ipc ) || ( "unix" == ipc ) ) ) {
+		logger( fmiWarning, "WARNING", "sockets do not support applications shared by several instances, using shared memory" );
+		ipc = "shm";
+	}
 
-	// Start application.
-	/// \FIXME Allow to start applications remotely on other machines?
-	if ( false == startApplication( &modelDescription, mimeType, fmuLocationTrimmed ) ) {
-		logger( fmiFatal, "ABORT", "unable to start external simulator application" );
-		return fmiFatal;
+	ipcLogger_ = new IPCMasterLogger( this );
+
+	// Sockets are set up before the application is started. The application inherits
+	// the address to connect to via an environment variable (see FMIComponentBackEnd).
+	if ( ( "tcp" == ipc ) || ( "unix" == ipc ) )
+	{
+		string address;
+		if ( "tcp" == ipc ) {
+			address = string( "tcp://" ) + ipcHost + ":" + boost::lexical_cast<string>( ipcPort );
+		} else {
+			boost::filesystem::path socketPath = boost::filesystem::temp_directory_path() /
+				boost::filesystem::unique_path( "fmipp-%%%%-%%%%-%%%%.sock" );
+			address = string( "unix://" ) + socketPath.string();
+		}
+
+		ipcMaster_ = IPCMasterFactory::createIPCMaster<SocketMaster>( address, ipcLogger_ );
+		SocketMaster* socketMaster = static_cast<SocketMaster*>( ipcMaster_ );
+
+		if ( false == socketMaster->isOperational() ) {
+			logger( fmiFatal, "ABORT", "unable to set up socket for inter-process communication" );
+			return fmiFatal;
+		}
+
+		logger( fmiOK, "DEBUG", string( "socket address = " ) + socketMaster->getAddress() );
+		HelperFunctions::setEnvironmentVariable( "FMIPP_IPC_ADDRESS", socketMaster->getAddress() );
+	}
+	else if ( ( false == ipc.empty() ) && ( "shm" != ipc ) )
+	{
+		logger( fmiWarning, "WARNING", string( "unknown type of inter-process communication, using shared memory: " ) + ipc );
 	}
 
-	// Create shared memory segment.
-	/// \FIXME Allow other types of inter process communication.
-	string shmSegmentName = string( "FMI_SEGMENT_PID" ) + boost::lexical_cast<string>( pid_ );
+	// Start application, unless this instance joins an application shared with other instances.
+	if ( 0 == instance_ )
+	{
+		// The application inherits the number of instances it is supposed to serve.
+		if ( 1 < instancesPerProcess_ )
+			HelperFunctions::setEnvironmentVariable( "FMIPP_INSTANCES", boost::lexical_cast<string>( instancesPerProcess_ ) );
 
-	/// \FIXME Use more sensible estimate for the segment size.
-	long unsigned int shmSegmentSize = 2048
-		+ nRealScalars*sizeof(RealScalar)
-		+ nIntegerScalars*sizeof(IntegerScalar)
-		+ nBooleanScalars*sizeof(BooleanScalar)
-		+ nStringScalars*2048;
+		/// \FIXME Allow to start applications remotely on other machines?
+		bool applicationStarted = startApplication( modelDescription, mimeType, fmuLocation );
 
-	ipcLogger_ = new IPCMasterLogger( this );
-	ipcMaster_ = IPCMasterFactory::createIPCMaster<SHMMaster>( shmSegmentName, shmSegmentSize, ipcLogger_ );
+		// The environment variables must not be inherited by applications started later on.
+		if ( 0 != ipcMaster_ ) HelperFunctions::setEnvironmentVariable( "FMIPP_IPC_ADDRESS", string() );
+		if ( 1 < instancesPerProcess_ ) HelperFunctions::setEnvironmentVariable( "FMIPP_INSTANCES", string() );
+
+		if ( false == applicationStarted ) {
+			logger( fmiFatal, "ABORT", "unable to start external simulator application" );
+			return fmiFatal;
+		}
+	}
+	else
+	{
+		stringstream info;
+		info << "joining external application shared with other instances. PID = " << pid_
+		     << " - instance = " << instance_;
+		logger( fmiOK, "DEBUG", info.str() );
+	}
+
+	if ( 0 == ipcMaster_ )
+	{
+		// Create shared memory segment. Instances sharing an application use a region of the same
+		// segment each, the first instance creates the segment with regions for all instances.
+		string shmSegmentName = string( "FMI_SEGMENT_PID" ) + boost::lexical_cast<string>( pid_ );
+
+		// Plan all objects that will be created in the shared memory segment (in each region),
+		// in order to compute its size.
+		SHMSegmentPlan shmSegmentPlan( shmSegmentName, instancesPerProcess_ );
+		shmSegmentPlan.addObject<fmiReal>( "current_comm_point" );
+		shmSegmentPlan.addObject<fmiReal>( "comm_step_size" );
+		shmSegmentPlan.addObject<bool>( "enforce_step" );
+		shmSegmentPlan.addObject<bool>( "reject_step" );
+		shmSegmentPlan.addObject<bool>( "slave_has_terminated" );
+		shmSegmentPlan.addObject<bool>( "logging_on" );
+		shmSegmentPlan.addObject<bool>( "reset_slave" );
+		shmSegmentPlan.addScalars<fmiReal>( "real_scalars", nRealScalars );
+		shmSegmentPlan.addScalars<fmiInteger>( "integer_scalars", nIntegerScalars );
+		shmSegmentPlan.addScalars<fmiBoolean>( "boolean_scalars", nBooleanScalars );
+		shmSegmentPlan.addScalars<ScalarVariableString>( "string_scalars", nStringScalars );
+		shmSegmentPlan.addChangeLog( "real_scalars", nRealScalars );
+		shmSegmentPlan.addChangeLog( "integer_scalars", nIntegerScalars );
+		shmSegmentPlan.addChangeLog( "boolean_scalars", nBooleanScalars );
+		shmSegmentPlan.addChangeLog( "string_scalars", nStringScalars );
+		shmSegmentPlan.addLogChannel( "slave_log", slaveLogCapacity );
+
+		long unsigned int shmSegmentSize = shmSegmentPlan.getSegmentSize( shmHugePages );
+
+		stringstream shmInfo;
+		shmInfo << "shared memory segment size = " << shmSegmentSize
+			<< " bytes (payload = " << shmSegmentPlan.getPayloadSize() << " bytes)";
+		logger( fmiOK, "DEBUG", shmInfo.str() );
+
+		if ( 1 == instancesPerProcess_ ) {
+			ipcMaster_ = IPCMasterFactory::createIPCMaster<SHMMaster>( shmSegmentName, shmSegmentSize, ipcLogger_ );
+		} else {
+			ipcMaster_ = IPCMasterFactory::createIPCMaster<SHMMaster>( shmSegmentName, shmSegmentSize, ipcLogger_,
+										   instance_, instancesPerProcess_ );
+		}
+
+		SHMMaster* shmMaster = static_cast<SHMMaster*>( ipcMaster_ );
+		if ( true == shmHugePages ) shmMaster->adviseHugePages();
+		if ( true == shmLockMemory ) shmMaster->lockMemory();
+	}
 
 	// Synchronization point - take control back from slave.
 	ipcMaster_->waitForSlave();
+	if ( false == isSlaveConnected() ) return fmiFatal;
 
 	// Create variables used for internal frontend/backend syncing.
 	if ( false == ipcMaster_->createVariable( "current_comm_point", currentCommunicationPoint_, 0. ) ) {
@@ -389,37 +678,75 @@ FMIComponentFrontEnd::instantiateSlave( const string& instanceName, const string
 	}
 
 	// Create boolean variable that tells the backend if logging is on/off.
-	bool* tmpLoggingOn = 0;
-	if ( false == ipcMaster_->createVariable( "logging_on", tmpLoggingOn, loggingOn_ ) ) {
+	if ( false == ipcMaster_->createVariable( "logging_on", slaveLoggingOn_, loggingOn_ ) ) {
 		logger( fmiFatal, "ABORT", "unable to create internal variable 'logging_on'" );
 		return fmiFatal;
 	}
 
-	// Create vector of real scalar variables.
-	if ( false == ipcMaster_->createScalars( "real_scalars", nRealScalars, realScalars ) ) {
-		logger( fmiFatal, "ABORT", "unable to create internal vector 'real_scalars'" );
+	if ( false == ipcMaster_->createVariable( "reset_slave", resetSlave_, false ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal variable 'reset_slave'" );
 		return fmiFatal;
 	}
 
-	// Create vector of integer scalar variables.
-	if ( false == ipcMaster_->createScalars( "integer_scalars", nIntegerScalars, integerScalars ) ) {
-		logger( fmiFatal, "ABORT", "unable to create internal vector 'integer_scalars'" );
+	// Create metadata table and array of values of real scalar variables.
+	if ( false == ipcMaster_->createScalars( "real_scalars", nRealScalars, realMetadata_, realValues_ ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal arrays 'real_scalars'" );
 		return fmiFatal;
 	}
 
-	// Create vector of boolean scalar variables.
-	if ( false == ipcMaster_->createScalars( "boolean_scalars", nBooleanScalars, booleanScalars ) ) {
-		logger( fmiFatal, "ABORT", "unable to create internal vector 'boolean_scalars'" );
+	// Create metadata table and array of values of integer scalar variables.
+	if ( false == ipcMaster_->createScalars( "integer_scalars", nIntegerScalars, integerMetadata_, integerValues_ ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal arrays 'integer_scalars'" );
 		return fmiFatal;
 	}
 
-	// Create vector of string scalar variables.
-	if ( false == ipcMaster_->createScalars( "string_scalars", nStringScalars, stringScalars ) ) {
-		logger( fmiFatal, "ABORT", "unable to create internal vector 'string_scalars'" );
+	// Create metadata table and array of values of boolean scalar variables.
+	if ( false == ipcMaster_->createScalars( "boolean_scalars", nBooleanScalars, booleanMetadata_, booleanValues_ ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal arrays 'boolean_scalars'" );
 		return fmiFatal;
 	}
 
-	initializeVariables( &modelDescription, realScalars, integerScalars, booleanScalars, stringScalars );
+	// Create metadata table and array of values of string scalar variables.
+	if ( false == ipcMaster_->createScalars( "string_scalars", nStringScalars, stringMetadata_, stringValues_ ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal arrays 'string_scalars'" );
+		return fmiFatal;
+	}
+
+	// Create change logs of the scalar variables.
+	unsigned int* log = 0;
+
+	if ( false == ipcMaster_->createChangeLog( "real_scalars", nRealScalars, log ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal array 'real_scalars_changes'" );
+		return fmiFatal;
+	}
+	realChanges_.attach( nRealScalars, log );
+
+	if ( false == ipcMaster_->createChangeLog( "integer_scalars", nIntegerScalars, log ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal array 'integer_scalars_changes'" );
+		return fmiFatal;
+	}
+	integerChanges_.attach( nIntegerScalars, log );
+
+	if ( false == ipcMaster_->createChangeLog( "boolean_scalars", nBooleanScalars, log ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal array 'boolean_scalars_changes'" );
+		return fmiFatal;
+	}
+	booleanChanges_.attach( nBooleanScalars, log );
+
+	if ( false == ipcMaster_->createChangeLog( "string_scalars", nStringScalars, log ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal array 'string_scalars_changes'" );
+		return fmiFatal;
+	}
+	stringChanges_.attach( nStringScalars, log );
+
+	// Create channel for log messages from the slave.
+	IPCLogRecord* records = 0;
+	unsigned int* count = 0;
+	if ( false == ipcMaster_->createLogChannel( "slave_log", slaveLogCapacity, records, count ) ) {
+		logger( fmiFatal, "ABORT", "unable to create internal array 'slave_log_records'" );
+		return fmiFatal;
+	}
+	slaveLog_.attach( slaveLogCapacity, records, count );
 
 	return fmiOK;
 }
@@ -428,11 +755,14 @@ FMIComponentFrontEnd::instantiateSlave( const string& instanceName, const string
 fmiStatus
 FMIComponentFrontEnd::initializeSlave( fmiReal tStart, fmiBoolean StopTimeDefined, fmiReal tStop )
 {
-	stringstream debugInfo;
-	debugInfo << "initialize slave at time t = " << tStart;
-	logger( fmiOK, "DEBUG", debugInfo.str().c_str() );
+	if ( fmiTrue == loggingOn_ ) {
+		stringstream debugInfo;
+		debugInfo << "initialize slave at time t = " << tStart;
+		logger( fmiOK, "DEBUG", debugInfo.str() );
+	}
 
 	*currentCommunicationPoint_ = tStart;
+	lastSuccessfulTime_ = tStart;
 
 	// Synchronization point - give control to the slave.
 	ipcMaster_->signalToSlave();
@@ -441,6 +771,8 @@ FMIComponentFrontEnd::initializeSlave( fmiReal tStart, fmiBoolean StopTimeDefine
 
 	// Synchronization point - take control back from slave.
 	ipcMaster_->waitForSlave();
+	if ( false == isSlaveConnected() ) return fmiFatal;
+	forwardSlaveLog();
 
 	logger( fmiOK, "DEBUG", "initialization done" );
 	
@@ -451,7 +783,50 @@ FMIComponentFrontEnd::initializeSlave( fmiReal tStart, fmiBoolean StopTimeDefine
 fmiStatus
 FMIComponentFrontEnd::resetSlave()
 {
-	return fmiFatal; /// \FIXME Replace dummy implementation.
+	logger( fmiOK, "DEBUG", "reset slave" );
+
+	// A step that is still pending has to be finished first.
+	waitForPendingStep();
+
+	if ( ( 0 == ipcMaster_ ) || ( true == *slaveHasTerminated_ ) ) {
+		logger( fmiFatal, "ABORT", "unable to reset slave, slave has terminated" );
+		return fmiFatal;
+	}
+
+	if ( false == isSlaveConnected() ) return fmiFatal;
+
+	// Restore start values and internal variables.
+	copy( realStartValues_.begin(), realStartValues_.end(), realValues_ );
+	copy( integerStartValues_.begin(), integerStartValues_.end(), integerValues_ );
+	copy( booleanStartValues_.begin(), booleanStartValues_.end(), booleanValues_ );
+	copy( stringStartValues_.begin(), stringStartValues_.end(), stringValues_ );
+
+	*currentCommunicationPoint_ = 0.;
+	*communicationStepSize_ = 0.;
+	*enforceTimeStep_ = false;
+	*rejectStep_ = false;
+	lastSuccessfulTime_ = 0.;
+	lastStepStatus_ = fmiOK;
+
+	// Synchronization point - let the slave start over. The slave acknowledges the
+	// reset by calling FMIComponentBackEnd::startInitialization() again.
+	*resetSlave_ = true;
+	ipcMaster_->signalToSlave();
+
+	// Synchronization point - take control back from slave.
+	ipcMaster_->waitForSlave();
+	if ( false == isSlaveConnected() ) return fmiFatal;
+	forwardSlaveLog();
+
+	if ( true == *resetSlave_ ) {
+		*resetSlave_ = false;
+		logger( fmiFatal, "ABORT", "slave does not support reset" );
+		return fmiFatal;
+	}
+
+	logger( fmiOK, "DEBUG", "reset done" );
+
+	return fmiOK;
 }
 
 
@@ -474,9 +849,14 @@ FMIComponentFrontEnd::getRealOutputDerivatives( const fmiValueReference vr[], si
 fmiStatus
 FMIComponentFrontEnd::doStep( fmiReal comPoint, fmiReal stepSize, fmiBoolean newStep )
 {
-	stringstream debugInfo;
-	debugInfo << "doStep" << " - communication point = " << comPoint << " - step size = " << stepSize;
-	logger( fmiOK, "DEBUG", debugInfo.str().c_str() );
+	if ( fmiTrue == loggingOn_ ) {
+		stringstream debugInfo;
+		debugInfo << "doStep" << " - communication point = " << comPoint << " - step size = " << stepSize;
+		logger( fmiOK, "DEBUG", debugInfo.str() );
+	}
+
+	// A step that is still pending has to be finished first.
+	waitForPendingStep();
 
 	if ( true == *slaveHasTerminated_ ) {
 		logger( fmiFatal, "DEBUG", "slave has terminated" );
@@ -484,6 +864,11 @@ FMIComponentFrontEnd::doStep( fmiReal comPoint, fmiReal stepSize, fmiBoolean new
 		return fmiFatal;
 	}
 
+	if ( false == isSlaveConnected() ) {
+		callStepFinished( fmiFatal );
+		return fmiFatal;
+	}
+
 	// if ( 0. == stepSize ) { // This is an event.
 	// 	/// \FIXME Nothing else to be done here?
 	// 	callStepFinished( fmiOK );
@@ -493,10 +878,10 @@ FMIComponentFrontEnd::doStep( fmiReal comPoint, fmiReal stepSize, fmiBoolean new
 	//cout << "\tcomPoint = " << comPoint << " - currentCommunicationPoint_ = " << *currentCommunicationPoint_ << endl; fflush(stdout);
 
 	if ( *currentCommunicationPoint_ != comPoint ) {
-		debugInfo.str( string() );
-		debugInfo << "internal time (" << *currentCommunicationPoint_ << ") "
-			  << "does not match communication point (" << comPoint << ")";
-		logger( fmiDiscard, "DISCARD STEP", debugInfo.str().c_str() );
+		stringstream err;
+		err << "internal time (" << *currentCommunicationPoint_ << ") "
+		    << "does not match communication point (" << comPoint << ")";
+		logger( fmiDiscard, "DISCARD STEP", err.str() );
 		callStepFinished( fmiDiscard );
 		return fmiDiscard;
 	}
@@ -515,29 +900,21 @@ FMIComponentFrontEnd::doStep( fmiReal comPoint, fmiReal stepSize, fmiBoolean new
 		*communicationStepSize_ = stepSize;
 	}
 
-	logger( fmiOK, "DEBUG", "start synchronization with slave ..." );
-
-	// Synchronization point - give control to slave and let it do its work ...
-	ipcMaster_->signalToSlave();
-
-	// Synchronization point - take control back from slave.
-	ipcMaster_->waitForSlave();
-
-	logger( fmiOK, "DEBUG", "... DONE" );
+	// Hand the step over to the worker thread, which lets the slave do the step and finishes it.
+	if ( true == pipelinedDoStep_ )
+	{
+		{
+			boost::mutex::scoped_lock lock( stepMutex_ );
+			stepPending_ = true;
+			stepRequested_ = true;
+			requestedStepSize_ = stepSize;
+		}
+		stepCondition_.notify_all();
 
-	if ( true == *rejectStep_ ) {
-		*rejectStep_ = false; // Reset flag.
-		logger( fmiDiscard, "DISCARD STEP", "step rejected by slave" );
-		callStepFinished( fmiDiscard );
-		return fmiDiscard;
+		return fmiPending;
 	}
 
-	// Advance time.
-	*currentCommunicationPoint_ += stepSize;
-
-	callStepFinished( fmiOK );
-
-	return fmiOK;
+	return finishStep( stepSize );
 }
 
 
@@ -551,14 +928,22 @@ FMIComponentFrontEnd::cancelStep()
 fmiStatus
 FMIComponentFrontEnd::getStatus( const fmiStatusKind s, fmiStatus* value )
 {
-	return fmiFatal; /// \FIXME Replace dummy implementation.
+	if ( fmiDoStepStatus != s ) return fmiDiscard;
+
+	boost::mutex::scoped_lock lock( stepMutex_ );
+	*value = ( true == stepPending_ ) ? fmiPending : lastStepStatus_;
+	return fmiOK;
 }
 
 
 fmiStatus
 FMIComponentFrontEnd::getRealStatus( const fmiStatusKind s, fmiReal* value )
 {
-	return fmiFatal; /// \FIXME Replace dummy implementation.
+	if ( fmiLastSuccessfulTime != s ) return fmiDiscard;
+
+	boost::mutex::scoped_lock lock( stepMutex_ );
+	*value = lastSuccessfulTime_;
+	return fmiOK;
 }
 
 
@@ -588,6 +973,9 @@ FMIComponentFrontEnd::logger( fmiStatus status, const string& category, const st
 {
 	if ( ( status == fmiOK ) && ( fmiFalse == loggingOn_ ) ) return;
 
+	// Front end components kept in the process pool have no callback functions.
+	if ( 0 == functions_ ) return;
+
 	functions_->logger( static_cast<fmiComponent>( this ),
 			    instanceName_.c_str(), status,
 			    category.c_str(), msg.c_str() );
@@ -782,17 +1170,176 @@ FMIComponentFrontEnd::killApplication()
 }
 
 
+// Check for options concerning the inter-process communication (as part of optional vendor
+// annotations): the type of communication ("ipc"), the host and port the master listens at
+// in case of TCP sockets ("ipcHost" and "ipcPort", by default the loopback interface and a
+// free port), back the shared memory segment with huge pages ("shmHugePages") and lock the
+// segment in physical memory ("shmLockMemory").
 void
-FMIComponentFrontEnd::initializeVariables( const ModelDescription* modelDescription,
-					   RealCollection& realScalars,
-					   IntegerCollection& integerScalars,
-					   BooleanCollection& booleanScalars,
-					   StringCollection& stringScalars )
+FMIComponentFrontEnd::parseIPCOptions( const ModelDescription* modelDescription,
+				       string& ipc,
+				       string& host,
+				       unsigned int& port,
+				       bool& hugePages,
+				       bool& lockMemory ) const
 {
-	RealCollection::iterator itRealScalar = realScalars.begin();
-	IntegerCollection::iterator itIntegerScalar = integerScalars.begin();
-	BooleanCollection::iterator itBooleanScalar = booleanScalars.begin();
-	StringCollection::iterator itStringScalar = stringScalars.begin();
+	using namespace ModelDescriptionUtilities;
+
+	host = "127.0.0.1";
+	port = 0;
+
+	if ( modelDescription->hasVendorAnnotations() )
+	{
+		string applicationName = modelDescription->getMIMEType().substr( 14 );
+		const Properties& vendorAnnotations = modelDescription->getVendorAnnotations();
+		if ( hasChild( vendorAnnotations, applicationName ) )
+		{
+			const Properties& annotations = getChildAttributes( vendorAnnotations, applicationName );
+
+			ipc = hasChild( annotations, "ipc" ) ?
+				annotations.get<string>( "ipc" ) : string();
+
+			if ( hasChild( annotations, "ipcHost" ) ) host = annotations.get<string>( "ipcHost" );
+
+			if ( hasChild( annotations, "ipcPort" ) ) port = annotations.get<unsigned int>( "ipcPort" );
+
+			hugePages = hasChild( annotations, "shmHugePages" ) ?
+				annotations.get<bool>( "shmHugePages" ) : false;
+
+			lockMemory = hasChild( annotations, "shmLockMemory" ) ?
+				annotations.get<bool>( "shmLockMemory" ) : false;
+		}
+	}
+}
+
+
+// Check for the number of idle applications to be kept alive for later use ("processPoolSize")
+// and for the number of instances that share one application ("instancesPerProcess"), as part
+// of optional vendor annotations. By default, no application is kept and none is shared.
+void
+FMIComponentFrontEnd::parseProcessOptions( const ModelDescription* modelDescription,
+					   unsigned int& processPoolSize,
+					   unsigned int& instancesPerProcess ) const
+{
+	using namespace ModelDescriptionUtilities;
+
+	processPoolSize = 0;
+	instancesPerProcess = 1;
+
+	if ( modelDescription->hasVendorAnnotations() )
+	{
+		string applicationName = modelDescription->getMIMEType().substr( 14 );
+		const Properties& vendorAnnotations = modelDescription->getVendorAnnotations();
+		if ( hasChild( vendorAnnotations, applicationName ) )
+		{
+			const Properties& annotations = getChildAttributes( vendorAnnotations, applicationName );
+
+			if ( hasChild( annotations, "processPoolSize" ) )
+				processPoolSize = annotations.get<unsigned int>( "processPoolSize" );
+
+			if ( hasChild( annotations, "instancesPerProcess" ) )
+				instancesPerProcess = annotations.get<unsigned int>( "instancesPerProcess" );
+
+			if ( 0 == instancesPerProcess ) instancesPerProcess = 1;
+		}
+	}
+}
+
+
+// Check if calls to doStep(...) should be pipelined ("pipelineDoStep", as part of optional vendor
+// annotations). By default, doStep(...) blocks until the step has been finished.
+void
+FMIComponentFrontEnd::parseStepOptions( const ModelDescription* modelDescription,
+					bool& pipelineDoStep ) const
+{
+	using namespace ModelDescriptionUtilities;
+
+	pipelineDoStep = false;
+
+	if ( modelDescription->hasVendorAnnotations() )
+	{
+		string applicationName = modelDescription->getMIMEType().substr( 14 );
+		const Properties& vendorAnnotations = modelDescription->getVendorAnnotations();
+		if ( hasChild( vendorAnnotations, applicationName ) )
+		{
+			const Properties& annotations = getChildAttributes( vendorAnnotations, applicationName );
+
+			if ( hasChild( annotations, "pipelineDoStep" ) )
+				pipelineDoStep = annotations.get<bool>( "pipelineDoStep" );
+		}
+	}
+}
+
+
+void
+FMIComponentFrontEnd::swapProcess( FMIComponentFrontEnd& other )
+{
+	swap( realMetadata_, other.realMetadata_ );
+	swap( integerMetadata_, other.integerMetadata_ );
+	swap( booleanMetadata_, other.booleanMetadata_ );
+	swap( stringMetadata_, other.stringMetadata_ );
+
+	swap( realValues_, other.realValues_ );
+	swap( integerValues_, other.integerValues_ );
+	swap( booleanValues_, other.booleanValues_ );
+	swap( stringValues_, other.stringValues_ );
+
+	swap( realChanges_, other.realChanges_ );
+	swap( integerChanges_, other.integerChanges_ );
+	swap( booleanChanges_, other.booleanChanges_ );
+	swap( stringChanges_, other.stringChanges_ );
+
+	swap( slaveLog_, other.slaveLog_ );
+
+	swap( ipcMaster_, other.ipcMaster_ );
+	swap( ipcLogger_, other.ipcLogger_ );
+
+	swap( currentCommunicationPoint_, other.currentCommunicationPoint_ );
+	swap( communicationStepSize_, other.communicationStepSize_ );
+	swap( enforceTimeStep_, other.enforceTimeStep_ );
+	swap( rejectStep_, other.rejectStep_ );
+	swap( slaveHasTerminated_, other.slaveHasTerminated_ );
+	swap( slaveLoggingOn_, other.slaveLoggingOn_ );
+	swap( resetSlave_, other.resetSlave_ );
+
+	swap( pid_, other.pid_ );
+
+	// Messages from the inter-process communication go to the new owner.
+	if ( 0 != ipcLogger_ ) ipcLogger_->setFrontEnd( this );
+	if ( 0 != other.ipcLogger_ ) other.ipcLogger_->setFrontEnd( &other );
+}
+
+
+void
+FMIComponentFrontEnd::releaseProcess()
+{
+	if ( ( true == *slaveHasTerminated_ ) ||
+	     ( SlaveProcessPool::getNumberOfIdleProcesses( processPoolKey_ ) >= processPoolSize_ ) ) return;
+
+	// Only applications that are waiting to be initialized can be re-used.
+	if ( fmiOK != resetSlave() ) return;
+
+	// The pool takes ownership of the application by means of an otherwise empty front end component.
+	FMIComponentFrontEnd* idle = new FMIComponentFrontEnd;
+	idle->swapProcess( *this );
+
+	if ( false == SlaveProcessPool::release( processPoolKey_, idle, processPoolSize_ ) ) {
+		swapProcess( *idle );
+		delete idle;
+		return;
+	}
+
+	logger( fmiOK, "DEBUG", "external application has been put into the process pool" );
+}
+
+
+void
+FMIComponentFrontEnd::initializeVariables( const ModelDescription* modelDescription )
+{
+	unsigned int iRealScalar = 0;
+	unsigned int iIntegerScalar = 0;
+	unsigned int iBooleanScalar = 0;
+	unsigned int iStringScalar = 0;
 
 	const string xmlRealTag( "Real" );
 	const string xmlIntegerTag( "Integer" );
@@ -805,30 +1352,30 @@ FMIComponentFrontEnd::initializeVariables( const ModelDescription* modelDescript
 	{
 		if ( v.second.find( xmlRealTag ) != v.second.not_found() )
 		{
-			initializeScalar( *itRealScalar, &v.second, xmlRealTag, this );
-			realScalarMap_[(*itRealScalar)->valueReference_] = *itRealScalar;
-			++itRealScalar;
+			initializeScalar( &realMetadata_[iRealScalar], &realValues_[iRealScalar], &v.second, xmlRealTag, this );
+			realScalarMap_[realMetadata_[iRealScalar].valueReference_] = iRealScalar;
+			++iRealScalar;
 			continue;
 		}
 		else if ( v.second.find( xmlIntegerTag ) != v.second.not_found() )
 		{
-			initializeScalar( *itIntegerScalar, &v.second, xmlIntegerTag, this );
-			integerScalarMap_[(*itIntegerScalar)->valueReference_] = *itIntegerScalar;
-			++itIntegerScalar;
+			initializeScalar( &integerMetadata_[iIntegerScalar], &integerValues_[iIntegerScalar], &v.second, xmlIntegerTag, this );
+			integerScalarMap_[integerMetadata_[iIntegerScalar].valueReference_] = iIntegerScalar;
+			++iIntegerScalar;
 			continue;
 		}
 		else if ( v.second.find( xmlBooleanTag ) != v.second.not_found() )
 		{
-			initializeScalar( *itBooleanScalar, &v.second, xmlBooleanTag, this );
-			booleanScalarMap_[(*itBooleanScalar)->valueReference_] = *itBooleanScalar;
-			++itBooleanScalar;
+			initializeScalar( &booleanMetadata_[iBooleanScalar], &booleanValues_[iBooleanScalar], &v.second, xmlBooleanTag, this );
+			booleanScalarMap_[booleanMetadata_[iBooleanScalar].valueReference_] = iBooleanScalar;
+			++iBooleanScalar;
 			continue;
 		}
 		else if ( v.second.find( xmlStringTag ) != v.second.not_found() )
 		{
-			initializeScalar( *itStringScalar, &v.second, xmlStringTag, this );
-			stringScalarMap_[(*itStringScalar)->valueReference_] = *itStringScalar;
-			++itStringScalar;
+			initializeScalar( &stringMetadata_[iStringScalar], &stringValues_[iStringScalar], &v.second, xmlStringTag, this );
+			stringScalarMap_[stringMetadata_[iStringScalar].valueReference_] = iStringScalar;
+			++iStringScalar;
 			continue;
 		} else {
 			stringstream err;
@@ -836,43 +1383,162 @@ FMIComponentFrontEnd::initializeVariables( const ModelDescription* modelDescript
 			logger( fmiFatal, "ABORT", err.str() );
 		}
 	}
+
+	// Keep the start values, they are restored when the slave is reset.
+	realStartValues_.assign( realValues_, realValues_ + iRealScalar );
+	integerStartValues_.assign( integerValues_, integerValues_ + iIntegerScalar );
+	booleanStartValues_.assign( booleanValues_, booleanValues_ + iBooleanScalar );
+	stringStartValues_.assign( stringValues_, stringValues_ + iStringScalar );
 }
 
 
 template<typename T>
-void initializeScalar( ScalarVariable<T>* scalar,
-					const ModelDescription::Properties* description,
-					const string& xmlTypeTag,
-					FMIComponentFrontEnd* frontend )
+void initializeScalar( ScalarVariableMetadata* metadata,
+		       T* value,
+		       const ModelDescription::Properties* description,
+		       const string& xmlTypeTag,
+		       FMIComponentFrontEnd* frontend )
 {
 	using namespace ScalarVariableAttributes;
 	using namespace ModelDescriptionUtilities;
 
 	const Properties& attributes = getAttributes( *description );
 
-	scalar->setName( attributes.get<string>( "name" ) );
-	scalar->valueReference_ = attributes.get<int>( "valueReference" );
-	scalar->causality_ = getCausality( attributes.get<string>( "causality" ) );
-	scalar->variability_ = getVariability( attributes.get<string>( "variability" ) );
+	metadata->setName( attributes.get<string>( "name" ) );
+	metadata->valueReference_ = attributes.get<int>( "valueReference" );
+	metadata->causality_ = getCausality( attributes.get<string>( "causality" ) );
+	metadata->variability_ = getVariability( attributes.get<string>( "variability" ) );
 
 	if ( hasChildAttributes( *description, xmlTypeTag ) )
 	{
 		const Properties& properties = getChildAttributes( *description, xmlTypeTag );
 
 		if ( properties.find( "start" ) != properties.not_found() )
-			scalar->value_ = properties.get<T>( "start" );
+			getStartValue( properties, *value );
 	}
 
 	/// \FIXME What about the remaining properties?
 
 	stringstream info;
 	info << "initialized scalar variable." << 
-		" name = " << scalar->name_ <<
+		" name = " << metadata->name_ <<
 		" - type = " << xmlTypeTag <<
-		" - valueReference = " << scalar->valueReference_ <<
-		" - causality = " << scalar->causality_ <<
-		" - variability = " << scalar->variability_ <<
-		" - value = " << scalar->value_;
+		" - valueReference = " << metadata->valueReference_ <<
+		" - causality = " << metadata->causality_ <<
+		" - variability = " << metadata->variability_ <<
+		" - value = " << *value;
 	frontend->logger( fmiOK, "DEBUG", info.str() );
 
 }
+
+
+fmiStatus
+FMIComponentFrontEnd::finishStep( fmiReal stepSize )
+{
+	if ( fmiTrue == loggingOn_ ) logger( fmiOK, "DEBUG", "start synchronization with slave ..." );
+
+	// Synchronization point - give control to slave and let it do its work ...
+	ipcMaster_->signalToSlave();
+
+	// Synchronization point - take control back from slave.
+	ipcMaster_->waitForSlave();
+
+	// The step is lost together with the slave.
+	if ( false == isSlaveConnected() ) {
+		{
+			boost::mutex::scoped_lock lock( stepMutex_ );
+			lastStepStatus_ = fmiFatal;
+			stepPending_ = false;
+		}
+
+		callStepFinished( fmiFatal );
+		return fmiFatal;
+	}
+
+	forwardSlaveLog();
+
+	if ( fmiTrue == loggingOn_ ) logger( fmiOK, "DEBUG", "... DONE" );
+
+	fmiStatus status = fmiOK;
+
+	if ( true == *rejectStep_ ) {
+		*rejectStep_ = false; // Reset flag.
+		logger( fmiDiscard, "DISCARD STEP", "step rejected by slave" );
+		status = fmiDiscard;
+	} else {
+		// Advance time.
+		*currentCommunicationPoint_ += stepSize;
+	}
+
+	{
+		boost::mutex::scoped_lock lock( stepMutex_ );
+		if ( fmiOK == status ) lastSuccessfulTime_ = *currentCommunicationPoint_;
+		lastStepStatus_ = status;
+		stepPending_ = false;
+	}
+
+	callStepFinished( status );
+
+	return status;
+}
+
+
+// Check if the inter-process communication with the slave is still working. It fails in case
+// the slave has crashed or closed the connection (sockets).
+bool
+FMIComponentFrontEnd::isSlaveConnected()
+{
+	if ( ( 0 != ipcMaster_ ) && ( true == ipcMaster_->isOperational() ) ) return true;
+
+	logger( fmiFatal, "ABORT", "inter-process communication with slave has failed" );
+	return false;
+}
+
+
+void
+FMIComponentFrontEnd::waitForPendingStep()
+{
+	if ( 0 == stepThread_ ) return;
+
+	boost::mutex::scoped_lock lock( stepMutex_ );
+	while ( true == stepRequested_ ) stepCondition_.wait( lock );
+}
+
+
+void
+FMIComponentFrontEnd::runStepThread()
+{
+	boost::mutex::scoped_lock lock( stepMutex_ );
+
+	while ( true )
+	{
+		while ( ( false == stepRequested_ ) && ( false == stopStepThread_ ) ) stepCondition_.wait( lock );
+
+		if ( false == stepRequested_ ) return; // Stop request and no step left to finish.
+
+		fmiReal stepSize = requestedStepSize_;
+
+		// The step is finished without holding the lock (finishStep(...) updates the step status itself).
+		lock.unlock();
+		finishStep( stepSize );
+		lock.lock();
+
+		stepRequested_ = false;
+		stepCondition_.notify_all();
+	}
+}
+
+
+void
+FMIComponentFrontEnd::forwardSlaveLog()
+{
+	const unsigned int nRecords = slaveLog_.getNumberOfRecords();
+	if ( 0 == nRecords ) return;
+
+	for ( unsigned int k = 0; k < nRecords; ++k ) {
+		const IPCLogRecord& record = slaveLog_.getRecord( k );
+		logger( record.status_, record.category_, record.message_ );
+	}
+
+	slaveLog_.clear();
+}
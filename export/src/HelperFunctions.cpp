@@ -13,6 +13,8 @@
 #include "Shlwapi.h"
 #endif
 
+#include <cstdlib>
+
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/bind.hpp>
@@ -73,5 +75,17 @@ namespace HelperFunctions {
 #endif
 	}
 
-}
 
+	bool
+	setEnvironmentVariable( const std::string& name, const std::string& value )
+	{
+#ifdef WIN32
+		// An empty value removes the variable.
+		return ( 0 == _putenv_s( name.c_str(), value.c_str() ) );
+#else
+		if ( true == value.empty() ) return ( 0 == unsetenv( name.c_str() ) );
+		return ( 0 == setenv( name.c_str(), value.c_str(), 1 ) );
+#endif
+	}
+
+}
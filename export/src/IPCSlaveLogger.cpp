@@ -6,37 +6,117 @@
 /// \file IPCSlaveLogger.cpp
 
 #include <boost/filesystem.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
 
 #include "export/include/IPCSlaveLogger.h"
 
 
+using namespace boost::interprocess;
+
+
 IPCSlaveLogger::IPCSlaveLogger() :
 	fileName_( "debug.log" ),
-	out_( 0 )
+	out_( 0 ),
+	queue_( 0 ),
+	forwardQueue_( 0 ),
+	writer_( 0 ),
+	recordsQueued_( 0 ),
+	enqueued_( 0 ),
+	written_( 0 ),
+	dropped_( 0 ),
+	forwarding_( 0 ),
+	started_( 0 ),
+	stop_( 0 ),
+	reportedDropped_( 0 )
 {}
 
 
-IPCSlaveLogger::IPCSlaveLogger( const std::string& fileName ) :
+IPCSlaveLogger::IPCSlaveLogger( const std::string& fileName, unsigned int queueCapacity ) :
 	fileName_( fileName ),
-	out_( 0 )
+	out_( 0 ),
+	queue_( new Queue( queueCapacity ) ),
+	forwardQueue_( new Queue( queueCapacity ) ),
+	writer_( 0 ),
+	recordsQueued_( 0 ),
+	enqueued_( 0 ),
+	written_( 0 ),
+	dropped_( 0 ),
+	forwarding_( 0 ),
+	started_( 0 ),
+	stop_( 0 ),
+	reportedDropped_( 0 )
 {}
 
 
 IPCSlaveLogger::~IPCSlaveLogger()
 {
+	if ( 0 != writer_ ) {
+		ipcdetail::atomic_write32( &stop_, 1 );
+		recordsQueued_.post();
+		writer_->join();
+		delete writer_;
+	}
+
 	// Only delete file stream in case it was really used.
 	if ( 0 != out_ ) delete out_;
+
+	if ( 0 != queue_ ) delete queue_;
+	if ( 0 != forwardQueue_ ) delete forwardQueue_;
 }
 
 
 void
 IPCSlaveLogger::logger( fmiStatus status, const std::string& category, const std::string& msg )
 {
-	// Only open an output file in case there is something to report.
-	if ( 0 == out_ ) out_ = new std::ofstream( fileName_.c_str(), std::ios::out | std::ios::trunc );
+	IPCLogRecord record;
+	record.set( status, category, msg );
+
+	if ( 0 == ipcdetail::atomic_read32( &started_ ) ) startWriter();
+
+	// Never block the caller, drop the record in case the queue is full.
+	if ( true == queue_->bounded_push( record ) ) {
+		ipcdetail::atomic_inc32( &enqueued_ );
+		recordsQueued_.post();
+	} else {
+		ipcdetail::atomic_inc32( &dropped_ );
+	}
+
+	if ( 0 != ipcdetail::atomic_read32( &forwarding_ ) ) forwardQueue_->bounded_push( record );
+}
+
+
+void
+IPCSlaveLogger::flush() const
+{
+	while ( ipcdetail::atomic_read32( &written_ ) != ipcdetail::atomic_read32( &enqueued_ ) )
+		ipcdetail::thread_sleep( 1 );
+}
+
+
+void
+IPCSlaveLogger::attachChannel( const IPCLogChannel& channel )
+{
+	channel_ = channel;
+	ipcdetail::atomic_write32( &forwarding_, channel_.isAttached() ? 1 : 0 );
+}
+
 
-	// Write to output file.
-	*out_ << "STATUS: " << status << " - CATEGORY: " << category << " - MESSAGE: " << msg << std::endl;
+void
+IPCSlaveLogger::forwardRecords()
+{
+	if ( 0 == ipcdetail::atomic_read32( &forwarding_ ) ) return;
+
+	IPCLogRecord record;
+	while ( ( false == channel_.isFull() ) && ( true == forwardQueue_->pop( record ) ) )
+		channel_.put( record );
+}
+
+
+unsigned int
+IPCSlaveLogger::getNumberOfDroppedRecords() const
+{
+	return ipcdetail::atomic_read32( &dropped_ );
 }
 
 
@@ -45,6 +125,9 @@ IPCSlaveLogger::getLogFileName() const
 {
 	using namespace boost::filesystem;
 
+	// Make sure the log file has been written.
+	flush();
+
 	// Use Boost tools for file manipulation.
 	path logFile( fileName_ );
 	if ( is_regular_file( logFile ) ) { // Check if regular file.
@@ -52,7 +135,62 @@ IPCSlaveLogger::getLogFileName() const
 		path fullLogFileName = current_path() /= logFile.filename();
 		return fullLogFileName.string();
 	}
-	
+
 	std::string err = std::string( "ERROR - no log file with this name has been found: " ) + fileName_;
 	return err;
-}
\ No newline at end of file
+}
+
+
+void
+IPCSlaveLogger::startWriter()
+{
+	// Only the caller that sets the flag first starts the thread.
+	if ( 0 == ipcdetail::atomic_cas32( &started_, 1, 0 ) )
+		writer_ = new boost::thread( &IPCSlaveLogger::writeRecords, this );
+}
+
+
+void
+IPCSlaveLogger::writeRecords()
+{
+	while ( 0 == ipcdetail::atomic_read32( &stop_ ) ) {
+		recordsQueued_.wait();
+		drain();
+	}
+
+	// Write what is left.
+	drain();
+}
+
+
+unsigned int
+IPCSlaveLogger::drain()
+{
+	unsigned int n = 0;
+	IPCLogRecord record;
+
+	while ( true == queue_->pop( record ) )
+	{
+		// Only open an output file in case there is something to report.
+		if ( 0 == out_ ) out_ = new std::ofstream( fileName_.c_str(), std::ios::out | std::ios::trunc );
+
+		*out_ << "STATUS: " << record.status_ << " - CATEGORY: " << record.category_
+		      << " - MESSAGE: " << record.message_ << '\n';
+		++n;
+	}
+
+	boost::uint32_t dropped = ipcdetail::atomic_read32( &dropped_ );
+	if ( dropped != reportedDropped_ ) {
+		if ( 0 == out_ ) out_ = new std::ofstream( fileName_.c_str(), std::ios::out | std::ios::trunc );
+		*out_ << "STATUS: " << fmiWarning << " - CATEGORY: WARNING - MESSAGE: "
+		      << dropped - reportedDropped_ << " log messages have been dropped" << '\n';
+		reportedDropped_ = dropped;
+	}
+
+	if ( 0 != n ) {
+		out_->flush();
+		ipcdetail::atomic_add32( &written_, n );
+	}
+
+	return n;
+}
@@ -6,6 +6,21 @@
 /// \file SHMManager.cpp
 
 #include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+
+#if defined( _MSC_VER ) && ( defined( _M_IX86 ) || defined( _M_X64 ) )
+#include <intrin.h>
+#endif
+
+#ifdef WIN32
+#include "Windows.h"
+#else
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstring>
+#endif
 
 #include "export/include/SHMManager.h"
 
@@ -13,13 +28,55 @@
 using namespace boost::interprocess;
 
 
+namespace {
+
+	// Bounds for the number of spin iterations before blocking.
+	const unsigned int minSpinLimit = 16;
+	const unsigned int maxSpinLimit = 16384;
+
+	// Every so many spin iterations, the rest of the time slice is given up.
+	const unsigned int spinYieldInterval = 1024;
+
+	// Hint to the CPU that this is a spin-wait loop.
+	inline void cpuRelax()
+	{
+#if defined( _MSC_VER ) && ( defined( _M_IX86 ) || defined( _M_X64 ) )
+		_mm_pause();
+#elif defined( __GNUC__ ) && ( defined( __i386__ ) || defined( __x86_64__ ) )
+		__builtin_ia32_pause();
+#endif
+	}
+
+	// Decrement the counter in case a signal is pending (i.e., the counter is positive).
+	inline bool tryAcquire( volatile boost::uint32_t* count )
+	{
+		boost::uint32_t c = ipcdetail::atomic_read32( count );
+		while ( static_cast<boost::int32_t>( c ) > 0 ) {
+			boost::uint32_t old = ipcdetail::atomic_cas32( count, c - 1, c );
+			if ( old == c ) return true;
+			c = old;
+		}
+		return false;
+	}
+
+}
+
+
+
 SHMManager::SHMManager() :
 	logger_( 0 ),
 	operational_( false ),
 	segmentId_( "" ),
+	removeSegment_( true ),
 	segment_( 0 ),
 	semaphoreMaster_( 0 ),
-	semaphoreSlave_( 0 )
+	semaphoreSlave_( 0 ),
+	countMaster_( 0 ),
+	countSlave_( 0 ),
+	semaphoreAny_( 0 ),
+	countAny_( 0 ),
+	spinThenBlock_( false ),
+	spinLimit_( maxSpinLimit )
 {}
 
 
@@ -27,9 +84,16 @@ SHMManager::SHMManager( IPCLogger* logger ) :
 	logger_( logger ),
 	operational_( false ),
 	segmentId_( "" ),
+	removeSegment_( true ),
 	segment_( 0 ),
 	semaphoreMaster_( 0 ),
-	semaphoreSlave_( 0 )
+	semaphoreSlave_( 0 ),
+	countMaster_( 0 ),
+	countSlave_( 0 ),
+	semaphoreAny_( 0 ),
+	countAny_( 0 ),
+	spinThenBlock_( false ),
+	spinLimit_( maxSpinLimit )
 {}
 
 
@@ -37,9 +101,16 @@ SHMManager::SHMManager( const std::string& segmentId,
 			const long unsigned int segmentSize,
 			IPCLogger* logger ) :
 	logger_( logger ),
+	removeSegment_( true ),
 	segment_( 0 ),
 	semaphoreMaster_( 0 ),
-	semaphoreSlave_( 0 )
+	semaphoreSlave_( 0 ),
+	countMaster_( 0 ),
+	countSlave_( 0 ),
+	semaphoreAny_( 0 ),
+	countAny_( 0 ),
+	spinThenBlock_( false ),
+	spinLimit_( maxSpinLimit )
 {
 	createSHMSegment( segmentId, segmentSize );
 }
@@ -48,7 +119,16 @@ SHMManager::SHMManager( const std::string& segmentId,
 SHMManager::SHMManager( const std::string& segmentId,
 			IPCLogger* logger ) :
 	logger_( logger ),
-	segment_( 0 )
+	removeSegment_( true ),
+	segment_( 0 ),
+	semaphoreMaster_( 0 ),
+	semaphoreSlave_( 0 ),
+	countMaster_( 0 ),
+	countSlave_( 0 ),
+	semaphoreAny_( 0 ),
+	countAny_( 0 ),
+	spinThenBlock_( false ),
+	spinLimit_( maxSpinLimit )
 {
 	openSHMSegment( segmentId );
 }
@@ -57,7 +137,7 @@ SHMManager::SHMManager( const std::string& segmentId,
 SHMManager::~SHMManager()
 {
 	if ( segment_ ) {
-		shared_memory_object::remove( segmentId_.c_str() );
+		if ( true == removeSegment_ ) shared_memory_object::remove( segmentId_.c_str() );
 		delete segment_;
 	}
 }
@@ -67,7 +147,7 @@ void
 SHMManager::masterWaitForSlave()
 {
 	// Wait until next notification.
-	if ( semaphoreMaster_ ) semaphoreMaster_->wait();
+	if ( semaphoreMaster_ && countMaster_ ) wait( countMaster_, semaphoreMaster_ );
 }
 
 
@@ -75,7 +155,34 @@ void
 SHMManager::slaveWaitForMaster()
 {
 	// Wait until next notification.
-	if ( semaphoreSlave_ ) semaphoreSlave_->wait();
+	if ( semaphoreSlave_ && countSlave_ ) wait( countSlave_, semaphoreSlave_ );
+}
+
+
+bool
+SHMManager::slaveTryWaitForMaster()
+{
+	// Consume a pending notification (if any).
+	return ( 0 != countSlave_ ) && tryAcquire( countSlave_ );
+}
+
+
+void
+SHMManager::slaveWaitForAnyMaster()
+{
+	// Wait until next notification to any slave.
+	if ( semaphoreAny_ && countAny_ ) wait( countAny_, semaphoreAny_ );
+}
+
+
+std::string
+SHMManager::getRegionPrefix( unsigned int region )
+{
+	if ( 0 == region ) return std::string();
+
+	std::stringstream prefix;
+	prefix << "region" << region << "_";
+	return prefix.str();
 }
 
 
@@ -83,7 +190,11 @@ void
 SHMManager::masterSignalToSlave()
 {
 	// Done -> send notification.
-	if ( semaphoreMaster_ ) semaphoreSlave_->post();
+	if ( semaphoreSlave_ && countSlave_ ) post( countSlave_, semaphoreSlave_ );
+
+	// Let a slave serving several regions know that it has to check its regions. This is
+	// done after posting to the region, such that the signal is pending when the slave checks.
+	if ( semaphoreAny_ && countAny_ ) post( countAny_, semaphoreAny_ );
 }
 
 
@@ -91,15 +202,55 @@ void
 SHMManager::slaveSignalToMaster()
 {
 	// Done -> send notification.
-	if ( semaphoreSlave_ ) semaphoreMaster_->post();
+	if ( semaphoreMaster_ && countMaster_ ) post( countMaster_, semaphoreMaster_ );
+}
+
+
+void
+SHMManager::wait( volatile boost::uint32_t* count,
+		  interprocess_semaphore* semaphore )
+{
+	if ( true == spinThenBlock_ )
+	{
+		for ( unsigned int i = 0; i < spinLimit_; ++i )
+		{
+			if ( tryAcquire( count ) ) {
+				// Spinning was successful, allow to spin longer next time.
+				if ( spinLimit_ < maxSpinLimit ) spinLimit_ *= 2;
+				return;
+			}
+
+			if ( 0 == ( i + 1 ) % spinYieldInterval ) {
+				ipcdetail::thread_yield();
+			} else {
+				cpuRelax();
+			}
+		}
+
+		// Spinning was not successful, spin shorter next time.
+		if ( spinLimit_ > minSpinLimit ) spinLimit_ /= 2;
+	}
+
+	// Decrement the counter. In case no signal was pending, block until the other side posts.
+	if ( static_cast<boost::int32_t>( ipcdetail::atomic_dec32( count ) ) < 1 ) semaphore->wait();
+}
+
+
+void
+SHMManager::post( volatile boost::uint32_t* count,
+		  interprocess_semaphore* semaphore )
+{
+	// Increment the counter. In case the other side is blocked, wake it up.
+	if ( static_cast<boost::int32_t>( ipcdetail::atomic_inc32( count ) ) < 0 ) semaphore->post();
 }
 
 
 void
 SHMManager::createSHMSegment( const std::string& segmentId,
-			      const long unsigned int segmentSize )
+			      const long unsigned int segmentSize,
+			      unsigned int nRegions )
 {
-	if ( 0 == segmentSize ) {
+	if ( ( 0 == segmentSize ) || ( 0 == nRegions ) ) {
 		operational_ = false;
 		return;
 	}
@@ -107,7 +258,7 @@ SHMManager::createSHMSegment( const std::string& segmentId,
 	try {
 		if ( segment_ )
 		{
-			shared_memory_object::remove( segmentId_.c_str() );
+			if ( true == removeSegment_ ) shared_memory_object::remove( segmentId_.c_str() );
 			delete segment_;
 		}
 
@@ -122,14 +273,37 @@ SHMManager::createSHMSegment( const std::string& segmentId,
 
 		// Store new ID.
 		segmentId_ = segmentId;
+		regionPrefix_ = getRegionPrefix( 0 );
+
+		// Create semaphores for master-slave synchronization (for all regions).
+		// The semaphores are only used for blocking, pending signals are kept track of by the
+		// counters. Initially, the master is allowed to proceed.
+		for ( unsigned int region = 0; region < nRegions; ++region )
+		{
+			std::string syncId = getRegionPrefix( region ) + segmentId_;
 
-		// Create semaphores for master-slave synchronization.
-		std::string semaphoreMasterName = segmentId_ + "_sem_master";
-		semaphoreMaster_ = segment_->construct<interprocess_semaphore>( semaphoreMasterName.c_str() )( 1 );
+			std::string semaphoreMasterName = syncId + "_sem_master";
+			segment_->construct<interprocess_semaphore>( semaphoreMasterName.c_str() )( 0 );
 
-		std::string semaphoreSlaveName = segmentId_ + "_sem_slave";
-		semaphoreSlave_ = segment_->construct<interprocess_semaphore>( semaphoreSlaveName.c_str() )( 0 );
+			std::string semaphoreSlaveName = syncId + "_sem_slave";
+			segment_->construct<interprocess_semaphore>( semaphoreSlaveName.c_str() )( 0 );
 
+			std::string countMasterName = syncId + "_count_master";
+			segment_->construct<boost::uint32_t>( countMasterName.c_str() )( 1 );
+
+			std::string countSlaveName = syncId + "_count_slave";
+			segment_->construct<boost::uint32_t>( countSlaveName.c_str() )( 0 );
+		}
+
+		// Signals to the slaves of all regions are counted in addition.
+		if ( 1 < nRegions )
+		{
+			std::string semaphoreAnyName = segmentId_ + "_sem_any";
+			segment_->construct<interprocess_semaphore>( semaphoreAnyName.c_str() )( 0 );
+
+			std::string countAnyName = segmentId_ + "_count_any";
+			segment_->construct<boost::uint32_t>( countAnyName.c_str() )( 0 );
+		}
 	}
 	catch ( interprocess_exception& e )
 	{
@@ -143,20 +317,26 @@ SHMManager::createSHMSegment( const std::string& segmentId,
 		// All other functions check whether these pointers are NULL or not. Hence, setting them to
 		// NULL effectively renders the manager inoperational without any dangerous side effects.
 		if ( segment_ ) { delete segment_; segment_ = 0; }
-		if ( semaphoreMaster_ ) { delete semaphoreMaster_; semaphoreMaster_ = 0; }
-		if ( semaphoreSlave_ ) { delete semaphoreSlave_; semaphoreSlave_ = 0; }
+		semaphoreMaster_ = 0;
+		semaphoreSlave_ = 0;
+		countMaster_ = 0;
+		countSlave_ = 0;
+		semaphoreAny_ = 0;
+		countAny_ = 0;
 		return;
 	}
 
-	// Everything worked out fine, the interface is operational.
-	operational_ = true;
+	// Retrieve the objects for syncing in region 0.
+	operational_ = findSyncObjects();
 }
 
 
 void
-SHMManager::openSHMSegment( const std::string& segmentId )
+SHMManager::openSHMSegment( const std::string& segmentId,
+			    unsigned int region )
 {
 	segmentId_ = segmentId;
+	regionPrefix_ = getRegionPrefix( region );
 
 	try {
 		if ( segment_ )
@@ -180,50 +360,68 @@ SHMManager::openSHMSegment( const std::string& segmentId )
 		segment_ = 0;
 		semaphoreMaster_ = 0;
 		semaphoreSlave_ = 0;
+		countMaster_ = 0;
+		countSlave_ = 0;
+		semaphoreAny_ = 0;
+		countAny_ = 0;
 		operational_ = false;
 		return;
 	}
 
+	// Retrieve the objects for syncing in the region.
+	operational_ = findSyncObjects();
+}
+
 
-	// Get semaphore for syncing from shared memory.
-	std::string semaphoreName;
+template<typename Type>
+bool
+SHMManager::findSyncObject( const std::string& name, Type*& object ) const
+{
 #ifdef WIN32
-	std::pair<interprocess_semaphore*, managed_windows_shared_memory::size_type> findSemaphore;
+	std::pair<Type*, managed_windows_shared_memory::size_type> findObject;
 #else
-	std::pair<interprocess_semaphore*, managed_shared_memory::size_type> findSemaphore;
+	std::pair<Type*, managed_shared_memory::size_type> findObject;
 #endif
 
-	// Slave sempahore.
-	semaphoreName = segmentId_ + "_sem_slave";
-	findSemaphore = segment_->find<interprocess_semaphore>( semaphoreName.c_str() );
-	if ( findSemaphore.second != 1 ) {
+	findObject = segment_->find<Type>( name.c_str() );
+	if ( findObject.second != 1 ) {
 		std::stringstream err;
-		err << "found " << findSemaphore.second << " semaphores called '"
-		    << semaphoreName << "', but expected only 1.";
+		err << "found " << findObject.second << " objects called '"
+		    << name << "', but expected only 1.";
 		logger_->logger( fmiFatal, "ABORT", err.str() );
-
-		operational_ = false;
-		return;
+		object = 0;
+		return false;
 	}
-	//if ( semaphoreSlave_ ) delete semaphoreSlave_;
-	semaphoreSlave_ = findSemaphore.first;
 
-	// Master semaphore.
-	semaphoreName = segmentId_ + "_sem_master";
-	findSemaphore = segment_->find<interprocess_semaphore>( semaphoreName.c_str() );
-	if ( findSemaphore.second != 1 ) {
-		std::stringstream err;
-		err << "found " << findSemaphore.second << " semaphores called '"
-		    << semaphoreName << "', but expected only 1.";
-		logger_->logger( fmiFatal, "ABORT", err.str() );
-		operational_ = false;
-		return;
-	}
-	//if ( semaphoreMaster_ ) delete semaphoreMaster_;
-	semaphoreMaster_ = findSemaphore.first;
+	object = findObject.first;
+	return true;
+}
+
 
-	// Everything worked out fine, the interface is operational.
-	operational_ = true;
+bool
+SHMManager::findSyncObjects()
+{
+	const std::string syncId = regionPrefix_ + segmentId_;
+
+	// Slave sempahore, master semaphore and counters of pending signals.
+	boost::uint32_t* countSlave = 0;
+	boost::uint32_t* countMaster = 0;
+	if ( ( false == findSyncObject( syncId + "_sem_slave", semaphoreSlave_ ) ) ||
+	     ( false == findSyncObject( syncId + "_sem_master", semaphoreMaster_ ) ) ||
+	     ( false == findSyncObject( syncId + "_count_slave", countSlave ) ) ||
+	     ( false == findSyncObject( syncId + "_count_master", countMaster ) ) )
+		return false;
+
+	countSlave_ = countSlave;
+	countMaster_ = countMaster;
+
+	// The semaphore and counter of signals to any slave only exist for segments with several regions.
+	std::string semaphoreAnyName = segmentId_ + "_sem_any";
+	std::string countAnyName = segmentId_ + "_count_any";
+	semaphoreAny_ = segment_->find<interprocess_semaphore>( semaphoreAnyName.c_str() ).first;
+	countAny_ = segment_->find<boost::uint32_t>( countAnyName.c_str() ).first;
+
+	return true;
 }
 
 
@@ -232,3 +430,73 @@ SHMManager::sleep( unsigned int ms ) const
 {
 	ipcdetail::thread_sleep( ms );
 }
+
+
+long unsigned int
+SHMManager::getFreeMemory() const
+{
+	return segment_ ? segment_->get_free_memory() : 0;
+}
+
+
+bool
+SHMManager::adviseHugePages()
+{
+	if ( !segment_ ) return false;
+
+#if defined( MADV_HUGEPAGE )
+	// The advice applies to whole pages, starting at the beginning of the mapped region.
+	char* begin;
+	std::size_t length;
+	getPageAlignedRange( begin, length );
+
+	if ( 0 == madvise( begin, length, MADV_HUGEPAGE ) ) return true;
+
+	std::stringstream err;
+	err << "unable to back shared memory segment with huge pages: " << std::strerror( errno );
+	logger_->logger( fmiWarning, "WARNING", err.str() );
+#else
+	logger_->logger( fmiWarning, "WARNING", "huge pages for shared memory are not supported on this platform" );
+#endif
+
+	return false;
+}
+
+
+bool
+SHMManager::lockMemory()
+{
+	if ( !segment_ ) return false;
+
+	char* begin;
+	std::size_t length;
+	getPageAlignedRange( begin, length );
+
+#ifdef WIN32
+	if ( 0 != VirtualLock( begin, length ) ) return true;
+
+	std::stringstream err;
+	err << "unable to lock shared memory segment: error code " << GetLastError();
+#else
+	if ( 0 == mlock( begin, length ) ) return true;
+
+	std::stringstream err;
+	err << "unable to lock shared memory segment: " << std::strerror( errno );
+#endif
+
+	logger_->logger( fmiWarning, "WARNING", err.str() );
+	return false;
+}
+
+
+void
+SHMManager::getPageAlignedRange( char*& begin, std::size_t& length ) const
+{
+	const std::size_t pageSize = mapped_region::get_page_size();
+
+	char* address = static_cast<char*>( segment_->get_address() );
+	char* end = address + segment_->get_size();
+
+	begin = address - reinterpret_cast<std::size_t>( address ) % pageSize;
+	length = ( ( end - begin + pageSize - 1 )/pageSize )*pageSize;
+}
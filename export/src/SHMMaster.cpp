@@ -13,19 +13,55 @@
 #include "export/include/ScalarVariable.h"
 
 
+namespace {
+
+	// Create the metadata table and the array of values of scalar variables of one type.
+	template<typename Type>
+	bool createScalarArrays( SHMManager* shmManager,
+				 const std::string& id,
+				 unsigned int numObj,
+				 ScalarVariableMetadata*& metadata,
+				 Type*& values )
+	{
+		return ( shmManager->createArray( id + "_metadata", numObj, metadata ) &&
+			 shmManager->createArray( id + "_values", numObj, values ) );
+	}
+}
+
 
 SHMMaster::SHMMaster( const std::string& shmSegmentId,
 		      const long unsigned int& shmSegmentSize,
-		      IPCLogger* logger ) :
+		      IPCLogger* logger,
+		      bool spinThenBlock ) :
 	IPCMaster( logger ),
 	shmSegmentId_( shmSegmentId ),
 	shmSegmentSize_( shmSegmentSize ),
+	region_( 0 ),
+	nRegions_( 1 ),
 	shmManager_( new SHMManager( logger ) )
 {
+	shmManager_->setSpinThenBlock( spinThenBlock );
 	shmManager_->createSHMSegment( shmSegmentId_, shmSegmentSize_ );
 }
 
 
+SHMMaster::SHMMaster( const std::string& shmSegmentId,
+		      const long unsigned int& shmSegmentSize,
+		      IPCLogger* logger,
+		      unsigned int region,
+		      unsigned int nRegions ) :
+	IPCMaster( logger ),
+	shmSegmentId_( shmSegmentId ),
+	shmSegmentSize_( shmSegmentSize ),
+	region_( region ),
+	nRegions_( nRegions ),
+	shmManager_( new SHMManager( logger ) )
+{
+	shmManager_->setRemoveSegment( false );
+	reinitialize();
+}
+
+
 SHMMaster::~SHMMaster()
 {
 	delete shmManager_;
@@ -36,7 +72,11 @@ SHMMaster::~SHMMaster()
 void
 SHMMaster::reinitialize()
 {
-	shmManager_->createSHMSegment( shmSegmentId_, shmSegmentSize_ );
+	if ( 0 == region_ ) {
+		shmManager_->createSHMSegment( shmSegmentId_, shmSegmentSize_, nRegions_ );
+	} else {
+		shmManager_->openSHMSegment( shmSegmentId_, region_ );
+	}
 }
 
 
@@ -81,63 +121,99 @@ SHMMaster::createVariable( const std::string& id,
 }
 
 
-// Create internally double scalar variables and retrieve pointers to it.
+// Create internally double scalar variables (metadata table and dense
+// array of values) and retrieve pointers to it.
 bool
 SHMMaster::createScalars( const std::string& id,
 			  unsigned int numObj,
-			  std::vector<ScalarVariable<double>*>& vars )
+			  ScalarVariableMetadata*& metadata,
+			  double*& values )
 {
-	if ( 0 == numObj ) { vars.clear(); return true; }
+	if ( 0 == numObj ) { metadata = 0; values = 0; return true; }
 
 	std::stringstream info;
-	info << "create vector containing " << numObj << " object(s) of type 'double'";
+	info << "create table and array containing " << numObj << " object(s) of type 'double'";
 	logger( fmiOK, "DEBUG", info.str() );
-	return shmManager_->createVector( id, numObj, vars );
+
+	return createScalarArrays( shmManager_, id, numObj, metadata, values );
 }
 
 
-// Create internally integer scalar variables and retrieve pointers to it.
+// Create internally integer scalar variables (metadata table and dense
+// array of values) and retrieve pointers to it.
 bool
 SHMMaster::createScalars( const std::string& id,
 			  unsigned int numObj,
-			  std::vector<ScalarVariable<int>*>& vars )
+			  ScalarVariableMetadata*& metadata,
+			  int*& values )
 {
-	if ( 0 == numObj ) { vars.clear(); return true; }
+	if ( 0 == numObj ) { metadata = 0; values = 0; return true; }
 
 	std::stringstream info;
-	info << "create vector containing " << numObj << " object(s) of type 'int'";
+	info << "create table and array containing " << numObj << " object(s) of type 'int'";
 	logger( fmiOK, "DEBUG", info.str() );
-	return shmManager_->createVector( id, numObj, vars );
+
+	return createScalarArrays( shmManager_, id, numObj, metadata, values );
 }
 
 
-// Create internally char (fmiBoolean) scalar variables and retrieve pointers to it.
+// Create internally char (fmiBoolean) scalar variables (metadata table and dense
+// array of values) and retrieve pointers to it.
 bool
 SHMMaster::createScalars( const std::string& id,
 			  unsigned int numObj,
-			  std::vector<ScalarVariable<char>*>& vars )
+			  ScalarVariableMetadata*& metadata,
+			  char*& values )
 {
-	if ( 0 == numObj ) { vars.clear(); return true; }
+	if ( 0 == numObj ) { metadata = 0; values = 0; return true; }
 
 	std::stringstream info;
-	info << "create vector containing " << numObj << " object(s) of type 'char' (fmiBoolean)";
+	info << "create table and array containing " << numObj << " object(s) of type 'char' (fmiBoolean)";
 	logger( fmiOK, "DEBUG", info.str() );
-	return shmManager_->createVector( id, numObj, vars );
+
+	return createScalarArrays( shmManager_, id, numObj, metadata, values );
 }
 
 
-// Create internally string scalar variables and retrieve pointers to it.
+// Create internally string scalar variables (metadata table and dense
+// array of values) and retrieve pointers to it.
 bool
 SHMMaster::createScalars( const std::string& id,
 			  unsigned int numObj,
-			  std::vector<ScalarVariable<std::string>*>& vars )
+			  ScalarVariableMetadata*& metadata,
+			  ScalarVariableString*& values )
 {
-	if ( 0 == numObj ) { vars.clear(); return true; }
+	if ( 0 == numObj ) { metadata = 0; values = 0; return true; }
 
 	std::stringstream info;
-	info << "create vector containing " << numObj << " object(s) of type 'std::string'";
+	info << "create table and array containing " << numObj << " object(s) of type 'ScalarVariableString'";
 	logger( fmiOK, "DEBUG", info.str() );
-	return shmManager_->createVector( id, numObj, vars );
+
+	return createScalarArrays( shmManager_, id, numObj, metadata, values );
+}
+
+
+// Create internally the change log of a collection of scalar variables and retrieve pointer to it.
+bool
+SHMMaster::createChangeLog( const std::string& id,
+			   unsigned int numObj,
+			   unsigned int*& log )
+{
+	if ( 0 == numObj ) { log = 0; return true; }
+
+	return shmManager_->createArray( id + "_changes", ScalarVariableChangeLog::getSize( numObj ), log );
+}
+
+
+// Create internally a channel for log records from the slave and retrieve pointers to it.
+bool
+SHMMaster::createLogChannel( const std::string& id,
+			    unsigned int numRecords,
+			    IPCLogRecord*& records,
+			    unsigned int*& count )
+{
+	return ( true == shmManager_->createArray( id + "_records", numRecords, records ) ) &&
+		( true == shmManager_->createArray( id + "_count", 1, count ) );
 }
 
 
@@ -165,3 +241,51 @@ SHMMaster::sleep( unsigned int ms ) const
 {
 	shmManager_->sleep( ms );
 }
+
+
+// Advise the operating system to back the shared memory segment with huge pages.
+bool
+SHMMaster::adviseHugePages()
+{
+	return shmManager_->adviseHugePages();
+}
+
+
+// Lock the shared memory segment in physical memory.
+bool
+SHMMaster::lockMemory()
+{
+	return shmManager_->lockMemory();
+}
+
+
+// Get the number of free bytes in the shared memory segment.
+long unsigned int
+SHMMaster::getFreeMemory() const
+{
+	return shmManager_->getFreeMemory();
+}
+
+
+// Turn spinning before blocking when waiting for the slave on/off.
+void
+SHMMaster::setSpinThenBlock( bool flag )
+{
+	shmManager_->setSpinThenBlock( flag );
+}
+
+
+// Check if spinning before blocking is turned on.
+bool
+SHMMaster::getSpinThenBlock() const
+{
+	return shmManager_->getSpinThenBlock();
+}
+
+
+// Turn the removal of the shared memory segment in the destructor on/off.
+void
+SHMMaster::setRemoveSegment( bool flag )
+{
+	shmManager_->setRemoveSegment( flag );
+}
@@ -0,0 +1,183 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+/// \file SHMSegmentPlan.cpp
+
+#include <boost/interprocess/managed_heap_memory.hpp>
+#include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/indexes/iset_index.hpp>
+#include <boost/interprocess/sync/mutex_family.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/cstdint.hpp>
+
+#include "export/include/SHMSegmentPlan.h"
+#include "export/include/SHMManager.h"
+#include "export/include/ScalarVariable.h"
+#include "export/include/IPCLogger.h"
+
+
+using namespace boost::interprocess;
+
+
+namespace {
+
+	// Process-local memory with the same allocation algorithm and index as the shared memory
+	// segments (see typedefs managed_shared_memory and managed_windows_shared_memory).
+	typedef basic_managed_heap_memory< char, rbtree_best_fit<mutex_family>, iset_index > RehearsalMemory;
+
+	// Bytes reserved for the header of the shared memory segment (in front of the segment manager).
+	const std::size_t segmentHeaderSize = 64;
+
+	// Assumed size of huge pages.
+	const long unsigned int hugePageSize = 2*1024*1024;
+
+	// Placeholder with the same size and alignment as a planned object.
+	template<std::size_t Alignment>
+	struct Chunk
+	{
+		typename boost::aligned_storage<Alignment, Alignment>::type data_;
+	};
+
+	template<std::size_t Alignment>
+	bool construct( RehearsalMemory& memory, const std::string& id, std::size_t bytes )
+	{
+		return 0 != memory.construct< Chunk<Alignment> >( id.c_str(), std::nothrow )[bytes/Alignment]();
+	}
+
+	// Round up to the next multiple of granularity.
+	inline long unsigned int roundUp( long unsigned int size, long unsigned int granularity )
+	{
+		return ( ( size + granularity - 1 )/granularity )*granularity;
+	}
+}
+
+
+SHMSegmentPlan::SHMSegmentPlan( const std::string& segmentId, unsigned int nRegions ) :
+	nRegions_( nRegions )
+{
+	// Objects for master-slave synchronization (see SHMManager::createSHMSegment(...)).
+	// Their names already include the region, hence they are added to the plan directly.
+	for ( unsigned int region = 0; region < nRegions_; ++region )
+	{
+		std::string syncId = SHMManager::getRegionPrefix( region ) + segmentId;
+		addOnce( syncId + "_sem_master", sizeof( interprocess_semaphore ), boost::alignment_of<interprocess_semaphore>::value );
+		addOnce( syncId + "_sem_slave", sizeof( interprocess_semaphore ), boost::alignment_of<interprocess_semaphore>::value );
+		addOnce( syncId + "_count_master", sizeof( boost::uint32_t ), boost::alignment_of<boost::uint32_t>::value );
+		addOnce( syncId + "_count_slave", sizeof( boost::uint32_t ), boost::alignment_of<boost::uint32_t>::value );
+	}
+
+	if ( 1 < nRegions_ ) {
+		addOnce( segmentId + "_sem_any", sizeof( interprocess_semaphore ), boost::alignment_of<interprocess_semaphore>::value );
+		addOnce( segmentId + "_count_any", sizeof( boost::uint32_t ), boost::alignment_of<boost::uint32_t>::value );
+	}
+}
+
+
+void
+SHMSegmentPlan::addChangeLog( const std::string& id, unsigned int numObj )
+{
+	// No change log is created for empty collections of scalars.
+	if ( 0 == numObj ) return;
+
+	addArray<unsigned int>( id + "_changes", ScalarVariableChangeLog::getSize( numObj ) );
+}
+
+
+void
+SHMSegmentPlan::addLogChannel( const std::string& id, unsigned int numRecords )
+{
+	addArray<IPCLogRecord>( id + "_records", numRecords );
+	addArray<unsigned int>( id + "_count", 1 );
+}
+
+
+long unsigned int
+SHMSegmentPlan::getPayloadSize() const
+{
+	long unsigned int size = 0;
+
+	std::vector<PlannedObject>::const_iterator it;
+	for ( it = objects_.begin(); it != objects_.end(); ++it ) size += it->bytes_;
+
+	return size;
+}
+
+
+long unsigned int
+SHMSegmentPlan::getSegmentSize( bool hugePages ) const
+{
+	// Initial guess for the size of the local buffer, which is increased if necessary.
+	std::size_t bufferSize = 4096;
+	std::vector<PlannedObject>::const_iterator it;
+	for ( it = objects_.begin(); it != objects_.end(); ++it )
+		bufferSize += it->bytes_ + it->alignment_ + it->id_.size() + 128;
+
+	std::size_t usedSize = 0;
+	while ( false == rehearse( bufferSize, usedSize ) ) bufferSize *= 2;
+
+	long unsigned int granularity = hugePages ?
+		hugePageSize : static_cast<long unsigned int>( mapped_region::get_page_size() );
+
+	return roundUp( usedSize + segmentHeaderSize, granularity );
+}
+
+
+long unsigned int
+SHMSegmentPlan::getHugePageSize()
+{
+	return hugePageSize;
+}
+
+
+void
+SHMSegmentPlan::add( const std::string& id, std::size_t bytes, std::size_t alignment )
+{
+	for ( unsigned int region = 0; region < nRegions_; ++region )
+		addOnce( SHMManager::getRegionPrefix( region ) + id, bytes, alignment );
+}
+
+
+void
+SHMSegmentPlan::addOnce( const std::string& id, std::size_t bytes, std::size_t alignment )
+{
+	// Named objects can only be created once.
+	std::vector<PlannedObject>::const_iterator it;
+	for ( it = objects_.begin(); it != objects_.end(); ++it )
+		if ( it->id_ == id ) return;
+
+	PlannedObject object;
+	object.id_ = id;
+	object.bytes_ = bytes;
+	object.alignment_ = alignment;
+	objects_.push_back( object );
+}
+
+
+bool
+SHMSegmentPlan::rehearse( std::size_t bufferSize, std::size_t& usedSize ) const
+{
+	RehearsalMemory memory( bufferSize );
+
+	std::vector<PlannedObject>::const_iterator it;
+	for ( it = objects_.begin(); it != objects_.end(); ++it )
+	{
+		bool constructed = false;
+
+		switch ( it->alignment_ ) {
+		case 1: constructed = construct<1>( memory, it->id_, it->bytes_ ); break;
+		case 2: constructed = construct<2>( memory, it->id_, it->bytes_ ); break;
+		case 4: constructed = construct<4>( memory, it->id_, it->bytes_ ); break;
+		case 8: constructed = construct<8>( memory, it->id_, it->bytes_ ); break;
+		default: constructed = construct<16>( memory, it->id_, roundUp( it->bytes_, 16 ) ); break;
+		}
+
+		if ( false == constructed ) return false;
+	}
+
+	usedSize = memory.get_size() - memory.get_free_memory();
+	return true;
+}
@@ -11,13 +11,46 @@
 #include "export/include/ScalarVariable.h"
 
 
+namespace {
+
+	// Retrieve the metadata table and the array of values of scalar variables of one type.
+	template<typename Type>
+	bool retrieveScalarArrays( const SHMManager* shmManager,
+				   const std::string& id,
+				   unsigned int& numObj,
+				   const ScalarVariableMetadata*& metadata,
+				   Type*& values )
+	{
+		ScalarVariableMetadata* table = 0;
+		unsigned int numValues = 0;
+
+		if ( ( false == shmManager->retrieveArray( id + "_metadata", table, numObj ) ) ||
+		     ( false == shmManager->retrieveArray( id + "_values", values, numValues ) ) ||
+		     ( numObj != numValues ) )
+		{
+			numObj = 0;
+			metadata = 0;
+			values = 0;
+			return false;
+		}
+
+		metadata = table;
+		return true;
+	}
+}
+
+
 SHMSlave::SHMSlave( const std::string& shmSegmentId,
-		    IPCLogger* logger ) :
+		    IPCLogger* logger,
+		    bool spinThenBlock,
+		    unsigned int region ) :
 	IPCSlave( logger ),
 	shmSegmentId_( shmSegmentId ),
+	region_( region ),
 	shmManager_( new SHMManager( logger ) )
 {
-	shmManager_->openSHMSegment( shmSegmentId_ );
+	shmManager_->setSpinThenBlock( spinThenBlock );
+	shmManager_->openSHMSegment( shmSegmentId_, region_ );
 }
 
 
@@ -31,7 +64,7 @@ SHMSlave::~SHMSlave()
 void
 SHMSlave::reinitialize()
 {
-	shmManager_->openSHMSegment( shmSegmentId_ );
+	shmManager_->openSHMSegment( shmSegmentId_, region_ );
 }
 
 
@@ -70,39 +103,89 @@ SHMSlave::retrieveVariable( const std::string& id,
 }
 
 
-// Retrieve vector of pointers to double scalar variables.
+// Retrieve pointers to the metadata table and the array of values of double scalar variables.
 bool
 SHMSlave::retrieveScalars( const std::string& id,
-			   std::vector<ScalarVariable<double>*>& vars ) const
+			   unsigned int& numObj,
+			   const ScalarVariableMetadata*& metadata,
+			   double*& values ) const
 {
-	return shmManager_->retrieveVector( id, vars );
+	return retrieveScalarArrays( shmManager_, id, numObj, metadata, values );
 }
 
 
-// Retrieve vector of pointers to integer scalar variables.
+// Retrieve pointers to the metadata table and the array of values of integer scalar variables.
 bool
 SHMSlave::retrieveScalars( const std::string& id,
-			   std::vector<ScalarVariable<int>*>& vars ) const
+			   unsigned int& numObj,
+			   const ScalarVariableMetadata*& metadata,
+			   int*& values ) const
 {
-	return shmManager_->retrieveVector( id, vars );
+	return retrieveScalarArrays( shmManager_, id, numObj, metadata, values );
 }
 
 
-// Retrieve vector of pointers to char (fmiBoolean) scalar variables.
+// Retrieve pointers to the metadata table and the array of values of char (fmiBoolean) scalar variables.
 bool
 SHMSlave::retrieveScalars( const std::string& id,
-			   std::vector<ScalarVariable<char>*>& vars ) const
+			   unsigned int& numObj,
+			   const ScalarVariableMetadata*& metadata,
+			   char*& values ) const
 {
-	return shmManager_->retrieveVector( id, vars );
+	return retrieveScalarArrays( shmManager_, id, numObj, metadata, values );
 }
 
 
-// Retrieve vector of pointers to string scalar variables.
+// Retrieve pointers to the metadata table and the array of values of string scalar variables.
 bool
 SHMSlave::retrieveScalars( const std::string& id,
-			   std::vector<ScalarVariable<std::string>*>& vars ) const
+			   unsigned int& numObj,
+			   const ScalarVariableMetadata*& metadata,
+			   ScalarVariableString*& values ) const
 {
-	return shmManager_->retrieveVector( id, vars );
+	return retrieveScalarArrays( shmManager_, id, numObj, metadata, values );
+}
+
+
+// Retrieve pointer to the change log of a collection of scalar variables.
+bool
+SHMSlave::retrieveChangeLog( const std::string& id,
+			    unsigned int& numObj,
+			    unsigned int*& log ) const
+{
+	unsigned int size = 0;
+	if ( ( false == shmManager_->retrieveArray( id + "_changes", log, size ) ) ||
+	     ( 0 == size % 2 ) )
+	{
+		numObj = 0;
+		log = 0;
+		return false;
+	}
+
+	numObj = ( size - 1 )/2;
+	return true;
+}
+
+
+// Retrieve pointers to the channel for log records to the master.
+bool
+SHMSlave::retrieveLogChannel( const std::string& id,
+			     unsigned int& numRecords,
+			     IPCLogRecord*& records,
+			     unsigned int*& count ) const
+{
+	unsigned int size = 0;
+	if ( ( false == shmManager_->retrieveArray( id + "_records", records, numRecords ) ) ||
+	     ( false == shmManager_->retrieveArray( id + "_count", count, size ) ) ||
+	     ( 1 != size ) )
+	{
+		numRecords = 0;
+		records = 0;
+		count = 0;
+		return false;
+	}
+
+	return true;
 }
 
 
@@ -115,6 +198,22 @@ SHMSlave::waitForMaster()
 }
 
 
+// Check for a signal from master without blocking.
+bool
+SHMSlave::tryWaitForMaster()
+{
+	return shmManager_->slaveTryWaitForMaster();
+}
+
+
+// Block until the master of any region has signaled.
+void
+SHMSlave::waitForAnyMaster()
+{
+	shmManager_->slaveWaitForAnyMaster();
+}
+
+
 // Send signal to master to proceed with execution.
 // Do not alter shared data until waitForMaster() unblocks.
 void
@@ -130,3 +229,19 @@ SHMSlave::sleep( unsigned int ms ) const
 {
 	shmManager_->sleep( ms );
 }
+
+
+// Turn spinning before blocking when waiting for the master on/off.
+void
+SHMSlave::setSpinThenBlock( bool flag )
+{
+	shmManager_->setSpinThenBlock( flag );
+}
+
+
+// Check if spinning before blocking is turned on.
+bool
+SHMSlave::getSpinThenBlock() const
+{
+	return shmManager_->getSpinThenBlock();
+}
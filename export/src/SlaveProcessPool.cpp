@@ -0,0 +1,168 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+/// \file SlaveProcessPool.cpp
+
+#include <vector>
+
+#include "export/include/SlaveProcessPool.h"
+#include "export/include/FMIComponentFrontEnd.h"
+
+
+using namespace std;
+
+
+FMIComponentFrontEnd*
+SlaveProcessPool::acquire( const string& key )
+{
+	SlaveProcessPool& pool = getInstance();
+	boost::mutex::scoped_lock lock( pool.mutex_ );
+
+	IdleProcesses::iterator it = pool.idle_.find( key );
+	if ( it == pool.idle_.end() ) return 0;
+
+	FMIComponentFrontEnd* idle = it->second;
+	pool.idle_.erase( it );
+
+	return idle;
+}
+
+
+bool
+SlaveProcessPool::release( const string& key, FMIComponentFrontEnd* idle, unsigned int maxIdle )
+{
+	SlaveProcessPool& pool = getInstance();
+	boost::mutex::scoped_lock lock( pool.mutex_ );
+
+	if ( pool.idle_.count( key ) >= maxIdle ) return false;
+
+	pool.idle_.insert( IdleProcesses::value_type( key, idle ) );
+
+	return true;
+}
+
+
+unsigned int
+SlaveProcessPool::getNumberOfIdleProcesses( const string& key )
+{
+	SlaveProcessPool& pool = getInstance();
+	boost::mutex::scoped_lock lock( pool.mutex_ );
+
+	return static_cast<unsigned int>( pool.idle_.count( key ) );
+}
+
+
+unsigned int
+SlaveProcessPool::getNumberOfIdleProcesses()
+{
+	SlaveProcessPool& pool = getInstance();
+	boost::mutex::scoped_lock lock( pool.mutex_ );
+
+	return static_cast<unsigned int>( pool.idle_.size() );
+}
+
+
+void
+SlaveProcessPool::clear()
+{
+	SlaveProcessPool& pool = getInstance();
+	vector<FMIComponentFrontEnd*> idle;
+
+	{
+		boost::mutex::scoped_lock lock( pool.mutex_ );
+
+		IdleProcesses::iterator it;
+		for ( it = pool.idle_.begin(); it != pool.idle_.end(); ++it ) idle.push_back( it->second );
+		pool.idle_.clear();
+	}
+
+	// Deleting the owning front end components terminates the applications.
+	vector<FMIComponentFrontEnd*>::iterator it;
+	for ( it = idle.begin(); it != idle.end(); ++it ) delete *it;
+}
+
+
+void
+SlaveProcessPool::share( const string& key, long pid, unsigned int maxInstances )
+{
+	SlaveProcessPool& pool = getInstance();
+	boost::mutex::scoped_lock lock( pool.mutex_ );
+
+	SharedProcess shared;
+	shared.key_ = key;
+	shared.pid_ = pid;
+	shared.maxInstances_ = maxInstances;
+	shared.nextInstance_ = 1;
+	shared.activeInstances_ = 1;
+	pool.shared_.push_back( shared );
+}
+
+
+bool
+SlaveProcessPool::join( const string& key, long& pid, unsigned int& instance )
+{
+	SlaveProcessPool& pool = getInstance();
+	boost::mutex::scoped_lock lock( pool.mutex_ );
+
+	vector<SharedProcess>::iterator it;
+	for ( it = pool.shared_.begin(); it != pool.shared_.end(); ++it )
+	{
+		if ( ( it->key_ != key ) || ( it->nextInstance_ >= it->maxInstances_ ) ) continue;
+
+		pid = it->pid_;
+		instance = it->nextInstance_++;
+		++it->activeInstances_;
+		return true;
+	}
+
+	return false;
+}
+
+
+bool
+SlaveProcessPool::leave( const string& key, long pid )
+{
+	SlaveProcessPool& pool = getInstance();
+	boost::mutex::scoped_lock lock( pool.mutex_ );
+
+	vector<SharedProcess>::iterator it;
+	for ( it = pool.shared_.begin(); it != pool.shared_.end(); ++it )
+	{
+		if ( ( it->key_ != key ) || ( it->pid_ != pid ) ) continue;
+
+		if ( 0 != --it->activeInstances_ ) return false;
+
+		pool.shared_.erase( it );
+		return true;
+	}
+
+	// Unknown applications are not shared.
+	return true;
+}
+
+
+unsigned int
+SlaveProcessPool::getNumberOfSharedProcesses()
+{
+	SlaveProcessPool& pool = getInstance();
+	boost::mutex::scoped_lock lock( pool.mutex_ );
+
+	return static_cast<unsigned int>( pool.shared_.size() );
+}
+
+
+SlaveProcessPool::~SlaveProcessPool()
+{
+	IdleProcesses::iterator it;
+	for ( it = idle_.begin(); it != idle_.end(); ++it ) delete it->second;
+}
+
+
+SlaveProcessPool&
+SlaveProcessPool::getInstance()
+{
+	static SlaveProcessPool pool;
+	return pool;
+}
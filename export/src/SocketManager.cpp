@@ -0,0 +1,536 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+/// \file SocketManager.cpp
+
+#include <cstring>
+#include <cstdio>
+#include <new>
+
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+
+#ifndef WIN32
+#include <fcntl.h>
+#endif
+
+#include "export/include/SocketManager.h"
+
+
+using namespace boost::asio;
+
+
+namespace {
+
+	const std::string tcpPrefix = "tcp://";
+	const std::string unixPrefix = "unix://";
+
+	// Size of the header of a message (message size, number of announced objects, number of updates).
+	const std::size_t headerSize = 3*sizeof( boost::uint32_t );
+
+	inline void appendBytes( std::vector<char>& buffer, const void* data, std::size_t size )
+	{
+		const char* bytes = static_cast<const char*>( data );
+		buffer.insert( buffer.end(), bytes, bytes + size );
+	}
+
+	inline void appendUInt32( std::vector<char>& buffer, std::size_t value )
+	{
+		boost::uint32_t v = static_cast<boost::uint32_t>( value );
+		appendBytes( buffer, &v, sizeof( v ) );
+	}
+
+	inline void writeUInt32( std::vector<char>& buffer, std::size_t pos, std::size_t value )
+	{
+		boost::uint32_t v = static_cast<boost::uint32_t>( value );
+		std::memcpy( &buffer[pos], &v, sizeof( v ) );
+	}
+
+	// Read bytes from a message, returns false if the message is too short.
+	inline bool readBytes( const char*& pos, const char* end, void* data, std::size_t size )
+	{
+		if ( static_cast<std::size_t>( end - pos ) < size ) return false;
+		std::memcpy( data, pos, size );
+		pos += size;
+		return true;
+	}
+
+	inline bool readUInt32( const char*& pos, const char* end, boost::uint32_t& value )
+	{
+		return readBytes( pos, end, &value, sizeof( value ) );
+	}
+
+	// Prevent child processes (see FMIComponentFrontEnd::startApplication(...)) from inheriting a socket.
+	template<typename Socket>
+	void setCloseOnExec( Socket& socket )
+	{
+#ifndef WIN32
+		int fd = socket.native_handle();
+		int flags = ::fcntl( fd, F_GETFD );
+		if ( -1 != flags ) ::fcntl( fd, F_SETFD, flags | FD_CLOEXEC );
+#endif
+	}
+}
+
+
+
+SocketManager::SocketManager() :
+	logger_( 0 ),
+	operational_( false ),
+	isTCP_( false ),
+	acceptor_( 0 ),
+	socket_( 0 ),
+	lastMessageSize_( 0 )
+{}
+
+
+SocketManager::SocketManager( IPCLogger* logger ) :
+	logger_( logger ),
+	operational_( false ),
+	isTCP_( false ),
+	acceptor_( 0 ),
+	socket_( 0 ),
+	lastMessageSize_( 0 )
+{}
+
+
+SocketManager::~SocketManager()
+{
+	close();
+
+	std::vector<Object>::iterator it;
+	for ( it = objects_.begin(); it != objects_.end(); ++it ) {
+		::operator delete( it->data_ );
+		::operator delete( it->shadow_ );
+	}
+}
+
+
+void
+SocketManager::listen( const std::string& address )
+{
+	close();
+
+	Protocol::endpoint endpoint;
+	if ( false == resolve( address, endpoint, isTCP_ ) ) return;
+
+	// Remove stale socket files of previous runs.
+	if ( false == isTCP_ ) std::remove( socketPath_.c_str() );
+
+	boost::system::error_code ec;
+	acceptor_ = new basic_socket_acceptor<Protocol>( ioService_ );
+
+	acceptor_->open( endpoint.protocol(), ec );
+	if ( ec ) { fail( "unable to open socket for address " + address, ec ); return; }
+
+	if ( isTCP_ ) acceptor_->set_option( socket_base::reuse_address( true ), ec );
+
+	acceptor_->bind( endpoint, ec );
+	if ( ec ) { fail( "unable to bind socket to address " + address, ec ); return; }
+
+	acceptor_->listen( socket_base::max_connections, ec );
+	if ( ec ) { fail( "unable to listen at address " + address, ec ); return; }
+
+	setCloseOnExec( *acceptor_ );
+
+	if ( isTCP_ )
+	{
+		// Retrieve the actual port number (in case the port number 0 was used).
+		Protocol::endpoint local = acceptor_->local_endpoint( ec );
+		if ( ec ) { fail( "unable to retrieve local endpoint for address " + address, ec ); return; }
+
+		ip::tcp::endpoint tcpEndpoint;
+		std::memcpy( tcpEndpoint.data(), local.data(), local.size() );
+		tcpEndpoint.resize( local.size() );
+
+		std::stringstream actualAddress;
+		actualAddress << tcpPrefix << tcpEndpoint.address().to_string() << ":" << tcpEndpoint.port();
+		address_ = actualAddress.str();
+	}
+	else
+	{
+		address_ = address;
+	}
+
+	operational_ = true;
+}
+
+
+bool
+SocketManager::accept()
+{
+	if ( ( false == operational_ ) || ( 0 == acceptor_ ) ) return false;
+
+	if ( socket_ ) { delete socket_; socket_ = 0; }
+	socket_ = new Protocol::socket( ioService_ );
+
+	boost::system::error_code ec;
+	acceptor_->accept( *socket_, ec );
+	if ( ec ) { fail( "unable to accept connection at address " + address_, ec ); return false; }
+
+	configureSocket();
+	return true;
+}
+
+
+void
+SocketManager::connect( const std::string& address )
+{
+	close();
+
+	Protocol::endpoint endpoint;
+	if ( false == resolve( address, endpoint, isTCP_ ) ) return;
+
+	// The socket file belongs to the listening side.
+	socketPath_.clear();
+
+	boost::system::error_code ec;
+	socket_ = new Protocol::socket( ioService_ );
+	socket_->connect( endpoint, ec );
+	if ( ec ) { fail( "unable to connect to address " + address, ec ); return; }
+
+	configureSocket();
+
+	address_ = address;
+	operational_ = true;
+}
+
+
+bool
+SocketManager::isConnected() const
+{
+	return ( 0 != socket_ ) && socket_->is_open();
+}
+
+
+bool
+SocketManager::send()
+{
+	if ( ( false == operational_ ) || ( false == isConnected() ) ) return false;
+
+	buffer_.assign( headerSize, 0 );
+	std::size_t nAnnounced = 0;
+	std::size_t nUpdates = 0;
+
+	std::vector<Object>::iterator it;
+
+	// Announce new objects, including their current contents.
+	for ( it = objects_.begin(); it != objects_.end(); ++it )
+	{
+		if ( true == it->announced_ ) continue;
+
+		std::size_t bytes = it->elementSize_*it->numElements_;
+
+		appendUInt32( buffer_, it->id_.size() );
+		appendBytes( buffer_, it->id_.data(), it->id_.size() );
+		appendUInt32( buffer_, it->elementSize_ );
+		appendUInt32( buffer_, it->numElements_ );
+		appendBytes( buffer_, it->data_, bytes );
+
+		std::memcpy( it->shadow_, it->data_, bytes );
+		it->announced_ = true;
+		++nAnnounced;
+	}
+
+	// Send consecutive runs of elements that have changed since the last message.
+	for ( it = objects_.begin(); it != objects_.end(); ++it )
+	{
+		const std::size_t size = it->elementSize_;
+		unsigned int element = 0;
+
+		while ( element < it->numElements_ )
+		{
+			if ( 0 == std::memcmp( it->data_ + element*size, it->shadow_ + element*size, size ) ) {
+				++element;
+				continue;
+			}
+
+			unsigned int first = element;
+			while ( ( element < it->numElements_ ) &&
+				( 0 != std::memcmp( it->data_ + element*size, it->shadow_ + element*size, size ) ) )
+				++element;
+
+			std::size_t bytes = ( element - first )*size;
+
+			appendUInt32( buffer_, it - objects_.begin() );
+			appendUInt32( buffer_, first );
+			appendUInt32( buffer_, element - first );
+			appendBytes( buffer_, it->data_ + first*size, bytes );
+
+			std::memcpy( it->shadow_ + first*size, it->data_ + first*size, bytes );
+			++nUpdates;
+		}
+	}
+
+	writeUInt32( buffer_, 0, buffer_.size() - sizeof( boost::uint32_t ) );
+	writeUInt32( buffer_, sizeof( boost::uint32_t ), nAnnounced );
+	writeUInt32( buffer_, 2*sizeof( boost::uint32_t ), nUpdates );
+
+	boost::system::error_code ec;
+	boost::asio::write( *socket_, boost::asio::buffer( buffer_ ), ec );
+	if ( ec ) { fail( "unable to send message", ec ); return false; }
+
+	lastMessageSize_ = buffer_.size();
+	return true;
+}
+
+
+bool
+SocketManager::isMessagePending()
+{
+	if ( ( false == operational_ ) || ( false == isConnected() ) ) return false;
+
+	boost::system::error_code ec;
+	std::size_t available = socket_->available( ec );
+	if ( ec ) { fail( "unable to check for pending messages", ec ); return false; }
+
+	return 0 != available;
+}
+
+
+bool
+SocketManager::receive()
+{
+	if ( ( false == operational_ ) || ( false == isConnected() ) ) return false;
+
+	boost::system::error_code ec;
+
+	boost::uint32_t messageSize = 0;
+	boost::asio::read( *socket_, boost::asio::buffer( &messageSize, sizeof( messageSize ) ), ec );
+	if ( ec ) { fail( "unable to receive message", ec ); return false; }
+
+	buffer_.resize( messageSize );
+	if ( messageSize > 0 ) {
+		boost::asio::read( *socket_, boost::asio::buffer( buffer_ ), ec );
+		if ( ec ) { fail( "unable to receive message", ec ); return false; }
+	}
+
+	const char* pos = buffer_.empty() ? 0 : &buffer_.front();
+	const char* end = pos + buffer_.size();
+
+	boost::uint32_t nAnnounced = 0;
+	boost::uint32_t nUpdates = 0;
+	if ( ( false == readUInt32( pos, end, nAnnounced ) ) || ( false == readUInt32( pos, end, nUpdates ) ) ) {
+		fail( "received malformed message header", ec );
+		return false;
+	}
+
+	// Objects announced by the other side.
+	for ( boost::uint32_t i = 0; i < nAnnounced; ++i )
+	{
+		boost::uint32_t idLength = 0;
+		boost::uint32_t elementSize = 0;
+		boost::uint32_t numElements = 0;
+
+		if ( ( false == readUInt32( pos, end, idLength ) ) ||
+		     ( static_cast<std::size_t>( end - pos ) < idLength ) ) {
+			fail( "received malformed object announcement", ec );
+			return false;
+		}
+
+		std::string id( pos, idLength );
+		pos += idLength;
+
+		if ( ( false == readUInt32( pos, end, elementSize ) ) ||
+		     ( false == readUInt32( pos, end, numElements ) ) ) {
+			fail( "received malformed object announcement", ec );
+			return false;
+		}
+
+		Object* object = addObject( id, elementSize, numElements );
+		if ( 0 == object ) {
+			fail( "unable to create announced object '" + id + "'", ec );
+			return false;
+		}
+
+		std::size_t bytes = elementSize*numElements;
+		if ( false == readBytes( pos, end, object->data_, bytes ) ) {
+			fail( "received malformed object announcement", ec );
+			return false;
+		}
+
+		std::memcpy( object->shadow_, object->data_, bytes );
+		object->announced_ = true;
+	}
+
+	// Updates of individual elements. The shadow copy is updated too, so that these
+	// changes are not sent back with the next message.
+	for ( boost::uint32_t i = 0; i < nUpdates; ++i )
+	{
+		boost::uint32_t index = 0;
+		boost::uint32_t first = 0;
+		boost::uint32_t count = 0;
+
+		if ( ( false == readUInt32( pos, end, index ) ) ||
+		     ( false == readUInt32( pos, end, first ) ) ||
+		     ( false == readUInt32( pos, end, count ) ) ||
+		     ( index >= objects_.size() ) ||
+		     ( first + count > objects_[index].numElements_ ) ) {
+			fail( "received malformed update", ec );
+			return false;
+		}
+
+		Object& object = objects_[index];
+		std::size_t offset = first*object.elementSize_;
+		std::size_t bytes = count*object.elementSize_;
+
+		if ( false == readBytes( pos, end, object.data_ + offset, bytes ) ) {
+			fail( "received malformed update", ec );
+			return false;
+		}
+
+		std::memcpy( object.shadow_ + offset, object.data_ + offset, bytes );
+	}
+
+	return true;
+}
+
+
+void
+SocketManager::sleep( unsigned int ms ) const
+{
+	boost::interprocess::ipcdetail::thread_sleep( ms );
+}
+
+
+SocketManager::Object*
+SocketManager::addObject( const std::string& id, std::size_t elementSize, unsigned int numElements )
+{
+	if ( objectIndices_.end() != objectIndices_.find( id ) ) {
+		logger_->logger( fmiWarning, "WARNING", "object '" + id + "' already exists" );
+		return 0;
+	}
+
+	std::size_t bytes = elementSize*numElements;
+
+	Object object;
+	object.id_ = id;
+	object.elementSize_ = elementSize;
+	object.numElements_ = numElements;
+	object.data_ = static_cast<char*>( ::operator new( bytes ? bytes : 1, std::nothrow ) );
+	object.shadow_ = static_cast<char*>( ::operator new( bytes ? bytes : 1, std::nothrow ) );
+	object.announced_ = false;
+
+	if ( ( 0 == object.data_ ) || ( 0 == object.shadow_ ) ) {
+		::operator delete( object.data_ );
+		::operator delete( object.shadow_ );
+		logger_->logger( fmiFatal, "ABORT", "unable to allocate memory for object '" + id + "'" );
+		return 0;
+	}
+
+	std::memset( object.data_, 0, bytes );
+	std::memset( object.shadow_, 0, bytes );
+
+	objectIndices_[id] = objects_.size();
+	objects_.push_back( object );
+
+	return &objects_.back();
+}
+
+
+const SocketManager::Object*
+SocketManager::findObject( const std::string& id ) const
+{
+	std::map<std::string, std::size_t>::const_iterator it = objectIndices_.find( id );
+	return ( objectIndices_.end() == it ) ? 0 : &objects_[it->second];
+}
+
+
+bool
+SocketManager::resolve( const std::string& address, Protocol::endpoint& endpoint, bool& isTCP )
+{
+	boost::system::error_code ec;
+
+	if ( 0 == address.compare( 0, tcpPrefix.size(), tcpPrefix ) )
+	{
+		std::string hostAndPort = address.substr( tcpPrefix.size() );
+		std::size_t colon = hostAndPort.rfind( ':' );
+		if ( std::string::npos == colon ) {
+			logger_->logger( fmiFatal, "ABORT", "missing port number in address: " + address );
+			operational_ = false;
+			return false;
+		}
+
+		std::string host = hostAndPort.substr( 0, colon );
+		std::string port = hostAndPort.substr( colon + 1 );
+		if ( host.empty() ) host = "127.0.0.1";
+
+		ip::tcp::resolver resolver( ioService_ );
+		ip::tcp::resolver::iterator it =
+			resolver.resolve( ip::tcp::resolver::query( host, port, ip::tcp::resolver::query::numeric_service ), ec );
+		if ( ec || ( ip::tcp::resolver::iterator() == it ) ) {
+			fail( "unable to resolve address " + address, ec );
+			return false;
+		}
+
+		endpoint = Protocol::endpoint( it->endpoint() );
+		socketPath_.clear();
+		isTCP = true;
+		return true;
+	}
+
+	if ( 0 == address.compare( 0, unixPrefix.size(), unixPrefix ) )
+	{
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+		socketPath_ = address.substr( unixPrefix.size() );
+		endpoint = Protocol::endpoint( local::stream_protocol::endpoint( socketPath_ ) );
+		isTCP = false;
+		return true;
+#else
+		logger_->logger( fmiFatal, "ABORT", "Unix domain sockets are not supported on this platform" );
+		operational_ = false;
+		return false;
+#endif
+	}
+
+	logger_->logger( fmiFatal, "ABORT", "unknown address format: " + address );
+	operational_ = false;
+	return false;
+}
+
+
+void
+SocketManager::configureSocket()
+{
+	// Small messages are exchanged in strict alternation, do not delay them.
+	boost::system::error_code ec;
+	if ( isTCP_ ) socket_->set_option( ip::tcp::no_delay( true ), ec );
+
+	setCloseOnExec( *socket_ );
+}
+
+
+void
+SocketManager::close()
+{
+	boost::system::error_code ec;
+
+	if ( socket_ ) {
+		socket_->close( ec );
+		delete socket_;
+		socket_ = 0;
+	}
+
+	if ( acceptor_ ) {
+		acceptor_->close( ec );
+		delete acceptor_;
+		acceptor_ = 0;
+
+		if ( false == socketPath_.empty() ) std::remove( socketPath_.c_str() );
+	}
+
+	operational_ = false;
+}
+
+
+void
+SocketManager::fail( const std::string& msg, const boost::system::error_code& ec )
+{
+	std::stringstream err;
+	err << msg;
+	if ( ec ) err << std::endl << "ERROR: " << ec.message();
+	logger_->logger( fmiFatal, "ABORT", err.str() );
+
+	close();
+}
@@ -0,0 +1,245 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+/// \file SocketMaster.cpp
+
+#include <sstream>
+
+#include "export/include/SocketMaster.h"
+#include "export/include/SocketManager.h"
+#include "export/include/IPCLogger.h"
+#include "export/include/ScalarVariable.h"
+
+
+namespace {
+
+	// Create the metadata table and the array of values of scalar variables of one type.
+	template<typename Type>
+	bool createScalarArrays( SocketManager* socketManager,
+				 const std::string& id,
+				 unsigned int numObj,
+				 ScalarVariableMetadata*& metadata,
+				 Type*& values )
+	{
+		return ( socketManager->createArray( id + "_metadata", numObj, metadata ) &&
+			 socketManager->createArray( id + "_values", numObj, values ) );
+	}
+}
+
+
+SocketMaster::SocketMaster( const std::string& address,
+			    IPCLogger* logger ) :
+	IPCMaster( logger ),
+	address_( address ),
+	socketManager_( new SocketManager( logger ) ),
+	connected_( false )
+{
+	socketManager_->listen( address_ );
+}
+
+
+SocketMaster::~SocketMaster()
+{
+	delete socketManager_;
+}
+
+
+// Re-initialize the master.
+void
+SocketMaster::reinitialize()
+{
+	connected_ = false;
+
+	// Listen again at the endpoint already bound to (in case port number 0 was requested
+	// initially, listening at address_ would choose a new port unknown to the slave).
+	const std::string boundAddress = socketManager_->getAddress();
+	socketManager_->listen( boundAddress );
+}
+
+
+// Check if data exchange/syncing is working.
+bool
+SocketMaster::isOperational()
+{
+	return socketManager_->isOperational();
+}
+
+
+// Create internally a double data object and retrieve pointer to it.
+bool
+SocketMaster::createVariable( const std::string& id,
+			      double*& var,
+			      const double& val )
+{
+	logger( fmiOK, "DEBUG", "create variable of type 'double'" );
+	return socketManager_->createObject( id, var, val );
+}
+
+
+// Create internally an integer data object and retrieve pointer to it.
+bool
+SocketMaster::createVariable( const std::string& id,
+			      int*& var,
+			      const int& val )
+{
+	logger( fmiOK, "DEBUG", "create variable of type 'int'" );
+	return socketManager_->createObject( id, var, val );
+}
+
+
+// Create internally a boolean data object and retrieve pointer to it.
+bool
+SocketMaster::createVariable( const std::string& id,
+			      bool*& var,
+			      const bool& val )
+{
+	logger( fmiOK, "DEBUG", "create variable of type 'bool'" );
+	return socketManager_->createObject( id, var, val );
+}
+
+
+// Create internally double scalar variables (metadata table and dense
+// array of values) and retrieve pointers to it.
+bool
+SocketMaster::createScalars( const std::string& id,
+			     unsigned int numObj,
+			     ScalarVariableMetadata*& metadata,
+			     double*& values )
+{
+	if ( 0 == numObj ) { metadata = 0; values = 0; return true; }
+
+	std::stringstream info;
+	info << "create table and array containing " << numObj << " object(s) of type 'double'";
+	logger( fmiOK, "DEBUG", info.str() );
+
+	return createScalarArrays( socketManager_, id, numObj, metadata, values );
+}
+
+
+// Create internally integer scalar variables (metadata table and dense
+// array of values) and retrieve pointers to it.
+bool
+SocketMaster::createScalars( const std::string& id,
+			     unsigned int numObj,
+			     ScalarVariableMetadata*& metadata,
+			     int*& values )
+{
+	if ( 0 == numObj ) { metadata = 0; values = 0; return true; }
+
+	std::stringstream info;
+	info << "create table and array containing " << numObj << " object(s) of type 'int'";
+	logger( fmiOK, "DEBUG", info.str() );
+
+	return createScalarArrays( socketManager_, id, numObj, metadata, values );
+}
+
+
+// Create internally char (fmiBoolean) scalar variables (metadata table and dense
+// array of values) and retrieve pointers to it.
+bool
+SocketMaster::createScalars( const std::string& id,
+			     unsigned int numObj,
+			     ScalarVariableMetadata*& metadata,
+			     char*& values )
+{
+	if ( 0 == numObj ) { metadata = 0; values = 0; return true; }
+
+	std::stringstream info;
+	info << "create table and array containing " << numObj << " object(s) of type 'char' (fmiBoolean)";
+	logger( fmiOK, "DEBUG", info.str() );
+
+	return createScalarArrays( socketManager_, id, numObj, metadata, values );
+}
+
+
+// Create internally string scalar variables (metadata table and dense
+// array of values) and retrieve pointers to it.
+bool
+SocketMaster::createScalars( const std::string& id,
+			     unsigned int numObj,
+			     ScalarVariableMetadata*& metadata,
+			     ScalarVariableString*& values )
+{
+	if ( 0 == numObj ) { metadata = 0; values = 0; return true; }
+
+	std::stringstream info;
+	info << "create table and array containing " << numObj << " object(s) of type 'ScalarVariableString'";
+	logger( fmiOK, "DEBUG", info.str() );
+
+	return createScalarArrays( socketManager_, id, numObj, metadata, values );
+}
+
+
+// Create internally the change log of a collection of scalar variables and retrieve pointer to it.
+bool
+SocketMaster::createChangeLog( const std::string& id,
+			      unsigned int numObj,
+			      unsigned int*& log )
+{
+	if ( 0 == numObj ) { log = 0; return true; }
+
+	return socketManager_->createArray( id + "_changes", ScalarVariableChangeLog::getSize( numObj ), log );
+}
+
+
+// Create internally a channel for log records from the slave and retrieve pointers to it.
+bool
+SocketMaster::createLogChannel( const std::string& id,
+			       unsigned int numRecords,
+			       IPCLogRecord*& records,
+			       unsigned int*& count )
+{
+	return ( true == socketManager_->createArray( id + "_records", numRecords, records ) ) &&
+		( true == socketManager_->createArray( id + "_count", 1, count ) );
+}
+
+
+// Wait for signal from slave to resume execution. Blocks until signal from slave is
+// received. In case the connection fails (e.g., because the slave has crashed), the
+// socket is closed and the master is not operational anymore (see SocketManager::fail).
+void
+SocketMaster::waitForSlave()
+{
+	// Initially, the master is allowed to proceed as soon as the slave has connected.
+	if ( false == connected_ ) {
+		connected_ = socketManager_->accept();
+		return;
+	}
+
+	socketManager_->receive();
+}
+
+
+// Send signal to slave to proceed with execution.
+// Do not alter shared data until waitForSlave() unblocks.
+void
+SocketMaster::signalToSlave()
+{
+	socketManager_->send();
+}
+
+
+// Stop execution for ms milliseconds.
+void
+SocketMaster::sleep( unsigned int ms ) const
+{
+	socketManager_->sleep( ms );
+}
+
+
+// Get the address the slave has to connect to.
+const std::string&
+SocketMaster::getAddress() const
+{
+	return socketManager_->getAddress();
+}
+
+
+// Get the size of the last message sent to the slave.
+std::size_t
+SocketMaster::getLastMessageSize() const
+{
+	return socketManager_->getLastMessageSize();
+}
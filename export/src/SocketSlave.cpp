@@ -0,0 +1,237 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+/// \file SocketSlave.cpp
+
+#include "export/include/SocketSlave.h"
+#include "export/include/SocketManager.h"
+#include "export/include/IPCLogger.h"
+#include "export/include/ScalarVariable.h"
+
+
+namespace {
+
+	// Retrieve a single data object.
+	template<typename Type>
+	bool retrieveObject( const SocketManager* socketManager,
+			     const std::string& id,
+			     Type*& var )
+	{
+		unsigned int numObj = 0;
+		return ( socketManager->retrieveArray( id, var, numObj ) && ( 1 == numObj ) );
+	}
+
+	// Retrieve the metadata table and the array of values of scalar variables of one type.
+	template<typename Type>
+	bool retrieveScalarArrays( const SocketManager* socketManager,
+				   const std::string& id,
+				   unsigned int& numObj,
+				   const ScalarVariableMetadata*& metadata,
+				   Type*& values )
+	{
+		ScalarVariableMetadata* table = 0;
+		unsigned int numValues = 0;
+
+		if ( ( false == socketManager->retrieveArray( id + "_metadata", table, numObj ) ) ||
+		     ( false == socketManager->retrieveArray( id + "_values", values, numValues ) ) ||
+		     ( numObj != numValues ) )
+		{
+			numObj = 0;
+			metadata = 0;
+			values = 0;
+			return false;
+		}
+
+		metadata = table;
+		return true;
+	}
+}
+
+
+SocketSlave::SocketSlave( const std::string& address,
+			  IPCLogger* logger ) :
+	IPCSlave( logger ),
+	address_( address ),
+	socketManager_( new SocketManager( logger ) )
+{
+	socketManager_->connect( address_ );
+}
+
+
+SocketSlave::~SocketSlave()
+{
+	delete socketManager_;
+}
+
+
+// Re-initialize the slave, i.e., try to connect again.
+void
+SocketSlave::reinitialize()
+{
+	socketManager_->connect( address_ );
+}
+
+
+// Check if data exchange/syncing is working.
+bool
+SocketSlave::isOperational()
+{
+	return socketManager_->isOperational();
+}
+
+
+// Retrieve pointer to a double data object.
+bool
+SocketSlave::retrieveVariable( const std::string& id,
+			       double*& var ) const
+{
+	return retrieveObject( socketManager_, id, var );
+}
+
+
+// Retrieve pointer to an integer data object.
+bool
+SocketSlave::retrieveVariable( const std::string& id,
+			       int*& var ) const
+{
+	return retrieveObject( socketManager_, id, var );
+}
+
+
+// Retrieve pointer to a boolean data object.
+bool
+SocketSlave::retrieveVariable( const std::string& id,
+			       bool*& var ) const
+{
+	return retrieveObject( socketManager_, id, var );
+}
+
+
+// Retrieve pointers to the metadata table and the array of values of double scalar variables.
+bool
+SocketSlave::retrieveScalars( const std::string& id,
+			      unsigned int& numObj,
+			      const ScalarVariableMetadata*& metadata,
+			      double*& values ) const
+{
+	return retrieveScalarArrays( socketManager_, id, numObj, metadata, values );
+}
+
+
+// Retrieve pointers to the metadata table and the array of values of integer scalar variables.
+bool
+SocketSlave::retrieveScalars( const std::string& id,
+			      unsigned int& numObj,
+			      const ScalarVariableMetadata*& metadata,
+			      int*& values ) const
+{
+	return retrieveScalarArrays( socketManager_, id, numObj, metadata, values );
+}
+
+
+// Retrieve pointers to the metadata table and the array of values of char (fmiBoolean) scalar variables.
+bool
+SocketSlave::retrieveScalars( const std::string& id,
+			      unsigned int& numObj,
+			      const ScalarVariableMetadata*& metadata,
+			      char*& values ) const
+{
+	return retrieveScalarArrays( socketManager_, id, numObj, metadata, values );
+}
+
+
+// Retrieve pointers to the metadata table and the array of values of string scalar variables.
+bool
+SocketSlave::retrieveScalars( const std::string& id,
+			      unsigned int& numObj,
+			      const ScalarVariableMetadata*& metadata,
+			      ScalarVariableString*& values ) const
+{
+	return retrieveScalarArrays( socketManager_, id, numObj, metadata, values );
+}
+
+
+// Retrieve pointer to the change log of a collection of scalar variables.
+bool
+SocketSlave::retrieveChangeLog( const std::string& id,
+				unsigned int& numObj,
+				unsigned int*& log ) const
+{
+	unsigned int size = 0;
+	if ( ( false == socketManager_->retrieveArray( id + "_changes", log, size ) ) ||
+	     ( 0 == size % 2 ) )
+	{
+		numObj = 0;
+		log = 0;
+		return false;
+	}
+
+	numObj = ( size - 1 )/2;
+	return true;
+}
+
+
+// Retrieve pointers to the channel for log records to the master.
+bool
+SocketSlave::retrieveLogChannel( const std::string& id,
+				 unsigned int& numRecords,
+				 IPCLogRecord*& records,
+				 unsigned int*& count ) const
+{
+	unsigned int size = 0;
+	if ( ( false == socketManager_->retrieveArray( id + "_records", records, numRecords ) ) ||
+	     ( false == socketManager_->retrieveArray( id + "_count", count, size ) ) ||
+	     ( 1 != size ) )
+	{
+		numRecords = 0;
+		records = 0;
+		count = 0;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Wait for signal from master to resume execution.
+// Blocks until signal from master is received.
+void
+SocketSlave::waitForMaster()
+{
+	socketManager_->receive();
+}
+
+
+// Check for a signal from master without blocking.
+bool
+SocketSlave::tryWaitForMaster()
+{
+	// Once a message has started to arrive, it is received completely.
+	if ( false == socketManager_->isMessagePending() ) return false;
+	return socketManager_->receive();
+}
+
+
+// There is only one master, use waitForMaster() instead.
+void
+SocketSlave::waitForAnyMaster()
+{}
+
+
+// Send signal to master to proceed with execution.
+// Do not alter shared data until waitForMaster() unblocks.
+void
+SocketSlave::signalToMaster()
+{
+	socketManager_->send();
+}
+
+
+// Stop execution for ms milliseconds.
+void
+SocketSlave::sleep( unsigned int ms ) const
+{
+	socketManager_->sleep( ms );
+}
@@ -1,6 +1,9 @@
 #ifndef _DYNAMICAL_SYSTEM_H
 #define _DYNAMICAL_SYSTEM_H
 
+#include <vector>
+#include <boost/cstdint.hpp>
+
 //#include "import/integrators/include/IntegratorProperties.h"
 #include "common/fmi_v1.0/fmiModelTypes.h"
 #include "import/integrators/include/Integrator.h"
@@ -94,10 +97,37 @@ public:
 	 */
 	virtual void getNumericalJacobian( fmiReal* J, const fmiReal* x, fmiReal* dfdt, const fmiReal t );
 
+	/**
+	 * get the structural pattern of the Jacobian
+	 *
+	 * The pattern gets stored in a vector of length NEQ*NEQ rowise, where an element is false if
+	 * the derivative of state i is known not to depend on state j.
+	 *
+	 * \return false if the pattern is not available ( always for 1.0 FMUs )
+	 */
+	virtual bool getJacobianPattern( std::vector<bool>& pattern );
+
+	/// get the index of a state in the vector of continuous states. Returns false if there is
+	/// no state with the given name ( always for 1.0 FMUs )
+	virtual bool getStateIndex( const std::string& name, std::size_t& index );
+
 	/// check whether the sign of at least one event indicator changed since the last call
 	/// to saveEventIndicators()
 	bool checkStateEvent();
 
+	/**
+	 * get the event indicators that changed their sign during the last call to checkStateEvent()
+	 * which detected a state event.
+	 *
+	 * The indices of these event indicators are stored in ascending order in \p indices, the
+	 * directions of the zero-crossings in \p directions ( +1 for a change from negative to
+	 * positive values, -1 for a change from positive to negative values ).
+	 *
+	 * \return the number of event indicators that changed their sign
+	 */
+	std::size_t getEventIndicatorCrossings( std::vector<std::size_t>& indices,
+						std::vector<int>& directions ) const;
+
 	/// call completedIntegratorStep and check for a step event
 	virtual bool checkStepEvent() = 0;
 
@@ -133,6 +163,17 @@ private:
 
 	/// Temporary storage for event indicators.
 	fmiReal* currentEventIndicators_;
+
+	/// Bitmasks of the event indicators that changed their sign from negative to positive
+	/// ( bit k of word w corresponds to event indicator 64*w + k ) during the last check.
+	std::vector<boost::uint64_t> rising_;
+
+	/// Bitmasks of the event indicators that changed their sign from positive to negative.
+	std::vector<boost::uint64_t> falling_;
+
+	/// Bitmasks of the zero-crossings of the last check that detected a state event.
+	std::vector<boost::uint64_t> risingEvent_;
+	std::vector<boost::uint64_t> fallingEvent_;
 };
 
 #endif
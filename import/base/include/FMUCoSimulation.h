@@ -63,11 +63,21 @@ public:
 				      const fmiBoolean stopTimeDefined,
 				      const fmiReal stopTime );
 
+	/// \copydoc FMUCoSimulationBase::reset
+	virtual fmiStatus reset();
+
 	/// \copydoc FMUCoSimulationBase::doStep
 	virtual fmiStatus doStep( fmiReal currentCommunicationPoint,
 				  fmiReal communicationStepSize,
 				  fmiBoolean newStep );
 
+	/// \copydoc FMUCoSimulationBase::getRealOutputDerivatives
+	virtual fmiStatus getRealOutputDerivatives( fmiValueReference* valref, std::size_t ival,
+						    fmiInteger* order, fmiReal* val );
+
+	/// \copydoc FMUCoSimulationBase::getMaxOutputDerivativeOrder
+	virtual fmiInteger getMaxOutputDerivativeOrder() const;
+
 	/// \copydoc FMUCoSimulationBase::setCallbacks
 	virtual fmiStatus setCallbacks( cs::fmiCallbackLogger logger,
 					cs::fmiCallbackAllocateMemory allocateMemory,
@@ -211,8 +221,13 @@ private:
 
 	fmiStatus lastStatus_; ///< Last status returned by the FMU.
 
+	fmiInteger maxOutputDerivativeOrder_; ///< Maximum order of output derivatives provided by the FMU.
+
 	void readModelDescription(); ///< Read the model description.
 
+	/// Block until a pending step has been finished and return its final status.
+	fmiStatus waitForPendingStep();
+
 };
 
 #endif // _FMIPP_FMU_COSIMULATION_H
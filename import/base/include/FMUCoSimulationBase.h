@@ -65,6 +65,14 @@ public:
 				      const fmiBoolean stopTimeDefined,
 				      const fmiReal stopTime ) = 0;
 
+	/**
+	 * Reset the slave to the state after instantiation. Call initialize(...) afterwards
+	 * to start a new simulation run.
+	 *
+	 * @return reset status.
+	 */
+	virtual fmiStatus reset() = 0;
+
 	
 	/**
 	 * Call doStep(...) function of CS FMU.
@@ -74,13 +82,29 @@ public:
 	 *             event iteration the parameter is zero
 	 * @param[in]  newStep  is true (fmiTrue) if the last communication step is accepted by the
 	 *             master and a new communication step is started
-	 * @return simulation step status.
+	 * @return simulation step status (fmiPending only if a callback function stepFinished(...)
+	 *         has been set via setCallbacks(...), otherwise the step is waited for).
 	 */
 	virtual fmiStatus doStep( fmiReal currentCommunicationPoint,
 				  fmiReal communicationStepSize,
 				  fmiBoolean newStep ) = 0;
 
 
+	/**
+	 * Get derivatives of real outputs with respect to time at the current communication point.
+	 *
+	 * @param[in]  valref  value references of the outputs
+	 * @param[in]  ival  number of outputs
+	 * @param[in]  order  order of the derivative (for each output)
+	 * @param[out]  val  values of the derivatives
+	 * @return status of the FMU
+	 */
+	virtual fmiStatus getRealOutputDerivatives( fmiValueReference* valref, std::size_t ival,
+						    fmiInteger* order, fmiReal* val ) = 0;
+
+	/// Get the maximum order of output derivatives the slave is able to provide (0 if none).
+	virtual fmiInteger getMaxOutputDerivativeOrder() const = 0;
+
 	
 	/**
 	 * Set callback functions of CS FMU. Call before instantiate(...).
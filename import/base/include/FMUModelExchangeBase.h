@@ -176,6 +176,16 @@ public:
 		integrator_->setProperties( properties );
 	}
 
+	/// \copydoc Integrator::getStatistics
+	Integrator::Statistics getIntegratorStatistics() const {
+		return integrator_->getStatistics();
+	}
+
+	/// \copydoc Integrator::resetStatistics
+	void resetIntegratorStatistics(){
+		integrator_->resetStatistics();
+	}
+
  protected:
 
 	fmiBoolean callEventUpdate_;  ///< Internal flag indicationg to call an event update.
@@ -110,6 +110,12 @@ public:
 	/// \copydoc DynamicalSystem::getJac( fmiReal* J )
 	virtual	fmiStatus getJac( fmiReal* J );
 
+	/// \copydoc DynamicalSystem::getJacobianPattern
+	virtual bool getJacobianPattern( std::vector<bool>& pattern );
+
+	/// \copydoc DynamicalSystem::getStateIndex
+	virtual bool getStateIndex( const std::string& name, std::size_t& index );
+
 	/// \copydoc FMUModelExchangeBase::getEventIndicators
 	virtual fmiStatus getEventIndicators( fmiReal* eventsind );
 
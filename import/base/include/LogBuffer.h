@@ -5,11 +5,14 @@
 
 /**
  * \file LogBuffer.h
- * Provide a global buffer instance for all FMU callback loggers.
+ * Provide a global buffer instance for all FMU callback loggers. The buffer may
+ * be accessed concurrently by FMUs simulated in different threads.
  */
 
 #include <string>
 
+#include <boost/thread/mutex.hpp>
+
 #include "common/FMIPPConfig.h"
 
 
@@ -61,4 +64,7 @@ private:
 
 	/// The string for buffering log messages.
 	std::string buffer_;
+
+	/// Protects the flag and the buffer.
+	boost::mutex mutex_;
 };
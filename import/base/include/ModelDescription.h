@@ -18,6 +18,7 @@
  */
 
 #include <string>
+#include <vector>
 #include <boost/property_tree/ptree.hpp>
 
 #include "common/FMIPPConfig.h"
@@ -101,6 +102,12 @@ public:
 	/// Get entry point from description (FMI CS feature).
 	std::string getEntryPoint() const;
 
+	/// Get maximum order of output derivatives provided by the slave (FMI CS feature).
+	int getMaxOutputDerivativeOrder() const;
+
+	/// Check if the slave can run asynchronously, i.e., if doStep(...) may return fmiPending (FMI CS feature).
+	bool canRunAsynchronuously() const;
+
 	/// Get number of continuous states from description.
 	int getNumberOfContinuousStates() const;
 
@@ -114,6 +121,10 @@ public:
 	/// Get the value references for all states and derivatives
 	void getStatesAndDerivativesReferences( fmiValueReference* state_ref, fmiValueReference* der_ref ) const;
 
+	/// Get the dependencies of the derivatives on the states (FMI 2.0 only), as row-major
+	/// matrix with one row per derivative. Returns false if no model structure is available.
+	bool getDerivativeDependencies( std::vector<bool>& pattern ) const;
+
 
 private:
 
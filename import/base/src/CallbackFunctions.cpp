@@ -12,56 +12,58 @@
 #include <cstdlib>
 #include <cstdio>
 #include <cstdarg>
+#include <cstring>
 
 #include "import/base/include/CallbackFunctions.h"
 #include "import/base/include/LogBuffer.h"
 
 
+namespace {
 
-namespace callback{
-
-
-	// This is a very verbose logger that prints out all messages it receives.
-	void verboseLogger( fmiComponent c, fmiString instanceName, fmiStatus status,
-			    fmiString category, fmiString message, ... )
+	// Compose "<instance name> [<category>]: <message>" (with the message formatted according
+	// to the variable argument list) in a single pass and write it to the log buffer or stdout.
+	void writeLogMessage( const char* instanceName, const char* category, const char* message, va_list ap )
 	{
-		char msg[4096];
 		char buf[4096];
 		int len;
-		int capacity;
+		int capacity = sizeof(buf) - 1; // Reserve space for the line break.
 
-		LogBuffer& logBuffer = LogBuffer::getLogBuffer();
-
-		va_list ap;
-		va_start( ap, message );
-		capacity = sizeof(buf) - 1;
+		// Write the prefix, which must not be interpreted as format string.
+#if defined(_MSC_VER) && _MSC_VER>=1400
+		len = _snprintf_s( buf, capacity, _TRUNCATE, "%s [%s]: ", instanceName, category );
+#elif defined(WIN32)
+		len = _snprintf( buf, capacity, "%s [%s]: ", instanceName, category );
+#else
+		len = snprintf( buf, capacity, "%s [%s]: ", instanceName, category );
+#endif
+		if ( ( len < 0 ) || ( len >= capacity ) ) goto fail;
 
+		// Append the formatted message (truncated if it is too long).
+		int msgLen;
 #if defined(_MSC_VER) && _MSC_VER>=1400
-		len = _snprintf_s( msg, capacity, _TRUNCATE, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf_s( buf, capacity, _TRUNCATE, msg, ap );
-		if ( len < 0 ) goto fail;
+		msgLen = vsnprintf_s( buf + len, capacity - len, _TRUNCATE, message, ap );
+		if ( msgLen < 0 ) msgLen = static_cast<int>( strlen( buf + len ) );
 #elif defined(WIN32)
-		len = _snprintf( msg, capacity, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf( buf, capacity, msg, ap );
-		if ( len < 0 ) goto fail;
+		msgLen = _vsnprintf( buf + len, capacity - len, message, ap );
+		if ( msgLen < 0 ) msgLen = capacity - len - 1;
 #else
-		len = snprintf( msg, capacity, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf( buf, capacity, msg, ap );
-		if ( len < 0 ) goto fail;
+		msgLen = vsnprintf( buf + len, capacity - len, message, ap );
+		if ( msgLen < 0 ) goto fail;
+		if ( msgLen >= capacity - len ) msgLen = capacity - len - 1;
 #endif
+		len += msgLen;
 
 		// Append line break.
 		buf[len] = '\n';
 		buf[len + 1] = 0;
-		va_end( ap );
 
-		if ( true == logBuffer.isActivated() ) {
-			logBuffer.writeToBuffer( buf );
-		} else {
-			fprintf( stdout, "%s", buf ); fflush( stdout );
+		{
+			LogBuffer& logBuffer = LogBuffer::getLogBuffer();
+			if ( true == logBuffer.isActivated() ) {
+				logBuffer.writeToBuffer( buf );
+			} else {
+				fprintf( stdout, "%s", buf ); fflush( stdout );
+			}
 		}
 
 		return;
@@ -69,7 +71,22 @@ namespace callback{
 	fail:
 
 		fprintf( stderr, "logger failed, message too long?" ); fflush( stderr );
+	}
+}
+
 
+
+namespace callback{
+
+
+	// This is a very verbose logger that prints out all messages it receives.
+	void verboseLogger( fmiComponent c, fmiString instanceName, fmiStatus status,
+			    fmiString category, fmiString message, ... )
+	{
+		va_list ap;
+		va_start( ap, message );
+		writeLogMessage( instanceName, category, message, ap );
+		va_end( ap );
 	}
 
 
@@ -79,49 +96,10 @@ namespace callback{
 	{
 		if ( ( fmiOK == status ) || ( fmiWarning == status ) ) return;
 
-		char msg[4096];
-		char buf[4096];
-		int len;
-		int capacity;
-
-		LogBuffer& logBuffer = LogBuffer::getLogBuffer();
-
 		va_list ap;
 		va_start( ap, message );
-		capacity = sizeof(buf) - 1;
-
-
-#if defined(_MSC_VER) && _MSC_VER>=1400
-		len = _snprintf_s( msg, capacity, _TRUNCATE, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf_s( buf, capacity, _TRUNCATE, msg, ap );
-		if ( len < 0 ) goto fail;
-#elif defined(WIN32)
-		len = _snprintf( msg, capacity, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf( buf, capacity, msg, ap );
-		if ( len < 0 ) goto fail;
-#else
-		len = snprintf( msg, capacity, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf( buf, capacity, msg, ap );
-		if ( len < 0 ) goto fail;
-#endif
-
-		// Append line break.
-		buf[len] = '\n';
-		buf[len + 1] = 0;
+		writeLogMessage( instanceName, category, message, ap );
 		va_end( ap );
-
-		if ( true == logBuffer.isActivated() ) {
-			logBuffer.writeToBuffer( buf );
-		} else {
-			fprintf( stdout, "%s", buf ); fflush( stdout );
-		}
-
-		return;
-	fail:
-		fprintf( stderr, "logger failed, message too long?" ); fflush( stderr );
 	}
 
 
@@ -154,48 +132,10 @@ namespace callback2{
 	void verboseLogger( fmi2ComponentEnvironment c, fmi2String instanceName, fmi2Status status,
 			    fmi2String category, fmi2String message, ... )
 	{
-		char msg[4096];
-		char buf[4096];
-		int len;
-		int capacity;
-
-		LogBuffer& logBuffer = LogBuffer::getLogBuffer();
-
 		va_list ap;
 		va_start( ap, message );
-		capacity = sizeof(buf) - 1;
-
-#if defined(_MSC_VER) && _MSC_VER>=1400
-		len = _snprintf_s( msg, capacity, _TRUNCATE, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf_s( buf, capacity, _TRUNCATE, msg, ap );
-		if ( len < 0 ) goto fail;
-#elif defined(WIN32)
-		len = _snprintf( msg, capacity, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf( buf, capacity, msg, ap );
-		if ( len < 0 ) goto fail;
-#else
-		len = snprintf( msg, capacity, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf( buf, capacity, msg, ap );
-		if ( len < 0 ) goto fail;
-#endif
-
-		// Append line break.
-		buf[len] = '\n';
-		buf[len + 1] = 0;
+		writeLogMessage( instanceName, category, message, ap );
 		va_end( ap );
-
-		if ( true == logBuffer.isActivated() ) {
-			logBuffer.writeToBuffer( buf );
-		} else {
-			fprintf( stdout, "%s", buf ); fflush( stdout );
-		}
-
-		return;
-	fail:
-		fprintf( stderr, "logger failed, message too long?" ); fflush( stderr );
 	}
 
 
@@ -205,48 +145,10 @@ namespace callback2{
 	{
 		if ( ( fmi2OK == status ) || ( fmi2Warning == status ) ) return;
 
-		char msg[4096];
-		char buf[4096];
-		int len;
-		int capacity;
-
-		LogBuffer& logBuffer = LogBuffer::getLogBuffer();
-
 		va_list ap;
 		va_start( ap, message );
-		capacity = sizeof(buf) - 1;
-
-#if defined(_MSC_VER) && _MSC_VER>=1400
-		len = _snprintf_s( msg, capacity, _TRUNCATE, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf_s( buf, capacity, _TRUNCATE, msg, ap );
-		if ( len < 0 ) goto fail;
-#elif defined(WIN32)
-		len = _snprintf( msg, capacity, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf( buf, capacity, msg, ap );
-		if ( len < 0 ) goto fail;
-#else
-		len = snprintf( msg, capacity, "%s [%s]: %s", instanceName, category, message );
-		if ( len < 0 ) goto fail;
-		len = vsnprintf( buf, capacity, msg, ap );
-		if ( len < 0 ) goto fail;
-#endif
-
-		// Append line break.
-		buf[len] = '\n';
-		buf[len + 1] = 0;
+		writeLogMessage( instanceName, category, message, ap );
 		va_end( ap );
-
-		if ( true == logBuffer.isActivated() ) {
-			logBuffer.writeToBuffer( buf );
-		} else {
-			fprintf( stdout, "%s", buf ); fflush( stdout );
-		}
-
-		return;
-	fail:
-		fprintf( stderr, "logger failed, message too long?" ); fflush( stderr );
 	}
 
 
@@ -1,6 +1,38 @@
 #include "import/base/include/DynamicalSystem.h"
 #include "import/base/include/NumericalJacobianCoefficients.icc"
 #include <iostream>
+#include <algorithm>
+
+
+namespace {
+
+	// Number of event indicators per word of the crossing bitmasks.
+	const std::size_t maskBits = 64;
+
+	// Compare the signs of the saved and the current event indicators and set the bits of the
+	// zero-crossings in the bitmasks. The inner loop is branchless, so that the compiler can
+	// vectorize the comparisons. Returns true if at least one event indicator crossed zero.
+	bool compareEventIndicators( const fmiReal* saved, const fmiReal* current, std::size_t n,
+				     boost::uint64_t* rising, boost::uint64_t* falling )
+	{
+		boost::uint64_t any = 0;
+		for ( std::size_t w = 0; w*maskBits < n; ++w ){
+			const fmiReal* a = saved + w*maskBits;
+			const fmiReal* b = current + w*maskBits;
+			const std::size_t m = std::min( maskBits, n - w*maskBits );
+			boost::uint64_t up = 0;
+			boost::uint64_t down = 0;
+			for ( std::size_t k = 0; k < m; ++k ){
+				up   |= (boost::uint64_t) ( ( a[k] < 0 ) & ( b[k] > 0 ) ) << k;
+				down |= (boost::uint64_t) ( ( a[k] > 0 ) & ( b[k] < 0 ) ) << k;
+			}
+			rising[w]  = up;
+			falling[w] = down;
+			any |= up | down;
+		}
+		return 0 != any;
+	}
+}
 
 
 DynamicalSystem::DynamicalSystem()
@@ -28,6 +60,18 @@ fmiStatus DynamicalSystem::getJac( fmiReal* J ){
 }
 
 
+bool DynamicalSystem::getJacobianPattern( std::vector<bool>& pattern ){
+	// if this function is not overwritten by derived classes, no structural information is available
+	return false;
+}
+
+
+bool DynamicalSystem::getStateIndex( const std::string& name, std::size_t& index ){
+	// if this function is not overwritten by derived classes, states can not be identified by name
+	return false;
+}
+
+
 void DynamicalSystem::getNumericalJacobian( fmiReal* J, const fmiReal* x, fmiReal* dfdt, const fmiReal t )
 {
 	/**
@@ -132,10 +176,42 @@ bool DynamicalSystem::checkStateEvent(){
 			currentEventIndicators_ = new fmiReal[ nEventInds() ];
 
 	getEventIndicators( currentEventIndicators_ );
-	for ( size_t i = 0; i < nEventInds(); i++ )
-		if ( currentEventIndicators_[i] * savedEventIndicators_[i] < 0 ){
-			return true;
+
+	const std::size_t nWords = ( nEventInds() + maskBits - 1 )/maskBits;
+	if ( rising_.size() != nWords ){
+		rising_.assign( nWords, 0 );
+		falling_.assign( nWords, 0 );
+	}
+
+	if ( !compareEventIndicators( savedEventIndicators_, currentEventIndicators_, nEventInds(),
+				      &rising_.front(), &falling_.front() ) )
+		return false;
+
+	// keep the zero-crossings of the detected state event
+	risingEvent_.swap( rising_ );
+	fallingEvent_.swap( falling_ );
+	return true;
+}
+
+
+std::size_t DynamicalSystem::getEventIndicatorCrossings( std::vector<std::size_t>& indices,
+							 std::vector<int>& directions ) const
+{
+	indices.clear();
+	directions.clear();
+
+	for ( std::size_t w = 0; w < risingEvent_.size(); ++w ){
+		boost::uint64_t mask = risingEvent_[w] | fallingEvent_[w];
+		while ( 0 != mask ){
+			// index of the lowest set bit
+			std::size_t k = 0;
+			while ( 0 == ( ( mask >> k ) & 1 ) ) ++k;
+			mask &= mask - 1;
+
+			indices.push_back( w*maskBits + k );
+			directions.push_back( ( ( risingEvent_[w] >> k ) & 1 ) ? 1 : -1 );
 		}
+	}
 
-	return false;
+	return indices.size();
 }
@@ -11,6 +11,8 @@
 #include <cmath>
 #include <limits>
 
+#include <boost/thread/thread.hpp>
+
 #include "common/FMIPPConfig.h"
 #include "common/fmi_v1.0/fmiModelTypes.h"
 #include "common/fmi_v1.0/fmi_cs.h"
@@ -32,7 +34,8 @@ FMUCoSimulation::FMUCoSimulation( const string& fmuPath,
 	fmuPath_( fmuPath ),
 	time_( numeric_limits<fmiReal>::quiet_NaN() ),
 	timeDiffResolution_( timeDiffResolution ),
-	lastStatus_( fmiOK )
+	lastStatus_( fmiOK ),
+	maxOutputDerivativeOrder_( 0 )
 {
 	ModelManager& manager = ModelManager::getModelManager();
 	fmu_ = manager.getSlave( fmuPath_, modelName, loggingOn_ );
@@ -49,7 +52,8 @@ FMUCoSimulation::FMUCoSimulation( const FMUCoSimulation& fmu ) :
 	varTypeMap_( fmu.varTypeMap_ ),
 	time_( numeric_limits<fmiReal>::quiet_NaN() ),
 	timeDiffResolution_( fmu.timeDiffResolution_ ),
-	lastStatus_( fmiOK )
+	lastStatus_( fmiOK ),
+	maxOutputDerivativeOrder_( fmu.maxOutputDerivativeOrder_ )
 {}
 
 
@@ -121,6 +125,8 @@ void FMUCoSimulation::readModelDescription() {
 	}
 
 	//nValueRefs_ = varMap_.size();
+
+	maxOutputDerivativeOrder_ = description->getMaxOutputDerivativeOrder();
 }
 
 
@@ -166,6 +172,16 @@ fmiStatus FMUCoSimulation::initialize( const fmiReal tStart,
 }
 
 
+fmiStatus FMUCoSimulation::reset()
+{
+	if ( 0 == instance_ ) {
+		return lastStatus_ = fmiError;
+	}
+
+	return lastStatus_ = fmu_->functions->resetSlave( instance_ );
+}
+
+
 fmiReal FMUCoSimulation::getTime() const
 {
 	return time_;
@@ -508,12 +524,49 @@ fmiStatus FMUCoSimulation::doStep( fmiReal currentCommunicationPoint,
 	fmiStatus status = fmu_->functions->doStep( instance_, currentCommunicationPoint,
 						    communicationStepSize, newStep );
 
-	if ( fmiOK == status ) time_ += communicationStepSize;
+	// The default callback function stepFinished(...) does nothing. Unless the user has provided a callback
+	// function, a pending step is waited for and its final status is returned.
+	if ( ( fmiPending == status ) && ( callback::stepFinished == fmu_->callbacks->stepFinished ) )
+		status = waitForPendingStep();
+
+	// In case the step is still pending, its outcome is reported via callback function stepFinished(...).
+	if ( ( fmiOK == status ) || ( fmiPending == status ) ) time_ += communicationStepSize;
 
 	return status;
 }
 
 
+fmiStatus FMUCoSimulation::waitForPendingStep()
+{
+	fmiStatus stepStatus = fmiPending;
+
+	while ( fmiPending == stepStatus )
+	{
+		if ( fmiOK != fmu_->functions->getStatus( instance_, fmiDoStepStatus, &stepStatus ) ) {
+			logger( fmiError, "ABORT", "unable to retrieve the status of a pending step" );
+			return fmiError;
+		}
+
+		if ( fmiPending == stepStatus ) boost::this_thread::yield();
+	}
+
+	return stepStatus;
+}
+
+
+fmiStatus FMUCoSimulation::getRealOutputDerivatives( fmiValueReference* valref, size_t ival,
+						     fmiInteger* order, fmiReal* val )
+{
+	return lastStatus_ = fmu_->functions->getRealOutputDerivatives( instance_, valref, ival, order, val );
+}
+
+
+fmiInteger FMUCoSimulation::getMaxOutputDerivativeOrder() const
+{
+	return maxOutputDerivativeOrder_;
+}
+
+
 fmiStatus FMUCoSimulation::setCallbacks( cs::fmiCallbackLogger logger,
 					 cs::fmiCallbackAllocateMemory allocateMemory,
 					 cs::fmiCallbackFreeMemory freeMemory,
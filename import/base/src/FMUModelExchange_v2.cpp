@@ -872,6 +872,26 @@ fmiStatus FMUModelExchange::getJac( fmiReal* J ){
 }
 
 
+bool FMUModelExchange::getJacobianPattern( vector<bool>& pattern ){
+	return fmu_->description->getDerivativeDependencies( pattern ) &&
+		( pattern.size() == nStateVars_*nStateVars_ );
+}
+
+
+bool FMUModelExchange::getStateIndex( const string& name, size_t& index ){
+	fmi2ValueReference ref = getValueRef( name );
+	if ( fmi2UndefinedValueReference == ref ) return false;
+
+	for ( size_t i = 0; i < nStateVars_; i++ ){
+		if ( states_refs_[i] == ref ){
+			index = i;
+			return true;
+		}
+	}
+	return false;
+}
+
+
 fmiValueReference FMUModelExchange::getValueRef( const string& name ) const {
 	map<string,fmi2ValueReference>::const_iterator it = varMap_.find(name);
 
@@ -10,6 +10,8 @@
 
 #include <cstdio>
 
+#include <boost/thread/lock_guard.hpp>
+
 #include "import/base/include/LogBuffer.h"
 
 
@@ -65,6 +67,7 @@ LogBuffer::getLogBuffer()
 void
 LogBuffer::writeToBuffer( const string& msg )
 {
+	boost::lock_guard<boost::mutex> lock( logBuffer_->mutex_ );
 	logBuffer_->buffer_ += msg;
 }
 
@@ -72,6 +75,7 @@ LogBuffer::writeToBuffer( const string& msg )
 string
 LogBuffer::readFromBuffer()
 {
+	boost::lock_guard<boost::mutex> lock( logBuffer_->mutex_ );
 	return logBuffer_->buffer_;
 }
 
@@ -79,6 +83,7 @@ LogBuffer::readFromBuffer()
 void
 LogBuffer::clear()
 {
+	boost::lock_guard<boost::mutex> lock( logBuffer_->mutex_ );
 	logBuffer_->buffer_.clear();
 }
 
@@ -86,6 +91,7 @@ LogBuffer::clear()
 void
 LogBuffer::activate()
 {
+	boost::lock_guard<boost::mutex> lock( logBuffer_->mutex_ );
 	logBuffer_->isActivated_ = true;
 }
 
@@ -93,6 +99,7 @@ LogBuffer::activate()
 void
 LogBuffer::deactivate()
 {
+	boost::lock_guard<boost::mutex> lock( logBuffer_->mutex_ );
 	logBuffer_->isActivated_ = false;
 }
 
@@ -100,5 +107,6 @@ LogBuffer::deactivate()
 bool
 LogBuffer::isActivated()
 {
+	boost::lock_guard<boost::mutex> lock( logBuffer_->mutex_ );
 	return logBuffer_->isActivated_;
 }
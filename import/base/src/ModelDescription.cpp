@@ -7,6 +7,10 @@
  * \file ModelDescription.cpp
  */
 
+#include <map>
+#include <sstream>
+#include <algorithm>
+
 #include <boost/property_tree/xml_parser.hpp>
 #include <boost/foreach.hpp>
 
@@ -350,6 +354,60 @@ ModelDescription::getEntryPoint() const
 }
 
 
+// Get maximum order of output derivatives provided by the slave (FMI CS feature).
+int
+ModelDescription::getMaxOutputDerivativeOrder() const
+{
+	int order = 0;
+
+	if ( false == isCSv1_ ) return order;
+
+	if ( hasChildAttributes( data_, "fmiModelDescription.Implementation.CoSimulation_Tool.Capabilities" ) )
+	{
+		const Properties& attributes =
+			getChildAttributes( data_, "fmiModelDescription.Implementation.CoSimulation_Tool.Capabilities" );
+
+		order = attributes.get<int>( "maxOutputDerivativeOrder", 0 );
+	}
+	else if ( hasChildAttributes( data_, "fmiModelDescription.Implementation.CoSimulation_StandAlone.Capabilities" ) )
+	{
+		const Properties& attributes =
+			getChildAttributes( data_, "fmiModelDescription.Implementation.CoSimulation_StandAlone.Capabilities" );
+
+		order = attributes.get<int>( "maxOutputDerivativeOrder", 0 );
+	}
+
+	return order;
+}
+
+
+// Check if the slave can run asynchronously (FMI CS feature).
+bool
+ModelDescription::canRunAsynchronuously() const
+{
+	bool flag = false;
+
+	if ( false == isCSv1_ ) return flag;
+
+	if ( hasChildAttributes( data_, "fmiModelDescription.Implementation.CoSimulation_Tool.Capabilities" ) )
+	{
+		const Properties& attributes =
+			getChildAttributes( data_, "fmiModelDescription.Implementation.CoSimulation_Tool.Capabilities" );
+
+		flag = attributes.get<bool>( "canRunAsynchronuously", false );
+	}
+	else if ( hasChildAttributes( data_, "fmiModelDescription.Implementation.CoSimulation_StandAlone.Capabilities" ) )
+	{
+		const Properties& attributes =
+			getChildAttributes( data_, "fmiModelDescription.Implementation.CoSimulation_StandAlone.Capabilities" );
+
+		flag = attributes.get<bool>( "canRunAsynchronuously", false );
+	}
+
+	return flag;
+}
+
+
 // Get number of continuous states from description.
 int
 ModelDescription::getNumberOfContinuousStates() const
@@ -459,6 +517,63 @@ ModelDescription::getStatesAndDerivativesReferences( fmiValueReference* state_re
 }
 
 
+// Get the dependencies of the derivatives on the states.
+bool
+ModelDescription::getDerivativeDependencies( vector<bool>& pattern ) const
+{
+	if ( !isMEv2_ ) return false;
+
+	boost::optional<const Properties&> derivatives =
+		data_.get_child_optional( "fmiModelDescription.ModelStructure.Derivatives" );
+	if ( !derivatives ) return false;
+
+	// random access to the model variables (indices in the model structure start at 1)
+	vector<const Properties*> variables;
+	BOOST_FOREACH( const Properties::value_type& v, getModelVariables() )
+		variables.push_back( &v.second );
+
+	// map the indices of the state variables to the positions in the state vector
+	vector<unsigned int> derivativeIndices;
+	map<unsigned int, size_t> stateIndices;
+	BOOST_FOREACH( const Properties::value_type& v, *derivatives )
+	{
+		const unsigned int index = v.second.get<unsigned int>( "<xmlattr>.index" );
+		if ( ( 0 == index ) || ( index > variables.size() ) ) return false;
+
+		boost::optional<unsigned int> state =
+			variables[index - 1]->get_optional<unsigned int>( "Real.<xmlattr>.derivative" );
+		if ( !state ) return false;
+
+		stateIndices[*state] = derivativeIndices.size();
+		derivativeIndices.push_back( index );
+	}
+
+	const size_t n = derivativeIndices.size();
+	pattern.assign( n*n, false );
+
+	size_t i = 0;
+	BOOST_FOREACH( const Properties::value_type& v, *derivatives )
+	{
+		boost::optional<string> dependencies = v.second.get_optional<string>( "<xmlattr>.dependencies" );
+		if ( !dependencies ) {
+			// no dependencies given, the derivative may depend on all states
+			fill( pattern.begin() + n*i, pattern.begin() + n*( i + 1 ), true );
+		} else {
+			// dependencies on variables other than states (e.g., inputs) are ignored
+			istringstream stream( *dependencies );
+			unsigned int index;
+			while ( stream >> index ) {
+				map<unsigned int, size_t>::const_iterator it = stateIndices.find( index );
+				if ( it != stateIndices.end() ) pattern[n*i + it->second] = true;
+			}
+		}
+		++i;
+	}
+
+	return true;
+}
+
+
 //
 //  Implementation of functionalities from namespace ModelDescriptionUtilities.
 //
@@ -0,0 +1,86 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+#ifndef _FMIPP_DENSELU_H
+#define _FMIPP_DENSELU_H
+
+
+#include <cstddef>
+#include <vector>
+
+#include "common/FMIPPConfig.h"
+#include "common/fmi_v1.0/fmiModelTypes.h"
+
+
+/**
+ * \file DenseLU.h
+ * LU factorization of dense matrices stored in contiguous row-major buffers.
+ *
+ * \class DenseLU DenseLU.h
+ * LU factorization of dense matrices stored in contiguous row-major buffers.
+ *
+ * The factorization uses partial pivoting and is blocked (right-looking): a panel of columns
+ * is factorized, then the corresponding block row of U is computed and the trailing matrix is
+ * updated with a matrix-matrix product. The trailing update accounts for almost all arithmetic
+ * operations and runs over contiguous rows, which keeps it cache-friendly for large matrices.
+ *
+ * The matrix is factorized in place. Once factorized, it can be used to solve any number of
+ * linear systems (see solve(...)), e.g., in several consecutive integrator steps.
+ */
+class __FMI_DLL DenseLU
+{
+
+public:
+
+	/// Constructor, prepares a buffer for an n x n matrix.
+	DenseLU( std::size_t n = 0 );
+
+	/// Resize the buffer for an n x n matrix, invalidates the factorization.
+	void resize( std::size_t n );
+
+	/// Get the dimension of the matrix.
+	std::size_t size() const { return n_; }
+
+	/// Get the row-major buffer of the matrix to be factorized. Writing to the
+	/// buffer invalidates the factorization (see invalidate()).
+	fmiReal* data() { return &a_[0]; }
+
+	/// Get element (i,j) of the matrix.
+	fmiReal& operator()( std::size_t i, std::size_t j ) { return a_[n_*i + j]; }
+
+	/// Factorize the matrix in place, returns false if the matrix is singular.
+	bool factorize();
+
+	/// Check if the buffer holds a valid factorization.
+	bool isFactorized() const { return factorized_; }
+
+	/// Mark the factorization as invalid (e.g., after writing a new matrix to the buffer).
+	void invalidate() { factorized_ = false; }
+
+	/// Solve the linear system A x = b in place (b is overwritten with x).
+	/// Requires a valid factorization.
+	void solve( fmiReal* b ) const;
+
+private:
+
+	/// Factorize the panel of columns [k0,k1) with partial pivoting.
+	bool factorizePanel( std::size_t k0, std::size_t k1 );
+
+	/// Dimension of the matrix.
+	std::size_t n_;
+
+	/// Row-major matrix, holds L (unit lower triangle) and U after the factorization.
+	std::vector<fmiReal> a_;
+
+	/// Row interchanges, row k has been swapped with row pivots_[k].
+	std::vector<std::size_t> pivots_;
+
+	/// Flag indicating whether the buffer holds a valid factorization.
+	bool factorized_;
+
+};
+
+
+#endif // _FMIPP_DENSELU_H
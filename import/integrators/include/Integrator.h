@@ -12,6 +12,7 @@
 #include "common/FMIPPConfig.h"
 
 #include "import/integrators/include/IntegratorType.h"
+#include "import/integrators/include/IntegratorStatistics.h"
 
 #include <string>
 #include <limits>
@@ -72,6 +73,8 @@ public:
 		int            order;    ///< global trunounciation error of the stepper
 		double         abstol;   ///< absolute tolerance. Inf for non adaptive steppers
 		double         reltol;   ///< relative tolerance. Inf for non adaptive steppers
+		std::vector<std::string> fastStates; ///< names of the fast states for multirate steppers.
+		                                     ///  Empty for an automatic partitioning
 		Properties() : type( IntegratorType::dp ),
 			name( "" ),
 			order( 0 ),
@@ -90,6 +93,9 @@ public:
 	EventInfo() : stepEvent( 0 ), stateEvent( 0 ), tLower( 0 ), tUpper( 0 ){}
 	};
 
+	/// \copydoc IntegratorStatistics
+	typedef IntegratorStatistics Statistics;
+
 	/// Integrate FMU ME state.
 	EventInfo integrate( fmiReal step_size, fmiReal dt, fmiReal eventSearchPrecision );
 
@@ -120,6 +126,12 @@ public:
 	/// get the properties of the currently used stepper
 	Properties getProperties() const;
 
+	/// get the statistics of the currently used stepper ( see IntegratorStatistics )
+	Statistics getStatistics() const;
+
+	/// reset all counters of the statistics to zero
+	void resetStatistics();
+
 private:
 
 	Properties properties_;         ///< Internal copy of the stepper properties
@@ -131,6 +143,18 @@ private:
 	state_type states_;		///< Internal states. Serve as backup if an intEvent occurs.
 	fmiTime time_;			///< Internal time. Serves as backup if an intEvent occurs.
 
+	fmiTime tEnd_;                  ///< Time at the end of the last call to integrate without events.
+	                                ///  NaN if the stepper has to be reset.
+	state_type statesEnd_;          ///< States at tEnd_.
+	state_type derivativesEnd_;     ///< Derivatives at tEnd_ ( only for steppers keeping a history ).
+	state_type derivatives_;        ///< Temporary storage for derivatives.
+
+	/// Check whether the integration continues at the time and states where the last call to
+	/// integrate stopped ( see tEnd_ ), with the same right-hand side if the stepper keeps a history.
+	bool continues();
+
+	unsigned long nEventIterations_; ///< Iterations of the event search loop since the last reset of the statistics.
+
 	bool is_copy_;                  ///< Is this just a copy of another instance of Integrator? -> See destructor.
 };
 
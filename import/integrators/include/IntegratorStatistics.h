@@ -0,0 +1,46 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+#ifndef _FMIPP_INTEGRATORSTATISTICS_H
+#define _FMIPP_INTEGRATORSTATISTICS_H
+
+/**
+ * \file IntegratorStatistics.h
+ * Statistics about the work done by an integrator.
+ *
+ * \struct IntegratorStatistics IntegratorStatistics.h
+ * Statistics about the work done by an integrator.
+ *
+ * The counters accumulate from the creation of the stepper ( see Integrator::setType and
+ * Integrator::setProperties ) or from the last call to Integrator::resetStatistics. They are
+ * meant for tuning tolerances and choosing steppers.
+ *
+ * \note The steppers ODEINT provides with dense output ( dp, bs ) repeat rejected steps
+ *       internally, hence their rejected steps are not counted.
+ */
+struct IntegratorStatistics
+{
+	unsigned long nRhsEvaluations;       ///< evaluations of the right-hand side ( including the ones
+	                                     ///  for numerical Jacobians )
+	unsigned long nJacobianEvaluations;  ///< evaluations of the Jacobian
+	unsigned long nFactorizations;       ///< LU factorizations of iteration matrices
+	unsigned long nAcceptedSteps;        ///< accepted steps ( requantizations for QSS steppers )
+	unsigned long nRejectedSteps;        ///< steps rejected by the step size control or because the
+	                                     ///  Newton iterations did not converge
+	unsigned long nEventIterations;      ///< iterations of the event search loop of the Integrator
+	double        lastStepSize;          ///< size of the last accepted step
+
+	IntegratorStatistics() :
+		nRhsEvaluations( 0 ),
+		nJacobianEvaluations( 0 ),
+		nFactorizations( 0 ),
+		nAcceptedSteps( 0 ),
+		nRejectedSteps( 0 ),
+		nEventIterations( 0 ),
+		lastStepSize( 0 ){}
+};
+
+
+#endif // _FMIPP_INTEGRATORSTATISTICS_H
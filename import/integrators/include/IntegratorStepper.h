@@ -28,6 +28,14 @@
  * | fe      | Fehlberg                         | ODEINT   | 8     | Yes      | Nonstiff, smooth Models        |
  * | bs      | BulirschStoer                    | ODEINT   | 1-16  | Yes      | High precision required        |
  * | ro      | Rosenbrock                       | ODEINT   | 4     | Yes      | Stiff Models                   |
+ * | rol     | RosenbrockLU                     | FMI++    | 4     | Yes      | Large stiff Models             |
+ * | lie     | LinearlyImplicitEuler            | FMI++    | 1     | No       | Stiff Models, low accuracy     |
+ * | rad     | RadauIIA                         | FMI++    | 5     | Yes      | Stiff Models, high accuracy    |
+ * | esd2    | ESDIRK (TR-BDF2)                 | FMI++    | 2     | Yes      | Stiff Models, low accuracy     |
+ * | esd3    | ESDIRK                           | FMI++    | 3     | Yes      | Stiff Models                   |
+ * | mr      | Multirate                        | FMI++    | 2     | Yes      | Models with fast/slow states   |
+ * | qss     | QSS (QSS2)                       | FMI++    | 2     | Yes      | Sparse, discontinuous Models   |
+ * | liqss   | QSS (LIQSS2)                     | FMI++    | 2     | Yes      | Sparse, discontinuous, stiff   |
  * | bdf     | BackwardsDifferentiationFormula  | SUNDIALS | 1-5   | Yes      | Stiff Models                   |
  * | abm2    | AdamsBashforthMoulton2           | SUNDIALS | 1-12  | Yes      | Nonstiff Models, expensive rhs |
  *
@@ -43,10 +51,17 @@ class IntegratorStepper
 
 protected:
 	DynamicalSystem* const fmu_;     ///< pointer to the FMU
+	Integrator::Statistics statistics_; ///< statistics, to be filled by the derived classes
 
 	/// Costructor
 	IntegratorStepper( DynamicalSystem* fmu ) : fmu_( fmu ){};
 
+	/// Count an accepted step of size h.
+	void stepAccepted( fmiTime h ){
+		++statistics_.nAcceptedSteps;
+		statistics_.lastStepSize = h;
+	}
+
 public:
 
 	/// Destructor
@@ -91,11 +106,28 @@ public:
 	/**
 	 * Reset the stepper since the states changed externally
 	 *
-	 * Currently the steppers are reset before every call to invokeMethod. Yet, it would
-	 * be adviseable to make less reset calls for the sake of performance.
+	 * The Integrator resets the stepper before every call to invokeMethod, unless the integration
+	 * continues at the time and states where the previous call stopped (see Integrator::integrate).
+	 * Otherwise, the stepper may keep its step size control and history.
 	 */
 	virtual void reset(){};
 
+	/// Get the step size proposed by the step size control for the next step, which is used as
+	/// initial step size if the integration continues. 0 if the step size is not adapted.
+	virtual fmiTime getProposedStepSize() const { return 0; }
+
+	/// Say whether the stepper keeps a history of previous steps ( multistep methods ). The history
+	/// is only kept if the right-hand side did not change since the previous call ( e.g., due to
+	/// new inputs ).
+	virtual bool keepsHistory() const { return false; }
+
+	/// Get the statistics of the stepper ( without the event iterations, which are counted
+	/// by the Integrator ).
+	virtual Integrator::Statistics getStatistics() const { return statistics_; }
+
+	/// Reset all counters of the statistics to zero.
+	virtual void resetStatistics() { statistics_ = Integrator::Statistics(); }
+
 	/**
 	 * Factory: creates a new integrator stepper.
 	 *
@@ -22,6 +22,14 @@ enum IntegratorType {
 	fe,	///< 8th order Runge-Kutta-Fehlberg method with controlled step size.
 	bs,	///< Bulirsch-Stoer method with controlled step size.
 	ro,     ///< 4th Rosenbrock Method for stiff problems.
+	rol,    ///< 4th order Rosenbrock method for large stiff problems (optimized dense LU).
+	lie,    ///< Linearly implicit Euler method with constant step size for stiff problems.
+	rad,    ///< 5th order Radau IIA method with controlled step size for stiff problems.
+	esd2,   ///< 2nd order ESDIRK method (TR-BDF2) with controlled step size for stiff problems.
+	esd3,   ///< 3rd order ESDIRK method with controlled step size for stiff problems.
+	mr,     ///< 2nd order multirate Rosenbrock method, sub-cycles the fast states of multiscale problems.
+	qss,    ///< 2nd order quantized state system method (QSS2) for models with many discontinuities.
+	liqss,  ///< 2nd order linearly implicit quantized state system method (LIQSS2) for stiff models with many discontinuities.
 #ifdef USE_SUNDIALS
 	bdf,	///< Backwards Differentiation formula from Sundials. This stepper has adaptive step size,
 		///  error control and an internal algorithm for the event search loop. The order varies
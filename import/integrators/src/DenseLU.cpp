@@ -0,0 +1,151 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+/// \file DenseLU.cpp
+
+#include <algorithm>
+#include <cmath>
+
+#include "import/integrators/include/DenseLU.h"
+
+
+namespace {
+
+	// Number of columns per panel.
+	const std::size_t panelSize = 32;
+
+	// Number of columns of the trailing matrix updated at once (keeps the block row of U in cache).
+	const std::size_t tileSize = 256;
+}
+
+
+DenseLU::DenseLU( std::size_t n ) :
+	n_( 0 ),
+	factorized_( false )
+{
+	resize( n );
+}
+
+
+void
+DenseLU::resize( std::size_t n )
+{
+	n_ = n;
+	a_.assign( n*n + 1, 0. ); // One extra element, so that data() is valid for n = 0.
+	pivots_.assign( n, 0 );
+	factorized_ = false;
+}
+
+
+bool
+DenseLU::factorize()
+{
+	const std::size_t n = n_;
+	fmiReal* a = &a_[0];
+
+	factorized_ = false;
+
+	for ( std::size_t k0 = 0; k0 < n; k0 += panelSize )
+	{
+		const std::size_t k1 = std::min( k0 + panelSize, n );
+
+		if ( false == factorizePanel( k0, k1 ) ) return false;
+
+		// Block row of U: solve L11 U12 = A12 (L11 is unit lower triangular).
+		for ( std::size_t k = k0; k < k1; ++k ) {
+			const fmiReal* rowK = a + n*k;
+			for ( std::size_t i = k + 1; i < k1; ++i ) {
+				fmiReal* rowI = a + n*i;
+				const fmiReal l = rowI[k];
+				if ( 0. == l ) continue;
+				for ( std::size_t j = k1; j < n; ++j ) rowI[j] -= l*rowK[j];
+			}
+		}
+
+		// Trailing matrix: A22 -= L21 U12.
+		for ( std::size_t j0 = k1; j0 < n; j0 += tileSize )
+		{
+			const std::size_t j1 = std::min( j0 + tileSize, n );
+
+			for ( std::size_t i = k1; i < n; ++i ) {
+				fmiReal* rowI = a + n*i;
+				for ( std::size_t k = k0; k < k1; ++k ) {
+					const fmiReal l = rowI[k];
+					if ( 0. == l ) continue;
+					const fmiReal* rowK = a + n*k;
+					for ( std::size_t j = j0; j < j1; ++j ) rowI[j] -= l*rowK[j];
+				}
+			}
+		}
+	}
+
+	factorized_ = true;
+	return true;
+}
+
+
+void
+DenseLU::solve( fmiReal* b ) const
+{
+	const std::size_t n = n_;
+	const fmiReal* a = &a_[0];
+
+	// Apply the row interchanges.
+	for ( std::size_t k = 0; k < n; ++k )
+		if ( pivots_[k] != k ) std::swap( b[k], b[pivots_[k]] );
+
+	// Forward substitution with L (unit diagonal).
+	for ( std::size_t i = 1; i < n; ++i ) {
+		const fmiReal* rowI = a + n*i;
+		fmiReal sum = b[i];
+		for ( std::size_t j = 0; j < i; ++j ) sum -= rowI[j]*b[j];
+		b[i] = sum;
+	}
+
+	// Backward substitution with U.
+	for ( std::size_t i = n; i-- > 0; ) {
+		const fmiReal* rowI = a + n*i;
+		fmiReal sum = b[i];
+		for ( std::size_t j = i + 1; j < n; ++j ) sum -= rowI[j]*b[j];
+		b[i] = sum/rowI[i];
+	}
+}
+
+
+bool
+DenseLU::factorizePanel( std::size_t k0, std::size_t k1 )
+{
+	const std::size_t n = n_;
+	fmiReal* a = &a_[0];
+
+	for ( std::size_t k = k0; k < k1; ++k )
+	{
+		// Find the pivot in column k.
+		std::size_t p = k;
+		fmiReal pivot = std::fabs( a[n*k + k] );
+		for ( std::size_t i = k + 1; i < n; ++i ) {
+			const fmiReal value = std::fabs( a[n*i + k] );
+			if ( value > pivot ) { pivot = value; p = i; }
+		}
+
+		if ( 0. == pivot ) return false;
+
+		// Interchange complete rows (contiguous in row-major storage).
+		pivots_[k] = p;
+		if ( p != k ) std::swap_ranges( a + n*k, a + n*( k + 1 ), a + n*p );
+
+		// Compute the multipliers and update the remaining columns of the panel.
+		const fmiReal* rowK = a + n*k;
+		const fmiReal inverse = 1./rowK[k];
+		for ( std::size_t i = k + 1; i < n; ++i ) {
+			fmiReal* rowI = a + n*i;
+			const fmiReal l = ( rowI[k] *= inverse );
+			if ( 0. == l ) continue;
+			for ( std::size_t j = k + 1; j < k1; ++j ) rowI[j] -= l*rowK[j];
+		}
+	}
+
+	return true;
+}
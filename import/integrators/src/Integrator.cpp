@@ -27,6 +27,8 @@ using namespace std;
 Integrator::Integrator( DynamicalSystem* fmu ) :
 	fmu_( fmu ),
 	stepper_( 0 ),
+	tEnd_( std::numeric_limits<fmiTime>::quiet_NaN() ),
+	nEventIterations_( 0 ),
 	is_copy_( false )
 {}
 
@@ -36,6 +38,11 @@ Integrator::Integrator( const Integrator& other ) :
 	stepper_( other.stepper_ ),
 	states_( other.states_ ),
 	time_( other.time_ ),
+	tEnd_( other.tEnd_ ),
+	statesEnd_( other.statesEnd_ ),
+	derivativesEnd_( other.derivativesEnd_ ),
+	derivatives_( other.derivatives_ ),
+	nEventIterations_( other.nEventIterations_ ),
 	is_copy_( true )
 {}
 
@@ -63,6 +70,10 @@ Integrator* Integrator::clone() const
 void Integrator::initialize(){
 	states_      = state_type( fmu_->nStates(), std::numeric_limits<fmiReal>::quiet_NaN() );
 	time_        = std::numeric_limits<fmiReal>::quiet_NaN();
+	tEnd_        = std::numeric_limits<fmiReal>::quiet_NaN();
+	statesEnd_.assign( fmu_->nStates(), 0 );
+	derivativesEnd_.assign( fmu_->nStates(), 0 );
+	derivatives_.assign( fmu_->nStates(), 0 );
 }
 
 
@@ -72,6 +83,8 @@ void Integrator::setType( IntegratorType type )
 		delete stepper_;
 	properties_.type  = type;
 	stepper_ = IntegratorStepper::createStepper( properties_, fmu_ );
+	tEnd_ = std::numeric_limits<fmiTime>::quiet_NaN();
+	nEventIterations_ = 0;
 }
 
 
@@ -81,6 +94,8 @@ void Integrator::setProperties( Integrator::Properties& properties )
 		delete stepper_;
 	stepper_ = IntegratorStepper::createStepper( properties, fmu_ );
 	properties_ = properties;
+	tEnd_ = std::numeric_limits<fmiTime>::quiet_NaN();
+	nEventIterations_ = 0;
 }
 
 Integrator::Properties Integrator::getProperties() const
@@ -89,6 +104,21 @@ Integrator::Properties Integrator::getProperties() const
 }
 
 
+Integrator::Statistics Integrator::getStatistics() const
+{
+	Statistics statistics = stepper_->getStatistics();
+	statistics.nEventIterations = nEventIterations_;
+	return statistics;
+}
+
+
+void Integrator::resetStatistics()
+{
+	stepper_->resetStatistics();
+	nEventIterations_ = 0;
+}
+
+
 Integrator::EventInfo Integrator::integrate( fmiTime step_size, fmiTime dt, fmiTime eventSearchPrecision )
 {
 	// Get current time.
@@ -97,11 +127,30 @@ Integrator::EventInfo Integrator::integrate( fmiTime step_size, fmiTime dt, fmiT
 	// Get current continuous states.
 	fmu_->getContinuousStates( &states_.front() );
 
+	// Keep the step size control and the history of the stepper if the integration continues
+	// where the last call stopped. Otherwise, the states have been changed externally or an
+	// event has been handled in between.
+	if ( continues() ){
+		fmiTime proposed = stepper_->getProposedStepSize();
+		if ( proposed > 0 )
+			dt = proposed;
+	} else{
+		stepper_->reset();
+	}
+	tEnd_ = std::numeric_limits<fmiTime>::quiet_NaN();
+
 	// Invoke integration method.
 	stepper_->invokeMethod( eventInfo_, states_, time_, step_size, dt, eventSearchPrecision );
 
 	// if no event happened, return
 	if ( !eventInfo_.stateEvent ){
+		if ( !eventInfo_.stepEvent ){
+			// remember where the integration stopped
+			tEnd_ = fmu_->getTime();
+			fmu_->getContinuousStates( &statesEnd_.front() );
+			if ( stepper_->keepsHistory() )
+				fmu_->getDerivatives( &derivativesEnd_.front() );
+		}
 		return eventInfo_;
 	} // else, use a binary search to locate the event upt to the eventSearchPrecision_
 	else{
@@ -129,6 +178,8 @@ Integrator::EventInfo Integrator::integrate( fmiTime step_size, fmiTime dt, fmiT
 			eventInfo_.tUpper = time_ + step_size;
 		}
 		while ( eventInfo_.tUpper - eventInfo_.tLower > eventSearchPrecision/2.0 ){
+			++nEventIterations_;
+
 			// create backup states
 			state_type states_bak = states_;
 
@@ -168,6 +219,22 @@ Integrator::EventInfo Integrator::integrate( fmiTime step_size, fmiTime dt, fmiT
 }
 
 
+bool Integrator::continues()
+{
+	// time and states must not have been changed since the last call ( tEnd_ is NaN after events )
+	if ( !( time_ == tEnd_ ) || ( states_ != statesEnd_ ) )
+		return false;
+
+	// the history of multistep methods requires an unchanged right-hand side
+	if ( stepper_->keepsHistory() ){
+		fmu_->getDerivatives( &derivatives_.front() );
+		return derivatives_ == derivativesEnd_;
+	}
+
+	return true;
+}
+
+
 // get time horizon for the event
 void Integrator::getEventHorizon( fmiTime& tLower, fmiTime& tUpper ){
 	tLower = eventInfo_.tLower;
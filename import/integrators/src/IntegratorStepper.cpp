@@ -27,6 +27,7 @@
 #include "import/base/include/FMUModelExchangeBase.h"
 #include "import/base/include/DynamicalSystem.h"
 #include "import/integrators/include/IntegratorStepper.h"
+#include "import/integrators/include/DenseLU.h"
 
 #include <boost/numeric/odeint/stepper/controlled_step_result.hpp>
 
@@ -38,8 +39,10 @@ IntegratorStepper::~IntegratorStepper() {}
     [system concept](http://www.boost.org/doc/libs/1_55_0/libs/numeric/odeint/doc/html/boost_numeric_odeint/concepts/system.html) */
 struct system_wrapper{
 	DynamicalSystem* ds_;
-	system_wrapper( DynamicalSystem* ds ) : ds_( ds ){}
+	unsigned long* nCalls_;   ///< counter for the evaluations ( see IntegratorStatistics ), optional
+	system_wrapper( DynamicalSystem* ds, unsigned long* nCalls = 0 ) : ds_( ds ), nCalls_( nCalls ){}
 	void operator()( const state_type& x, state_type& dx, fmiTime t ){
+		if ( nCalls_ ) ++*nCalls_;
 		ds_->setTime( t );
 		ds_->setContinuousStates( &x[0] );
 		ds_->getDerivatives( &dx[0] );
@@ -61,10 +64,13 @@ class OdeintStepper : public IntegratorStepper
 protected:
 	/// wrapped version of the DynamicalSystem
 	system_wrapper sys_;
+	/// step size for the next step, before it is shortened to hit the end of the integration
+	fmiTime dtNext_;
 public:
 	/// Constructor
 	OdeintStepper( int ord, DynamicalSystem* fmu ) : IntegratorStepper( fmu ),
-							 sys_( fmu ){}
+							 sys_( fmu, &statistics_.nRhsEvaluations ),
+							 dtNext_( 0 ){}
 	/// Make a (possibly adaptive) step and try the step size dt for the first attempt.
 	virtual void do_step( EventInfo& eventInfo, state_type& states,
 			      fmiTime& currentTime, fmiTime& dt ) = 0;
@@ -91,20 +97,22 @@ public:
 			time_bak_   = currentTime;
 			states_bak_ = states;
 
-			if ( currentTime + dt >= time + step_size ){
-				// perform the last step
+			// do not leave a remainder of the size of round-off errors for another step
+			if ( currentTime + dt*( 1.0 + 1.0e-10 ) >= time + step_size ){
+				// perform the last step with forced stepsize, keep the proposed one
+				dtNext_ = dt;
 				dt = time + step_size - currentTime;
-
-				// force stepsize
 				do_step_const( eventInfo, states, currentTime, dt );
-				reset();
 
 				// exit the while loop next time
 				stop = true;
 			} else{
 				//do_step
 				do_step( eventInfo, states, currentTime, dt );
+				dtNext_ = dt;
 			}
+			stepAccepted( currentTime - time_bak_ );
+
 			// update the state and time
 			fmu_->setTime( currentTime );
 			fmu_->setContinuousStates( &states[0] );
@@ -231,9 +239,12 @@ public:
 		      fmiTime& currentTime, fmiTime& dt ){
 		do {
 			res_ = stepper.try_step( sys_, states, currentTime, dt );
+			if ( res_ == fail ) ++statistics_.nRejectedSteps;
 		}
 		while ( res_ == fail );
 	}
+
+	fmiTime getProposedStepSize() const { return dtNext_; }
 };
 
 
@@ -253,7 +264,7 @@ class DormandPrince : public IntegratorStepper
 public:
 	DormandPrince( DynamicalSystem* fmu, Integrator::Properties& properties ) :
 		IntegratorStepper( fmu ),
-		sys_( fmu )
+		sys_( fmu, &statistics_.nRhsEvaluations )
 	{
 		properties.name  = "Dormand Prince";
 		properties.order = 5;
@@ -279,6 +290,7 @@ public:
 		while ( true ){
 			// perform a step
 			stepper.do_step( sys_ );
+			stepAccepted( stepper.current_time() - stepper.previous_time() );
 
 			// event detection like in OdeintStepper
 			fmu_->setTime( stepper.current_time() );
@@ -335,6 +347,8 @@ public:
 	void reset(){
 		/// \todo Test if this is really OK. Semms like initialize makes reset unnecessary.
 	}
+
+	fmiTime getProposedStepSize() const { return stepper.current_time_step(); }
 };
 
 
@@ -378,9 +392,12 @@ public:
 		      fmiTime& currentTime, fmiTime& dt ){
 		do {
 			res_ = stepper.try_step( sys_, states, currentTime, dt );
+			if ( res_ == fail ) ++statistics_.nRejectedSteps;
 		}
 		while ( res_ == fail );
 	}
+
+	fmiTime getProposedStepSize() const { return dtNext_; }
 };
 
 
@@ -406,7 +423,7 @@ public:
 			properties.reltol != properties.reltol ?
 			1.0e-6 : properties.reltol
 			),
-		sys_( fmu )
+		sys_( fmu, &statistics_.nRhsEvaluations )
 	{
 		properties.name  = "Bulirsch Stoer";
 		properties.order = 0;
@@ -430,6 +447,7 @@ public:
 		while ( true ){
 			// perform a step
 			stepper.do_step( sys_ );
+			stepAccepted( stepper.current_time() - stepper.previous_time() );
 
 			// event detection like in OdeintStepper
 			fmu_->setTime( stepper.current_time() );
@@ -482,6 +500,9 @@ public:
 	void reset(){
 		stepper.reset();
 	}
+
+	/// \note The step size is not kept if the integration continues, since the error of the
+	///       dense output is not controlled and grows with the step size.
 };
 
 
@@ -510,7 +531,8 @@ public:
 
 	void do_step( EventInfo& eventInfo, state_type& states,
 		      fmiTime& currentTime, fmiTime& dt ){
-		if ( dt != dt_ ){
+		// the history is only valid for the same step size ( up to round-off errors )
+		if ( std::fabs( dt - dt_ ) > 1.0e-10*dt_ ){
 			reset();
 			dt_ = dt;
 		}
@@ -520,6 +542,8 @@ public:
 	void reset(){
 		stepper = adams_bashforth_moulton< 5, state_type>();
 	}
+
+	bool keepsHistory() const { return true; }
 };
 
 
@@ -540,10 +564,14 @@ class Rosenbrock : public IntegratorStepper
 	/// Different system wrapper using the ublas vectors as state_type
 	struct system_wrapper_vector{
 		DynamicalSystem* ds_;
-		system_wrapper_vector( DynamicalSystem* ds ) : ds_( ds ){}
+		Integrator::Statistics* statistics_;
+		system_wrapper_vector( DynamicalSystem* ds, Integrator::Statistics* statistics ) :
+			ds_( ds ), statistics_( statistics ){}
 		/// rhs function
 		void operator()( const vector_type& x , vector_type &dx , fmiTime t ) const
 		{
+			++statistics_->nRhsEvaluations;
+
 			// call the rhs function from the ds_
 			ds_->setTime( t );
 			ds_->setContinuousStates( &x[0] );
@@ -554,11 +582,19 @@ class Rosenbrock : public IntegratorStepper
 	/// Wrapper around the Jacobian function.
 	struct jacobi_wrapper{
 		DynamicalSystem* ds_;
-		jacobi_wrapper( DynamicalSystem* ds ) : ds_( ds ){}
+		Integrator::Statistics* statistics_;
+		jacobi_wrapper( DynamicalSystem* ds, Integrator::Statistics* statistics ) :
+			ds_( ds ), statistics_( statistics ){}
 		/// jacobi function
 		void operator()( const vector_type &x , matrix_type &jacobi , const fmiTime &t ,
 				 vector_type &dfdt ) const
 		{
+			// the stepper factorizes a new matrix for every Jacobian
+			++statistics_->nJacobianEvaluations;
+			++statistics_->nFactorizations;
+			if ( !ds_->providesJacobian() )
+				statistics_->nRhsEvaluations += 6*( x.size() + 1 );
+
 			if ( ds_->providesJacobian() ){
 				ds_->setTime( t );
 				ds_->setContinuousStates( &x[0] );
@@ -601,8 +637,8 @@ class Rosenbrock : public IntegratorStepper
 public:
 	Rosenbrock( DynamicalSystem* ds, Integrator::Properties& properties ):
 		IntegratorStepper( ds ),
-		sys_( ds ),
-		jac_( ds ),
+		sys_( ds, &statistics_ ),
+		jac_( ds, &statistics_ ),
 		neq( ds->nStates() ),
 		statesV_( neq ),
 		stepper( make_dense_output( properties.abstol != properties.abstol ?
@@ -634,6 +670,7 @@ public:
 		while ( true ){
 			// perform a step
 			stepper.do_step( std::make_pair( sys_, jac_ ) );
+			stepAccepted( stepper.current_time() - stepper.previous_time() );
 
 			// event detection like in OdeintStepper
 			fmu_->setTime( stepper.current_time() );
@@ -687,244 +724,2267 @@ public:
 	void reset(){
 		//stepper.reset();
 	}
+
+	Integrator::Statistics getStatistics() const {
+		// every attempted step evaluates the Jacobian once
+		Integrator::Statistics statistics = statistics_;
+		statistics.nRejectedSteps = statistics_.nJacobianEvaluations - statistics_.nAcceptedSteps;
+		return statistics;
+	}
+
+	fmiTime getProposedStepSize() const { return stepper.current_time_step(); }
 };
 
 
-#ifdef USE_SUNDIALS
 /**
- * Base class for all implementations of sundials steppers
+ * Jacobian of the right-hand side, for linearly implicit and implicit steppers.
  *
- * \todo use CV_ONE_STEP instead of CV_NORMAL to add more proper step event handling
+ * The Jacobian is stored as provided by the FMU (column-wise from getJac, row-wise from
+ * getNumericalJacobian). Matrices of the form a*I - J, which have to be factorized by these
+ * steppers, are assembled directly from it in the row-major buffer of a DenseLU. There are no
+ * conversions to other vector or matrix types.
  */
-class SundialsStepper : public IntegratorStepper
+class DenseJacobian
 {
+	DynamicalSystem* fmu_;
+	Integrator::Statistics* statistics_;
+	system_wrapper sys_;
+	std::vector<fmiReal> jac_;   ///< Jacobian, column-wise if columnwise_ is true, row-wise otherwise
+	bool columnwise_;            ///< storage order of the Jacobian
+	bool valid_;                 ///< has the Jacobian been evaluated (and not invalidated since)?
+	state_type tmp_;             ///< temporary storage
 
-private:
-	/**
-	 * the righthandside of the ode
-	 *
-	 * @param[in]		t		time
-	 * @param[in]		x		state
-	 * @param[out]		dx		the derivatives at ( x, t )
-	 * @param[in,out]	user_data	the fmu to be evaluated. The states of the fmu
-	 *					are ( x, t ) after the call
-	 */
-	static int f( fmiTime t, N_Vector x, N_Vector dx, void *user_data )
-        {
-		DynamicalSystem* fmu = (DynamicalSystem*) user_data;
-		fmu->setTime( t );
-		fmu->setContinuousStates( N_VGetArrayPointer(x) );
-		fmu->getDerivatives( N_VGetArrayPointer(dx) );
-		return 0 ;
-		// \FIXME: return 1 in case one of rhe calls fmu->setContinuousStates, fmu->setTime
-		//         or fmu->getDerivatives was *not* sucessful
-
+	/// Write row i of a*I - J to row.
+	void assembleRow( fmiReal* row, std::size_t i, fmiReal a ) const
+	{
+		if ( columnwise_ ){
+			for ( std::size_t j = 0; j < neq_; j++ ) row[j] = -jac_[neq_*j + i];
+		} else {
+			const fmiReal* jacRow = &jac_[neq_*i];
+			for ( std::size_t j = 0; j < neq_; j++ ) row[j] = -jacRow[j];
+		}
+		row[i] += a;
 	}
 
-	/**
-	 * the event indicator function
-	 *
-	 * @param[in]		t		time
-	 * @param[in]		x		state
-	 * @param[out]		eventsind	the event indicators at ( x, t )
-	 * @param[in,out]	user_data	the fmu to be evaluated. The states of the fmu
-	 *					are ( x, t ) after the call
-	 */
-	static int g( fmiTime t, N_Vector x, fmiReal *eventsind, void *user_data )
+public:
+	const std::size_t neq_;      ///< dimension of the state space
+	state_type dxdt_;            ///< derivatives at the state/time the Jacobian has been evaluated at
+	state_type dfdt_;            ///< partial derivatives of the rhs with respect to time
+
+	DenseJacobian( DynamicalSystem* fmu, Integrator::Statistics* statistics ) :
+		fmu_( fmu ),
+		statistics_( statistics ),
+		sys_( fmu, &statistics->nRhsEvaluations ),
+		jac_( fmu->nStates()*fmu->nStates() + 1 ),
+		columnwise_( false ),
+		valid_( false ),
+		tmp_( fmu->nStates() ),
+		neq_( fmu->nStates() ),
+		dxdt_( fmu->nStates() ),
+		dfdt_( fmu->nStates() ){}
+
+	/// Check whether the Jacobian has been evaluated (and not invalidated since).
+	bool valid() const { return valid_; }
+
+	/// Mark the Jacobian as invalid (e.g., after the states have been changed externally).
+	void invalidate() { valid_ = false; }
+
+	/// Get the element ( i, j ) of the Jacobian, i.e., the partial derivative of f_i with respect to x_j.
+	fmiReal operator()( std::size_t i, std::size_t j ) const
 	{
-		DynamicalSystem* fmu = (DynamicalSystem*) user_data;
-		fmu->setTime( t );
-		fmu->setContinuousStates( N_VGetArrayPointer( x ) );
-		return fmu->getEventIndicators( eventsind );
-		// \FIXME: return 1 in case one of rhe calls fmu->setContinuousStates, fmu->setTime
-		//         was *not* sucessful
+		return columnwise_ ? jac_[neq_*j + i] : jac_[neq_*i + j];
 	}
 
-	/**
-	 * Jacobian matrix
-	 * like for the rhs, states have to be converted. This function will not be used in case
-	 * the fmu is of type 1.0 or the modeldescription does not explicitly say that the Jacobian
-	 * is available
-	 *
-	 * @param[in]      N                    the dimension of the state space ( equal to NEQ_ )
-	 * @param[in]      t,x                  time and state
-	 * @param[in]      fx                   current derivative
-	 * @param[out]     J                    the dense jacobian martix
-	 * @param[in]      user_data            the dynamical system
-	 * @param[in,out]  tmp1,tmp2,tmp3       variables used internally by CVode
-	 *
-	 */
-	static int Jac( long int N, fmiTime t, N_Vector x, N_Vector fx,
-			DlsMat J, void *user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3 )
+	/// Evaluate the derivatives and the Jacobian at ( x, t ). The partial derivatives with
+	/// respect to time are only computed if timeDerivatives is true.
+	void evaluate( const state_type& x, fmiTime t, bool timeDerivatives = true )
 	{
-		DynamicalSystem* ds = (DynamicalSystem*) user_data;
+		++statistics_->nJacobianEvaluations;
+		sys_( x, dxdt_, t );
 
-		// send the input state/time to the FMU
-		ds->setTime( t );
-		ds->setContinuousStates( N_VGetArrayPointer( x ) );
-		// get the jacobian
-		fmiStatus status = ds->getJac( J->data );
-		// tell SUNDIALs whether the call to getJac was successful
-		if ( status == fmiOK )
-			return 0;
-		else
-			return 1;
+		fmiStatus status = fmiWarning;
+		if ( fmu_->providesJacobian() )
+			status = fmu_->getJac( &jac_[0] );
+
+		if ( fmiOK == status ){
+			columnwise_ = true;
+
+			if ( timeDerivatives ){
+				// forward difference for the partial derivatives with respect to time
+				const fmiTime delta = 1.0e-8*std::max( 1.0, std::fabs( t ) );
+				sys_( x, tmp_, t + delta );
+				for ( std::size_t i = 0; i < neq_; i++ )
+					dfdt_[i] = ( tmp_[i] - dxdt_[i] )/delta;
+			}
+		} else {
+			columnwise_ = false;
+			tmp_ = x; // getNumericalJacobian perturbs its input temporarily
+			fmu_->getNumericalJacobian( &jac_[0], &tmp_[0], &dfdt_[0], t );
+
+			// central differences of 6th order for all states and the time
+			statistics_->nRhsEvaluations += 6*( neq_ + 1 );
+		}
+
+		valid_ = true;
 	}
-  
-	const int NEQ_;				///< dimension of state space
-	const int NEV_;				///< number of event indicators
-	N_Vector states_N_;			///< states in N_Vector format
-	fmiTime t_;				///< internal time
-	const realtype reltol_;			///< relative tolerance
-	const realtype abstol_;			///< absolute tolerance
-	void *cvode_mem_;			///< memory of the stepper. This memory later stores
-						///< the RHS, states, time and buffer datas for the
-						///< multistep methods
 
-  
-public:
-	/**
-	 * Constructor
-	 *
-	 * @param[in] fmu	 the fmu to be integrated
-	 * @param[in] isBDF	 bool saying wether the bdf or the abm version is required
-	 */
-	SundialsStepper( DynamicalSystem* fmu, bool isBDF, Integrator::Properties& properties ) :
-		IntegratorStepper( fmu ),
-		NEQ_( fmu->nStates() ),
-		NEV_( fmu->nEventInds() ),
-		states_N_( N_VNew_Serial( NEQ_ ) ),
-		reltol_( properties.reltol != properties.reltol ? 1e-10 : properties.reltol ),
-		abstol_( properties.abstol != properties.abstol ? 1e-10 : properties.abstol ),
-		cvode_mem_( 0 )
+	/// Assemble a*I - J in the buffer of lu (of size n).
+	void assemble( DenseLU& lu, fmiReal a ) const
 	{
-		// add missing tolerances if necessary
-		if ( properties.abstol != properties.abstol )
-			properties.abstol = 1.0e-10;
-		if ( properties.reltol != properties.reltol )
-			properties.reltol = 1.0e-10;
-
-		// choose solution procedure
-		if ( isBDF )
-			cvode_mem_ = CVodeCreate( CV_BDF, CV_NEWTON );
-		else
-			cvode_mem_ = CVodeCreate( CV_ADAMS, CV_FUNCTIONAL );
-		
-		// other possible options are not available even tough they perform well
-		//   *  cvode_mem_ = CVodeCreate( CV_ADAMS, CV_NEWTON );
-		//   *  cvode_mem_ = CVodeCreate( CV_BDF, CV_FUNCTIONAL );
+		for ( std::size_t i = 0; i < neq_; i++ )
+			assembleRow( &lu( i, 0 ), i, a );
+		lu.invalidate();
+	}
 
-		// set the fmu as (void*) user_data
-		CVodeSetUserData( cvode_mem_, fmu_ );
+	/// Assemble the real form [ a*I - J, -b*I; b*I, a*I - J ] of the complex matrix
+	/// ( a + ib )*I - J in the buffer of lu (of size 2n).
+	void assembleComplex( DenseLU& lu, fmiReal a, fmiReal b ) const
+	{
+		const std::size_t n = neq_;
+		for ( std::size_t i = 0; i < n; i++ ){
+			fmiReal* upper = &lu( i, 0 );
+			fmiReal* lower = &lu( n + i, 0 );
+			std::fill( upper + n, upper + 2*n, 0.0 );
+			std::fill( lower, lower + n, 0.0 );
+			assembleRow( upper, i, a );
+			assembleRow( lower + n, i, a );
+			upper[n + i] = -b;
+			lower[i] = b;
+		}
+		lu.invalidate();
+	}
+};
 
-		// set initial conditions and RHS
-		CVodeInit( cvode_mem_, f, t_, states_N_ );
 
-		// pass the event indicators as root function
-		CVodeRootInit( cvode_mem_, NEV_, g );
+/**
+ * Base class for linearly implicit steppers working on contiguous buffers.
+ *
+ * Linearly implicit methods solve linear systems with the matrix W = I/h - J in every step, where
+ * J is the Jacobian of the right-hand side and h is a multiple of the step size. W is assembled
+ * directly from the Jacobian (see DenseJacobian) and factorized with DenseLU.
+ *
+ * The factorization is reused as long as neither the Jacobian nor h have changed.
+ */
+class LinearlyImplicitStepper : public OdeintStepper
+{
+	fmiReal factorizedFor_;      ///< value of h the factorization of W has been computed for
+	DenseLU lu_;                 ///< factorization of W = I/h - J
 
-		// set tolerances
-		CVodeSStolerances( cvode_mem_ ,reltol_ ,abstol_ );
+protected:
+	DenseJacobian jac_;          ///< Jacobian, derivatives and their partial derivatives with respect to time
+	const std::size_t neq_;      ///< dimension of the state space
 
-		// Detrmine which procedure to use for linear equations. Since the jacobean is dense,
-		// CVDense is the choice here.
-		CVDense( cvode_mem_, NEQ_ );
+	LinearlyImplicitStepper( int ord, DynamicalSystem* fmu ) :
+		OdeintStepper( ord, fmu ),
+		factorizedFor_( 0 ),
+		lu_( fmu->nStates() ),
+		jac_( fmu, &statistics_ ),
+		neq_( fmu->nStates() ){}
 
-		// Set the Jacobian routine to Jac if available. Do not use the numeric jacobian for sundials
-		if ( fmu_->providesJacobian() )
-			CVDlsSetDenseJacFn( cvode_mem_, Jac );
+	/// Check whether the Jacobian has been evaluated (and not invalidated since).
+	bool jacobianValid() const { return jac_.valid(); }
 
-		//CVodeSetErrFile( cvode_mem, NULL ); // uncomment to suppress error messages
+	/// Force the evaluation of the Jacobian in the next step.
+	void invalidateJacobian() { jac_.invalidate(); }
 
-		CVodeSetMaxNumSteps( cvode_mem_, static_cast<long>( 1.0e5 ) );
+	/// Evaluate the derivatives, their partial derivatives with respect to time and the Jacobian at ( x, t ).
+	void evaluateJacobian( const state_type& x, fmiTime t )
+	{
+		jac_.evaluate( x, t );
+		lu_.invalidate();
 	}
 
-	~SundialsStepper()
+	/// Assemble and factorize W = I/h - J unless the factorization can be reused.
+	bool factorize( fmiReal h )
 	{
-		N_VDestroy_Serial( states_N_ );
+		if ( lu_.isFactorized() && ( factorizedFor_ == h ) ) return true;
+
+		jac_.assemble( lu_, 1.0/h );
+
+		factorizedFor_ = h;
+		++statistics_.nFactorizations;
+		return lu_.factorize();
 	}
 
+	/// Solve W x = b in place.
+	void solve( state_type& b ) const { lu_.solve( &b[0] ); }
 
-	void invokeMethod( EventInfo& eventInfo, state_type& states,
-			   fmiTime time, fmiTime step_size, fmiTime dt,
-			   fmiTime eventSearchPrecision )
-	{
-		/// \todo add more proper event handling to sundials: currently, time events are
-		///       just checked at the begining of each invokeMethod call.
+public:
 
-		// write input into internal time
-		t_ = time;
-	
-		// Convert states into N_Vector format
-		for ( int i = 0; i < NEQ_; i++ ) {
-			Ith( states_N_ , i ) = states[ i ];
-		}
+	void reset(){
+		// the states might have been changed externally
+		invalidateJacobian();
+	}
+};
+
+
+/**
+ * 4th order Rosenbrock method with controlled step size, for large stiff models.
+ *
+ * Uses the same method (coefficients, embedded error estimate and step size control) as the
+ * Rosenbrock stepper, but works on contiguous buffers with an optimized LU factorization (see
+ * LinearlyImplicitStepper). The Jacobian is evaluated once per step, rejected steps reuse it.
+ */
+class RosenbrockLU : public LinearlyImplicitStepper
+{
+	const rosenbrock4< fmiReal >::rosenbrock_coefficients coef_;
+	const fmiReal abstol_;
+	const fmiReal reltol_;
 
-		// reinitialize cvode. this deletes internal memeory
-		CVodeReInit( cvode_mem_, t_, states_N_ );     /// \todo reset only if states changed externally
+	state_type g1_, g2_, g3_, g4_, g5_;  ///< stages
+	state_type xtmp_, dxdtnew_, xnew_, xerr_;
 
-		// set initial step size
-		CVodeSetInitStep( cvode_mem_, dt );
+	bool    firstStep_;                   ///< step size control: no previous step
+	bool    lastRejected_;                ///< step size control: previous attempt rejected
+	fmiReal errOld_;                      ///< step size control: error of the previous step
+	fmiTime dtOld_;                       ///< step size control: previous step size
 
-		// make iteration
-		int flag = CVode( cvode_mem_, t_ + step_size, states_N_, &t_, CV_NORMAL );
+	/// Make a single step from ( x, t ) to xnew_ with error estimate xerr_. Returns false if W is singular.
+	bool attempt( const state_type& x, fmiTime t, fmiTime dt )
+	{
+		if ( !jacobianValid() )
+			evaluateJacobian( x, t );
+
+		if ( !factorize( coef_.gamma*dt ) )
+			return false;
+
+		for ( std::size_t i = 0; i < neq_; i++ )
+			g1_[i] = jac_.dxdt_[i] + dt*coef_.d1*jac_.dfdt_[i];
+		solve( g1_ );
+
+		for ( std::size_t i = 0; i < neq_; i++ )
+			xtmp_[i] = x[i] + coef_.a21*g1_[i];
+		sys_( xtmp_, dxdtnew_, t + coef_.c2*dt );
+		for ( std::size_t i = 0; i < neq_; i++ )
+			g2_[i] = dxdtnew_[i] + dt*coef_.d2*jac_.dfdt_[i] + coef_.c21*g1_[i]/dt;
+		solve( g2_ );
+
+		for ( std::size_t i = 0; i < neq_; i++ )
+			xtmp_[i] = x[i] + coef_.a31*g1_[i] + coef_.a32*g2_[i];
+		sys_( xtmp_, dxdtnew_, t + coef_.c3*dt );
+		for ( std::size_t i = 0; i < neq_; i++ )
+			g3_[i] = dxdtnew_[i] + dt*coef_.d3*jac_.dfdt_[i] + ( coef_.c31*g1_[i] + coef_.c32*g2_[i] )/dt;
+		solve( g3_ );
+
+		for ( std::size_t i = 0; i < neq_; i++ )
+			xtmp_[i] = x[i] + coef_.a41*g1_[i] + coef_.a42*g2_[i] + coef_.a43*g3_[i];
+		sys_( xtmp_, dxdtnew_, t + coef_.c4*dt );
+		for ( std::size_t i = 0; i < neq_; i++ )
+			g4_[i] = dxdtnew_[i] + dt*coef_.d4*jac_.dfdt_[i]
+				+ ( coef_.c41*g1_[i] + coef_.c42*g2_[i] + coef_.c43*g3_[i] )/dt;
+		solve( g4_ );
+
+		for ( std::size_t i = 0; i < neq_; i++ )
+			xtmp_[i] = x[i] + coef_.a51*g1_[i] + coef_.a52*g2_[i] + coef_.a53*g3_[i] + coef_.a54*g4_[i];
+		sys_( xtmp_, dxdtnew_, t + dt );
+		for ( std::size_t i = 0; i < neq_; i++ )
+			g5_[i] = dxdtnew_[i] + ( coef_.c51*g1_[i] + coef_.c52*g2_[i] + coef_.c53*g3_[i] + coef_.c54*g4_[i] )/dt;
+		solve( g5_ );
+
+		for ( std::size_t i = 0; i < neq_; i++ )
+			xtmp_[i] += g5_[i];
+		sys_( xtmp_, dxdtnew_, t + dt );
+		for ( std::size_t i = 0; i < neq_; i++ )
+			xerr_[i] = dxdtnew_[i] + ( coef_.c61*g1_[i] + coef_.c62*g2_[i] + coef_.c63*g3_[i]
+						   + coef_.c64*g4_[i] + coef_.c65*g5_[i] )/dt;
+		solve( xerr_ );
+
+		for ( std::size_t i = 0; i < neq_; i++ )
+			xnew_[i] = xtmp_[i] + xerr_[i];
+
+		return true;
+	}
 
-		// convert output of cvode in state_type format
-		for ( int i = 0; i < NEQ_; i++ ) {
-			states[i] = Ith( states_N_, i );
+	/// Weighted RMS norm of the error estimate (same as rosenbrock4_controller).
+	fmiReal error( const state_type& x ) const
+	{
+		fmiReal err = 0.0;
+		for ( std::size_t i = 0; i < neq_; i++ ){
+			const fmiReal sk = abstol_ + reltol_*std::max( std::fabs( x[i] ), std::fabs( xnew_[i] ) );
+			err += xerr_[i]*xerr_[i]/sk/sk;
 		}
+		return std::sqrt( err/fmiReal( neq_ ) );
+	}
+
+public:
+	RosenbrockLU( DynamicalSystem* fmu, Integrator::Properties& properties ) :
+		LinearlyImplicitStepper( 4, fmu ),
+		abstol_( properties.abstol != properties.abstol ? 1.0e-6 : properties.abstol ),
+		reltol_( properties.reltol != properties.reltol ? 1.0e-6 : properties.reltol ),
+		g1_( neq_ ), g2_( neq_ ), g3_( neq_ ), g4_( neq_ ), g5_( neq_ ),
+		xtmp_( neq_ ), dxdtnew_( neq_ ), xnew_( neq_ ), xerr_( neq_ ),
+		firstStep_( true ),
+		lastRejected_( false ),
+		errOld_( 0 ),
+		dtOld_( 0 )
+	{
+		properties.name  = "Rosenbrock LU";
+		properties.order = 4;
+
+		// add missing tolerances if necessary
+		if ( properties.abstol != properties.abstol )
+			properties.abstol = 1.0e-6;
+		if ( properties.reltol != properties.reltol )
+			properties.reltol = 1.0e-6;
+	}
 
-		if ( flag == CV_ROOT_RETURN ){
-			eventInfo.stateEvent = true;
-			// an event happened -> make sure to return a state before the event.
-			state_type dx( NEQ_ );
+	void do_step( EventInfo& eventInfo, state_type& states,
+		      fmiTime& currentTime, fmiTime& dt ){
+		static const fmiReal safe = 0.9, fac1 = 5.0, fac2 = 1.0/6.0;
 
-			/*
-			 * rewind the states to make sure the returned state/time is shortly *before* the
-			 * event. The rewinding tends to cause bugs if rewind is smaller than the precision
-			 * of the sundials solvers. This precision is 100 times the precision of doubles (~1e-14)
-			 * according to the official documentation of CVode. However, if the fmu is coded in
-			 * floats it might be necessary to adapt the figure rewind
-			 *
-			 * \todo test with float fmu
-			*/
-			fmiTime rewind = eventSearchPrecision/10.0;
-			if ( rewind <= 1.0e-12 ){
-				std::cout << "WARNING: the specified eventsearchprecision might be too small"
-					  << " for the use with sundials" << std::endl;
+		while ( true ){
+			if ( !attempt( states, currentTime, dt ) ){
+				// W is singular for this step size
+				dt *= 0.5;
+				continue;
 			}
-			fmu_->setTime( t_ );
-			fmu_->setContinuousStates( &states.front() );
-			fmu_->getDerivatives( &dx[0] );
 
-			for ( int i = 0; i < NEQ_; i++ ){
-				states[i] -= rewind*dx[i];
+			const fmiReal err = error( states );
+			fmiReal fac = std::max( fac2, std::min( fac1, std::pow( err, 0.25 )/safe ) );
+
+			if ( err <= 1.0 ){
+				if ( firstStep_ ){
+					firstStep_ = false;
+				} else {
+					fmiReal facPred = ( dtOld_/dt )*std::pow( err*err/errOld_, 0.25 )/safe;
+					facPred = std::max( fac2, std::min( fac1, facPred ) );
+					fac = std::max( fac, facPred );
+				}
+
+				fmiTime dtNew = dt/fac;
+				if ( lastRejected_ )
+					dtNew = std::min( dtNew, dt );
+
+				dtOld_  = dt;
+				errOld_ = std::max( 0.01, err );
+				lastRejected_ = false;
+
+				states = xnew_;
+				currentTime += dt;
+				dt = dtNew;
+
+				// the Jacobian has to be evaluated at the new state
+				invalidateJacobian();
+				return;
 			}
-			t_ -= rewind;
 
-			// wrtite solution into the fmu ( i.e. set back the time/states )
-			fmu_->setTime( t_ );
-			fmu_->setContinuousStates( &states.front() );
-			
-			// tell FMUModelexchange the EventHorizon ( upper and lower limit for the
-			// state-event-time )
-			eventInfo.tUpper = t_+2*rewind;
-			eventInfo.tLower = t_;
+			// reject the step, the Jacobian is reused for the next attempt
+			dt /= std::max( fac, 1.0 );
+			lastRejected_ = true;
+			++statistics_.nRejectedSteps;
+		}
+	}
 
+	void do_step_const( EventInfo& eventInfo, state_type& states,
+			    fmiTime& currentTime, fmiTime& dt ){
+		if ( !attempt( states, currentTime, dt ) ){
+			// W is singular for this step size, use two steps instead
+			fmiTime half = 0.5*dt;
+			do_step_const( eventInfo, states, currentTime, half );
+			do_step_const( eventInfo, states, currentTime, half );
 			return;
 		}
-		else if ( flag == CV_SUCCESS ){
-			eventInfo.stateEvent = false;
-			// no event happened -> just write the result into the fmu
-			fmu_->setTime( t_ );
-			fmu_->setContinuousStates( &states.front() );
 
-			if ( fmu_->checkStepEvent() )
-				eventInfo.stepEvent = true;
+		states = xnew_;
+		currentTime += dt;
+		invalidateJacobian();
+	}
+
+	void reset(){
+		LinearlyImplicitStepper::reset();
+		firstStep_ = true;
+		lastRejected_ = false;
+	}
+
+	fmiTime getProposedStepSize() const { return dtNext_; }
+};
+
+
+/**
+ * Linearly implicit Euler method with constant step size.
+ *
+ * A first order method for stiff models, which solves one linear system per step. Since the
+ * method remains consistent for approximate Jacobians, the Jacobian (and the factorization,
+ * as long as the step size does not change) is reused for several steps.
+ */
+class LinearlyImplicitEuler : public LinearlyImplicitStepper
+{
+	/// maximum number of steps the Jacobian is reused for
+	static const unsigned int maxJacobianAge = 10;
+
+	unsigned int jacobianAge_;   ///< number of steps the current Jacobian has been used for
+	state_type g_;               ///< increment of the states
+
+public:
+	LinearlyImplicitEuler( DynamicalSystem* fmu, Integrator::Properties& properties ) :
+		LinearlyImplicitStepper( 1, fmu ),
+		jacobianAge_( 0 ),
+		g_( neq_ )
+	{
+		properties.name   = "Linearly Implicit Euler";
+		properties.order  = 1;
+		properties.abstol = std::numeric_limits< fmiReal >::infinity();
+		properties.reltol = std::numeric_limits< fmiReal >::infinity();
+	}
+
+	void do_step( EventInfo& eventInfo, state_type& states,
+		      fmiTime& currentTime, fmiTime& dt ){
+		if ( !jacobianValid() || ( jacobianAge_ >= maxJacobianAge ) ){
+			evaluateJacobian( states, currentTime );
+			jacobianAge_ = 0;
+			g_ = jac_.dxdt_;
+		} else {
+			sys_( states, g_, currentTime );
 		}
-		else{
-			std::cout << "an exception happened when running the sundials stepper" << std::endl;
+
+		if ( !factorize( dt ) ){
+			// W is singular for this step size, use two steps instead
+			fmiTime half = 0.5*dt;
+			invalidateJacobian();
+			do_step( eventInfo, states, currentTime, half );
+			do_step( eventInfo, states, currentTime, half );
+			return;
 		}
+
+		// ( I/dt - J ) g = f + dt*df/dt
+		for ( std::size_t i = 0; i < neq_; i++ )
+			g_[i] += dt*jac_.dfdt_[i];
+		solve( g_ );
+
+		for ( std::size_t i = 0; i < neq_; i++ )
+			states[i] += g_[i];
+		currentTime += dt;
+		++jacobianAge_;
+	}
+};
+
+
+/**
+ * Base class for implicit Runge-Kutta steppers with controlled step size and dense output.
+ *
+ * The stage equations are solved with simplified Newton iterations, i.e., all iterations of a
+ * step use the same Jacobian. The Jacobian is only re-evaluated when the iterations converge
+ * slowly or fail, hence it is typically reused for many steps (and across calls of invokeMethod).
+ * The iteration matrices are factorized with DenseLU, the factorizations are reused as long as
+ * neither the Jacobian nor the step size change.
+ *
+ * The steps are limited to end exactly at the end of the integration interval, since the dense
+ * output is typically less accurate than the states at the end of a step. The dense output is
+ * used during the event search and to predict the starting values for the Newton iterations.
+ * The derived classes only have to implement the following methods
+ *   * step
+ *   * interpolate
+ */
+class ImplicitStepper : public IntegratorStepper
+{
+protected:
+	/// maximum number of Newton iterations per step (or stage)
+	static const unsigned int maxNewtonIterations = 6;
+
+	system_wrapper sys_;         ///< wrapped version of the DynamicalSystem
+	DenseJacobian jac_;          ///< Jacobian of the rhs
+	const std::size_t neq_;      ///< dimension of the state space
+	const fmiReal abstol_;       ///< absolute tolerance
+	const fmiReal reltol_;       ///< relative tolerance
+	const fmiReal newtonTol_;    ///< tolerance for the Newton iterations (relative to the error weights)
+
+	fmiTime    t_;               ///< time after the last step
+	fmiTime    tOld_;            ///< time before the last step
+	fmiTime    dt_;              ///< step size for the next step
+	fmiTime    tStop_;           ///< steps must not go beyond this time
+	state_type x_;               ///< states after the last step
+	state_type xOld_;            ///< states before the last step
+	state_type f_;               ///< derivatives at ( x_, t_ )
+	state_type scale_;           ///< error weights
+	bool       jacCurrent_;      ///< has the Jacobian been evaluated at ( x_, t_ )?
+
+	ImplicitStepper( DynamicalSystem* fmu, Integrator::Properties& properties ) :
+		IntegratorStepper( fmu ),
+		sys_( fmu, &statistics_.nRhsEvaluations ),
+		jac_( fmu, &statistics_ ),
+		neq_( fmu->nStates() ),
+		abstol_( properties.abstol != properties.abstol ? 1.0e-6 : properties.abstol ),
+		reltol_( properties.reltol != properties.reltol ? 1.0e-6 : properties.reltol ),
+		newtonTol_( std::max( 10*std::numeric_limits< fmiReal >::epsilon()/reltol_,
+				      std::min( 0.03, std::sqrt( reltol_ ) ) ) ),
+		t_( 0 ), tOld_( 0 ), dt_( 0 ), tStop_( 0 ),
+		x_( neq_ ), xOld_( neq_ ), f_( neq_ ), scale_( neq_ ),
+		jacCurrent_( false )
+	{
+		// add missing tolerances if necessary
+		if ( properties.abstol != properties.abstol )
+			properties.abstol = 1.0e-6;
+		if ( properties.reltol != properties.reltol )
+			properties.reltol = 1.0e-6;
+	}
+
+	/// Make a controlled step from ( x_, t_ ), trying the step size dt_ first (but not beyond tStop_).
+	/// Updates x_, t_, f_, xOld_, tOld_, the dense output and dt_ (step size proposed for the next
+	/// step). Returns false if the step size becomes too small.
+	virtual bool step() = 0;
+
+	/// Evaluate the dense output of the last step (tOld_ <= t <= t_).
+	virtual void interpolate( fmiTime t, state_type& x ) const = 0;
+
+	/// Start integrating from the given states until tStop, the dense output of previous steps is discarded.
+	virtual void initialize( const state_type& states, fmiTime time, fmiTime dt, fmiTime tStop )
+	{
+		x_ = xOld_ = states;
+		t_ = tOld_ = time;
+		dt_ = dt;
+		tStop_ = tStop;
+		sys_( x_, f_, t_ );
+		jacCurrent_ = false;
+	}
+
+	/// Make sure there is a Jacobian, evaluate it at ( x_, t_ ) if there is none (or if force is true).
+	/// Returns true if a new Jacobian has been evaluated.
+	bool updateJacobian( bool force = false )
+	{
+		if ( jac_.valid() && ( !force || jacCurrent_ ) ) return false;
+		jac_.evaluate( x_, t_, false );
+		jacCurrent_ = true;
+		return true;
+	}
+
+	/// Limit the step size dt such that the step does not go beyond tStop_.
+	fmiTime limitStepSize( fmiTime dt ) const
+	{
+		return std::min( dt, tStop_ - t_ );
+	}
+
+	/// Advance the time by the step size h (h has been limited with limitStepSize).
+	void advanceTime( fmiTime h )
+	{
+		t_ = ( h == tStop_ - t_ ) ? tStop_ : t_ + h;
+	}
+
+	/// Check whether tStop_ has been reached. A remainder of the interval, which is too small for the
+	/// implicit method, is covered with an explicit Euler step (like in FMUModelExchange::stepOverEvent).
+	bool stopReached()
+	{
+		if ( ( t_ < tStop_ ) && stepSizeTooSmall( t_, tStop_ - t_ ) ){
+			for ( std::size_t i = 0; i < neq_; i++ )
+				x_[i] += ( tStop_ - t_ )*f_[i];
+			t_ = tStop_;
+		}
+		return t_ >= tStop_;
+	}
+
+	/// Check whether the step size dt is too small for time t.
+	static bool stepSizeTooSmall( fmiTime t, fmiTime dt )
+	{
+		return ( dt <= 10*std::numeric_limits< fmiTime >::epsilon()*std::fabs( t ) ) ||
+			( dt <= std::numeric_limits< fmiTime >::min() );
+	}
+
+	/// Check whether a (weighted) Newton increment is at the level of round-off errors.
+	bool negligible( fmiReal increment ) const
+	{
+		return increment <= 10*std::numeric_limits< fmiReal >::epsilon()/reltol_;
+	}
+
+	/// Update the error weights for the states x and y.
+	void updateScale( const state_type& x, const state_type& y )
+	{
+		for ( std::size_t i = 0; i < neq_; i++ )
+			scale_[i] = abstol_ + reltol_*std::max( std::fabs( x[i] ), std::fabs( y[i] ) );
+	}
+
+	/// Cubic Hermite interpolation of the last step, using the derivatives fOld at ( xOld_, tOld_ ) and f_.
+	void interpolateHermite( fmiTime t, const state_type& fOld, state_type& x ) const
+	{
+		if ( t_ == tOld_ ){
+			x = x_;
+			return;
+		}
+		const fmiTime h = t_ - tOld_;
+		const fmiReal s = ( t - tOld_ )/h;
+		const fmiReal h00 = ( 1.0 + 2.0*s )*( 1.0 - s )*( 1.0 - s );
+		const fmiReal h10 = s*( 1.0 - s )*( 1.0 - s );
+		const fmiReal h01 = s*s*( 3.0 - 2.0*s );
+		const fmiReal h11 = s*s*( s - 1.0 );
+		for ( std::size_t i = 0; i < neq_; i++ )
+			x[i] = h00*xOld_[i] + h*( h10*fOld[i] + h11*f_[i] ) + h01*x_[i];
+	}
+
+	/// Weighted RMS norm of the vector v of size n*neq_ (n vectors of size neq_).
+	fmiReal norm( const fmiReal* v, std::size_t n = 1 ) const
+	{
+		fmiReal sum = 0.0;
+		for ( std::size_t k = 0; k < n; k++ )
+			for ( std::size_t i = 0; i < neq_; i++ ){
+				const fmiReal e = v[k*neq_ + i]/scale_[i];
+				sum += e*e;
+			}
+		return std::sqrt( sum/fmiReal( n*neq_ ) );
+	}
+
+public:
+
+	void invokeMethod( EventInfo& eventInfo,
+			   state_type& states,
+			   fmiTime time,
+			   fmiTime step_size,
+			   fmiTime dt,
+			   fmiTime eventSearchPrecision ){
+		initialize( states, time, dt, time + step_size );
+		while ( !stopReached() ){
+			// perform a step
+			if ( !step() ){
+				std::cout << "WARNING: step size too small at t = " << t_
+					  << ", the integration is aborted" << std::endl;
+				states = x_;
+				fmu_->setTime( t_ );
+				fmu_->setContinuousStates( &states[0] );
+				eventInfo.stateEvent = false;
+				eventInfo.stepEvent  = false;
+				return;
+			}
+			stepAccepted( t_ - tOld_ );
+
+			// event detection like in OdeintStepper
+			fmu_->setTime( t_ );
+			fmu_->setContinuousStates( &x_[0] );
+			if ( fmu_->checkStateEvent() ){
+				// set back to the backup state/time
+				states = xOld_;
+				fmu_->setTime( tOld_ );
+				fmu_->setContinuousStates( &states[0] );
+
+				// tell the integrator about the event
+				eventInfo.stepEvent  = false;
+				eventInfo.stateEvent = true;
+				eventInfo.tLower     = tOld_;
+				eventInfo.tUpper     = t_;
+
+				return;
+			}
+
+			if ( fmu_->checkStepEvent() ){
+				// tell the integrator about the event
+				states = x_;
+				eventInfo.stepEvent  = true;
+				eventInfo.stateEvent = false;
+
+				return;
+			}
+		}
+
+		// write the results in the FMU
+		states = x_;
+		fmu_->setTime( t_ );
+		fmu_->setContinuousStates( &states[0] );
+
+		eventInfo.stateEvent = false;
+		eventInfo.stepEvent  = false;
+	}
+
+	void do_step_const( EventInfo& eventInfo,
+			    state_type& states,
+			    fmiTime& time,
+			    fmiTime& dt ){
+		const fmiTime target = time + dt;
+
+		// use interpolation if possible, continue from the given states otherwise
+		if ( ( target < tOld_ ) || ( target > t_ ) ){
+			initialize( states, time, dt, target );
+			while ( !stopReached() && step() ) stepAccepted( t_ - tOld_ );
+			states = x_;
+		} else {
+			interpolate( target, states );
+		}
+
+		time = target;
+		fmu_->setTime( time );
+		fmu_->setContinuousStates( &states[0] );
+	}
+
+	void reset(){
+		// the states might have been changed externally
+		jac_.invalidate();
+	}
+
+	fmiTime getProposedStepSize() const { return dt_; }
+};
+
+
+/**
+ * Radau IIA method of order 5 with controlled step size (3 stages).
+ *
+ * The implementation follows RADAU5 by Hairer and Wanner: the (3n x 3n) Newton systems are
+ * transformed into one real (n x n) and one complex system, based on the eigenvalues of the
+ * inverse of the coefficient matrix. The complex system is solved in its real form of size 2n.
+ * The error estimate uses an embedded formula of order 3, the step size control is predictive
+ * (Gustafsson). The dense output is given by the collocation polynomial, which is also used to
+ * predict the stage values for the Newton iterations of the next step.
+ */
+class RadauIIA : public ImplicitStepper
+{
+	/// nodes
+	static const fmiReal c_[3];
+	/// eigenvalues of the inverse of the coefficient matrix (real one and complex pair muReal_[1] -+ i*muImag_)
+	static const fmiReal muReal_[2];
+	static const fmiReal muImag_;
+	/// transformation to the eigenbasis of the inverse of the coefficient matrix and its inverse
+	static const fmiReal T_[3][3];
+	static const fmiReal TI_[3][3];
+	/// error estimate
+	static const fmiReal e_[3];
+	/// dense output
+	static const fmiReal p_[3][3];
+
+	DenseLU    luReal_;          ///< factorization of muReal_[0]/h*I - J
+	DenseLU    luComplex_;       ///< factorization of ( muReal_[1] - i*muImag_ )/h*I - J (real form)
+	fmiTime    factorizedFor_;   ///< step size the factorizations have been computed for
+
+	state_type z_;               ///< stage values (relative to the states at the beginning of the step)
+	state_type w_;               ///< transformed stage values
+	state_type f3_;              ///< derivatives at the stages
+	state_type dw_;              ///< Newton increments
+	state_type xtmp_;
+	state_type err_;
+	state_type q_;               ///< coefficients of the collocation polynomial (dense output)
+	bool       dense_;           ///< is the dense output of the last step available?
+
+	fmiTime    hOld_;            ///< step size control: previous step size
+	fmiReal    errOld_;          ///< step size control: error of the previous step
+
+	/// Factorize the iteration matrices for step size h unless the factorizations can be reused.
+	bool factorize( fmiTime h )
+	{
+		if ( luReal_.isFactorized() && luComplex_.isFactorized() && ( factorizedFor_ == h ) ) return true;
+
+		jac_.assemble( luReal_, muReal_[0]/h );
+		jac_.assembleComplex( luComplex_, muReal_[1]/h, -muImag_/h );
+		factorizedFor_ = h;
+		statistics_.nFactorizations += 2;
+		return luReal_.factorize() && luComplex_.factorize();
+	}
+
+	/// Simplified Newton iterations for the stage values z_ with step size h.
+	bool newton( fmiTime h, unsigned int& iterations, fmiReal& rate )
+	{
+		const std::size_t n = neq_;
+		const fmiReal a = muReal_[1]/h;
+		const fmiReal b = muImag_/h;
+
+		for ( std::size_t i = 0; i < n; i++ )
+			for ( std::size_t k = 0; k < 3; k++ )
+				w_[k*n + i] = TI_[k][0]*z_[i] + TI_[k][1]*z_[n + i] + TI_[k][2]*z_[2*n + i];
+
+		fmiReal normOld = -1.0;
+		rate = -1.0;
+		for ( iterations = 1; iterations <= maxNewtonIterations; iterations++ ){
+			for ( std::size_t k = 0; k < 3; k++ ){
+				for ( std::size_t i = 0; i < n; i++ )
+					xtmp_[i] = x_[i] + z_[k*n + i];
+				sys_( xtmp_, err_, t_ + c_[k]*h );
+				std::copy( err_.begin(), err_.end(), f3_.begin() + k*n );
+			}
+
+			for ( std::size_t i = 0; i < 3*n; i++ )
+				if ( !( std::fabs( f3_[i] ) <= std::numeric_limits< fmiReal >::max() ) ) return false;
+
+			// right-hand sides of the transformed systems
+			for ( std::size_t i = 0; i < n; i++ ){
+				fmiReal r[3];
+				for ( std::size_t k = 0; k < 3; k++ )
+					r[k] = TI_[k][0]*f3_[i] + TI_[k][1]*f3_[n + i] + TI_[k][2]*f3_[2*n + i];
+				dw_[i]       = r[0] - muReal_[0]/h*w_[i];
+				dw_[n + i]   = r[1] - ( a*w_[n + i] + b*w_[2*n + i] );
+				dw_[2*n + i] = r[2] - ( a*w_[2*n + i] - b*w_[n + i] );
+			}
+			luReal_.solve( &dw_[0] );
+			luComplex_.solve( &dw_[n] );
+
+			const fmiReal dwNorm = norm( &dw_[0], 3 );
+			if ( normOld >= 0.0 ) rate = dwNorm/normOld;
+
+			if ( !negligible( dwNorm ) && ( rate >= 0.0 ) &&
+			     ( ( rate >= 1.0 ) ||
+			       ( std::pow( rate, fmiReal( maxNewtonIterations - iterations + 1 ) )/( 1.0 - rate )*dwNorm > newtonTol_ ) ) )
+				return false;
+
+			for ( std::size_t i = 0; i < 3*n; i++ )
+				w_[i] += dw_[i];
+			for ( std::size_t i = 0; i < n; i++ )
+				for ( std::size_t k = 0; k < 3; k++ )
+					z_[k*n + i] = T_[k][0]*w_[i] + T_[k][1]*w_[n + i] + T_[k][2]*w_[2*n + i];
+
+			if ( negligible( dwNorm ) || ( ( rate >= 0.0 ) && ( rate/( 1.0 - rate )*dwNorm < newtonTol_ ) ) )
+				return true;
+
+			normOld = dwNorm;
+		}
+
+		return false;
+	}
+
+	/// Predictive step size control (Gustafsson).
+	fmiReal predictFactor( fmiTime h, fmiReal err ) const
+	{
+		fmiReal multiplier = 1.0;
+		if ( ( hOld_ > 0.0 ) && ( err > 0.0 ) )
+			multiplier = h/hOld_*std::pow( errOld_/err, 0.25 );
+		return std::min( 1.0, multiplier )*std::pow( err, -0.25 );
+	}
+
+	/// Error estimate of the stage values z_ with step size h, sets err_.
+	void estimateError( fmiTime h, const state_type& f )
+	{
+		const std::size_t n = neq_;
+		for ( std::size_t i = 0; i < n; i++ )
+			err_[i] = f[i] + ( e_[0]*z_[i] + e_[1]*z_[n + i] + e_[2]*z_[2*n + i] )/h;
+		luReal_.solve( &err_[0] );
+	}
+
+public:
+	RadauIIA( DynamicalSystem* fmu, Integrator::Properties& properties ) :
+		ImplicitStepper( fmu, properties ),
+		luReal_( neq_ ),
+		luComplex_( 2*neq_ ),
+		factorizedFor_( 0 ),
+		z_( 3*neq_ ), w_( 3*neq_ ), f3_( 3*neq_ ), dw_( 3*neq_ ),
+		xtmp_( neq_ ), err_( neq_ ), q_( 3*neq_ ),
+		dense_( false ),
+		hOld_( 0 ),
+		errOld_( 0 )
+	{
+		properties.name  = "Radau IIA";
+		properties.order = 5;
+	}
+
+	void initialize( const state_type& states, fmiTime time, fmiTime dt, fmiTime tStop )
+	{
+		ImplicitStepper::initialize( states, time, dt, tStop );
+		dense_ = false;
+		hOld_ = 0;
+	}
+
+	void interpolate( fmiTime t, state_type& x ) const
+	{
+		const std::size_t n = neq_;
+		if ( t_ == tOld_ ){
+			x = x_;
+			return;
+		}
+		const fmiReal s = ( t - tOld_ )/( t_ - tOld_ );
+		for ( std::size_t i = 0; i < n; i++ )
+			x[i] = xOld_[i] + s*( q_[i] + s*( q_[n + i] + s*q_[2*n + i] ) );
+	}
+
+	bool step()
+	{
+		static const fmiReal minFactor = 0.2, maxFactor = 10.0;
+		const std::size_t n = neq_;
+		const fmiReal safetyNum = 0.9*( 2*maxNewtonIterations + 1 );
+
+		bool rejected = false;
+		unsigned int iterations = 0;
+		fmiReal rate = -1.0, err = 0.0, safety = 0.9;
+		fmiTime h = dt_;
+
+		while ( true ){
+			h = limitStepSize( dt_ );
+			if ( stepSizeTooSmall( t_, h ) ) return false;
+
+			// starting values for the stage values: extrapolate the collocation polynomial of the last step
+			if ( dense_ ){
+				for ( std::size_t k = 0; k < 3; k++ ){
+					interpolate( t_ + c_[k]*h, xtmp_ );
+					for ( std::size_t i = 0; i < n; i++ )
+						z_[k*n + i] = xtmp_[i] - x_[i];
+				}
+			} else {
+				std::fill( z_.begin(), z_.end(), 0.0 );
+			}
+
+			updateScale( x_, x_ );
+
+			bool converged = false;
+			updateJacobian();
+			while ( true ){
+				if ( factorize( h ) )
+					converged = newton( h, iterations, rate );
+				if ( converged || jacCurrent_ ) break;
+
+				// try again with a fresh Jacobian
+				updateJacobian( true );
+			}
+
+			if ( !converged ){
+				dt_ = 0.5*h;
+				continue;
+			}
+
+			for ( std::size_t i = 0; i < n; i++ )
+				xtmp_[i] = x_[i] + z_[2*n + i];
+
+			estimateError( h, f_ );
+			updateScale( x_, xtmp_ );
+			err = norm( &err_[0] );
+
+			safety = safetyNum/( 2*maxNewtonIterations + iterations );
+
+			if ( rejected && ( err > 1.0 ) ){
+				// improved error estimate for stiff components
+				for ( std::size_t i = 0; i < n; i++ )
+					err_[i] += x_[i];
+				sys_( err_, dw_, t_ );
+				estimateError( h, dw_ );
+				err = norm( &err_[0] );
+			}
+
+			if ( err > 1.0 ){
+				dt_ = h*std::max( minFactor, safety*predictFactor( h, err ) );
+				rejected = true;
+				++statistics_.nRejectedSteps;
+				continue;
+			}
+
+			break;
+		}
+
+		// accept the step
+		const bool recomputeJacobian = ( iterations > 2 ) && ( rate > 1.0e-3 );
+		fmiReal factor = std::min( maxFactor, safety*predictFactor( h, err ) );
+		if ( !recomputeJacobian && ( factor < 1.2 ) && ( factor >= 1.0 ) )
+			factor = 1.0; // keep the step size, which allows to reuse the factorizations
+		if ( rejected )
+			factor = std::min( factor, 1.0 );
+
+		xOld_ = x_;
+		tOld_ = t_;
+		x_ = xtmp_;
+		advanceTime( h );
+		sys_( x_, f_, t_ );
+		jacCurrent_ = false;
+		if ( recomputeJacobian )
+			updateJacobian( true );
+
+		// coefficients of the collocation polynomial
+		for ( std::size_t i = 0; i < n; i++ )
+			for ( std::size_t k = 0; k < 3; k++ )
+				q_[k*n + i] = p_[0][k]*z_[i] + p_[1][k]*z_[n + i] + p_[2][k]*z_[2*n + i];
+		dense_ = true;
+
+		hOld_ = h;
+		errOld_ = std::max( 0.01, err );
+		dt_ = h*factor;
+
+		return true;
+	}
+};
+
+const fmiReal RadauIIA::c_[3] = { 0.15505102572168219018, 0.64494897427831780982, 1.0 };
+const fmiReal RadauIIA::muReal_[2] = { 3.6378342527444957322, 2.6810828736277521339 };
+const fmiReal RadauIIA::muImag_ = 3.0504301992474105694;
+const fmiReal RadauIIA::T_[3][3] = {
+	{ 0.09443876248897524, -0.14125529502095421, 0.03002919410514742 },
+	{ 0.25021312296533332, 0.20412935229379994, -0.38294211275726192 },
+	{ 1.0, 1.0, 0.0 } };
+const fmiReal RadauIIA::TI_[3][3] = {
+	{ 4.17871859155190428, 0.32768282076106237, 0.52337644549944951 },
+	{ -4.17871859155190428, -0.32768282076106237, 0.47662355450055044 },
+	{ 0.50287263494578682, -2.57192694985560522, 0.59603920482822492 } };
+const fmiReal RadauIIA::e_[3] = { -10.048809399827415562, 1.3821427331607488958, -0.33333333333333333333 };
+const fmiReal RadauIIA::p_[3][3] = {
+	{ 10.048809399827415562, -25.629591447076638851, 15.580782047249223289 },
+	{ -1.3821427331607488958, 10.296258113743305518, -8.9141153805825566228 },
+	{ 0.33333333333333333333, -2.6666666666666666667, 3.3333333333333333333 } };
+
+
+/**
+ * Family of ESDIRK methods (singly diagonally implicit Runge-Kutta methods with an explicit first
+ * stage) with controlled step size.
+ *
+ * All methods of the family are L-stable and stiffly accurate, the stages are solved one after
+ * the other with simplified Newton iterations. Since all implicit stages have the same diagonal
+ * coefficient gamma, they share the iteration matrix I/( gamma*h ) - J. The error estimate of the
+ * embedded method is filtered with this matrix (which improves it for stiff components), the dense
+ * output uses cubic Hermite interpolation.
+ */
+class ESDIRK : public ImplicitStepper
+{
+public:
+	/// Coefficients of an ESDIRK method.
+	struct Tableau {
+		const char*     name;
+		int             order;          ///< order of the method
+		int             errorOrder;     ///< order of the error estimate (min. order of method and embedded method)
+		std::size_t     stages;
+		fmiReal         gamma;          ///< diagonal coefficient
+		const fmiReal*  a;              ///< coefficient matrix (row-major, stages x stages)
+		const fmiReal*  e;              ///< difference of the weights of the method and the embedded method
+	};
+
+	/// TR-BDF2, an ESDIRK method of order 2 with an embedded method of order 3.
+	static const Tableau trbdf2;
+	/// ESDIRK of order 3 with 4 stages (the method of ESDIRK3(2)4L[2]SA by Kennedy and Carpenter)
+	/// and an A-stable embedded method of order 2.
+	static const Tableau esdirk32;
+
+private:
+	const Tableau& tableau_;
+
+	DenseLU    lu_;              ///< factorization of I/( gamma*h ) - J
+	fmiTime    factorizedFor_;   ///< step size the factorization has been computed for
+
+	state_type k_;               ///< stage derivatives
+	state_type base_;            ///< explicit part of the current stage
+	state_type y_;               ///< current stage value
+	state_type dy_;              ///< Newton increment
+	state_type err_;
+	state_type fOld_;            ///< derivatives at ( xOld_, tOld_ ), for the dense output
+
+	/// Factorize the iteration matrix for step size h unless the factorization can be reused.
+	bool factorize( fmiTime h )
+	{
+		if ( lu_.isFactorized() && ( factorizedFor_ == h ) ) return true;
+
+		jac_.assemble( lu_, 1.0/( tableau_.gamma*h ) );
+		factorizedFor_ = h;
+		++statistics_.nFactorizations;
+		return lu_.factorize();
+	}
+
+	/// Simplified Newton iterations for stage s with step size h.
+	bool newton( std::size_t s, fmiTime h, unsigned int& iterations, fmiReal& rate )
+	{
+		const std::size_t n = neq_;
+		const fmiReal* a = tableau_.a + s*tableau_.stages;
+		const fmiReal gh = tableau_.gamma*h;
+		fmiReal ci = 0.0;
+
+		// explicit part of the stage and predictor
+		for ( std::size_t j = 0; j < s; j++ ) ci += a[j];
+		for ( std::size_t i = 0; i < n; i++ ){
+			fmiReal sum = 0.0;
+			for ( std::size_t j = 0; j < s; j++ ) sum += a[j]*k_[j*n + i];
+			base_[i] = x_[i] + h*sum;
+			y_[i] = base_[i] + gh*k_[( s - 1 )*n + i];
+		}
+		ci += tableau_.gamma;
+
+		fmiReal normOld = -1.0;
+		rate = -1.0;
+		for ( iterations = 1; iterations <= maxNewtonIterations; iterations++ ){
+			sys_( y_, dy_, t_ + ci*h );
+			for ( std::size_t i = 0; i < n; i++ ){
+				if ( !( std::fabs( dy_[i] ) <= std::numeric_limits< fmiReal >::max() ) ) return false;
+				dy_[i] += ( base_[i] - y_[i] )/gh;
+			}
+			lu_.solve( &dy_[0] );
+
+			const fmiReal dyNorm = norm( &dy_[0] );
+			if ( normOld >= 0.0 ) rate = dyNorm/normOld;
+
+			if ( !negligible( dyNorm ) && ( rate >= 0.0 ) &&
+			     ( ( rate >= 1.0 ) ||
+			       ( std::pow( rate, fmiReal( maxNewtonIterations - iterations + 1 ) )/( 1.0 - rate )*dyNorm > newtonTol_ ) ) )
+				return false;
+
+			for ( std::size_t i = 0; i < n; i++ )
+				y_[i] += dy_[i];
+
+			if ( negligible( dyNorm ) || ( ( rate >= 0.0 ) && ( rate/( 1.0 - rate )*dyNorm < newtonTol_ ) ) ){
+				// stage derivatives from the stage equation (more accurate than evaluating the rhs)
+				for ( std::size_t i = 0; i < n; i++ )
+					k_[s*n + i] = ( y_[i] - base_[i] )/gh;
+				return true;
+			}
+
+			normOld = dyNorm;
+		}
+
+		return false;
+	}
+
+public:
+	ESDIRK( DynamicalSystem* fmu, Integrator::Properties& properties, const Tableau& tableau ) :
+		ImplicitStepper( fmu, properties ),
+		tableau_( tableau ),
+		lu_( neq_ ),
+		factorizedFor_( 0 ),
+		k_( tableau.stages*neq_ ),
+		base_( neq_ ), y_( neq_ ), dy_( neq_ ), err_( neq_ ), fOld_( neq_ )
+	{
+		properties.name  = tableau.name;
+		properties.order = tableau.order;
+	}
+
+	void initialize( const state_type& states, fmiTime time, fmiTime dt, fmiTime tStop )
+	{
+		ImplicitStepper::initialize( states, time, dt, tStop );
+		fOld_ = f_;
+	}
+
+	void interpolate( fmiTime t, state_type& x ) const
+	{
+		interpolateHermite( t, fOld_, x );
+	}
+
+	bool step()
+	{
+		static const fmiReal minFactor = 0.2, maxFactor = 5.0, safety = 0.9;
+		const std::size_t n = neq_;
+		const std::size_t stages = tableau_.stages;
+		const fmiReal exponent = -1.0/( tableau_.errorOrder + 1 );
+
+		bool rejected = false;
+		unsigned int iterations = 0, maxIterations = 0;
+		fmiReal rate = -1.0, maxRate = -1.0, err = 0.0;
+		fmiTime h = dt_;
+
+		std::copy( f_.begin(), f_.end(), k_.begin() );
+
+		while ( true ){
+			h = limitStepSize( dt_ );
+			if ( stepSizeTooSmall( t_, h ) ) return false;
+
+			updateScale( x_, x_ );
+
+			bool converged = false;
+			updateJacobian();
+			while ( true ){
+				maxIterations = 0;
+				maxRate = -1.0;
+				if ( factorize( h ) ){
+					for ( std::size_t s = 1; s < stages; s++ ){
+						converged = newton( s, h, iterations, rate );
+						if ( !converged ) break;
+						maxIterations = std::max( maxIterations, iterations );
+						maxRate = std::max( maxRate, rate );
+					}
+				}
+				if ( converged || jacCurrent_ ) break;
+
+				// try again with a fresh Jacobian
+				updateJacobian( true );
+			}
+
+			if ( !converged ){
+				dt_ = 0.5*h;
+				continue;
+			}
+
+			// filtered error estimate ( I - gamma*h*J )^-1 h sum_i e_i k_i
+			for ( std::size_t i = 0; i < n; i++ ){
+				fmiReal sum = 0.0;
+				for ( std::size_t j = 0; j < stages; j++ ) sum += tableau_.e[j]*k_[j*n + i];
+				err_[i] = sum/tableau_.gamma;
+			}
+			lu_.solve( &err_[0] );
+
+			updateScale( x_, y_ );
+			err = norm( &err_[0] );
+
+			if ( err > 1.0 ){
+				dt_ = h*std::max( minFactor, safety*std::pow( err, exponent ) );
+				rejected = true;
+				++statistics_.nRejectedSteps;
+				continue;
+			}
+
+			break;
+		}
+
+		// accept the step (the methods are stiffly accurate: the last stage is the new state)
+		const bool recomputeJacobian = ( maxIterations > 2 ) && ( maxRate > 1.0e-3 );
+		fmiReal factor = std::min( maxFactor, safety*std::pow( err, exponent ) );
+		if ( !recomputeJacobian && ( factor < 1.2 ) && ( factor >= 1.0 ) )
+			factor = 1.0; // keep the step size, which allows to reuse the factorization
+		if ( rejected )
+			factor = std::min( factor, 1.0 );
+
+		xOld_ = x_;
+		tOld_ = t_;
+		fOld_ = f_;
+		x_ = y_;
+		advanceTime( h );
+		std::copy( k_.begin() + ( stages - 1 )*n, k_.end(), f_.begin() );
+		jacCurrent_ = false;
+		if ( recomputeJacobian )
+			updateJacobian( true );
+
+		dt_ = h*factor;
+
+		return true;
+	}
+};
+
+namespace {
+	const fmiReal trbdf2A[9] = {
+		0.0, 0.0, 0.0,
+		0.29289321881345247560, 0.29289321881345247560, 0.0,
+		0.35355339059327376220, 0.35355339059327376220, 0.29289321881345247560 };
+	const fmiReal trbdf2E[3] = {
+		0.35355339059327376220 - 0.21548220313557541260,
+		0.35355339059327376220 - 0.68688672392660709553,
+		0.29289321881345247560 - 0.09763107293781749187 };
+
+	const fmiReal esdirk32A[16] = {
+		0.0, 0.0, 0.0, 0.0,
+		0.43586652150845900, 0.43586652150845900, 0.0, 0.0,
+		0.25764824606642740, -0.09351476757488641, 0.43586652150845900, 0.0,
+		0.18764102434672358, -0.59529747357695510, 0.97178992772177240, 0.43586652150845900 };
+	const fmiReal esdirk32E[4] = {
+		0.18764102434672358 - 0.29539435554556010,
+		-0.59529747357695510 + 0.15737278837304097,
+		0.97178992772177240 - 0.56197843282748080,
+		0.43586652150845900 - 0.3 };
+}
+
+const ESDIRK::Tableau ESDIRK::trbdf2 = { "ESDIRK 2(3) (TR-BDF2)", 2, 2, 3, 0.29289321881345247560, trbdf2A, trbdf2E };
+const ESDIRK::Tableau ESDIRK::esdirk32 = { "ESDIRK 3(2)", 3, 2, 4, 0.43586652150845900, esdirk32A, esdirk32E };
+
+
+/**
+ * Multirate Rosenbrock method of order 2 with controlled step sizes, for models whose states
+ * evolve on very different time scales.
+ *
+ * The states are partitioned into a fast and a slow group. Either the names of the fast states are
+ * given in the integrator properties (see Integrator::Properties::fastStates), or the states are
+ * partitioned automatically whenever the Jacobian is evaluated: every state i is assigned the rate
+ * sum_j |J_ij| (a Gershgorin bound for the eigenvalues associated with it), where only the entries
+ * in the structural pattern of the Jacobian are taken into account if the FMU provides it (see
+ * DynamicalSystem::getJacobianPattern). The states are split at the largest gap between the sorted
+ * rates, as long as it spans at least one order of magnitude. Otherwise all states are fast and the
+ * stepper reduces to a single-rate method.
+ *
+ * Both groups use the linearly implicit two-stage method ROS2 (Verwer et al.), which is of order 2
+ * for any approximation of the Jacobian. In a macro step, the first stage of the slow group is
+ * computed, then the fast group is sub-cycled over the macro step with its own controlled micro
+ * steps, with the slow states interpolated linearly between the start of the macro step and their
+ * prediction from the first stage. The second stage of the slow group uses the fast states at the
+ * end of the macro step. Only the linear systems of the fast group are solved in every micro step,
+ * and the Jacobian is reused for several macro steps. The dense output uses cubic Hermite
+ * interpolation.
+ */
+class Multirate : public ImplicitStepper
+{
+	/// maximum number of macro steps the Jacobian is reused for
+	static const unsigned int maxJacobianAge = 10;
+
+	const fmiReal gamma_;                           ///< diagonal coefficient of ROS2
+	const std::vector< std::string > fastNames_;    ///< user-specified fast states (empty: automatic partitioning)
+	bool namesResolved_;                            ///< have the user-specified names been resolved?
+	bool partitionFixed_;                           ///< is the partition given by the user?
+	std::vector< std::size_t > fast_;               ///< indices of the fast states
+	std::vector< std::size_t > slow_;               ///< indices of the slow states
+	std::vector< bool > pattern_;                   ///< structural pattern of the Jacobian, empty if unknown
+
+	DenseLU    luFast_;                 ///< factorization of I - gamma*h*J for the fast states
+	DenseLU    luSlow_;                 ///< factorization of I - gamma*H*J for the slow states
+	fmiTime    fastFactorizedFor_;      ///< micro step size the factorization of the fast group has been computed for
+	fmiTime    slowFactorizedFor_;      ///< macro step size the factorization of the slow group has been computed for
+	unsigned int jacobianAge_;          ///< number of macro steps the current Jacobian has been used for
+	bool       rejected_;               ///< has a macro or micro step been rejected since the last Jacobian?
+	fmiTime    hFast_;                  ///< step size for the next micro step
+
+	state_type fOld_;                   ///< derivatives at ( xOld_, tOld_ ), for the dense output
+	state_type y_;                      ///< states during the sub-cycling
+	state_type z_;                      ///< argument of the second stage, new states
+	state_type g_;                      ///< derivatives
+	state_type k1_, k2_;                ///< stages (indexed like the states)
+	state_type yPred_;                  ///< predicted slow states at the end of the macro step
+	state_type err_;                    ///< error estimate (indexed like the states)
+	state_type b_;                      ///< right-hand side of the linear systems of one group
+
+	/// Use the states flagged in isFast as fast group, the others as slow group.
+	void setPartition( const std::vector< bool >& isFast )
+	{
+		fast_.clear();
+		slow_.clear();
+		for ( std::size_t i = 0; i < neq_; i++ )
+			( isFast[i] ? fast_ : slow_ ).push_back( i );
+
+		if ( luFast_.size() != fast_.size() ) luFast_.resize( fast_.size() );
+		if ( luSlow_.size() != slow_.size() ) luSlow_.resize( slow_.size() );
+	}
+
+	/// Resolve the names of the user-specified fast states, and get the pattern of the Jacobian.
+	void resolveFastStates()
+	{
+		namesResolved_ = true;
+
+		if ( !fmu_->getJacobianPattern( pattern_ ) )
+			pattern_.clear();
+
+		if ( fastNames_.empty() ) return;
+
+		std::vector< bool > isFast( neq_, false );
+		bool found = false;
+		for ( std::size_t k = 0; k < fastNames_.size(); k++ ){
+			std::size_t index;
+			if ( fmu_->getStateIndex( fastNames_[k], index ) ){
+				isFast[index] = true;
+				found = true;
+			} else {
+				std::cout << "WARNING: multirate stepper: '" << fastNames_[k]
+					  << "' is not a continuous state, it is ignored" << std::endl;
+			}
+		}
+
+		if ( !found ){
+			std::cout << "WARNING: multirate stepper: no fast states found, "
+				  << "the states are partitioned automatically" << std::endl;
+			return;
+		}
+
+		setPartition( isFast );
+		partitionFixed_ = true;
+	}
+
+	/// Partition the states automatically, based on the rates estimated from the current Jacobian.
+	void partition()
+	{
+		static const fmiReal minRateRatio = 10.0;
+
+		std::vector< std::pair< fmiReal, std::size_t > > rates( neq_ );
+		for ( std::size_t i = 0; i < neq_; i++ ){
+			fmiReal rate = 0.0;
+			for ( std::size_t j = 0; j < neq_; j++ )
+				if ( pattern_.empty() || pattern_[neq_*i + j] )
+					rate += std::fabs( jac_( i, j ) );
+			if ( rate != rate ) rate = std::numeric_limits< fmiReal >::infinity();
+			rates[i] = std::make_pair( rate, i );
+		}
+		std::sort( rates.rbegin(), rates.rend() );
+
+		// split at the largest gap between consecutive rates
+		std::size_t nFast = neq_;
+		fmiReal maxRatio = minRateRatio;
+		for ( std::size_t k = 0; k + 1 < neq_; k++ ){
+			const fmiReal ratio = rates[k].first/rates[k + 1].first;
+			if ( ( ratio >= minRateRatio ) && ( ( nFast == neq_ ) || ( ratio > maxRatio ) ) ){
+				maxRatio = ratio;
+				nFast = k + 1;
+			}
+		}
+
+		std::vector< bool > isFast( neq_, false );
+		for ( std::size_t k = 0; k < nFast; k++ )
+			isFast[rates[k].second] = true;
+		setPartition( isFast );
+	}
+
+	/// Evaluate the Jacobian at ( x_, t_ ) if there is none (or if force is true), and update the
+	/// partition and the factorizations accordingly.
+	void refreshJacobian( bool force )
+	{
+		if ( !updateJacobian( force ) ) return;
+
+		jacobianAge_ = 0;
+		rejected_ = false;
+		if ( !partitionFixed_ ) partition();
+		luFast_.invalidate();
+		luSlow_.invalidate();
+	}
+
+	/// Assemble and factorize I - gamma*h*J for the states idx, unless the factorization can be reused.
+	bool factorize( DenseLU& lu, fmiTime& factorizedFor, const std::vector< std::size_t >& idx, fmiTime h )
+	{
+		if ( lu.isFactorized() && ( factorizedFor == h ) ) return true;
+
+		const std::size_t m = idx.size();
+		for ( std::size_t p = 0; p < m; p++ ){
+			fmiReal* row = &lu( p, 0 );
+			for ( std::size_t q = 0; q < m; q++ )
+				row[q] = -gamma_*h*jac_( idx[p], idx[q] );
+			row[p] += 1.0;
+		}
+		lu.invalidate();
+
+		factorizedFor = h;
+		++statistics_.nFactorizations;
+		return lu.factorize();
+	}
+
+	/// Solve ( I - gamma*h*J ) k = b for the states idx (k and b are indexed like the states).
+	void solve( const DenseLU& lu, const std::vector< std::size_t >& idx, const state_type& b, state_type& k )
+	{
+		const std::size_t m = idx.size();
+		for ( std::size_t p = 0; p < m; p++ ) b_[p] = b[idx[p]];
+		lu.solve( &b_[0] );
+		for ( std::size_t p = 0; p < m; p++ ) k[idx[p]] = b_[p];
+	}
+
+	/// Weighted RMS norm of the error estimate of the states idx, for the states x and y.
+	fmiReal error( const std::vector< std::size_t >& idx, const state_type& x, const state_type& y ) const
+	{
+		if ( idx.empty() ) return 0.0;
+
+		fmiReal sum = 0.0;
+		for ( std::size_t p = 0; p < idx.size(); p++ ){
+			const std::size_t i = idx[p];
+			const fmiReal e = err_[i]/( abstol_ + reltol_*std::max( std::fabs( x[i] ), std::fabs( y[i] ) ) );
+			sum += e*e;
+		}
+		const fmiReal err = std::sqrt( sum/fmiReal( idx.size() ) );
+		return ( err == err ) ? err : std::numeric_limits< fmiReal >::infinity();
+	}
+
+	/// Factor for the next step size, for the error err of the last step.
+	static fmiReal stepSizeFactor( fmiReal err )
+	{
+		static const fmiReal minFactor = 0.2, maxFactor = 5.0, safety = 0.9;
+		return std::max( minFactor, std::min( maxFactor, safety/std::sqrt( std::max( err, 1.0e-10 ) ) ) );
+	}
+
+	/// Set the slow states of y to their linear interpolation at time t within the macro step [t_, t_ + H].
+	void interpolateSlow( state_type& y, fmiTime t, fmiTime H ) const
+	{
+		const fmiReal s = ( t - t_ )/H;
+		for ( std::size_t p = 0; p < slow_.size(); p++ ){
+			const std::size_t i = slow_[p];
+			y[i] = x_[i] + s*( yPred_[i] - x_[i] );
+		}
+	}
+
+	/// Integrate the fast states over the macro step [t_, tEnd] (of size H) with controlled micro steps,
+	/// the slow states are interpolated. Stores the states at tEnd in y_. Returns false if the micro step
+	/// size becomes too small.
+	bool subcycle( fmiTime H, fmiTime tEnd )
+	{
+		y_ = x_;
+		fmiTime tau = t_;
+		fmiTime hNext = std::min( hFast_, H );
+
+		while ( !fast_.empty() && ( tau < tEnd ) ){
+			const fmiTime remaining = tEnd - tau;
+			if ( stepSizeTooSmall( tau, remaining ) ){
+				// cover a remainder, which is too small for a micro step, with an explicit Euler step
+				interpolateSlow( y_, tau, H );
+				sys_( y_, g_, tau );
+				for ( std::size_t p = 0; p < fast_.size(); p++ )
+					y_[fast_[p]] += remaining*g_[fast_[p]];
+				break;
+			}
+
+			const fmiTime h = std::min( hNext, remaining );
+			const fmiTime tNext = ( h == remaining ) ? tEnd : tau + h;
+			if ( stepSizeTooSmall( tau, h ) ) return false;
+
+			if ( !factorize( luFast_, fastFactorizedFor_, fast_, h ) ){
+				hNext = 0.5*h;
+				rejected_ = true;
+				++statistics_.nRejectedSteps;
+				continue;
+			}
+
+			// first stage (the derivatives at the start of the macro step are known)
+			if ( tau == t_ ){
+				solve( luFast_, fast_, f_, k1_ );
+			} else {
+				interpolateSlow( y_, tau, H );
+				sys_( y_, g_, tau );
+				solve( luFast_, fast_, g_, k1_ );
+			}
+
+			// second stage
+			z_ = y_;
+			for ( std::size_t p = 0; p < fast_.size(); p++ )
+				z_[fast_[p]] += h*k1_[fast_[p]];
+			interpolateSlow( z_, tNext, H );
+			sys_( z_, g_, tNext );
+			for ( std::size_t p = 0; p < fast_.size(); p++ )
+				g_[fast_[p]] -= 2.0*k1_[fast_[p]];
+			solve( luFast_, fast_, g_, k2_ );
+
+			for ( std::size_t p = 0; p < fast_.size(); p++ ){
+				const std::size_t i = fast_[p];
+				z_[i] = y_[i] + h*( 1.5*k1_[i] + 0.5*k2_[i] );
+				err_[i] = 0.5*h*( k1_[i] + k2_[i] );
+			}
+
+			const fmiReal err = error( fast_, y_, z_ );
+			fmiReal factor = stepSizeFactor( err );
+			if ( err > 1.0 ){
+				hNext = h*factor;
+				rejected_ = true;
+				++statistics_.nRejectedSteps;
+				continue;
+			}
+
+			for ( std::size_t p = 0; p < fast_.size(); p++ )
+				y_[fast_[p]] = z_[fast_[p]];
+			tau = tNext;
+
+			if ( ( factor < 1.2 ) && ( factor >= 1.0 ) )
+				factor = 1.0; // keep the step size, which allows to reuse the factorization
+			// a step that has been shortened to the end of the macro step does not limit the next one
+			hNext = ( h < hNext ) ? std::max( hNext, h*factor ) : h*factor;
+		}
+
+		interpolateSlow( y_, tEnd, H );
+		hFast_ = hNext;
+		return true;
+	}
+
+public:
+	Multirate( DynamicalSystem* fmu, Integrator::Properties& properties ) :
+		ImplicitStepper( fmu, properties ),
+		gamma_( 1.0 + 1.0/std::sqrt( 2.0 ) ),
+		fastNames_( properties.fastStates ),
+		namesResolved_( false ),
+		partitionFixed_( false ),
+		fastFactorizedFor_( 0 ),
+		slowFactorizedFor_( 0 ),
+		jacobianAge_( 0 ),
+		rejected_( false ),
+		hFast_( 0 ),
+		fOld_( neq_ ), y_( neq_ ), z_( neq_ ), g_( neq_ ), k1_( neq_ ), k2_( neq_ ),
+		yPred_( neq_ ), err_( neq_ ), b_( neq_ )
+	{
+		properties.name  = "Multirate ROS2";
+		properties.order = 2;
+
+		// all states are fast until the partition is known
+		setPartition( std::vector< bool >( neq_, true ) );
+	}
+
+	void initialize( const state_type& states, fmiTime time, fmiTime dt, fmiTime tStop )
+	{
+		if ( !namesResolved_ ) resolveFastStates();
+
+		ImplicitStepper::initialize( states, time, dt, tStop );
+		fOld_ = f_;
+		hFast_ = dt;
+	}
+
+	void interpolate( fmiTime t, state_type& x ) const
+	{
+		interpolateHermite( t, fOld_, x );
+	}
+
+	bool step()
+	{
+		refreshJacobian( rejected_ || ( jacobianAge_ >= maxJacobianAge ) );
+
+		fmiReal err = 0.0;
+		fmiTime H = dt_;
+		while ( true ){
+			H = limitStepSize( dt_ );
+			if ( stepSizeTooSmall( t_, H ) ) return false;
+			const fmiTime tEnd = ( H == tStop_ - t_ ) ? tStop_ : t_ + H;
+
+			// first stage of the slow states and their prediction at the end of the macro step
+			if ( !factorize( luSlow_, slowFactorizedFor_, slow_, H ) ){
+				dt_ = 0.5*H;
+				++statistics_.nRejectedSteps;
+				continue;
+			}
+			solve( luSlow_, slow_, f_, k1_ );
+			for ( std::size_t p = 0; p < slow_.size(); p++ )
+				yPred_[slow_[p]] = x_[slow_[p]] + H*k1_[slow_[p]];
+
+			// sub-cycle the fast states
+			if ( !subcycle( H, tEnd ) ) return false;
+
+			// second stage of the slow states, with the fast states at the end of the macro step
+			z_ = y_;
+			if ( !slow_.empty() ){
+				sys_( y_, g_, tEnd );
+				for ( std::size_t p = 0; p < slow_.size(); p++ )
+					g_[slow_[p]] -= 2.0*k1_[slow_[p]];
+				solve( luSlow_, slow_, g_, k2_ );
+
+				for ( std::size_t p = 0; p < slow_.size(); p++ ){
+					const std::size_t i = slow_[p];
+					z_[i] = x_[i] + H*( 1.5*k1_[i] + 0.5*k2_[i] );
+					err_[i] = 0.5*H*( k1_[i] + k2_[i] );
+				}
+			}
+
+			err = error( slow_, x_, z_ );
+			if ( err > 1.0 ){
+				dt_ = H*stepSizeFactor( err );
+				rejected_ = true;
+				++statistics_.nRejectedSteps;
+
+				// try again with a fresh Jacobian (and partition) if the current one is outdated
+				refreshJacobian( true );
+				continue;
+			}
+
+			break;
+		}
+
+		// accept the macro step
+		xOld_ = x_;
+		tOld_ = t_;
+		fOld_ = f_;
+		x_ = z_;
+		advanceTime( H );
+		sys_( x_, f_, t_ );
+		jacCurrent_ = false;
+		++jacobianAge_;
+
+		if ( slow_.empty() ){
+			// single-rate: the macro steps follow the micro steps
+			dt_ = hFast_;
+		} else {
+			fmiReal factor = stepSizeFactor( err );
+			if ( ( factor < 1.2 ) && ( factor >= 1.0 ) )
+				factor = 1.0; // keep the step size, which allows to reuse the factorization
+			dt_ = H*factor;
+		}
+
+		return true;
+	}
+};
+
+
+/**
+ * Quantized state system methods QSS2 (Kofman) and LIQSS2 (Migoni et al.), for models with
+ * many discontinuities.
+ *
+ * Instead of discretizing time, the states are quantized: every state i has a trajectory x_i(t)
+ * of second order and a quantized trajectory q_i(t) of first order, and the derivatives are
+ * evaluated for the quantized states. The states are updated asynchronously: state i is
+ * requantized whenever x_i deviates from q_i by its quantum dQ_i = max( abstol, reltol*|x_i| ).
+ * Only the trajectories of the states whose derivatives depend on state i are updated then,
+ * according to the structural pattern of the Jacobian (see DynamicalSystem::getJacobianPattern).
+ * Since FMUs evaluate all derivatives at once, every update costs two evaluations of the
+ * right-hand side (the second one gives the time derivatives of the derivatives), independent
+ * of the number of affected states.
+ *
+ * LIQSS2 is the linearly implicit variant for stiff models: the quantized state is placed at the
+ * end of the quantum the state moves towards (or at its equilibrium), based on an estimate of
+ * the diagonal entry of the Jacobian, which is updated with every requantization. The state is
+ * requantized when it reaches the quantized state, or when it deviates by two quanta.
+ *
+ * State events are detected after every update of a state, like for the other steppers.
+ */
+class QSS : public IntegratorStepper
+{
+	const bool        linearlyImplicit_;  ///< use LIQSS2 instead of QSS2?
+	const fmiReal     abstol_;            ///< absolute tolerance (minimum quantum)
+	const fmiReal     reltol_;            ///< relative tolerance
+	const std::size_t neq_;               ///< dimension of the state space
+	system_wrapper    sys_;               ///< wrapped version of the DynamicalSystem
+
+	/// dependents_[j] contains the states whose derivatives depend on state j
+	std::vector< std::vector< std::size_t > > dependents_;
+
+	fmiTime    t_;                 ///< current time
+	state_type x_, dx_, ddx_;      ///< coefficients of the state trajectories at the times tx_
+	state_type tx_;                ///< times of the last updates of the state trajectories
+	state_type q_, dq_;            ///< coefficients of the quantized trajectories at the times tq_
+	state_type tq_;                ///< times of the last requantizations
+	state_type dQ_;                ///< quanta
+	state_type tNext_;             ///< times of the next requantizations
+	state_type a_;                 ///< estimates of the diagonal entries of the Jacobian (LIQSS2)
+	state_type y_, f_, f2_;        ///< temporary storage for the evaluation of the derivatives
+	state_type xNow_, xOld_;       ///< states at the current and the previous update
+
+	/// Get the pattern of the Jacobian, all derivatives depend on all states if it is unknown.
+	void initializeDependents()
+	{
+		std::vector< bool > pattern;
+		const bool known = fmu_->getJacobianPattern( pattern );
+
+		dependents_.assign( neq_, std::vector< std::size_t >() );
+		for ( std::size_t j = 0; j < neq_; j++ )
+			for ( std::size_t i = 0; i < neq_; i++ )
+				if ( !known || pattern[neq_*i + j] || ( i == j ) )
+					dependents_[j].push_back( i );
+	}
+
+	/// Evaluate the derivatives for the quantized states at time t (f_), and their time derivatives
+	/// along the quantized trajectories (f2_).
+	fmiTime evaluate( fmiTime t )
+	{
+		const fmiTime delta = 1.0e-8*std::max( 1.0, std::fabs( t ) );
+		for ( std::size_t k = 0; k < neq_; k++ )
+			y_[k] = q_[k] + dq_[k]*( t - tq_[k] );
+		sys_( y_, f_, t );
+		for ( std::size_t k = 0; k < neq_; k++ )
+			y_[k] += dq_[k]*delta;
+		sys_( y_, f2_, t + delta );
+		return delta;
+	}
+
+	/// Update the trajectory of state j at time t with the derivatives from the last evaluation.
+	void updateTrajectory( std::size_t j, fmiTime t, fmiTime delta )
+	{
+		const fmiTime s = t - tx_[j];
+		x_[j] += ( dx_[j] + 0.5*ddx_[j]*s )*s;
+		dx_[j] = f_[j];
+		ddx_[j] = ( f2_[j] - f_[j] )/delta;
+		tx_[j] = t;
+		tNext_[j] = nextTime( j );
+	}
+
+	/// Compute the time of the next requantization of state j.
+	fmiTime nextTime( std::size_t j ) const
+	{
+		// deviation of the state from the quantized state: d0 + d1*s + d2*s^2
+		const fmiReal d0 = x_[j] - q_[j] - dq_[j]*( tx_[j] - tq_[j] );
+		const fmiReal d1 = dx_[j] - dq_[j];
+		const fmiReal d2 = 0.5*ddx_[j];
+
+		fmiTime s = std::numeric_limits< fmiTime >::infinity();
+		if ( linearlyImplicit_ ){
+			if ( 0.0 != d0 ) s = std::min( s, firstRoot( d0, d1, d2 ) );
+			s = std::min( s, firstRoot( d0 - 2.0*dQ_[j], d1, d2 ) );
+			s = std::min( s, firstRoot( d0 + 2.0*dQ_[j], d1, d2 ) );
+		} else {
+			s = std::min( s, firstRoot( d0 - dQ_[j], d1, d2 ) );
+			s = std::min( s, firstRoot( d0 + dQ_[j], d1, d2 ) );
+		}
+		return tx_[j] + s;
+	}
+
+	/// Smallest positive root of c0 + c1*s + c2*s^2, infinity if there is none.
+	static fmiTime firstRoot( fmiReal c0, fmiReal c1, fmiReal c2 )
+	{
+		const fmiTime inf = std::numeric_limits< fmiTime >::infinity();
+		if ( 0.0 == c2 ){
+			const fmiTime s = ( 0.0 != c1 ) ? -c0/c1 : inf;
+			return ( s > 0.0 ) ? s : inf;
+		}
+
+		const fmiReal discriminant = c1*c1 - 4.0*c2*c0;
+		if ( discriminant < 0.0 ) return inf;
+
+		// numerically stable solution of the quadratic equation
+		const fmiReal w = -0.5*( c1 + ( c1 >= 0.0 ? 1.0 : -1.0 )*std::sqrt( discriminant ) );
+		const fmiTime s1 = w/c2;
+		const fmiTime s2 = ( 0.0 != w ) ? c0/w : inf;
+		fmiTime s = inf;
+		if ( s1 > 0.0 ) s = s1;
+		if ( ( s2 > 0.0 ) && ( s2 < s ) ) s = s2;
+		return s;
+	}
+
+	/// Requantize state i at time t and update the trajectories of the affected states.
+	void requantize( std::size_t i, fmiTime t )
+	{
+		// advance the trajectory of state i
+		const fmiTime s = t - tx_[i];
+		x_[i] += ( dx_[i] + 0.5*ddx_[i]*s )*s;
+		dx_[i] += ddx_[i]*s;
+		tx_[i] = t;
+
+		const fmiReal qOld = q_[i] + dq_[i]*( t - tq_[i] );
+		const fmiReal slope = dx_[i];
+		dQ_[i] = std::max( abstol_, reltol_*std::fabs( x_[i] ) );
+
+		if ( linearlyImplicit_ && ( 0.0 != a_[i] ) ){
+			// the derivative is approximately a*q + u + du*( t' - t ). The quantized state
+			// follows the slope of the state, and is placed at the end of the quantum the
+			// state is accelerated towards (or where the second derivative vanishes)
+			const fmiReal a = a_[i];
+			const fmiReal u = slope - a*qOld;
+			const fmiReal du = ddx_[i] - a*dq_[i];
+			const fmiReal upper = x_[i] + dQ_[i];
+			const fmiReal lower = x_[i] - dQ_[i];
+
+			if ( a*( a*upper + u ) + du > 0.0 )
+				q_[i] = upper;
+			else if ( a*( a*lower + u ) + du < 0.0 )
+				q_[i] = lower;
+			else
+				q_[i] = -( u + du/a )/a;
+			dq_[i] = a*q_[i] + u;
+		} else {
+			q_[i] = x_[i];
+			dq_[i] = slope;
+		}
+		tq_[i] = t;
+
+		const fmiTime delta = evaluate( t );
+
+		// estimate the diagonal entry of the Jacobian from the change of the derivative
+		if ( linearlyImplicit_ && ( q_[i] != qOld ) ){
+			const fmiReal a = ( f_[i] - slope )/( q_[i] - qOld );
+			if ( std::fabs( a ) <= std::numeric_limits< fmiReal >::max() ) a_[i] = a;
+		}
+
+		const std::vector< std::size_t >& dependents = dependents_[i];
+		for ( std::size_t k = 0; k < dependents.size(); k++ )
+			updateTrajectory( dependents[k], t, delta );
+	}
+
+	/// Start from the given states at the given time.
+	void initialize( const state_type& states, fmiTime time )
+	{
+		if ( dependents_.empty() ) initializeDependents();
+
+		t_ = time;
+		x_ = q_ = states;
+		std::fill( dq_.begin(), dq_.end(), 0.0 );
+		std::fill( tx_.begin(), tx_.end(), time );
+		std::fill( tq_.begin(), tq_.end(), time );
+		for ( std::size_t k = 0; k < neq_; k++ )
+			dQ_[k] = std::max( abstol_, reltol_*std::fabs( x_[k] ) );
+
+		// the slopes of the quantized trajectories are the derivatives
+		sys_( q_, dq_, time );
+		const fmiTime delta = evaluate( time );
+		for ( std::size_t k = 0; k < neq_; k++ )
+			updateTrajectory( k, time, delta );
+	}
+
+	/// Index of the state with the next requantization.
+	std::size_t nextState() const
+	{
+		return std::min_element( tNext_.begin(), tNext_.end() ) - tNext_.begin();
+	}
+
+	/// Evaluate the state trajectories at time t.
+	void currentStates( fmiTime t, state_type& x ) const
+	{
+		for ( std::size_t k = 0; k < neq_; k++ ){
+			const fmiTime s = t - tx_[k];
+			x[k] = x_[k] + ( dx_[k] + 0.5*ddx_[k]*s )*s;
+		}
+	}
+
+public:
+	QSS( DynamicalSystem* fmu, Integrator::Properties& properties, bool linearlyImplicit ) :
+		IntegratorStepper( fmu ),
+		linearlyImplicit_( linearlyImplicit ),
+		abstol_( properties.abstol != properties.abstol ? 1.0e-6 : properties.abstol ),
+		reltol_( properties.reltol != properties.reltol ? 1.0e-6 : properties.reltol ),
+		neq_( fmu->nStates() ),
+		sys_( fmu, &statistics_.nRhsEvaluations ),
+		t_( 0 ),
+		x_( neq_ ), dx_( neq_ ), ddx_( neq_ ), tx_( neq_ ),
+		q_( neq_ ), dq_( neq_ ), tq_( neq_ ), dQ_( neq_ ), tNext_( neq_ ),
+		a_( neq_, 0.0 ), y_( neq_ ), f_( neq_ ), f2_( neq_ ), xNow_( neq_ ), xOld_( neq_ )
+	{
+		properties.name  = linearlyImplicit ? "LIQSS2" : "QSS2";
+		properties.order = 2;
+
+		// add missing tolerances if necessary
+		if ( properties.abstol != properties.abstol )
+			properties.abstol = 1.0e-6;
+		if ( properties.reltol != properties.reltol )
+			properties.reltol = 1.0e-6;
+	}
+
+	void invokeMethod( EventInfo& eventInfo,
+			   state_type& states,
+			   fmiTime time,
+			   fmiTime step_size,
+			   fmiTime dt,
+			   fmiTime eventSearchPrecision ){
+		const fmiTime tEnd = time + step_size;
+		initialize( states, time );
+		xOld_ = states;
+		fmiTime tOld = time;
+
+		while ( true ){
+			// requantize the next state, or stop at the end of the step (the state trajectories
+			// may be valid over long intervals, events are checked there as well)
+			const std::size_t i = nextState();
+			const bool last = ( 0 == neq_ ) || ( tNext_[i] >= tEnd );
+			if ( last ){
+				t_ = tEnd;
+			} else {
+				t_ = tNext_[i];
+				requantize( i, t_ );
+				stepAccepted( t_ - tOld );
+			}
+
+			// event detection like in OdeintStepper
+			currentStates( t_, xNow_ );
+			fmu_->setTime( t_ );
+			fmu_->setContinuousStates( &xNow_[0] );
+			if ( fmu_->checkStateEvent() ){
+				// set back to the backup state/time
+				states = xOld_;
+				fmu_->setTime( tOld );
+				fmu_->setContinuousStates( &states[0] );
+
+				// tell the integrator about the event
+				eventInfo.stepEvent  = false;
+				eventInfo.stateEvent = true;
+				eventInfo.tLower     = tOld;
+				eventInfo.tUpper     = t_;
+
+				return;
+			}
+
+			if ( last ) break;
+
+			if ( fmu_->checkStepEvent() ){
+				// tell the integrator about the event
+				states = xNow_;
+				eventInfo.stepEvent  = true;
+				eventInfo.stateEvent = false;
+
+				return;
+			}
+
+			xOld_.swap( xNow_ );
+			tOld = t_;
+		}
+
+		// the results have already been written to the FMU
+		states = xNow_;
+
+		eventInfo.stateEvent = false;
+		eventInfo.stepEvent  = false;
+	}
+
+	void do_step_const( EventInfo& eventInfo,
+			    state_type& states,
+			    fmiTime& time,
+			    fmiTime& dt ){
+		const fmiTime target = time + dt;
+		initialize( states, time );
+
+		std::size_t i = nextState();
+		while ( ( neq_ > 0 ) && ( tNext_[i] < target ) ){
+			stepAccepted( tNext_[i] - t_ );
+			t_ = tNext_[i];
+			requantize( i, t_ );
+			i = nextState();
+		}
+
+		t_ = time = target;
+		currentStates( t_, states );
+		fmu_->setTime( time );
+		fmu_->setContinuousStates( &states[0] );
+	}
+};
+
+#ifdef USE_SUNDIALS
+/**
+ * Base class for all implementations of sundials steppers
+ *
+ * CVode is used in the one step mode: the event indicators of the FMU are passed as root
+ * functions, so state events are located by CVode itself, and step events are checked after
+ * every internal step.
+ */
+class SundialsStepper : public IntegratorStepper
+{
+
+private:
+	/**
+	 * the righthandside of the ode
+	 *
+	 * @param[in]		t		time
+	 * @param[in]		x		state
+	 * @param[out]		dx		the derivatives at ( x, t )
+	 * @param[in,out]	user_data	the fmu to be evaluated. The states of the fmu
+	 *					are ( x, t ) after the call
+	 */
+	static int f( fmiTime t, N_Vector x, N_Vector dx, void *user_data )
+        {
+		DynamicalSystem* fmu = (DynamicalSystem*) user_data;
+		fmu->setTime( t );
+		fmu->setContinuousStates( N_VGetArrayPointer(x) );
+		fmu->getDerivatives( N_VGetArrayPointer(dx) );
+		return 0 ;
+		// \FIXME: return 1 in case one of rhe calls fmu->setContinuousStates, fmu->setTime
+		//         or fmu->getDerivatives was *not* sucessful
+
+	}
+
+	/**
+	 * the event indicator function
+	 *
+	 * @param[in]		t		time
+	 * @param[in]		x		state
+	 * @param[out]		eventsind	the event indicators at ( x, t )
+	 * @param[in,out]	user_data	the fmu to be evaluated. The states of the fmu
+	 *					are ( x, t ) after the call
+	 */
+	static int g( fmiTime t, N_Vector x, fmiReal *eventsind, void *user_data )
+	{
+		DynamicalSystem* fmu = (DynamicalSystem*) user_data;
+		fmu->setTime( t );
+		fmu->setContinuousStates( N_VGetArrayPointer( x ) );
+		return fmu->getEventIndicators( eventsind );
+		// \FIXME: return 1 in case one of rhe calls fmu->setContinuousStates, fmu->setTime
+		//         was *not* sucessful
+	}
+
+	/**
+	 * Jacobian matrix
+	 * like for the rhs, states have to be converted. This function will not be used in case
+	 * the fmu is of type 1.0 or the modeldescription does not explicitly say that the Jacobian
+	 * is available
+	 *
+	 * @param[in]      N                    the dimension of the state space ( equal to NEQ_ )
+	 * @param[in]      t,x                  time and state
+	 * @param[in]      fx                   current derivative
+	 * @param[out]     J                    the dense jacobian martix
+	 * @param[in]      user_data            the dynamical system
+	 * @param[in,out]  tmp1,tmp2,tmp3       variables used internally by CVode
+	 *
+	 */
+	static int Jac( long int N, fmiTime t, N_Vector x, N_Vector fx,
+			DlsMat J, void *user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3 )
+	{
+		DynamicalSystem* ds = (DynamicalSystem*) user_data;
+
+		// send the input state/time to the FMU
+		ds->setTime( t );
+		ds->setContinuousStates( N_VGetArrayPointer( x ) );
+		// get the jacobian
+		fmiStatus status = ds->getJac( J->data );
+		// tell SUNDIALs whether the call to getJac was successful
+		if ( status == fmiOK )
+			return 0;
+		else
+			return 1;
+	}
+  
+	const int NEQ_;				///< dimension of state space
+	const int NEV_;				///< number of event indicators
+	N_Vector states_N_;			///< states in N_Vector format
+	fmiTime t_;				///< internal time
+	const realtype reltol_;			///< relative tolerance
+	const realtype abstol_;			///< absolute tolerance
+	void *cvode_mem_;			///< memory of the stepper. This memory later stores
+						///< the RHS, states, time and buffer datas for the
+						///< multistep methods
+	bool reinit_;				///< does cvode have to be reinitialized ( see reset() )?
+	Integrator::Statistics counted_;	///< counters of cvode already contained in statistics_
+
+	/// Get the counters of cvode (since the last reinitialization).
+	Integrator::Statistics cvodeStatistics() const
+	{
+		long int nRhs = 0, nJac = 0, nSetups = 0, nSteps = 0, nErrFails = 0, nConvFails = 0;
+		realtype hLast = 0;
+		CVodeGetNumRhsEvals( cvode_mem_, &nRhs );
+		CVDlsGetNumJacEvals( cvode_mem_, &nJac );
+		CVodeGetNumLinSolvSetups( cvode_mem_, &nSetups );
+		CVodeGetNumSteps( cvode_mem_, &nSteps );
+		CVodeGetNumErrTestFails( cvode_mem_, &nErrFails );
+		CVodeGetNumNonlinSolvConvFails( cvode_mem_, &nConvFails );
+		CVodeGetLastStep( cvode_mem_, &hLast );
+
+		Integrator::Statistics statistics;
+		statistics.nRhsEvaluations = nRhs;
+		statistics.nJacobianEvaluations = nJac;
+		statistics.nFactorizations = nSetups;
+		statistics.nAcceptedSteps = nSteps;
+		statistics.nRejectedSteps = nErrFails + nConvFails;
+		statistics.lastStepSize = hLast;
+		return statistics;
+	}
+
+	/// Get statistics_ plus the counters of cvode that have not been added yet.
+	Integrator::Statistics collectedStatistics() const
+	{
+		const Integrator::Statistics current = cvodeStatistics();
+		Integrator::Statistics statistics = statistics_;
+		statistics.nRhsEvaluations += current.nRhsEvaluations - counted_.nRhsEvaluations;
+		statistics.nJacobianEvaluations += current.nJacobianEvaluations - counted_.nJacobianEvaluations;
+		statistics.nFactorizations += current.nFactorizations - counted_.nFactorizations;
+		statistics.nAcceptedSteps += current.nAcceptedSteps - counted_.nAcceptedSteps;
+		statistics.nRejectedSteps += current.nRejectedSteps - counted_.nRejectedSteps;
+		if ( current.nAcceptedSteps > counted_.nAcceptedSteps )
+			statistics.lastStepSize = current.lastStepSize;
+		return statistics;
+	}
+
+  
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param[in] fmu	 the fmu to be integrated
+	 * @param[in] isBDF	 bool saying wether the bdf or the abm version is required
+	 */
+	SundialsStepper( DynamicalSystem* fmu, bool isBDF, Integrator::Properties& properties ) :
+		IntegratorStepper( fmu ),
+		NEQ_( fmu->nStates() ),
+		NEV_( fmu->nEventInds() ),
+		states_N_( N_VNew_Serial( NEQ_ ) ),
+		t_( 0 ),
+		reltol_( properties.reltol != properties.reltol ? 1e-10 : properties.reltol ),
+		abstol_( properties.abstol != properties.abstol ? 1e-10 : properties.abstol ),
+		cvode_mem_( 0 ),
+		reinit_( true )
+	{
+		// add missing tolerances if necessary
+		if ( properties.abstol != properties.abstol )
+			properties.abstol = 1.0e-10;
+		if ( properties.reltol != properties.reltol )
+			properties.reltol = 1.0e-10;
+
+		// choose solution procedure
+		if ( isBDF )
+			cvode_mem_ = CVodeCreate( CV_BDF, CV_NEWTON );
+		else
+			cvode_mem_ = CVodeCreate( CV_ADAMS, CV_FUNCTIONAL );
+		
+		// other possible options are not available even tough they perform well
+		//   *  cvode_mem_ = CVodeCreate( CV_ADAMS, CV_NEWTON );
+		//   *  cvode_mem_ = CVodeCreate( CV_BDF, CV_FUNCTIONAL );
+
+		// set the fmu as (void*) user_data
+		CVodeSetUserData( cvode_mem_, fmu_ );
+
+		// set initial conditions and RHS
+		CVodeInit( cvode_mem_, f, t_, states_N_ );
+
+		// pass the event indicators as root function
+		CVodeRootInit( cvode_mem_, NEV_, g );
+
+		// set tolerances
+		CVodeSStolerances( cvode_mem_ ,reltol_ ,abstol_ );
+
+		// Detrmine which procedure to use for linear equations. Since the jacobean is dense,
+		// CVDense is the choice here.
+		CVDense( cvode_mem_, NEQ_ );
+
+		// Set the Jacobian routine to Jac if available. Do not use the numeric jacobian for sundials
+		if ( fmu_->providesJacobian() )
+			CVDlsSetDenseJacFn( cvode_mem_, Jac );
+
+		//CVodeSetErrFile( cvode_mem, NULL ); // uncomment to suppress error messages
+
+		CVodeSetMaxNumSteps( cvode_mem_, static_cast<long>( 1.0e5 ) );
+	}
+
+	~SundialsStepper()
+	{
+		CVodeFree( &cvode_mem_ );
+		N_VDestroy_Serial( states_N_ );
+	}
+
+
+	void invokeMethod( EventInfo& eventInfo, state_type& states,
+			   fmiTime time, fmiTime step_size, fmiTime dt,
+			   fmiTime eventSearchPrecision )
+	{
+		/// \todo add more proper event handling to sundials: currently, time events are
+		///       just checked at the begining of each invokeMethod call.
+
+		const fmiTime tEnd = time + step_size;
+
+		// write input into internal time
+		t_ = time;
+
+		// reinitialize cvode only if the states changed externally ( otherwise, the
+		// history and the step size of the multistep method are kept )
+		if ( reinit_ ){
+			// Convert states into N_Vector format
+			for ( int i = 0; i < NEQ_; i++ ) {
+				Ith( states_N_ , i ) = states[ i ];
+			}
+
+			// reinitialize cvode. this deletes internal memeory (and resets the counters)
+			statistics_ = collectedStatistics();
+			CVodeReInit( cvode_mem_, t_, states_N_ );
+			counted_ = Integrator::Statistics();
+
+			// set initial step size
+			CVodeSetInitStep( cvode_mem_, dt );
+
+			reinit_ = false;
+		}
+
+		// do not step beyond the end of the integration interval
+		CVodeSetStopTime( cvode_mem_, tEnd );
+
+		eventInfo.stateEvent = false;
+		eventInfo.stepEvent  = false;
+
+		while ( true ){
+			// make one internal step. The roots of the event indicators are located by cvode
+			int flag = CVode( cvode_mem_, tEnd, states_N_, &t_, CV_ONE_STEP );
+
+			if ( flag == CV_ROOT_RETURN ){
+				eventInfo.stateEvent = true;
+
+				/*
+				 * rewind the states to make sure the returned state/time is shortly *before* the
+				 * event. The rewinding tends to cause bugs if rewind is smaller than the precision
+				 * of the sundials solvers. This precision is 100 times the precision of doubles (~1e-14)
+				 * according to the official documentation of CVode. However, if the fmu is coded in
+				 * floats it might be necessary to adapt the figure rewind
+				 *
+				 * \todo test with float fmu
+				*/
+				fmiTime rewind = eventSearchPrecision/10.0;
+				if ( rewind <= 1.0e-12 ){
+					std::cout << "WARNING: the specified eventsearchprecision might be too small"
+						  << " for the use with sundials" << std::endl;
+				}
+				const fmiTime tRoot = t_;
+				t_ -= rewind;
+
+				// let the fmu register the state event ( i.e., the crossed event indicators )
+				// at the root, where the event indicators have already changed their signs
+				fmu_->setTime( tRoot );
+				fmu_->setContinuousStates( N_VGetArrayPointer( states_N_ ) );
+				fmu_->checkStateEvent();
+
+				// use the dense output of cvode for the rewinded states. If the rewinded time
+				// is not covered by the last step, use an explicit euler step instead
+				if ( CV_SUCCESS != CVodeGetDky( cvode_mem_, t_, 0, states_N_ ) ){
+					state_type dx( NEQ_ );
+					fmu_->getDerivatives( &dx[0] );
+					for ( int i = 0; i < NEQ_; i++ )
+						Ith( states_N_, i ) -= rewind*dx[i];
+				}
+
+				for ( int i = 0; i < NEQ_; i++ ) {
+					states[i] = Ith( states_N_, i );
+				}
+
+				// wrtite solution into the fmu ( i.e. set back the time/states )
+				fmu_->setTime( t_ );
+				fmu_->setContinuousStates( &states.front() );
+
+				// tell FMUModelexchange the EventHorizon ( upper and lower limit for the
+				// state-event-time ). Because of the stop time, the root lies within the
+				// integration interval
+				eventInfo.tUpper = std::min( tRoot + rewind, tEnd );
+				eventInfo.tLower = t_;
+
+				return;
+			}
+			else if ( ( flag == CV_SUCCESS ) || ( flag == CV_TSTOP_RETURN ) ){
+				// convert output of cvode in state_type format
+				for ( int i = 0; i < NEQ_; i++ ) {
+					states[i] = Ith( states_N_, i );
+				}
+
+				// no state event happened -> write the result of the internal step into the fmu
+				fmu_->setTime( t_ );
+				fmu_->setContinuousStates( &states.front() );
+
+				// call completedIntegratorStep after every internal step
+				if ( fmu_->checkStepEvent() ){
+					eventInfo.stepEvent = true;
+					return;
+				}
+
+				if ( flag == CV_TSTOP_RETURN )
+					return;
+			}
+			else{
+				std::cout << "an exception happened when running the sundials stepper" << std::endl;
+				reinit_ = true;
+				return;
+			}
+		}
+	}
+
+	void reset(){
+		reinit_ = true;
+	}
+
+	bool keepsHistory() const { return true; }
+
+	Integrator::Statistics getStatistics() const { return collectedStatistics(); }
+
+	void resetStatistics()
+	{
+		counted_ = cvodeStatistics();
+		statistics_ = Integrator::Statistics();
 	}
 };
 
@@ -985,6 +3045,14 @@ IntegratorStepper* IntegratorStepper::createStepper( Integrator::Properties& pro
 	case IntegratorType::bs		: return new BulirschStoer        ( fmu, properties );
 	case IntegratorType::abm	: return new AdamsBashforthMoulton( fmu, properties );
 	case IntegratorType::ro         : return new Rosenbrock           ( fmu, properties );
+	case IntegratorType::rol        : return new RosenbrockLU         ( fmu, properties );
+	case IntegratorType::lie        : return new LinearlyImplicitEuler( fmu, properties );
+	case IntegratorType::rad        : return new RadauIIA             ( fmu, properties );
+	case IntegratorType::esd2       : return new ESDIRK               ( fmu, properties, ESDIRK::trbdf2 );
+	case IntegratorType::esd3       : return new ESDIRK               ( fmu, properties, ESDIRK::esdirk32 );
+	case IntegratorType::mr         : return new Multirate            ( fmu, properties );
+	case IntegratorType::qss        : return new QSS                  ( fmu, properties, false );
+	case IntegratorType::liqss      : return new QSS                  ( fmu, properties, true );
 #ifdef USE_SUNDIALS
 	case IntegratorType::bdf	: return new BackwardsDifferentiationFormula( fmu, properties );
 	case IntegratorType::abm2	: return new AdamsBashforthMoulton2         ( fmu, properties );
@@ -20,7 +20,11 @@
 #define __FMI_DLL
 
 
+#if defined(SWIGPYTHON)
+%module(threads="1") fmippim
+#else
 %module fmippim
+#endif
 
 %{
   //  typedef double fmiReal;
@@ -35,6 +39,7 @@
 #include "import/base/include/FMUCoSimulation.h"
 #include "import/base/include/LogBuffer.h"
 #include "import/integrators/include/IntegratorType.h"
+#include "import/integrators/include/IntegratorStatistics.h"
 #include "import/utility/include/RollbackFMU.h"
 #include "import/utility/include/IncrementalFMU.h"
 #include "import/utility/include/FixedStepSizeFMU.h"
@@ -72,9 +77,226 @@
  }
 %ignore fmi2False;
 %ignore fmi2True;
+
+// Zero-copy access to arrays from Python: arguments of type fmiReal*, fmiInteger* and
+// fmiValueReference* accept any C-contiguous object supporting the buffer protocol with a
+// matching item type (e.g., NumPy arrays or array.array), the FMU reads and writes their
+// memory directly. SWIG arrays (see %array_functions) are still accepted. As for SWIG
+// arrays, the caller is responsible for passing arrays of sufficient length.
+%{
+#include <cstring>
+
+// Check the item format of a buffer, ignoring the native byte order/alignment prefixes.
+static bool fmippim_checkFormat( const char* format, const char* kinds, Py_ssize_t itemsize, std::size_t size )
+{
+	if ( 0 == format ) format = "B";
+	if ( ( '@' == *format ) || ( '=' == *format ) ) ++format;
+	return ( static_cast<std::size_t>( itemsize ) == size ) &&
+		( 0 != *format ) && ( 0 == format[1] ) && ( 0 != strchr( kinds, *format ) );
+}
+
+// Get a C-contiguous buffer with the given item type, returns false (and clears the Python
+// error) if the object does not provide one.
+static bool fmippim_getBuffer( PyObject* obj, Py_buffer* view, const char* kinds, std::size_t size, bool writable )
+{
+	if ( !PyObject_CheckBuffer( obj ) ) return false;
+
+	int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
+	if ( writable ) flags |= PyBUF_WRITABLE;
+	if ( 0 != PyObject_GetBuffer( obj, view, flags ) ) {
+		PyErr_Clear();
+		return false;
+	}
+
+	if ( !fmippim_checkFormat( view->format, kinds, view->itemsize, size ) ) {
+		PyBuffer_Release( view );
+		return false;
+	}
+
+	return true;
+}
+
+// Check whether an object provides a C-contiguous buffer with the given item type.
+static bool fmippim_checkBuffer( PyObject* obj, const char* kinds, std::size_t size )
+{
+	Py_buffer view;
+	if ( !fmippim_getBuffer( obj, &view, kinds, size, false ) ) return false;
+	PyBuffer_Release( &view );
+	return true;
+}
+
+#if PY_VERSION_HEX >= 0x03030000
+// Exporter of a buffer of items owned by another Python object (e.g., the outputs of an FMU).
+// It keeps a reference to the owner, hence the memory stays valid as long as views of it exist.
+struct fmippim_BufferExporter {
+	PyObject_HEAD
+	PyObject* owner;
+	void* data;
+	Py_ssize_t shape;
+	Py_ssize_t itemsize;
+	char* format;
+};
+
+static int fmippim_BufferExporter_getbuffer( PyObject* self, Py_buffer* view, int flags )
+{
+	fmippim_BufferExporter* exporter = reinterpret_cast<fmippim_BufferExporter*>( self );
+
+	Py_INCREF( self );
+	view->obj = self;
+	view->buf = exporter->data;
+	view->len = exporter->shape*exporter->itemsize;
+	view->readonly = 0;
+	view->itemsize = exporter->itemsize;
+	view->format = ( flags & PyBUF_FORMAT ) ? exporter->format : 0;
+	view->ndim = 1;
+	view->shape = ( flags & PyBUF_ND ) ? &exporter->shape : 0;
+	view->strides = ( PyBUF_STRIDES == ( flags & PyBUF_STRIDES ) ) ? &exporter->itemsize : 0;
+	view->suboffsets = 0;
+	view->internal = 0;
+	return 0;
+}
+
+static void fmippim_BufferExporter_dealloc( PyObject* self )
+{
+	PyTypeObject* type = Py_TYPE( self );
+	Py_XDECREF( reinterpret_cast<fmippim_BufferExporter*>( self )->owner );
+	type->tp_free( self );
+#if PY_VERSION_HEX >= 0x03080000
+	Py_DECREF( type ); // Instances of heap types own a reference to their type.
+#endif
+}
+
+static PyType_Slot fmippim_BufferExporter_slots[] = {
+	{ Py_bf_getbuffer, reinterpret_cast<void*>( fmippim_BufferExporter_getbuffer ) },
+	{ Py_tp_dealloc, reinterpret_cast<void*>( fmippim_BufferExporter_dealloc ) },
+	{ 0, 0 }
+};
+
+static PyType_Spec fmippim_BufferExporter_spec = {
+	"fmippim.BufferExporter", sizeof( fmippim_BufferExporter ), 0, Py_TPFLAGS_DEFAULT, fmippim_BufferExporter_slots
+};
+#endif
+
+// Create a one-dimensional view of n items owned by a Python object (without copying). The
+// view keeps the owner alive. Use numpy.asarray( view ) to get a NumPy array sharing the memory.
+static PyObject* fmippim_view( PyObject* owner, void* data, std::size_t n, const char* format, std::size_t size )
+{
+	static char empty = 0;
+	if ( 0 == data ) {
+		data = &empty;
+		n = 0;
+	}
+
+#if PY_VERSION_HEX >= 0x03030000
+	static PyObject* exporterType = 0;
+	if ( 0 == exporterType ) {
+		exporterType = PyType_FromSpec( &fmippim_BufferExporter_spec );
+		if ( 0 == exporterType ) return 0;
+	}
+
+	PyObject* exporterObject = PyType_GenericAlloc( reinterpret_cast<PyTypeObject*>( exporterType ), 0 );
+	if ( 0 == exporterObject ) return 0;
+
+	fmippim_BufferExporter* exporter = reinterpret_cast<fmippim_BufferExporter*>( exporterObject );
+	Py_INCREF( owner );
+	exporter->owner = owner;
+	exporter->data = data;
+	exporter->shape = static_cast<Py_ssize_t>( n );
+	exporter->itemsize = static_cast<Py_ssize_t>( size );
+	exporter->format = const_cast<char*>( format );
+
+	PyObject* view = PyMemoryView_FromObject( exporterObject );
+	Py_DECREF( exporterObject ); // Owned by the view from now on.
+	return view;
+#else
+	// Python 2 buffers cannot keep the owner alive, return a copy instead (use numpy.frombuffer( copy, dtype )).
+	return PyByteArray_FromStringAndSize( static_cast<const char*>( data ), n*size );
+#endif
+}
+%}
+
+%define %fmippim_buffer_typemap( TYPE, KINDS, WRITABLE )
+%typemap(in) TYPE* ( Py_buffer view, bool hasView = false ) {
+	if ( fmippim_getBuffer( $input, &view, KINDS, sizeof( TYPE ), WRITABLE ) ) {
+		$1 = ( $1_ltype ) view.buf;
+		hasView = true;
+	} else if ( !SWIG_IsOK( SWIG_ConvertPtr( $input, (void**) &$1, $1_descriptor, 0 ) ) ) {
+		SWIG_exception_fail( SWIG_TypeError, "in method '" "$symname" "', argument " "$argnum"
+				     " must be a contiguous array of " #TYPE " or a SWIG array" );
+	}
+}
+%typemap(freearg) TYPE* {
+	if ( hasView$argnum ) PyBuffer_Release( &view$argnum );
+}
+%typemap(typecheck, precedence=SWIG_TYPECHECK_INT32_ARRAY) TYPE* {
+	void* ptr = 0;
+	$1 = fmippim_checkBuffer( $input, KINDS, sizeof( TYPE ) ) ||
+		SWIG_IsOK( SWIG_ConvertPtr( $input, &ptr, $1_descriptor, 0 ) );
+}
+%enddef
+
+%define %fmippim_buffer_typemaps( TYPE, KINDS )
+%fmippim_buffer_typemap( TYPE, KINDS, true )
+%fmippim_buffer_typemap( const TYPE, KINDS, false )
+%enddef
+
+%fmippim_buffer_typemaps( fmiReal, "d" )
+%fmippim_buffer_typemaps( fmiInteger, "bhilq" )
+%fmippim_buffer_typemaps( fmiValueReference, "BHILQ" )
+
+// Release the GIL during the long-running calls only, so that several FMUs can be simulated
+// concurrently from Python threads. An FMU object must not be used by several threads at once.
+%nothread;
+%thread fmi_1_0::FMUModelExchange::integrate;
+%thread fmi_2_0::FMUModelExchange::integrate;
+%thread FMUCoSimulation::doStep;
+%thread RollbackFMU::integrate;
+%thread IncrementalFMU::sync;
+%thread FixedStepSizeFMU::sync;
+%thread InterpolatingFixedStepSizeFMU::sync;
+
+// Views of the current real outputs, which are updated in place. A view keeps its FMU alive, it
+// refers to the outputs as defined when the view was created.
+%extend IncrementalFMU {
+	PyObject* _getRealOutputsView( PyObject* owner ) {
+		return fmippim_view( owner, $self->getRealOutputs(), $self->nRealOutputs(), "d", sizeof( fmiReal ) );
+	}
+%pythoncode %{
+    def getRealOutputsView(self):
+        return self._getRealOutputsView(self)
+%}
+}
+%extend FixedStepSizeFMU {
+	PyObject* _getRealOutputsView( PyObject* owner ) {
+		return fmippim_view( owner, $self->getRealOutputs(), $self->nRealOutputs(), "d", sizeof( fmiReal ) );
+	}
+%pythoncode %{
+    def getRealOutputsView(self):
+        return self._getRealOutputsView(self)
+%}
+}
+%extend InterpolatingFixedStepSizeFMU {
+	PyObject* _getRealOutputsView( PyObject* owner ) {
+		return fmippim_view( owner, $self->getRealOutputs(), $self->nRealOutputs(), "d", sizeof( fmiReal ) );
+	}
+%pythoncode %{
+    def getRealOutputsView(self):
+        return self._getRealOutputsView(self)
+%}
+}
 #else
 #endif
 
+// FMUModelExchangeBase is not wrapped, provide the integrator statistics for both FMI versions
+%extend fmi_1_0::FMUModelExchange {
+	IntegratorStatistics getIntegratorStatistics() { return $self->getIntegratorStatistics(); }
+	void resetIntegratorStatistics() { $self->resetIntegratorStatistics(); }
+}
+%extend fmi_2_0::FMUModelExchange {
+	IntegratorStatistics getIntegratorStatistics() { return $self->getIntegratorStatistics(); }
+	void resetIntegratorStatistics() { $self->resetIntegratorStatistics(); }
+}
+
 %ignore getCurrentState;
 %ignore getValue( const std::string& , fmiReal* );
 %include "common/FMIType.h"
@@ -88,6 +310,7 @@
 %include "import/base/include/FMUCoSimulation.h"
 %include "import/base/include/LogBuffer.h"
 %include "import/integrators/include/IntegratorType.h"
+%include "import/integrators/include/IntegratorStatistics.h"
 %include "import/utility/include/IncrementalFMU.h"
 %include "import/utility/include/RollbackFMU.h"
 %include "import/utility/include/FixedStepSizeFMU.h"
@@ -8,6 +8,7 @@
 
 
 #include <string>
+#include <vector>
 
 #include "common/FMIPPConfig.h"
 #include "common/fmi_v1.0/fmiModelTypes.h"
@@ -25,6 +26,14 @@ class FMUCoSimulation;
  * Eases the handling of FMU CS in case a fixed communication step size is enforced by the enclosed model.
  *
  * The FixedStepSizeFMU handles the proper synchronization of the FMU CS internally.
+ *
+ * Optionally, the communication step size can be adapted during the simulation (for FMUs that can
+ * handle variable communication step sizes, see enableAdaptiveStepSize). Before each step, the real
+ * outputs are extrapolated to the end of the step, either using the output derivatives provided by
+ * the FMU or linearly from the previous communication point. The deviation of the actual outputs
+ * from this prediction serves as error estimate for choosing the next step size. Since FMUs for
+ * CS (FMI 1.0) cannot restore a previous state, steps are never repeated, i.e., the error estimate
+ * only affects the size of the next step.
  */
 
 class __FMI_DLL FixedStepSizeFMU
@@ -99,6 +108,9 @@ public:
 	/// Get pointer to current outputs.
 	fmiReal* getRealOutputs() const { return currentState_.realValues_; }
 
+	/// Get number of real outputs.
+	std::size_t nRealOutputs() const { return nRealOutputs_; }
+
 	/// Get pointer to current outputs.
 	fmiInteger* getIntegerOutputs() const { return currentState_.integerValues_; }
 
@@ -125,6 +137,26 @@ public:
 	/// Get the status of the last operation on the FMU.
 	fmiStatus getLastStatus() const;
 
+	/**
+	 * Enable adaptive communication step size control. The step size is chosen such that the
+	 * deviation of the real outputs from their extrapolation over one step stays (approximately)
+	 * below tolerance * ( 1 + |output| ). The communication step size given to init(...) is used
+	 * as initial step size.
+	 *
+	 * @param[in]  tolerance  tolerance of the error estimate
+	 * @param[in]  minStepSize  minimal communication step size
+	 * @param[in]  maxStepSize  maximal communication step size
+	 */
+	void enableAdaptiveStepSize( const fmiReal tolerance,
+				     const fmiTime minStepSize,
+				     const fmiTime maxStepSize );
+
+	/// Disable adaptive communication step size control (the current step size will be kept).
+	void disableAdaptiveStepSize();
+
+	/// Get the current communication step size.
+	fmiTime getCommunicationStepSize() const { return communicationStepSize_; }
+
 protected:
 
 	fmiReal currentCommunicationPoint_;
@@ -172,6 +204,12 @@ protected:
 	/** Get the string outputs of the FMU. **/
 	void getOutputs( std::string* outputs ) const;
 
+	/** Predict the real outputs at the end of the next communication step, returns the order of the prediction (0 if none is available). **/
+	int predictOutputs( const fmiTime stepSize );
+
+	/** Adapt the communication step size according to the deviation of the real outputs from their prediction. **/
+	void adaptStepSize( const fmiTime stepSize, const int order );
+
 private:
 
 	/** Interface to the CS FMU. **/
@@ -231,6 +269,33 @@ private:
 	/** Flag indicating logging on/off **/
 	fmiBoolean loggingOn_;
 
+	/** Flag indicating adaptive communication step size control on/off. **/
+	fmiBoolean adaptiveStepSize_;
+
+	/** Tolerance for adaptive communication step size control. **/
+	fmiReal tolerance_;
+
+	/** Minimal communication step size. **/
+	fmiTime minStepSize_;
+
+	/** Maximal communication step size. **/
+	fmiTime maxStepSize_;
+
+	/** Communication point of the previous step (used for extrapolating the real outputs). **/
+	fmiTime previousCommunicationPoint_;
+
+	/** Real outputs at the previous communication point. **/
+	std::vector<fmiReal> previousRealOutputs_;
+
+	/** Predicted real outputs at the end of the current communication step. **/
+	std::vector<fmiReal> predictedRealOutputs_;
+
+	/** Derivatives of the real outputs (if provided by the FMU). **/
+	std::vector<fmiReal> realOutputDerivatives_;
+
+	/** Orders of the derivatives of the real outputs. **/
+	std::vector<fmiInteger> derivativeOrders_;
+
 	/** Protect default constructor. **/
 	FixedStepSizeFMU() {}
 
@@ -33,6 +33,12 @@ class FMUModelExchangeBase;
  * a lookahead mechanism, where predictions of the FMU’s state are incrementally computed and stored.
  * In case an event occurs, these predictions are then used to interpolate and update the state of
  * the FMU. If no event occurs, the latest prediction can be directly used to update the FMU’s state.
+ *
+ * Optionally, the outputs can be retrieved lazily (see setLazyOutputRetrieval). In this case, the
+ * predictions only store the time and the continuous state. The outputs are retrieved from the FMU
+ * only when the state is updated, after the corresponding (predicted or interpolated) continuous
+ * state has been restored. For models with many outputs but only a few states this considerably
+ * reduces the number of calls to the FMU during the look-ahead.
  */ 
 
 class __FMI_DLL IncrementalFMU
@@ -141,6 +147,8 @@ public:
 
 	fmiReal* getRealOutputs() const { return currentState_.realValues_; } ///< Get pointer to current outputs.
 
+	std::size_t nRealOutputs() const { return nRealOutputs_; } ///< Get number of real outputs.
+
 	fmiInteger* getIntegerOutputs() const { return currentState_.integerValues_; } ///< Get pointer to current outputs.
 
 	fmiBoolean* getBooleanOutputs() const { return currentState_.booleanValues_; } ///< Get pointer to current outputs.
@@ -179,11 +187,22 @@ public:
 	/** Get the status of the last operation on the FMU. **/
 	fmiStatus getLastStatus() const;
 
+	/**
+	 * Turn lazy retrieval of outputs on/off. If turned on, predictions only store the time
+	 * and the continuous state, the outputs are retrieved from the FMU in updateState(...).
+	 * Takes effect with the next call to predictState(...).
+	 */
+	void setLazyOutputRetrieval( const fmiBoolean lazy ) { lazyOutputRetrieval_ = lazy; }
+
+	/** Check if outputs are retrieved lazily. **/
+	fmiBoolean getLazyOutputRetrieval() const { return lazyOutputRetrieval_; }
+
 protected:
 
 	History::History predictions_; ///< Vector of state predictions.
 
 	/// Check the latest prediction if an event has occured. If so, update the latest prediction accordingly.
+	/// In case of lazy output retrieval, the prediction only contains the time and the continuous state.
 	virtual bool checkForEvent( const HistoryEntry& newestPrediction );
 
 	/** Called in case checkForEvent() returns true. **/
@@ -321,6 +340,12 @@ private:
 	/** Flag indicating logging on/off **/
 	fmiBoolean loggingOn_;
 
+	/** Flag indicating lazy retrieval of outputs on/off. **/
+	fmiBoolean lazyOutputRetrieval_;
+
+	/** Flag indicating that the current predictions include the outputs. **/
+	fmiBoolean predictionsIncludeOutputs_;
+
 	/** Protect default constructor. **/
 	IncrementalFMU() {}
 
@@ -24,8 +24,11 @@ class FMUCoSimulation;
  * \class InterpolatingFixedStepSizeFMU InterpolatingFixedStepSizeFMU.h
  * Eases the handling of FMU CS in case a fixed communication step size is enforced by the enclosed model.
  *
- * The FixedStepSizeFMU handles the proper synchronization of the FMU CS internally. The outputs between
- * two internal synchronizations are linearly interpolated.
+ * The FixedStepSizeFMU handles the proper synchronization of the FMU CS internally. The real outputs between
+ * two internal synchronizations are interpolated. By default, linear interpolation is used. Alternatively,
+ * the outputs can be held constant or interpolated with cubic Hermite polynomials (see setInterpolationMethod).
+ * For cubic interpolation, the output derivatives provided by the FMU are used (if its model description states
+ * maxOutputDerivativeOrder > 0). Otherwise, the derivatives are estimated from the last three communication points.
  */
 
 class __FMI_DLL InterpolatingFixedStepSizeFMU
@@ -33,6 +36,13 @@ class __FMI_DLL InterpolatingFixedStepSizeFMU
 
 public:
 
+	/// Methods for interpolating real outputs between two internal synchronization points.
+	enum InterpolationMethod {
+		zeroOrderHold, ///< Hold the outputs of the previous communication point.
+		linear,        ///< Linear interpolation (default).
+		cubic          ///< Cubic Hermite interpolation.
+	};
+
 	InterpolatingFixedStepSizeFMU( const std::string& fmuPath,
 				       const std::string& modelName,
 				       const fmiBoolean loggingOn = fmiFalse );
@@ -99,9 +109,18 @@ public:
 
 	//fmiReal* getCurrentState() const { return currentState_.state_; } ///< Get pointer to current state.
 
+	/// Set the method for interpolating real outputs. Call before init(...).
+	void setInterpolationMethod( InterpolationMethod method );
+
+	/// Get the method for interpolating real outputs.
+	InterpolationMethod getInterpolationMethod() const { return interpolationMethod_; }
+
 	/// Get pointer to current outputs.
 	fmiReal* getRealOutputs() const { return currentState_.realValues_; }
 
+	/// Get number of real outputs.
+	std::size_t nRealOutputs() const { return nRealOutputs_; }
+
 	/// Get pointer to current outputs.
 	fmiInteger* getIntegerOutputs() const { return currentState_.integerValues_; }
 
@@ -168,6 +187,9 @@ protected:
 	/** Get the string outputs of the FMU. **/
 	void getOutputs( std::string* outputs ) const;
 
+	/** Get the first derivatives of the real outputs of the FMU. **/
+	void getOutputDerivatives( fmiReal* derivatives ) const;
+
 	/** Interpolate FMU state between two steps. **/
 	void interpolateCurrentState( fmiTime t );
 
@@ -188,6 +210,24 @@ private:
 	/** The next state. **/
 	HistoryEntry nextState_;
 
+	/** The state before the previous state (only used for cubic interpolation). **/
+	HistoryEntry prePreviousState_;
+
+	/** Derivatives of the real outputs at the previous state (only used for cubic interpolation). **/
+	HistoryEntry previousDerivatives_;
+
+	/** Derivatives of the real outputs at the next state (only used for cubic interpolation). **/
+	HistoryEntry nextDerivatives_;
+
+	/** Orders of the requested output derivatives (all equal to one). **/
+	fmiInteger* derivativeOrders_;
+
+	/** Interpolation method for real outputs. **/
+	InterpolationMethod interpolationMethod_;
+
+	/** Flag indicating that output derivatives are retrieved from the FMU. **/
+	bool useOutputDerivatives_;
+
 	/** Value references of the real inputs. **/
 	fmiValueReference* realInputRefs_;
 
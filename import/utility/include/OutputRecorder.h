@@ -0,0 +1,219 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+#ifndef _FMIPP_OUTPUTRECORDER_H
+#define _FMIPP_OUTPUTRECORDER_H
+
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <fstream>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "common/FMIPPConfig.h"
+#include "common/FMIType.h"
+#include "common/fmi_v1.0/fmiModelTypes.h"
+
+class FMUBase;
+
+
+/**
+ * \file OutputRecorder.h
+ * \class OutputRecorder OutputRecorder.h
+ *  Records simulation results of a chosen set of variables to a file.
+ *
+ *  The recorder can be attached to any FMU (ME or CS), in which case calling record(t)
+ *  samples all recorded variables with one call per variable type. Alternatively, the values
+ *  can be handed over explicitly, e.g., the outputs of an IncrementalFMU or FixedStepSizeFMU.
+ *
+ *  Samples are stored in preallocated blocks with one column per variable. Full blocks are
+ *  written to file by a background thread, while recording continues in the next free block.
+ *  The number of blocks is fixed, hence the memory used by the recorder is bounded. In case
+ *  the writer falls behind, record(...) waits until a block becomes available again.
+ *
+ *  Real, integer and boolean variables can be recorded. The results are written either as
+ *  CSV file or in a compact binary columnar format (little endian for x86 hosts):
+ *
+ *   - header: magic "FMIPPREC" (8 chars), format version, number of real, integer and
+ *     boolean variables (4 x uint32), followed by the variable names (uint32 length + chars)
+ *     in the order real, integer, boolean
+ *   - blocks: number of samples n (uint32), followed by the time column (n x double), the
+ *     real columns (n x double each), the integer columns (n x int32 each) and the boolean
+ *     columns (n x char each)
+ **/
+
+
+class __FMI_DLL OutputRecorder
+{
+
+public:
+
+	/// Format of the result file.
+	enum FileFormat { binary, csv };
+
+	/**
+	 * Constructor.
+	 *
+	 * @param[in]  fileName  name of the result file
+	 * @param[in]  format  format of the result file
+	 * @param[in]  blockSize  number of samples stored per block
+	 * @param[in]  nBlocks  number of blocks (at least 2, one for recording and one for writing)
+	 */
+	OutputRecorder( const std::string& fileName,
+			const FileFormat format = binary,
+			const std::size_t blockSize = 1024,
+			const std::size_t nBlocks = 2 );
+
+	/// Destructor (writes all remaining samples to file).
+	~OutputRecorder();
+
+	/// Attach the recorder to an FMU, from which the values will be retrieved by record(t).
+	void attach( FMUBase* fmu );
+
+	/**
+	 * Add a variable of the attached FMU to the set of recorded variables. The type of the
+	 * variable is retrieved from the FMU. All variables have to be added before the first
+	 * call to record(...).
+	 *
+	 * @param[in]  name  variable name
+	 * \return false in case the variable could not be added
+	 */
+	bool addVariable( const std::string& name );
+
+	/**
+	 * Add a variable to the set of recorded variables, whose values will be handed over
+	 * explicitly by the user. All variables have to be added before the first call to
+	 * record(...).
+	 *
+	 * @param[in]  name  variable name (used as column name in the result file)
+	 * @param[in]  type  variable type (real, integer or boolean)
+	 * \return false in case the variable could not be added
+	 */
+	bool addVariable( const std::string& name, const FMIType type );
+
+	/// Add several variables of the same type (see addVariable( name, type )).
+	bool addVariables( const std::string* names, const std::size_t nVariables, const FMIType type );
+
+	/**
+	 * Sample the recorded variables from the attached FMU.
+	 *
+	 * @param[in]  t  time stamp of the sample
+	 */
+	fmiStatus record( const fmiTime t );
+
+	/**
+	 * Record values handed over by the user. The arrays have to provide the values of all
+	 * recorded variables of the respective type, in the order they have been added.
+	 *
+	 * @param[in]  t  time stamp of the sample
+	 * @param[in]  realValues  values of the real variables
+	 * @param[in]  integerValues  values of the integer variables
+	 * @param[in]  booleanValues  values of the boolean variables
+	 */
+	fmiStatus record( const fmiTime t,
+			  const fmiReal* realValues,
+			  const fmiInteger* integerValues = 0,
+			  const fmiBoolean* booleanValues = 0 );
+
+	/// Write all samples recorded so far to file and wait until they have been written.
+	void flush();
+
+	/// Write all remaining samples to file and close it. Further samples are not recorded.
+	void close();
+
+	/// Get the number of samples recorded so far.
+	std::size_t nRecords() const { return nRecords_; }
+
+	/// Get the number of recorded real variables.
+	std::size_t nRealVariables() const { return realNames_.size(); }
+
+	/// Get the number of recorded integer variables.
+	std::size_t nIntegerVariables() const { return integerNames_.size(); }
+
+	/// Get the number of recorded boolean variables.
+	std::size_t nBooleanVariables() const { return booleanNames_.size(); }
+
+	/// Check if the recorder has not encountered any error (e.g., with the result file).
+	bool isOK() const;
+
+private:
+
+	/// Preallocated storage for a block of samples, one column per variable.
+	struct Block
+	{
+		fmiTime* time_;
+		fmiReal* reals_;
+		fmiInteger* integers_;
+		fmiBoolean* booleans_;
+		std::size_t nSamples_;
+	};
+
+	/// Open the file, allocate the blocks and start the writer thread.
+	bool start();
+
+	/// Return the block currently used for recording (waits for a free block if necessary).
+	Block* currentBlock();
+
+	/// Hand over the current block to the writer thread.
+	void submitCurrentBlock();
+
+	/// Main loop of the writer thread.
+	void writerLoop();
+
+	/// Write the file header.
+	void writeHeader();
+
+	/// Write a block to file.
+	void writeBlock( const Block* block );
+
+	std::string fileName_; ///< Name of the result file.
+	FileFormat format_; ///< Format of the result file.
+	std::ofstream file_; ///< Result file (accessed only by the writer thread after start).
+
+	FMUBase* fmu_; ///< Attached FMU (optional).
+
+	std::vector<std::string> realNames_; ///< Names of recorded real variables.
+	std::vector<std::string> integerNames_; ///< Names of recorded integer variables.
+	std::vector<std::string> booleanNames_; ///< Names of recorded boolean variables.
+
+	std::vector<fmiValueReference> realValueRefs_; ///< Value references of recorded real variables.
+	std::vector<fmiValueReference> integerValueRefs_; ///< Value references of recorded integer variables.
+	std::vector<fmiValueReference> booleanValueRefs_; ///< Value references of recorded boolean variables.
+
+	std::vector<fmiReal> realSample_; ///< Buffer for sampling real values from the FMU.
+	std::vector<fmiInteger> integerSample_; ///< Buffer for sampling integer values from the FMU.
+	std::vector<fmiBoolean> booleanSample_; ///< Buffer for sampling boolean values from the FMU.
+
+	std::size_t blockSize_; ///< Number of samples per block.
+	std::size_t nBlocks_; ///< Number of blocks.
+	Block* blocks_; ///< All blocks.
+	Block* current_; ///< Block currently used for recording.
+
+	std::deque<Block*> freeBlocks_; ///< Blocks available for recording.
+	std::deque<Block*> fullBlocks_; ///< Blocks waiting to be written.
+	std::size_t nBlocksInWriting_; ///< Number of blocks currently being written.
+
+	mutable boost::mutex mutex_; ///< Protects the block queues and flags.
+	boost::condition_variable blockFull_; ///< Signals the writer that blocks are waiting.
+	boost::condition_variable blockFree_; ///< Signals the recorder that a block was written.
+	boost::thread writer_; ///< Writer thread.
+
+	std::size_t nRecords_; ///< Number of recorded samples.
+	bool started_; ///< Flag indicating that recording has started.
+	bool closed_; ///< Flag indicating that the recorder has been closed.
+	bool stopWriter_; ///< Flag telling the writer thread to terminate.
+	bool ok_; ///< Flag indicating that no error has been encountered.
+
+	// Not copyable.
+	OutputRecorder( const OutputRecorder& );
+	OutputRecorder& operator=( const OutputRecorder& );
+};
+
+
+#endif // _FMIPP_OUTPUTRECORDER_H
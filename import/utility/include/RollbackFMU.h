@@ -18,6 +18,13 @@
  * \class RollbackFMU RollbackFMU.h 
  *  This class allows to perform rollbacks to times not longer
  *  ago than the previous update (or a saved internal state).
+ *
+ *  Optionally, a store of checkpoints can be used (see setMaxCheckpoints), which allows
+ *  rollbacks to any time since the start of the simulation. A checkpoint is taken at the
+ *  beginning of each call to integrate(...). When the store is full, checkpoints are thinned
+ *  out such that their spacing grows with their age (i.e., recent checkpoints are dense, old
+ *  checkpoints are sparse). The re-integration needed after a rollback is therefore bounded
+ *  by a fraction of the time span of the rollback.
  **/
 
 
@@ -50,6 +57,16 @@ public:
 	    saved via "saveCurrentStateForRollback()". **/
 	void releaseRollbackState();
 
+	/** Set the maximum number of checkpoints used for rollbacks (default is 0, i.e.,
+	    no checkpoints). Each checkpoint stores the continuous states of the FMU. **/
+	void setMaxCheckpoints( std::size_t maxCheckpoints );
+
+	/// Get the maximum number of checkpoints used for rollbacks.
+	std::size_t getMaxCheckpoints() const { return maxCheckpoints_; }
+
+	/// Get the number of currently stored checkpoints.
+	std::size_t nCheckpoints() const { return checkpoints_.size(); }
+
 	/** getter functions for model variables **/
 
 	fmiStatus getValue( const std::string& name, fmiReal& val );
@@ -101,6 +118,18 @@ private:
 
 	bool rollbackStateSaved_;
 
+	/** Checkpoints for rollbacks (ordered by time). **/
+	History::History checkpoints_;
+
+	/** Maximum number of checkpoints. **/
+	std::size_t maxCheckpoints_;
+
+	/** Store the current state of the FMU as checkpoint. **/
+	void saveCheckpoint();
+
+	/** Remove one checkpoint from the store. **/
+	void thinOutCheckpoints();
+
 };
 
 
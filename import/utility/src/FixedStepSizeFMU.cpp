@@ -9,6 +9,8 @@
  */ 
 
 #include <cassert>
+#include <cmath>
+#include <algorithm>
 #include <sstream>
 
 #include "import/base/include/FMUCoSimulation.h"
@@ -31,7 +33,9 @@ FixedStepSizeFMU::FixedStepSizeFMU( const string& fmuPath,
 	nRealInputs_( 0 ), nIntegerInputs_( 0 ), nBooleanInputs_( 0 ), nStringInputs_( 0 ),
 	realOutputRefs_( 0 ), integerOutputRefs_( 0 ), booleanOutputRefs_( 0 ), stringOutputRefs_( 0 ),
 	nRealOutputs_( 0 ), nIntegerOutputs_( 0 ), nBooleanOutputs_( 0 ), nStringOutputs_( 0 ),
-	loggingOn_( loggingOn )
+	loggingOn_( loggingOn ), adaptiveStepSize_( fmiFalse ), tolerance_( 0. ),
+	minStepSize_( 0. ), maxStepSize_( 0. ),
+	previousCommunicationPoint_( numeric_limits<fmiTime>::quiet_NaN() )
 {}
 
 
@@ -342,6 +346,8 @@ int FixedStepSizeFMU::init( const string& instanceName,
 
 	currentCommunicationPoint_ = startTime;
 	communicationStepSize_ = communicationStepSize;
+	if ( fmiTrue == adaptiveStepSize_ )
+		communicationStepSize_ = min( max( communicationStepSize_, minStepSize_ ), maxStepSize_ );
 	finalCommunicationPoint_ = ( stopTimeDefined == fmiTrue ) ? stopTime : INVALID_FMI_TIME;
 
 	return 1;  /* return 1 on success, 0 on failure */
@@ -362,24 +368,29 @@ fmiTime FixedStepSizeFMU::sync( fmiTime t0, fmiTime t1 )
 	{
 		do
 		{
-			fmiStatus status = fmu_->doStep( currentCommunicationPoint_, communicationStepSize_, fmiTrue );
+			const fmiTime stepSize = communicationStepSize_;
+			const int order = ( fmiTrue == adaptiveStepSize_ ) ? predictOutputs( stepSize ) : 0;
+
+			fmiStatus status = fmu_->doStep( currentCommunicationPoint_, stepSize, fmiTrue );
 
 			if ( fmiOK != status ) {
 				stringstream message;
-				message << "doStep( " << currentCommunicationPoint_ 
-					<< ", " << communicationStepSize_
+				message << "doStep( " << currentCommunicationPoint_
+					<< ", " << stepSize
 					<< ", fmiTrue ) failed - status = " << status << std::endl;
 				fmu_->logger( status, "SYNC", message.str().c_str() );
 				return currentCommunicationPoint_;
 			}
 
-			currentCommunicationPoint_ += communicationStepSize_;
+			currentCommunicationPoint_ += stepSize;
 
 			currentState_.time_ = currentCommunicationPoint_;
 			getOutputs( currentState_.realValues_ );
 			getOutputs( currentState_.integerValues_ );
 			getOutputs( currentState_.booleanValues_ );
 			getOutputs( currentState_.stringValues_ );
+
+			if ( fmiTrue == adaptiveStepSize_ ) adaptStepSize( stepSize, order );
 		}
 		while ( t1 >= ( currentCommunicationPoint_ + communicationStepSize_ ) );
 	}
@@ -438,6 +449,119 @@ FixedStepSizeFMU::getLastStatus() const
 }
 
 
+void FixedStepSizeFMU::enableAdaptiveStepSize( const fmiReal tolerance,
+					       const fmiTime minStepSize,
+					       const fmiTime maxStepSize )
+{
+	assert( tolerance > 0. );
+	assert( ( minStepSize > 0. ) && ( minStepSize <= maxStepSize ) );
+
+	adaptiveStepSize_ = fmiTrue;
+	tolerance_ = tolerance;
+	minStepSize_ = minStepSize;
+	maxStepSize_ = maxStepSize;
+
+	// Restrict the current step size to the admissible range (in case the FMU is already initialized).
+	if ( communicationStepSize_ == communicationStepSize_ )
+		communicationStepSize_ = min( max( communicationStepSize_, minStepSize_ ), maxStepSize_ );
+
+	previousCommunicationPoint_ = numeric_limits<fmiTime>::quiet_NaN();
+}
+
+
+void FixedStepSizeFMU::disableAdaptiveStepSize()
+{
+	adaptiveStepSize_ = fmiFalse;
+}
+
+
+int FixedStepSizeFMU::predictOutputs( const fmiTime stepSize )
+{
+	if ( 0 == nRealOutputs_ ) return 0;
+
+	const fmiReal* outputs = currentState_.realValues_;
+	int order = 0;
+
+	predictedRealOutputs_.resize( nRealOutputs_ );
+
+	if ( fmu_->getMaxOutputDerivativeOrder() > 0 )
+	{
+		// Taylor expansion using the output derivatives provided by the FMU (up to 2nd order).
+		realOutputDerivatives_.resize( nRealOutputs_ );
+		derivativeOrders_.assign( nRealOutputs_, 1 );
+
+		if ( fmiOK == fmu_->getRealOutputDerivatives( realOutputRefs_, nRealOutputs_,
+							      &derivativeOrders_.front(),
+							      &realOutputDerivatives_.front() ) )
+		{
+			for ( size_t i = 0; i < nRealOutputs_; ++i )
+				predictedRealOutputs_[i] = outputs[i] + stepSize*realOutputDerivatives_[i];
+			order = 1;
+		}
+
+		if ( ( 1 == order ) && ( fmu_->getMaxOutputDerivativeOrder() > 1 ) )
+		{
+			derivativeOrders_.assign( nRealOutputs_, 2 );
+
+			if ( fmiOK == fmu_->getRealOutputDerivatives( realOutputRefs_, nRealOutputs_,
+								      &derivativeOrders_.front(),
+								      &realOutputDerivatives_.front() ) )
+			{
+				const fmiReal c = 0.5*stepSize*stepSize;
+				for ( size_t i = 0; i < nRealOutputs_; ++i )
+					predictedRealOutputs_[i] += c*realOutputDerivatives_[i];
+				order = 2;
+			}
+		}
+	}
+
+	if ( ( 0 == order ) && ( previousCommunicationPoint_ < currentCommunicationPoint_ ) &&
+	     ( previousRealOutputs_.size() == nRealOutputs_ ) )
+	{
+		// Linear extrapolation from the previous communication point.
+		const fmiReal c = stepSize/( currentCommunicationPoint_ - previousCommunicationPoint_ );
+		for ( size_t i = 0; i < nRealOutputs_; ++i )
+			predictedRealOutputs_[i] = outputs[i] + c*( outputs[i] - previousRealOutputs_[i] );
+		order = 1;
+	}
+
+	previousCommunicationPoint_ = currentCommunicationPoint_;
+	previousRealOutputs_.assign( outputs, outputs + nRealOutputs_ );
+
+	return order;
+}
+
+
+void FixedStepSizeFMU::adaptStepSize( const fmiTime stepSize, const int order )
+{
+	if ( 0 == order ) return; // No error estimate available.
+
+	// Maximum of the scaled deviations from the predicted outputs.
+	const fmiReal* outputs = currentState_.realValues_;
+	fmiReal error = 0.;
+	for ( size_t i = 0; i < nRealOutputs_; ++i ) {
+		fmiReal scaled = fabs( outputs[i] - predictedRealOutputs_[i] )/( tolerance_*( 1. + fabs( outputs[i] ) ) );
+		if ( scaled > error ) error = scaled;
+	}
+
+	// The local error of a prediction of order p is of order p+1 in the step size.
+	const fmiReal safety = 0.9;
+	const fmiReal minFactor = 0.2;
+	const fmiReal maxFactor = 5.;
+	fmiReal factor = ( error > 0. ) ? safety*pow( 1./error, 1./( order + 1 ) ) : maxFactor;
+	factor = min( max( factor, minFactor ), maxFactor );
+
+	communicationStepSize_ = min( max( stepSize*factor, minStepSize_ ), maxStepSize_ );
+
+	if ( fmiTrue == loggingOn_ )
+	{
+		stringstream msg;
+		msg << "error estimate = " << error << ", new communication step size = " << communicationStepSize_;
+		fmu_->sendDebugMessage( msg.str() );
+	}
+}
+
+
 fmiTime FixedStepSizeFMU::getNextSyncTime( const fmiTime& currentSyncTime ) const
 {
 	return ( currentSyncTime < currentCommunicationPoint_ ) ?
@@ -37,7 +37,8 @@ IncrementalFMU::IncrementalFMU( const string& fmuPath,
 	lookaheadStepSize_( numeric_limits<fmiTime>::quiet_NaN() ),
 	integratorStepSize_( numeric_limits<fmiTime>::quiet_NaN() ),
 	lastEventTime_( numeric_limits<fmiTime>::infinity() ),
-	timeDiffResolution_( timeDiffResolution ), loggingOn_( loggingOn )
+	timeDiffResolution_( timeDiffResolution ), loggingOn_( loggingOn ),
+	lazyOutputRetrieval_( fmiFalse ), predictionsIncludeOutputs_( fmiTrue )
 {
 	bool isValid = false;
 	ModelDescription md(  fmuPath + "/modelDescription.xml", isValid );
@@ -65,7 +66,8 @@ IncrementalFMU::IncrementalFMU( const string& xmlPath,
 	lookaheadStepSize_( numeric_limits<fmiTime>::quiet_NaN() ),
 	integratorStepSize_( numeric_limits<fmiTime>::quiet_NaN() ),
 	lastEventTime_( numeric_limits<fmiTime>::infinity() ),
-	timeDiffResolution_( timeDiffResolution ), loggingOn_( loggingOn )
+	timeDiffResolution_( timeDiffResolution ), loggingOn_( loggingOn ),
+	lazyOutputRetrieval_( fmiFalse ), predictionsIncludeOutputs_( fmiTrue )
 {
 	bool isValid = false;
 	ModelDescription md( xmlPath, isValid );
@@ -412,6 +414,7 @@ int IncrementalFMU::init( const std::string& instanceName,
 	fmu_->handleEvents(); // ... and finally take proper actions.
 	retrieveFMUState( init.state_, init.realValues_, init.integerValues_, init.booleanValues_, init.stringValues_ ); // Then retrieve the result and ...
 	predictions_.push_back( init ); // ... store as prediction -> will be used by first call to updateState().
+	predictionsIncludeOutputs_ = fmiTrue;
 
 	predictions_[0] = predictions_[0];
 
@@ -440,8 +443,11 @@ void IncrementalFMU::interpolateState( fmiTime t,
 		result.state_[i] = interpolateValue( t, left.time_, left.state_[i], right.time_, right.state_[i] );
 	}
 
-	for ( size_t i = 0; i < nRealOutputs_; ++i ) {
-		result.realValues_[i] = interpolateValue( t, left.time_, left.realValues_[i], right.time_, right.realValues_[i] );
+	// In case of lazy output retrieval, the outputs are not part of the predictions.
+	if ( fmiTrue == predictionsIncludeOutputs_ ) {
+		for ( size_t i = 0; i < nRealOutputs_; ++i ) {
+			result.realValues_[i] = interpolateValue( t, left.time_, left.realValues_[i], right.time_, right.realValues_[i] );
+		}
 	}
 
 	// no sense in interpolating other values.
@@ -530,7 +536,13 @@ void IncrementalFMU::getState( fmiTime t, HistoryEntry& state )
 	for ( ; itFind != itEnd; ++itFind ) {
 
 		if ( fabs( t - itFind->time_ ) < timeDiffResolution_ ) {
-			state = *itFind;
+			if ( fmiTrue == predictionsIncludeOutputs_ ) {
+				state = *itFind;
+			} else {
+				// Copy only time and continuous state, the outputs are retrieved later on.
+				state.time_ = itFind->time_;
+				for ( size_t i = 0; i < itFind->nStates_; ++i ) state.state_[i] = itFind->state_[i];
+			}
 			/* should not be necessary, remove again, but have a look ;) !!!
 			   if ( t < newestPredictionTime ) {
 			   fmu_->setContinuousStates(state.state);
@@ -568,6 +580,15 @@ fmiTime IncrementalFMU::updateState( fmiTime t1 )
 	// somewhere i have to do this, ask EW which functions he overloads, so we can solve this better!!!
 	initializeIntegration( currentState_ );
 	fmu_->setTime( t1 );
+
+	if ( fmiFalse == predictionsIncludeOutputs_ ) {
+		// Retrieve the outputs corresponding to the restored state.
+		getOutputs( currentState_.realValues_ );
+		getOutputs( currentState_.integerValues_ );
+		getOutputs( currentState_.booleanValues_ );
+		getOutputs( currentState_.stringValues_ );
+	}
+
 	fmu_->raiseEvent();
 	fmu_->handleEvents();
 
@@ -623,8 +644,16 @@ fmiTime IncrementalFMU::predictState( fmiTime t1 )
 	// Initialize the first state and the FMU.
 	HistoryEntry prediction;
 
-	prediction = currentState_;
-	prediction.time_ = t1;
+	if ( fmiTrue == lazyOutputRetrieval_ ) {
+		// Store only time and continuous state.
+		prediction = HistoryEntry( t1, fmu_->nStates(), 0, 0, 0, 0 );
+		for ( size_t i = 0; i < prediction.nStates_; ++i ) prediction.state_[i] = currentState_.state_[i];
+	} else {
+		prediction = currentState_;
+		prediction.time_ = t1;
+	}
+
+	predictionsIncludeOutputs_ = ( fmiTrue == lazyOutputRetrieval_ ) ? fmiFalse : fmiTrue;
 
 	// Initialize integration.
 	initializeIntegration( prediction );
@@ -640,7 +669,11 @@ fmiTime IncrementalFMU::predictState( fmiTime t1 )
 		lastEventTime_ = fmu_->integrate( prediction.time_ + lookaheadStepSize_, integratorStepSize_ );
 
 		// Retrieve results from FMU integration.
-		retrieveFMUState( prediction.state_, prediction.realValues_, prediction.integerValues_, prediction.booleanValues_, prediction.stringValues_ );
+		if ( fmiTrue == predictionsIncludeOutputs_ ) {
+			retrieveFMUState( prediction.state_, prediction.realValues_, prediction.integerValues_, prediction.booleanValues_, prediction.stringValues_ );
+		} else {
+			getContinuousStates( prediction.state_ );
+		}
 
 		// Add latest prediction.
 		prediction.time_ = lastEventTime_; //lookaheadStepSize_;
@@ -9,6 +9,7 @@
  */ 
 
 #include <cassert>
+#include <cmath>
 #include <sstream> /// \FIXME remove
 
 #include "import/base/include/FMUCoSimulation.h"
@@ -27,6 +28,7 @@ InterpolatingFixedStepSizeFMU::InterpolatingFixedStepSizeFMU( const string& fmuP
 	finalCommunicationPoint_( numeric_limits<fmiTime>::quiet_NaN() ),
 	communicationStepSize_( numeric_limits<fmiTime>::quiet_NaN() ),
 	fmu_( new FMUCoSimulation( fmuPath, modelName, loggingOn ) ),
+	derivativeOrders_( 0 ), interpolationMethod_( linear ), useOutputDerivatives_( false ),
 	realInputRefs_( 0 ), integerInputRefs_( 0 ), booleanInputRefs_( 0 ), stringInputRefs_( 0 ),
 	nRealInputs_( 0 ), nIntegerInputs_( 0 ), nBooleanInputs_( 0 ), nStringInputs_( 0 ),
 	realOutputRefs_( 0 ), integerOutputRefs_( 0 ), booleanOutputRefs_( 0 ), stringOutputRefs_( 0 ),
@@ -48,6 +50,26 @@ InterpolatingFixedStepSizeFMU::~InterpolatingFixedStepSizeFMU()
 	if ( integerOutputRefs_ ) delete integerOutputRefs_;
 	if ( booleanOutputRefs_ ) delete booleanOutputRefs_;
 	if ( stringOutputRefs_ ) delete stringOutputRefs_;
+
+	if ( derivativeOrders_ ) delete [] derivativeOrders_;
+}
+
+
+void InterpolatingFixedStepSizeFMU::setInterpolationMethod( InterpolationMethod method )
+{
+	interpolationMethod_ = method;
+
+	// Output derivatives are only retrieved in case cubic interpolation has been chosen before
+	// initialization. Otherwise cubic interpolation falls back to derivatives estimated from the
+	// last three communication points.
+	if ( cubic != interpolationMethod_ ) useOutputDerivatives_ = false;
+
+	if ( fmiTrue == loggingOn_ )
+	{
+		stringstream msg;
+		msg << "set interpolation method for real outputs to " << interpolationMethod_;
+		fmu_->sendDebugMessage( msg.str() );
+	}
 }
 
 
@@ -247,6 +269,21 @@ void InterpolatingFixedStepSizeFMU::getOutputs( fmiReal* outputs ) const
 }
 
 
+void InterpolatingFixedStepSizeFMU::getOutputDerivatives( fmiReal* derivatives ) const
+{
+	if ( 0 == nRealOutputs_ ) return;
+
+	fmiStatus status = fmu_->getRealOutputDerivatives( realOutputRefs_, nRealOutputs_,
+							   derivativeOrders_, derivatives );
+
+	if ( fmiOK != status ) {
+		stringstream message;
+		message << "getRealOutputDerivatives(...) failed - status = " << status;
+		fmu_->logger( status, "SYNC", message.str().c_str() );
+	}
+}
+
+
 void InterpolatingFixedStepSizeFMU::getOutputs( fmiInteger* outputs ) const
 {
 	for ( size_t i = 0; i < nIntegerOutputs_; ++i ) {
@@ -342,6 +379,26 @@ int InterpolatingFixedStepSizeFMU::init( const std::string& instanceName,
 	currentState_ = initState;
 	nextState_ = initState;
 
+	// Only the real outputs are needed for estimating derivatives from previous states.
+	prePreviousState_ = HistoryEntry( startTime, 0, nRealOutputs_, 0, 0, 0 );
+	for ( size_t i = 0; i < nRealOutputs_; ++i ) prePreviousState_.realValues_[i] = initState.realValues_[i];
+
+	useOutputDerivatives_ = ( cubic == interpolationMethod_ ) && ( 0 != nRealOutputs_ ) &&
+		( fmu_->getMaxOutputDerivativeOrder() > 0 );
+
+	if ( true == useOutputDerivatives_ )
+	{
+		if ( 0 != derivativeOrders_ ) delete [] derivativeOrders_;
+		derivativeOrders_ = new fmiInteger[nRealOutputs_];
+		for ( size_t i = 0; i < nRealOutputs_; ++i ) derivativeOrders_[i] = 1;
+
+		HistoryEntry initDerivatives( startTime, 0, nRealOutputs_, 0, 0, 0 );
+		getOutputDerivatives( initDerivatives.realValues_ );
+
+		previousDerivatives_ = initDerivatives;
+		nextDerivatives_ = initDerivatives;
+	}
+
 	currentCommunicationPoint_ = startTime;
 	communicationStepSize_ = communicationStepSize;
 	finalCommunicationPoint_ = ( stopTimeDefined == fmiTrue ) ? stopTime : INVALID_FMI_TIME;
@@ -358,8 +415,74 @@ void InterpolatingFixedStepSizeFMU::interpolateCurrentState( fmiTime t )
 		return;
 	}
 
-	for ( size_t i = 0; i < nRealOutputs_; ++i ) {
-		currentState_.realValues_[i] = interpolateValue( t, previousState_.time_, previousState_.realValues_[i], nextState_.time_, nextState_.realValues_[i] );
+	const size_t n = nRealOutputs_;
+	const fmiReal* y0 = previousState_.realValues_;
+	const fmiReal* y1 = nextState_.realValues_;
+	fmiReal* y = currentState_.realValues_;
+
+	const fmiTime h = nextState_.time_ - previousState_.time_;
+	const fmiReal s = ( t - previousState_.time_ ) / h;
+
+	// The interpolation weights only depend on time, hence they are computed once. The loops over
+	// the outputs are simple weighted sums on contiguous arrays, which the compiler can vectorize.
+	InterpolationMethod method = interpolationMethod_;
+
+	// Cubic interpolation without output derivatives requires three consecutive communication points.
+	if ( ( cubic == method ) && ( false == useOutputDerivatives_ ) &&
+	     ( std::fabs( previousState_.time_ - prePreviousState_.time_ - h ) > 1e-6 * h ) )
+		method = linear;
+
+	switch ( method )
+	{
+
+	case zeroOrderHold:
+
+		for ( size_t i = 0; i < n; ++i ) y[i] = y0[i];
+		break;
+
+	case cubic:
+	{
+		// Cubic Hermite basis functions.
+		const fmiReal s2 = s*s;
+		const fmiReal s3 = s2*s;
+		const fmiReal h00 = 2.*s3 - 3.*s2 + 1.;
+		const fmiReal h10 = s3 - 2.*s2 + s;
+		const fmiReal h01 = -2.*s3 + 3.*s2;
+		const fmiReal h11 = s3 - s2;
+
+		if ( true == useOutputDerivatives_ )
+		{
+			const fmiReal* d0 = previousDerivatives_.realValues_;
+			const fmiReal* d1 = nextDerivatives_.realValues_;
+			const fmiReal c10 = h10*h;
+			const fmiReal c11 = h11*h;
+
+			for ( size_t i = 0; i < n; ++i )
+				y[i] = h00*y0[i] + h01*y1[i] + c10*d0[i] + c11*d1[i];
+		}
+		else
+		{
+			// Derivatives estimated from the last three communication points (central difference
+			// at the previous and backward difference at the next communication point), which
+			// yields a weighted sum of the three stored states.
+			const fmiReal* ym = prePreviousState_.realValues_;
+			const fmiReal cm = 0.5*( h11 - h10 );
+			const fmiReal c0 = h00 - 2.*h11;
+			const fmiReal c1 = 0.5*h10 + h01 + 1.5*h11;
+
+			for ( size_t i = 0; i < n; ++i )
+				y[i] = cm*ym[i] + c0*y0[i] + c1*y1[i];
+		}
+
+		break;
+	}
+
+	case linear:
+	default:
+
+		for ( size_t i = 0; i < n; ++i ) y[i] = y0[i] + s*( y1[i] - y0[i] );
+		break;
+
 	}
 
 	currentState_.time_ = t;
@@ -387,8 +510,17 @@ fmiTime InterpolatingFixedStepSizeFMU::sync( fmiTime t0, fmiTime t1 )
 	{
 		do
 		{
+			if ( cubic == interpolationMethod_ )
+			{
+				prePreviousState_.time_ = previousState_.time_;
+				for ( size_t i = 0; i < nRealOutputs_; ++i )
+					prePreviousState_.realValues_[i] = previousState_.realValues_[i];
+			}
+
 			previousState_ = nextState_;
 
+			if ( true == useOutputDerivatives_ ) previousDerivatives_ = nextDerivatives_;
+
 			fmiStatus status = fmu_->doStep( currentCommunicationPoint_, communicationStepSize_, fmiTrue );
 
 			if ( fmiOK != status ) {
@@ -407,6 +539,11 @@ fmiTime InterpolatingFixedStepSizeFMU::sync( fmiTime t0, fmiTime t1 )
 			getOutputs( nextState_.integerValues_ );
 			getOutputs( nextState_.booleanValues_ );
 			getOutputs( nextState_.stringValues_ );
+
+			if ( true == useOutputDerivatives_ ) {
+				nextDerivatives_.time_ = currentCommunicationPoint_;
+				getOutputDerivatives( nextDerivatives_.realValues_ );
+			}
 		}
 		while ( t1 > ( currentCommunicationPoint_ ) );
 	}
@@ -0,0 +1,415 @@
+/* --------------------------------------------------------------
+ * Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+ * All rights reserved. See file FMIPP_LICENSE for details.
+ * --------------------------------------------------------------*/
+
+/**
+ * \file OutputRecorder.cpp
+ */
+
+#include <iomanip>
+#include <limits>
+
+#include <boost/cstdint.hpp>
+
+#include "import/base/include/FMUBase.h"
+
+#include "import/utility/include/OutputRecorder.h"
+
+
+using namespace std;
+
+
+// Version of the binary file format.
+static const boost::uint32_t binaryFormatVersion = 1;
+
+
+OutputRecorder::OutputRecorder( const string& fileName,
+				const FileFormat format,
+				const size_t blockSize,
+				const size_t nBlocks ) :
+	fileName_( fileName ), format_( format ), fmu_( 0 ),
+	blockSize_( ( blockSize > 0 ) ? blockSize : 1 ),
+	nBlocks_( ( nBlocks > 2 ) ? nBlocks : 2 ),
+	blocks_( 0 ), current_( 0 ), nBlocksInWriting_( 0 ),
+	nRecords_( 0 ), started_( false ), closed_( false ),
+	stopWriter_( false ), ok_( true )
+{}
+
+
+OutputRecorder::~OutputRecorder()
+{
+	close();
+}
+
+
+void OutputRecorder::attach( FMUBase* fmu )
+{
+	fmu_ = fmu;
+}
+
+
+bool OutputRecorder::addVariable( const string& name )
+{
+	if ( ( 0 == fmu_ ) || ( true == started_ ) ) return false;
+
+	fmiValueReference valref = fmu_->getValueRef( name );
+	if ( fmiUndefinedValueReference == valref ) return false;
+
+	switch ( fmu_->getType( name ) )
+	{
+	case fmiTypeReal:
+		realNames_.push_back( name );
+		realValueRefs_.push_back( valref );
+		return true;
+	case fmiTypeInteger:
+		integerNames_.push_back( name );
+		integerValueRefs_.push_back( valref );
+		return true;
+	case fmiTypeBoolean:
+		booleanNames_.push_back( name );
+		booleanValueRefs_.push_back( valref );
+		return true;
+	default:
+		return false;
+	}
+}
+
+
+bool OutputRecorder::addVariable( const string& name, const FMIType type )
+{
+	if ( true == started_ ) return false;
+
+	switch ( type )
+	{
+	case fmiTypeReal:
+		realNames_.push_back( name );
+		realValueRefs_.push_back( fmiUndefinedValueReference );
+		return true;
+	case fmiTypeInteger:
+		integerNames_.push_back( name );
+		integerValueRefs_.push_back( fmiUndefinedValueReference );
+		return true;
+	case fmiTypeBoolean:
+		booleanNames_.push_back( name );
+		booleanValueRefs_.push_back( fmiUndefinedValueReference );
+		return true;
+	default:
+		return false;
+	}
+}
+
+
+bool OutputRecorder::addVariables( const string* names, const size_t nVariables, const FMIType type )
+{
+	for ( size_t i = 0; i < nVariables; ++i ) {
+		if ( false == addVariable( names[i], type ) ) return false;
+	}
+	return true;
+}
+
+
+fmiStatus OutputRecorder::record( const fmiTime t )
+{
+	if ( 0 == fmu_ ) return fmiError;
+
+	if ( ( realSample_.size() != realValueRefs_.size() ) ||
+	     ( integerSample_.size() != integerValueRefs_.size() ) ||
+	     ( booleanSample_.size() != booleanValueRefs_.size() ) ) {
+		// All variables have to be known to the attached FMU.
+		for ( size_t i = 0; i < realValueRefs_.size(); ++i )
+			if ( fmiUndefinedValueReference == realValueRefs_[i] ) return fmiError;
+		for ( size_t i = 0; i < integerValueRefs_.size(); ++i )
+			if ( fmiUndefinedValueReference == integerValueRefs_[i] ) return fmiError;
+		for ( size_t i = 0; i < booleanValueRefs_.size(); ++i )
+			if ( fmiUndefinedValueReference == booleanValueRefs_[i] ) return fmiError;
+
+		realSample_.resize( realValueRefs_.size() );
+		integerSample_.resize( integerValueRefs_.size() );
+		booleanSample_.resize( booleanValueRefs_.size() );
+	}
+
+	fmiStatus status = fmiOK;
+	fmiStatus s;
+
+	// Retrieve all values of the same type with a single call.
+	if ( false == realSample_.empty() ) {
+		s = fmu_->getValue( &realValueRefs_.front(), &realSample_.front(), realSample_.size() );
+		if ( s > status ) status = s;
+	}
+
+	if ( false == integerSample_.empty() ) {
+		s = fmu_->getValue( &integerValueRefs_.front(), &integerSample_.front(), integerSample_.size() );
+		if ( s > status ) status = s;
+	}
+
+	if ( false == booleanSample_.empty() ) {
+		s = fmu_->getValue( &booleanValueRefs_.front(), &booleanSample_.front(), booleanSample_.size() );
+		if ( s > status ) status = s;
+	}
+
+	if ( status > fmiWarning ) return status;
+
+	s = record( t,
+		    realSample_.empty() ? 0 : &realSample_.front(),
+		    integerSample_.empty() ? 0 : &integerSample_.front(),
+		    booleanSample_.empty() ? 0 : &booleanSample_.front() );
+
+	return ( s > status ) ? s : status;
+}
+
+
+fmiStatus OutputRecorder::record( const fmiTime t,
+				  const fmiReal* realValues,
+				  const fmiInteger* integerValues,
+				  const fmiBoolean* booleanValues )
+{
+	if ( true == closed_ ) return fmiError;
+
+	if ( ( 0 == realValues ) && ( false == realNames_.empty() ) ) return fmiError;
+	if ( ( 0 == integerValues ) && ( false == integerNames_.empty() ) ) return fmiError;
+	if ( ( 0 == booleanValues ) && ( false == booleanNames_.empty() ) ) return fmiError;
+
+	if ( ( false == started_ ) && ( false == start() ) ) return fmiError;
+
+	Block* block = currentBlock();
+	if ( 0 == block ) return fmiError;
+
+	const size_t iSample = block->nSamples_;
+
+	block->time_[iSample] = t;
+
+	// Columns are stored contiguously, hence sample i of column c is at c*blockSize_ + i.
+	fmiReal* reals = block->reals_ + iSample;
+	for ( size_t c = 0; c < realNames_.size(); ++c ) reals[c*blockSize_] = realValues[c];
+
+	fmiInteger* integers = block->integers_ + iSample;
+	for ( size_t c = 0; c < integerNames_.size(); ++c ) integers[c*blockSize_] = integerValues[c];
+
+	fmiBoolean* booleans = block->booleans_ + iSample;
+	for ( size_t c = 0; c < booleanNames_.size(); ++c ) booleans[c*blockSize_] = booleanValues[c];
+
+	++block->nSamples_;
+	++nRecords_;
+
+	if ( blockSize_ == block->nSamples_ ) submitCurrentBlock();
+
+	return fmiOK;
+}
+
+
+void OutputRecorder::flush()
+{
+	if ( false == started_ ) return;
+
+	if ( ( 0 != current_ ) && ( 0 != current_->nSamples_ ) ) submitCurrentBlock();
+
+	boost::unique_lock<boost::mutex> lock( mutex_ );
+
+	while ( ( false == fullBlocks_.empty() ) || ( 0 != nBlocksInWriting_ ) ) blockFree_.wait( lock );
+
+	// The writer thread is idle, the file can be accessed safely.
+	file_.flush();
+	if ( file_.fail() ) ok_ = false;
+}
+
+
+void OutputRecorder::close()
+{
+	if ( true == closed_ ) return;
+	closed_ = true;
+
+	if ( false == started_ ) return;
+
+	flush();
+
+	{
+		boost::lock_guard<boost::mutex> lock( mutex_ );
+		stopWriter_ = true;
+	}
+	blockFull_.notify_one();
+
+	writer_.join();
+
+	file_.close();
+
+	for ( size_t i = 0; i < nBlocks_; ++i ) {
+		delete[] blocks_[i].time_;
+		delete[] blocks_[i].reals_;
+		delete[] blocks_[i].integers_;
+		delete[] blocks_[i].booleans_;
+	}
+
+	delete[] blocks_;
+	blocks_ = 0;
+	current_ = 0;
+	freeBlocks_.clear();
+}
+
+
+bool OutputRecorder::isOK() const
+{
+	boost::lock_guard<boost::mutex> lock( mutex_ );
+	return ok_;
+}
+
+
+bool OutputRecorder::start()
+{
+	if ( csv == format_ ) {
+		file_.open( fileName_.c_str(), ios::out | ios::trunc );
+	} else {
+		file_.open( fileName_.c_str(), ios::out | ios::trunc | ios::binary );
+	}
+
+	if ( false == file_.is_open() ) {
+		ok_ = false;
+		return false;
+	}
+
+	writeHeader();
+
+	// Allocate all memory needed for recording in advance.
+	blocks_ = new Block[nBlocks_];
+	for ( size_t i = 0; i < nBlocks_; ++i ) {
+		blocks_[i].time_ = new fmiTime[blockSize_];
+		blocks_[i].reals_ = new fmiReal[blockSize_*realNames_.size()];
+		blocks_[i].integers_ = new fmiInteger[blockSize_*integerNames_.size()];
+		blocks_[i].booleans_ = new fmiBoolean[blockSize_*booleanNames_.size()];
+		blocks_[i].nSamples_ = 0;
+		freeBlocks_.push_back( &blocks_[i] );
+	}
+
+	writer_ = boost::thread( &OutputRecorder::writerLoop, this );
+
+	started_ = true;
+	return true;
+}
+
+
+OutputRecorder::Block* OutputRecorder::currentBlock()
+{
+	if ( 0 != current_ ) return current_;
+
+	boost::unique_lock<boost::mutex> lock( mutex_ );
+
+	// Bounded memory: wait for the writer thread in case no block is available.
+	while ( true == freeBlocks_.empty() ) blockFree_.wait( lock );
+
+	if ( false == ok_ ) return 0;
+
+	current_ = freeBlocks_.front();
+	freeBlocks_.pop_front();
+	current_->nSamples_ = 0;
+
+	return current_;
+}
+
+
+void OutputRecorder::submitCurrentBlock()
+{
+	{
+		boost::lock_guard<boost::mutex> lock( mutex_ );
+		fullBlocks_.push_back( current_ );
+		current_ = 0;
+	}
+	blockFull_.notify_one();
+}
+
+
+void OutputRecorder::writerLoop()
+{
+	boost::unique_lock<boost::mutex> lock( mutex_ );
+
+	while ( true )
+	{
+		while ( ( true == fullBlocks_.empty() ) && ( false == stopWriter_ ) ) blockFull_.wait( lock );
+
+		if ( true == fullBlocks_.empty() ) break; // Stop only when all blocks have been written.
+
+		Block* block = fullBlocks_.front();
+		fullBlocks_.pop_front();
+		++nBlocksInWriting_;
+
+		// Write without holding the lock, so that recording can continue meanwhile.
+		lock.unlock();
+		writeBlock( block );
+		bool fail = file_.fail();
+		lock.lock();
+
+		if ( true == fail ) ok_ = false;
+
+		--nBlocksInWriting_;
+		freeBlocks_.push_back( block );
+		blockFree_.notify_all();
+	}
+}
+
+
+void OutputRecorder::writeHeader()
+{
+	if ( csv == format_ ) {
+		file_ << "time";
+		for ( size_t c = 0; c < realNames_.size(); ++c ) file_ << "," << realNames_[c];
+		for ( size_t c = 0; c < integerNames_.size(); ++c ) file_ << "," << integerNames_[c];
+		for ( size_t c = 0; c < booleanNames_.size(); ++c ) file_ << "," << booleanNames_[c];
+		file_ << endl;
+		file_ << setprecision( numeric_limits<fmiReal>::digits10 + 2 );
+		return;
+	}
+
+	file_.write( "FMIPPREC", 8 );
+
+	boost::uint32_t header[4] = { binaryFormatVersion,
+				      static_cast<boost::uint32_t>( realNames_.size() ),
+				      static_cast<boost::uint32_t>( integerNames_.size() ),
+				      static_cast<boost::uint32_t>( booleanNames_.size() ) };
+	file_.write( reinterpret_cast<const char*>( header ), sizeof( header ) );
+
+	const vector<string>* names[3] = { &realNames_, &integerNames_, &booleanNames_ };
+	for ( size_t n = 0; n < 3; ++n ) {
+		for ( size_t c = 0; c < names[n]->size(); ++c ) {
+			const string& name = names[n]->at( c );
+			boost::uint32_t length = static_cast<boost::uint32_t>( name.size() );
+			file_.write( reinterpret_cast<const char*>( &length ), sizeof( length ) );
+			file_.write( name.data(), length );
+		}
+	}
+}
+
+
+void OutputRecorder::writeBlock( const Block* block )
+{
+	const size_t nSamples = block->nSamples_;
+
+	if ( csv == format_ ) {
+		for ( size_t i = 0; i < nSamples; ++i ) {
+			file_ << block->time_[i];
+			for ( size_t c = 0; c < realNames_.size(); ++c )
+				file_ << "," << block->reals_[c*blockSize_ + i];
+			for ( size_t c = 0; c < integerNames_.size(); ++c )
+				file_ << "," << block->integers_[c*blockSize_ + i];
+			for ( size_t c = 0; c < booleanNames_.size(); ++c )
+				file_ << "," << ( ( fmiTrue == block->booleans_[c*blockSize_ + i] ) ? 1 : 0 );
+			file_ << "\n";
+		}
+		return;
+	}
+
+	boost::uint32_t n = static_cast<boost::uint32_t>( nSamples );
+	file_.write( reinterpret_cast<const char*>( &n ), sizeof( n ) );
+
+	file_.write( reinterpret_cast<const char*>( block->time_ ), nSamples*sizeof( fmiTime ) );
+
+	for ( size_t c = 0; c < realNames_.size(); ++c )
+		file_.write( reinterpret_cast<const char*>( block->reals_ + c*blockSize_ ),
+			     nSamples*sizeof( fmiReal ) );
+
+	for ( size_t c = 0; c < integerNames_.size(); ++c )
+		file_.write( reinterpret_cast<const char*>( block->integers_ + c*blockSize_ ),
+			     nSamples*sizeof( fmiInteger ) );
+
+	for ( size_t c = 0; c < booleanNames_.size(); ++c )
+		file_.write( reinterpret_cast<const char*>( block->booleans_ + c*blockSize_ ),
+			     nSamples*sizeof( fmiBoolean ) );
+}
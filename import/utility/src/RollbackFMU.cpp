@@ -38,7 +38,9 @@ RollbackFMU::RollbackFMU( const string& fmuPath,
 			  const string& modelName ) :
 	fmu_( 0 ),
 	rollbackState_(),
-	rollbackStateSaved_( false )
+	rollbackStateSaved_( false ),
+	checkpoints_(),
+	maxCheckpoints_( 0 )
 {
 	// load the fmu_ as type 1.0 or 2.0 depending on the Modeldescription
 	bool isValid = false;
@@ -66,7 +68,9 @@ RollbackFMU::RollbackFMU( const string& xmlPath,
 	fmu_( 0 ),
 	// \todo: check wether fmu_ == 0 before calling member functions
 	rollbackState_(),
-	rollbackStateSaved_( false )
+	rollbackStateSaved_( false ),
+	checkpoints_(),
+	maxCheckpoints_( 0 )
 {
 	bool isValid = false;
 	ModelDescription md( xmlPath, isValid );
@@ -122,6 +126,9 @@ fmiReal RollbackFMU::integrate( fmiReal tstop, unsigned int nsteps )
 		if ( 0 != fmu_->nStates() ) fmu_->getContinuousStates( rollbackState_.state_ );
 	}
 
+	// Store the current state as checkpoint.
+	if ( ( tstop >= now ) && ( 0 != maxCheckpoints_ ) ) saveCheckpoint();
+
 	// Integrate.
 	assert( nsteps > 0 );
 	double deltaT = ( tstop - fmu_->getTime() ) / nsteps;
@@ -143,6 +150,9 @@ fmiReal RollbackFMU::integrate( fmiReal tstop, double deltaT )
 		if ( 0 != fmu_->nStates() ) fmu_->getContinuousStates( rollbackState_.state_ );
 	}
 
+	// Store the current state as checkpoint.
+	if ( ( tstop >= now ) && ( 0 != maxCheckpoints_ ) ) saveCheckpoint();
+
 	// Integrate.
 	return fmu_->integrate( tstop, deltaT );
 }
@@ -174,13 +184,77 @@ void RollbackFMU::releaseRollbackState()
 }
 
 
+void RollbackFMU::setMaxCheckpoints( size_t maxCheckpoints )
+{
+	maxCheckpoints_ = maxCheckpoints;
+
+	while ( checkpoints_.size() > maxCheckpoints_ ) thinOutCheckpoints();
+}
+
+
+void RollbackFMU::saveCheckpoint()
+{
+	fmiTime now = fmu_->getTime();
+
+	// Only store checkpoints in chronological order.
+	if ( ( false == checkpoints_.empty() ) && ( now <= checkpoints_.back().time_ ) ) return;
+
+	HistoryEntry checkpoint( now, fmu_->nStates(), 0, 0, 0, 0 );
+	if ( 0 != fmu_->nStates() ) fmu_->getContinuousStates( checkpoint.state_ );
+
+	checkpoints_.push_back( checkpoint );
+
+	while ( checkpoints_.size() > maxCheckpoints_ ) thinOutCheckpoints();
+}
+
+
+/** Remove the checkpoint that leaves the smallest gap relative to its
+    age, i.e., the distance of the neighbouring checkpoints divided by the
+    time elapsed since the older neighbour. This keeps the oldest and the
+    newest checkpoint and leads to a (roughly) geometric spacing of the
+    remaining checkpoints, with dense checkpoints close to the current time. **/
+void RollbackFMU::thinOutCheckpoints()
+{
+	if ( checkpoints_.size() < 3 ) {
+		checkpoints_.erase( checkpoints_.begin() );
+		return;
+	}
+
+	const fmiTime newest = checkpoints_.back().time_;
+
+	History::iterator itRemove = checkpoints_.begin() + 1;
+	fmiTime minRelativeGap = numeric_limits<fmiTime>::max();
+
+	for ( History::iterator it = checkpoints_.begin() + 1; it != checkpoints_.end() - 1; ++it )
+	{
+		fmiTime before = ( it - 1 )->time_;
+		fmiTime relativeGap = ( ( it + 1 )->time_ - before ) / ( newest - before );
+
+		if ( relativeGap < minRelativeGap ) {
+			minRelativeGap = relativeGap;
+			itRemove = it;
+		}
+	}
+
+	checkpoints_.erase( itRemove );
+}
+
+
 fmiStatus RollbackFMU::rollback( fmiTime time )
 {
 #ifdef FMI_DEBUG
 	cout << "[RollbackFMU::rollback]" << endl; fflush( stdout );
 #endif
 
-	if ( time < rollbackState_.time_ ) {
+	// Find the latest checkpoint not later than the requested time.
+	History::reverse_iterator itCheckpoint = checkpoints_.rbegin();
+	while ( ( itCheckpoint != checkpoints_.rend() ) && ( itCheckpoint->time_ > time ) ) ++itCheckpoint;
+
+	// Use the checkpoint in case it is closer to the requested time than the rollback state.
+	bool useCheckpoint = ( itCheckpoint != checkpoints_.rend() ) &&
+		( ( time < rollbackState_.time_ ) || ( itCheckpoint->time_ > rollbackState_.time_ ) );
+
+	if ( ( time < rollbackState_.time_ ) && ( false == useCheckpoint ) ) {
 #ifdef FMI_DEBUG
 		cout << "[RollbackFMU::rollback] FAILED. requested time = " << time
 		     << " - rollback state time = " << rollbackState_.time_ << endl; fflush( stdout );
@@ -188,12 +262,27 @@ fmiStatus RollbackFMU::rollback( fmiTime time )
 		return fmiFatal;
 	}
 
-	fmu_->setTime( rollbackState_.time_ );
+	const fmiTime rollbackTime = useCheckpoint ? itCheckpoint->time_ : rollbackState_.time_;
+
+	// All checkpoints later than the state used for the rollback are outdated.
+	while ( ( false == checkpoints_.empty() ) && ( checkpoints_.back().time_ > rollbackTime ) )
+		checkpoints_.pop_back();
+
+	// A saved rollback state later than the checkpoint is outdated too.
+	if ( ( true == useCheckpoint ) &&
+	     ( ( false == rollbackStateSaved_ ) || ( rollbackTime < rollbackState_.time_ ) ) ) {
+		rollbackState_ = checkpoints_.back();
+		rollbackStateSaved_ = false;
+	}
+
+	const HistoryEntry& state = useCheckpoint ? checkpoints_.back() : rollbackState_;
+
+	fmu_->setTime( state.time_ );
 	fmu_->raiseEvent();
 	fmu_->handleEvents();
 
 	if ( 0 != fmu_->nStates() ) {
-		fmu_->setContinuousStates( rollbackState_.state_ );
+		fmu_->setContinuousStates( state.state_ );
 		fmu_->raiseEvent();
 	}
 
@@ -0,0 +1,331 @@
+// --------------------------------------------------------------
+// Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+// All rights reserved. See file FMIPP_LICENSE for details.
+// --------------------------------------------------------------
+
+/**
+ * \file benchmarkSHMTransport.cpp
+ * Microbenchmark for the export path (not part of the unit tests).
+ *
+ * Part 1 measures the shared memory transport (SHMMaster/SHMSlave) in isolation: for each type
+ * and number of scalar variables, the master changes all inputs and signals the slave, the slave
+ * copies the changed inputs to the outputs (as FMIComponentBackEnd does) and signals back, then
+ * the master reads all outputs. The per-variable cost is the difference between the median round
+ * trip time and the median round trip time without any variables, divided by the number of variables.
+ *
+ * Part 2 measures calls to doStep(...) of the sine_standalone FMU end to end, i.e., including
+ * FMIComponentFrontEnd and FMIComponentBackEnd (with sine_standalone_exe as stand-in application).
+ * Run the benchmark from the directory containing sine_standalone_exe or add it to the PATH.
+ *
+ * Usage: benchmarkSHMTransport [iterations] [spin]
+ * Use option "spin" for spin-then-block synchronization of master and slave.
+ */
+
+#include <import/base/include/FMUCoSimulation.h>
+#include <export/include/SHMMaster.h>
+#include <export/include/SHMSlave.h>
+#include <export/include/SHMSegmentPlan.h>
+#include <export/include/IPCLogger.h>
+#include <export/include/ScalarVariable.h>
+
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef WIN32
+#include <signal.h>
+#endif
+
+
+namespace {
+
+	typedef std::chrono::steady_clock Clock;
+
+	class DummyIPCLogger : public IPCLogger
+	{
+	public:
+		virtual void logger( fmiStatus status, const std::string& category, const std::string& msg ) {}
+	};
+
+#ifndef WIN32
+	void dummy_signal_handler( int ) {}
+#endif
+
+	// Numbers of scalar variables per benchmark run (0 measures the pure synchronization).
+	const unsigned int variableCounts[] = { 0, 1, 10, 100, 1000 };
+	const unsigned int nVariableCounts = sizeof( variableCounts )/sizeof( variableCounts[0] );
+
+	// Latency statistics of a benchmark run (in microseconds).
+	struct Statistics
+	{
+		double mean_;
+		double p50_;
+		double p90_;
+		double p99_;
+		double max_;
+		double throughput_; // round trips per second
+	};
+
+	Statistics evaluate( std::vector<double>& latencies, double totalTime )
+	{
+		std::sort( latencies.begin(), latencies.end() );
+
+		Statistics stats;
+		const std::size_t n = latencies.size();
+		double sum = 0.;
+		for ( std::size_t i = 0; i < n; ++i ) sum += latencies[i];
+
+		stats.mean_ = sum/n;
+		stats.p50_ = latencies[( n - 1 )*50/100];
+		stats.p90_ = latencies[( n - 1 )*90/100];
+		stats.p99_ = latencies[( n - 1 )*99/100];
+		stats.max_ = latencies[n - 1];
+		stats.throughput_ = n/totalTime;
+
+		return stats;
+	}
+
+	inline double microseconds( const Clock::time_point& start, const Clock::time_point& stop )
+	{
+		return std::chrono::duration<double, std::micro>( stop - start ).count();
+	}
+
+	// Change the value of an input.
+	inline void changeValue( double& value, unsigned int step ) { value = 0.5*step; }
+	inline void changeValue( int& value, unsigned int step ) { value = static_cast<int>( step ); }
+	inline void changeValue( char& value, unsigned int step ) { value = static_cast<char>( step & 1 ); }
+	inline void changeValue( ScalarVariableString& value, unsigned int step ) { value.set( ( step & 1 ) ? "odd" : "even" ); }
+
+	// Read the value of an output.
+	inline double readValue( const double& value ) { return value; }
+	inline double readValue( const int& value ) { return value; }
+	inline double readValue( const char& value ) { return value; }
+	inline double readValue( const ScalarVariableString& value ) { return static_cast<double>( std::strlen( value.c_str() ) ); }
+
+	// Slave side of the transport benchmark, copies changed inputs to outputs (see FMIComponentBackEnd).
+	template<typename Type>
+	void slaveLoop( SHMSlave* slave, unsigned int nVariables, unsigned int iterations )
+	{
+		unsigned int numObj = 0;
+		const ScalarVariableMetadata* metadata = 0;
+		Type* inputs = 0;
+		Type* outputs = 0;
+		unsigned int* log = 0;
+		ScalarVariableChangeLog changes;
+
+		if ( 0 != nVariables ) {
+			slave->retrieveScalars( "inputs", numObj, metadata, inputs );
+			slave->retrieveScalars( "outputs", numObj, metadata, outputs );
+			slave->retrieveChangeLog( "inputs", numObj, log );
+			changes.attach( numObj, log );
+		}
+
+		for ( unsigned int step = 0; step < iterations; ++step )
+		{
+			slave->waitForMaster();
+
+			const unsigned int nChanges = changes.getNumberOfChanges();
+			for ( unsigned int k = 0; k < nChanges; ++k ) {
+				const unsigned int i = changes.getChange( k );
+				outputs[i] = inputs[i];
+			}
+			changes.clear();
+
+			slave->signalToMaster();
+		}
+	}
+
+	// Master side of the transport benchmark.
+	template<typename Type>
+	bool benchmarkTransport( const std::string& typeName, unsigned int nVariables,
+				 unsigned int iterations, bool spin, Statistics& stats )
+	{
+		DummyIPCLogger logger;
+
+		std::stringstream id;
+		id << "benchmark_shm_transport_" << typeName << "_" << nVariables;
+
+		SHMSegmentPlan plan( id.str() );
+		plan.addScalars<Type>( "inputs", nVariables );
+		plan.addScalars<Type>( "outputs", nVariables );
+		plan.addChangeLog( "inputs", nVariables );
+
+		SHMMaster master( id.str(), plan.getSegmentSize(), &logger, spin );
+		if ( false == master.isOperational() ) return false;
+
+		ScalarVariableMetadata* metadata = 0;
+		Type* inputs = 0;
+		Type* outputs = 0;
+		unsigned int* log = 0;
+		ScalarVariableChangeLog changes;
+
+		if ( 0 != nVariables ) {
+			if ( false == master.createScalars( "inputs", nVariables, metadata, inputs ) ) return false;
+			if ( false == master.createScalars( "outputs", nVariables, metadata, outputs ) ) return false;
+			if ( false == master.createChangeLog( "inputs", nVariables, log ) ) return false;
+			changes.attach( nVariables, log );
+		}
+
+		SHMSlave slave( id.str(), &logger, spin );
+		if ( false == slave.isOperational() ) return false;
+
+		// Initially, the master is allowed to proceed.
+		master.waitForSlave();
+
+		boost::thread slaveThread( slaveLoop<Type>, &slave, nVariables, iterations );
+
+		std::vector<double> latencies( iterations );
+		double checksum = 0.;
+
+		Clock::time_point begin = Clock::now();
+		for ( unsigned int step = 0; step < iterations; ++step )
+		{
+			Clock::time_point start = Clock::now();
+
+			for ( unsigned int i = 0; i < nVariables; ++i ) {
+				changeValue( inputs[i], step );
+				changes.mark( i );
+			}
+
+			master.signalToSlave();
+			master.waitForSlave();
+
+			for ( unsigned int i = 0; i < nVariables; ++i ) checksum += readValue( outputs[i] );
+
+			latencies[step] = microseconds( start, Clock::now() );
+		}
+		double totalTime = microseconds( begin, Clock::now() )*1e-6;
+
+		slaveThread.join();
+
+		// Make sure the outputs have actually been read.
+		if ( checksum < 0. ) std::cout << checksum << std::endl;
+
+		stats = evaluate( latencies, totalTime );
+		return true;
+	}
+
+	void printHeader()
+	{
+		std::cout << std::setw( 12 ) << "type" << std::setw( 8 ) << "vars"
+			  << std::setw( 10 ) << "mean" << std::setw( 10 ) << "p50" << std::setw( 10 ) << "p90"
+			  << std::setw( 10 ) << "p99" << std::setw( 10 ) << "max" << std::setw( 14 ) << "steps/s"
+			  << std::setw( 12 ) << "ns/var" << std::endl;
+	}
+
+	void printStatistics( const std::string& typeName, unsigned int nVariables,
+			      const Statistics& stats, double baseline )
+	{
+		std::cout << std::fixed << std::setprecision( 2 )
+			  << std::setw( 12 ) << typeName << std::setw( 8 ) << nVariables
+			  << std::setw( 10 ) << stats.mean_ << std::setw( 10 ) << stats.p50_
+			  << std::setw( 10 ) << stats.p90_ << std::setw( 10 ) << stats.p99_
+			  << std::setw( 10 ) << stats.max_ << std::setw( 14 ) << std::setprecision( 0 ) << stats.throughput_;
+
+		// A negative baseline means that the per-variable cost is not available.
+		if ( ( 0 != nVariables ) && ( baseline >= 0. ) ) {
+			std::cout << std::setw( 12 ) << std::setprecision( 1 ) << 1e3*( stats.p50_ - baseline )/nVariables;
+		} else {
+			std::cout << std::setw( 12 ) << "-";
+		}
+
+		std::cout << std::endl;
+	}
+
+	template<typename Type>
+	bool benchmarkType( const std::string& typeName, unsigned int iterations, bool spin )
+	{
+		double baseline = 0.;
+
+		for ( unsigned int k = 0; k < nVariableCounts; ++k )
+		{
+			Statistics stats;
+			if ( false == benchmarkTransport<Type>( typeName, variableCounts[k], iterations, spin, stats ) ) {
+				std::cerr << "shared memory transport not operational (" << typeName << ")" << std::endl;
+				return false;
+			}
+
+			if ( 0 == variableCounts[k] ) baseline = stats.p50_;
+			printStatistics( typeName, variableCounts[k], stats, baseline );
+		}
+
+		return true;
+	}
+
+	bool benchmarkFMU( unsigned int iterations )
+	{
+#ifndef WIN32
+		// Avoid that the termination of the application is treated as error.
+		signal( SIGCHLD, dummy_signal_handler );
+#endif
+
+		std::string MODELNAME( "sine_standalone" );
+		FMUCoSimulation fmu( FMU_URI_PRE + MODELNAME, MODELNAME );
+
+		if ( fmiOK != fmu.instantiate( "sine_standalone1", 0., fmiFalse, fmiFalse ) ) return false;
+		if ( fmiOK != fmu.setValue( "omega", 0.1 ) ) return false;
+		if ( fmiOK != fmu.initialize( 0., fmiFalse, 0. ) ) return false;
+
+		std::vector<double> latencies( iterations );
+		fmiReal t = 0.;
+		fmiReal stepsize = 1.;
+		fmiReal x = 0.;
+
+		Clock::time_point begin = Clock::now();
+		for ( unsigned int step = 0; step < iterations; ++step )
+		{
+			Clock::time_point start = Clock::now();
+
+			if ( fmiOK != fmu.setValue( "omega", 0.1 + 1e-6*( step & 1 ) ) ) return false;
+			if ( fmiOK != fmu.doStep( t, stepsize, fmiTrue ) ) return false;
+			if ( fmiOK != fmu.getValue( "x", x ) ) return false;
+
+			latencies[step] = microseconds( start, Clock::now() );
+			t += stepsize;
+		}
+		double totalTime = microseconds( begin, Clock::now() )*1e-6;
+
+		Statistics stats = evaluate( latencies, totalTime );
+		printStatistics( "doStep", 1, stats, -1. );
+
+		return true;
+	}
+}
+
+
+int main( int argc, const char* argv[] )
+{
+	unsigned int iterations = ( argc > 1 ) ? static_cast<unsigned int>( atoi( argv[1] ) ) : 10000;
+	bool spin = ( argc > 2 ) && ( std::string( "spin" ) == argv[2] );
+
+	if ( 0 == iterations ) {
+		std::cerr << "usage: " << argv[0] << " [iterations] [spin]" << std::endl;
+		return -1;
+	}
+
+	std::cout << "shared memory transport, " << iterations << " round trips per run"
+		  << ( spin ? " (spin-then-block)" : "" ) << ", latencies in microseconds" << std::endl;
+	printHeader();
+
+	if ( false == benchmarkType<double>( "fmiReal", iterations, spin ) ) return -1;
+	if ( false == benchmarkType<int>( "fmiInteger", iterations, spin ) ) return -1;
+	if ( false == benchmarkType<char>( "fmiBoolean", iterations, spin ) ) return -1;
+	if ( false == benchmarkType<ScalarVariableString>( "fmiString", iterations, spin ) ) return -1;
+
+	std::cout << std::endl << "FMU sine_standalone, setValue + doStep + getValue, latencies in microseconds" << std::endl;
+	printHeader();
+
+	if ( false == benchmarkFMU( iterations ) ) {
+		std::cerr << "FMU benchmark failed (is sine_standalone_exe in the PATH?)" << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
@@ -18,16 +18,134 @@
 
 namespace {
 	const double twopi = 6.28318530718;
+
+	// State of one instance of the FMU served by this application.
+	struct SineInstance
+	{
+		SineInstance() :
+			syncTime( 0. ), omega( 0. ), x( 0. ), cycles( 0 ), positive( fmiFalse ), reset( false ),
+			realInputs( 1, &omega ), realOutputs( 1, &x ),
+			integerOutputs( 1, &cycles ), booleanOutputs( 1, &positive ) {}
+
+		FMIComponentBackEnd backend;
+
+		fmiReal syncTime;
+		fmiReal omega;
+		fmiReal x;
+		fmiInteger cycles;
+		fmiBoolean positive;
+
+		// Flag indicating that a reset has been acknowledged, i.e., the next request of
+		// the master is to initialize the slave anew.
+		bool reset;
+
+		std::vector<fmiReal*> realInputs;
+		std::vector<fmiReal*> realOutputs;
+		std::vector<fmiInteger*> integerOutputs;
+		std::vector<fmiBoolean*> booleanOutputs;
+	};
+
+	const fmiReal fixedTimeStep = 1.;
+
+	// Use the communication step size of the master instead of the fixed time step?
+	bool variableTimeStep = false;
+}
+
+
+// Initialize the inputs and outputs of an instance.
+void initialize( SineInstance& instance )
+{
+	std::vector<std::string> realInputLabels( 1, "omega" );
+	std::vector<std::string> realOutputLabels( 1, "x" );
+	std::vector<std::string> integerOutputLabels( 1, "cycles" );
+	std::vector<std::string> booleanOutputLabels( 1, "positive" );
+
+	FMIComponentBackEnd& backend = instance.backend;
+	instance.syncTime = backend.getCurrentCommunicationPoint();
+
+	fmiStatus init;
+
+	if ( fmiOK != ( init = backend.initializeRealInputs( realInputLabels ) ) ) {
+		std::cout << "initializeRealInputs returned " << init << std::endl;
+	}
+
+	if ( fmiOK != ( init = backend.initializeRealOutputs( realOutputLabels ) ) ) {
+		std::cout << "initializeRealOutputs returned " << init << std::endl;
+	}
+
+	if ( fmiOK != ( init = backend.initializeIntegerOutputs( integerOutputLabels ) ) ) {
+		std::cout << "initializeBoolOutputs returned " << init << std::endl;
+	}
+
+	if ( fmiOK != ( init = backend.initializeBooleanOutputs( booleanOutputLabels ) ) ) {
+		std::cout << "initializeBoolOutputs returned " << init << std::endl;
+	}
+
+	if ( false == variableTimeStep ) backend.enforceTimeStep( fixedTimeStep ); // Let's do fixed time steps!
+	backend.endInitialization();
+}
+
+
+// Serve a request of the master of an instance.
+void doStep( SineInstance& instance )
+{
+	FMIComponentBackEnd& backend = instance.backend;
+
+	// Start over if the master has reset the slave (the backend does not wait for the master
+	// to initialize the slave anew, since the backends are served by an event loop).
+	if ( true == backend.isResetRequested() )
+	{
+		backend.startInitialization();
+		instance.reset = true;
+		return;
+	}
+
+	if ( true == instance.reset )
+	{
+		instance.reset = false;
+		instance.syncTime = backend.getCurrentCommunicationPoint();
+		if ( false == variableTimeStep ) backend.enforceTimeStep( fixedTimeStep );
+		backend.endInitialization();
+		return;
+	}
+
+	// Only inputs changed by the master are copied.
+	size_t nChangedInputs = 0;
+	backend.getChangedRealInputs( instance.realInputs, nChangedInputs );
+
+	instance.syncTime += variableTimeStep ? backend.getCommunicationStepSize() : fixedTimeStep;
+	instance.x = sin( instance.omega*instance.syncTime );
+	instance.cycles = int( instance.omega*instance.syncTime/twopi );
+	instance.positive = ( instance.x > 0. ) ? fmiTrue : fmiFalse;
+
+	backend.setRealOutputs( instance.realOutputs );
+	backend.setIntegerOutputs( instance.integerOutputs );
+	backend.setBooleanOutputs( instance.booleanOutputs );
+	if ( false == variableTimeStep ) backend.enforceTimeStep( fixedTimeStep );
+	backend.signalToMaster();
 }
 
 
 
 int main( int argc, const char* argv[] )
 {
-	// Init backend.
-	FMIComponentBackEnd backend;
+	// Init backends, one per instance of the FMU served by this application.
+	const unsigned int nInstances = FMIComponentBackEnd::getNumberOfInstances();
+	std::vector<SineInstance*> instances( nInstances );
+	std::vector<FMIComponentBackEnd*> backends( nInstances );
+	for ( unsigned int i = 0; i < nInstances; ++i ) {
+		instances[i] = new SineInstance;
+		backends[i] = &instances[i]->backend;
+	}
+
+	FMIComponentBackEnd& backend = *backends[0];
 
-	try { backend.startInitialization(); } catch (...) { return -1; }
+	// Connect all backends upfront, without waiting for their masters.
+	try {
+		for ( unsigned int i = 0; i < nInstances; ++i ) {
+			if ( fmiOK != backends[i]->connect( i ) ) return -1;
+		}
+	} catch (...) { return -1; }
 
 	if ( 4 != argc ) {
 		std::ostringstream ss;
@@ -46,6 +164,7 @@ int main( int argc, const char* argv[] )
 #endif
 	std::string expectedPreArgument = std::string( "pre" );
 	std::string expectedPostArgument = std::string( "post" );
+	std::string variablePostArgument = std::string( "variable" ); // Variant with variable time steps.
 
 
 	if ( std::string( argv[1] ) != expectedPreArgument ) {
@@ -64,7 +183,9 @@ int main( int argc, const char* argv[] )
 		return -1;
 	}
 
-	if ( std::string( argv[3] ) != expectedPostArgument ) {
+	variableTimeStep = ( std::string( argv[3] ) == variablePostArgument );
+
+	if ( ( std::string( argv[3] ) != expectedPostArgument ) && ( false == variableTimeStep ) ) {
 		std::string err =
 			std::string( "Wrong input argument - expected \"" ) + expectedPostArgument +
 			std::string( "\", but got " ) + std::string( argv[3] );
@@ -72,62 +193,19 @@ int main( int argc, const char* argv[] )
 		return -1;
 	}
 
-	fmiReal syncTime = backend.getCurrentCommunicationPoint();
-	fmiReal fixedTimeStep = 1.;
-
-	fmiReal omega;
-	fmiReal x;
-	fmiInteger cycles;
-	fmiBoolean positive;
-
-
-	std::vector<std::string> realInputLabels( 1, "omega" );
-	std::vector<std::string> realOutputLabels( 1, "x" );
-	std::vector<std::string> integerOutputLabels( 1, "cycles" );
-	std::vector<std::string> booleanOutputLabels( 1, "positive" );
-
-	std::vector<fmiReal*> realInputs( 1, &omega );
-	std::vector<fmiReal*> realOutputs( 1, &x );
-	std::vector<fmiInteger*> integerOutputs( 1, &cycles );
-	std::vector<fmiBoolean*> booleanOutputs( 1, &positive );
-
-	fmiStatus init;
-
-	if ( fmiOK != ( init = backend.initializeRealInputs( realInputLabels ) ) ) {
-		std::cout << "initializeRealInputs returned " << init << std::endl;
-	}
-
-	if ( fmiOK != ( init = backend.initializeRealOutputs( realOutputLabels ) ) ) {
-		std::cout << "initializeRealOutputs returned " << init << std::endl;
-	}
-
-	if ( fmiOK != ( init = backend.initializeIntegerOutputs( integerOutputLabels ) ) ) {
-		std::cout << "initializeBoolOutputs returned " << init << std::endl;
-	}
-
-	if ( fmiOK != ( init = backend.initializeBooleanOutputs( booleanOutputLabels ) ) ) {
-		std::cout << "initializeBoolOutputs returned " << init << std::endl;
-	}
-
-	backend.enforceTimeStep( fixedTimeStep ); // Let's do fixed time steps!
-	backend.endInitialization();
-
-	// Pseudo simulation loop.
+	// Pseudo simulation loop, serving all instances.
+	unsigned int next = 0;
 	while ( true )
 	{
-		backend.waitForMaster();
-		backend.getRealInputs( realInputs );
-
-		syncTime += fixedTimeStep;
-		x = sin( omega*syncTime );
-		cycles = int( omega*syncTime/twopi );
-		positive = ( x > 0. ) ? fmiTrue : fmiFalse;
-
-		backend.setRealOutputs( realOutputs );
-		backend.setIntegerOutputs( integerOutputs );
-		backend.setBooleanOutputs( booleanOutputs );
-		backend.enforceTimeStep( fixedTimeStep );
-		backend.signalToMaster();
+		unsigned int i = FMIComponentBackEnd::waitForAnyMaster( backends, next );
+
+		// Instances are initialized as soon as their masters initialize them.
+		if ( false == backends[i]->isInitialized() ) {
+			if ( fmiOK != backends[i]->startInitialization( i ) ) return -1;
+			initialize( *instances[i] );
+		} else {
+			doStep( *instances[i] );
+		}
 	}
 
 	return 0;
@@ -5,18 +5,54 @@
 
 #include <import/base/include/FMUCoSimulation.h>
 #include <import/base/include/CallbackFunctions.h>
+#include <export/include/SHMMaster.h>
+#include <export/include/SHMSlave.h>
+#include <export/include/SHMSegmentPlan.h>
+#include <export/include/SocketMaster.h>
+#include <export/include/SocketSlave.h>
+#include <export/include/SlaveProcessPool.h>
+#include <boost/interprocess/mapped_region.hpp>
+#include <export/include/IPCLogger.h>
+#include <export/include/IPCSlaveLogger.h>
+#include <export/include/ScalarVariable.h>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE testFMIExportUtilities
 
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/thread/thread.hpp>
 #include <cmath>
+#include <sstream>
+#include <fstream>
+#include <string>
 
 
 #ifndef WIN32
 #include <signal.h>
+#include <set>
 void dummy_signal_handler( int ) {} // Dummy signal handler function.
+
+// Get the PIDs of the running (i.e., not yet terminated) child processes of this process.
+std::set<pid_t> getChildProcesses()
+{
+	std::set<pid_t> children;
+
+	using namespace boost::filesystem;
+	for ( directory_iterator it( "/proc" ), end; it != end; ++it )
+	{
+		std::ifstream stat( ( it->path() / "stat" ).string().c_str() );
+
+		pid_t pid;
+		std::string name;
+		char state;
+		pid_t parent;
+		if ( ( stat >> pid >> name >> state >> parent ) && ( getpid() == parent ) && ( 'Z' != state ) )
+			children.insert( pid );
+	}
+
+	return children;
+}
 #endif
 
 
@@ -30,6 +66,30 @@ namespace {
 		iStepFinished++;
 	}
 
+	unsigned int iPipelinedStepFinished = 0;
+	fmiStatus pipelinedStepStatus = fmiFatal;
+
+	void pipelinedStepFinished( fmiComponent c, fmiStatus status )
+	{
+		iPipelinedStepFinished++;
+		pipelinedStepStatus = status;
+	}
+
+	class DummyIPCLogger : public IPCLogger
+	{
+	public:
+		virtual void logger( fmiStatus status, const std::string& category, const std::string& msg ) {}
+	};
+
+	void slaveLoop( SHMSlave* slave, int* value, int nSteps )
+	{
+		for ( int i = 0; i < nSteps; ++i ) {
+			slave->waitForMaster();
+			++( *value );
+			slave->signalToMaster();
+		}
+	}
+
 }
 
 
@@ -344,3 +404,765 @@ BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_step_finished )
 
 	BOOST_REQUIRE( std::abs( tstop - fmu.getTime() ) < EPS_TIME );
 }
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_pipelined )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	// Same FMU as "sine_standalone", but with capability canRunAsynchronuously.
+	std::string MODELNAME( "sine_standalone" );
+	FMUCoSimulation fmu( FMU_URI_PRE + MODELNAME + "_async", MODELNAME );
+
+	fmu.setCallbacks( callback::verboseLogger,
+			  callback::allocateMemory,
+			  callback::freeMemory,
+			  pipelinedStepFinished );
+
+	fmiStatus status = fmu.instantiate( "sine_standalone_async1", 0., fmiFalse, fmiFalse );
+	BOOST_REQUIRE( status == fmiOK );
+
+	fmiReal omega = 0.628318531; // Corresponds to a period of 10s.
+	status = fmu.setValue( "omega", omega );
+	BOOST_REQUIRE( status == fmiOK );
+
+	fmiReal t = 0.;
+	fmiReal stepsize = 1.;
+	fmiReal tstop = 10.;
+	fmiReal x = 0.;
+
+	status = fmu.initialize( t, fmiTrue, tstop );
+	BOOST_REQUIRE( status == fmiOK );
+
+	unsigned int checkStepFinished = 0;
+
+	while ( ( t + stepsize ) - tstop < EPS_TIME )
+	{
+		// The step is handed over to the slave, doStep(...) returns immediately.
+		status = fmu.doStep( t, stepsize, fmiTrue );
+		BOOST_REQUIRE_MESSAGE( status == fmiPending, "doStep(...) failed: status = " << status );
+
+		t += stepsize;
+		++checkStepFinished;
+
+		// Retrieving results blocks until the pending step has been finished.
+		status = fmu.getValue( "x", x );
+		BOOST_REQUIRE( status == fmiOK );
+		BOOST_REQUIRE_EQUAL( checkStepFinished, iPipelinedStepFinished );
+		BOOST_REQUIRE( pipelinedStepStatus == fmiOK );
+
+		BOOST_REQUIRE_MESSAGE( std::abs( x - sin( omega*t ) ) < 1e-9,
+				       "wrong simulation results for x : return value = " << x <<
+				       " -> should be " << sin( omega*t ) );
+	}
+
+	BOOST_REQUIRE( std::abs( tstop - fmu.getTime() ) < EPS_TIME );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_reset )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	std::string MODELNAME( "sine_standalone" );
+	FMUCoSimulation fmu( FMU_URI_PRE + MODELNAME, MODELNAME );
+
+	fmiStatus status = fmu.instantiate( "sine_standalone_reset", 0., fmiFalse, fmiFalse );
+	BOOST_REQUIRE( status == fmiOK );
+
+	// The first run uses a different input, the second run the start value (omega = 1).
+	for ( unsigned int run = 0; run < 2; ++run )
+	{
+		fmiReal omega = 1.;
+
+		if ( 0 == run ) {
+			omega = 0.628318531;
+			status = fmu.setValue( "omega", omega );
+			BOOST_REQUIRE( status == fmiOK );
+		} else {
+			status = fmu.reset();
+			BOOST_REQUIRE( status == fmiOK );
+		}
+
+		fmiReal t = 0.;
+		fmiReal stepsize = 1.;
+		fmiReal tstop = 5.;
+		fmiReal x = 0.;
+
+		status = fmu.initialize( t, fmiTrue, tstop );
+		BOOST_REQUIRE( status == fmiOK );
+
+		while ( ( t + stepsize ) - tstop < EPS_TIME )
+		{
+			status = fmu.doStep( t, stepsize, fmiTrue );
+			BOOST_REQUIRE( status == fmiOK );
+
+			t += stepsize;
+
+			status = fmu.getValue( "x", x );
+			BOOST_REQUIRE( status == fmiOK );
+			BOOST_REQUIRE_MESSAGE( std::abs( x - sin( omega*t ) ) < 1e-9,
+					       "wrong simulation results for x (run " << run << ") : return value = " << x <<
+					       " -> should be " << sin( omega*t ) );
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_process_pool )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	// Same FMU as "sine_standalone", but keeps one idle application alive.
+	std::string MODELNAME( "sine_standalone" );
+
+	BOOST_REQUIRE_EQUAL( SlaveProcessPool::getNumberOfIdleProcesses(), 0u );
+
+	for ( unsigned int run = 0; run < 2; ++run )
+	{
+		FMUCoSimulation fmu( FMU_URI_PRE + MODELNAME + "_pool", MODELNAME );
+
+		fmiStatus status = fmu.instantiate( "sine_standalone_pool1", 0., fmiFalse, fmiFalse );
+		BOOST_REQUIRE( status == fmiOK );
+
+		// The second instance takes over the application of the first one.
+		BOOST_REQUIRE_EQUAL( SlaveProcessPool::getNumberOfIdleProcesses(), 0u );
+
+		fmiReal omega = ( 0 == run ) ? 0.628318531 : 0.314159265;
+		status = fmu.setValue( "omega", omega );
+		BOOST_REQUIRE( status == fmiOK );
+
+		fmiReal t = 0.;
+		fmiReal stepsize = 1.;
+		fmiReal tstop = 5.;
+		fmiReal x = 0.;
+
+		status = fmu.initialize( t, fmiTrue, tstop );
+		BOOST_REQUIRE( status == fmiOK );
+
+		while ( ( t + stepsize ) - tstop < EPS_TIME )
+		{
+			status = fmu.doStep( t, stepsize, fmiTrue );
+			BOOST_REQUIRE( status == fmiOK );
+
+			t += stepsize;
+
+			status = fmu.getValue( "x", x );
+			BOOST_REQUIRE( status == fmiOK );
+			BOOST_REQUIRE_MESSAGE( std::abs( x - sin( omega*t ) ) < 1e-9,
+					       "wrong simulation results for x (run " << run << ") : return value = " << x <<
+					       " -> should be " << sin( omega*t ) );
+		}
+	}
+
+	// The application of the last instance has been put into the pool.
+	BOOST_REQUIRE_EQUAL( SlaveProcessPool::getNumberOfIdleProcesses(), 1u );
+
+	SlaveProcessPool::clear();
+	BOOST_REQUIRE_EQUAL( SlaveProcessPool::getNumberOfIdleProcesses(), 0u );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_shared_process )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	// Same FMU as "sine_standalone", but two instances share one application.
+	std::string MODELNAME( "sine_standalone" );
+	const unsigned int nInstances = 3;
+
+	BOOST_REQUIRE_EQUAL( SlaveProcessPool::getNumberOfSharedProcesses(), 0u );
+
+	{
+		std::vector<FMUCoSimulation*> fmus( nInstances );
+		std::vector<fmiReal> omegas( nInstances );
+
+		for ( unsigned int i = 0; i < nInstances; ++i )
+		{
+			std::stringstream name;
+			name << "sine_standalone_shared" << i + 1;
+
+			fmus[i] = new FMUCoSimulation( FMU_URI_PRE + MODELNAME + "_shared", MODELNAME );
+			fmiStatus status = fmus[i]->instantiate( name.str(), 0., fmiFalse, fmiFalse );
+			BOOST_REQUIRE( status == fmiOK );
+
+			// The first two instances share one application, the third one starts another one.
+			BOOST_REQUIRE_EQUAL( SlaveProcessPool::getNumberOfSharedProcesses(), ( i < 2 ) ? 1u : 2u );
+		}
+
+		// The application serves its instances in any order, i.e., an instance that has been
+		// instantiated but not initialized yet does not block the others.
+		for ( unsigned int i = nInstances; i > 0; --i )
+		{
+			omegas[i - 1] = 0.314159265*i;
+			fmiStatus status = fmus[i - 1]->setValue( "omega", omegas[i - 1] );
+			BOOST_REQUIRE( status == fmiOK );
+
+			status = fmus[i - 1]->initialize( 0., fmiTrue, 5. );
+			BOOST_REQUIRE( status == fmiOK );
+		}
+
+		fmiReal t = 0.;
+		fmiReal stepsize = 1.;
+		fmiReal tstop = 5.;
+		fmiReal x = 0.;
+
+		while ( ( t + stepsize ) - tstop < EPS_TIME )
+		{
+			for ( unsigned int i = 0; i < nInstances; ++i ) {
+				fmiStatus status = fmus[i]->doStep( t, stepsize, fmiTrue );
+				BOOST_REQUIRE( status == fmiOK );
+			}
+
+			t += stepsize;
+
+			for ( unsigned int i = 0; i < nInstances; ++i ) {
+				fmiStatus status = fmus[i]->getValue( "x", x );
+				BOOST_REQUIRE( status == fmiOK );
+				BOOST_REQUIRE_MESSAGE( std::abs( x - sin( omegas[i]*t ) ) < 1e-9,
+						       "wrong simulation results for x (instance " << i << ") : return value = " << x <<
+						       " -> should be " << sin( omegas[i]*t ) );
+			}
+		}
+
+		// Instances that have been reset do not block each other either (the start value is omega = 1).
+		for ( unsigned int i = 0; i < nInstances; ++i ) {
+			fmiStatus status = fmus[i]->reset();
+			BOOST_REQUIRE( status == fmiOK );
+		}
+
+		for ( unsigned int i = nInstances; i > 0; --i ) {
+			fmiStatus status = fmus[i - 1]->initialize( 0., fmiTrue, 5. );
+			BOOST_REQUIRE( status == fmiOK );
+
+			status = fmus[i - 1]->doStep( 0., stepsize, fmiTrue );
+			BOOST_REQUIRE( status == fmiOK );
+
+			status = fmus[i - 1]->getValue( "x", x );
+			BOOST_REQUIRE( status == fmiOK );
+			BOOST_REQUIRE( std::abs( x - sin( stepsize ) ) < 1e-9 );
+		}
+
+		for ( unsigned int i = 0; i < nInstances; ++i ) delete fmus[i];
+	}
+
+	BOOST_REQUIRE_EQUAL( SlaveProcessPool::getNumberOfSharedProcesses(), 0u );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_tcp_slave_crash )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+
+	// Same FMU as "sine_standalone", but communicating with its application via TCP sockets.
+	std::string MODELNAME( "sine_standalone" );
+	FMUCoSimulation fmu( FMU_URI_PRE + MODELNAME + "_tcp", MODELNAME );
+
+	std::set<pid_t> children = getChildProcesses();
+
+	fmiStatus status = fmu.instantiate( "sine_standalone_tcp1", 0., fmiFalse, fmiFalse );
+	BOOST_REQUIRE( status == fmiOK );
+
+	// Find the application that has just been started.
+	std::set<pid_t> applications = getChildProcesses();
+	for ( std::set<pid_t>::const_iterator it = children.begin(); it != children.end(); ++it )
+		applications.erase( *it );
+	BOOST_REQUIRE_EQUAL( applications.size(), 1u );
+
+	fmiReal omega = 0.628318531; // Corresponds to a period of 10s.
+	status = fmu.setValue( "omega", omega );
+	BOOST_REQUIRE( status == fmiOK );
+
+	fmiReal t = 0.;
+	fmiReal stepsize = 1.;
+	fmiReal x = 0.;
+
+	status = fmu.initialize( t, fmiTrue, 10. );
+	BOOST_REQUIRE( status == fmiOK );
+
+	for ( int i = 0; i < 3; ++i )
+	{
+		status = fmu.doStep( t, stepsize, fmiTrue );
+		BOOST_REQUIRE( status == fmiOK );
+		t += stepsize;
+
+		status = fmu.getValue( "x", x );
+		BOOST_REQUIRE( status == fmiOK );
+		BOOST_REQUIRE( std::abs( x - sin( omega*t ) ) < 1e-9 );
+	}
+
+	// The application crashes in the middle of the run.
+	BOOST_REQUIRE( 0 == kill( *applications.begin(), SIGKILL ) );
+
+	status = fmu.doStep( t, stepsize, fmiTrue );
+	BOOST_REQUIRE_MESSAGE( status == fmiFatal, "doStep(...) after crash of slave: status = " << status );
+
+	// The outputs of the last step are not available anymore.
+	status = fmu.getValue( "x", x );
+	BOOST_REQUIRE_MESSAGE( status == fmiFatal, "getValue(...) after crash of slave: status = " << status );
+
+	status = fmu.doStep( t, stepsize, fmiTrue );
+	BOOST_REQUIRE( status == fmiFatal );
+#endif
+}
+
+
+BOOST_AUTO_TEST_CASE( test_shm_sync_spin_then_block )
+{
+	DummyIPCLogger logger;
+	const int nSteps = 2000;
+
+	// Check all combinations of blocking and spin-then-block modes for master and slave.
+	for ( int mode = 0; mode < 4; ++mode )
+	{
+		const bool masterSpin = ( 0 != ( mode & 1 ) );
+		const bool slaveSpin = ( 0 != ( mode & 2 ) );
+
+		std::stringstream id;
+		id << "test_shm_sync_spin_then_block_" << mode;
+
+		SHMMaster master( id.str(), 4096, &logger, masterSpin );
+		BOOST_REQUIRE( master.isOperational() );
+		BOOST_REQUIRE( master.getSpinThenBlock() == masterSpin );
+
+		int* value = 0;
+		BOOST_REQUIRE( master.createVariable( "value", value, 0 ) );
+
+		SHMSlave slave( id.str(), &logger, slaveSpin );
+		BOOST_REQUIRE( slave.isOperational() );
+		BOOST_REQUIRE( slave.getSpinThenBlock() == slaveSpin );
+
+		int* slaveValue = 0;
+		BOOST_REQUIRE( slave.retrieveVariable( "value", slaveValue ) );
+
+		// Initially, the master is allowed to proceed.
+		master.waitForSlave();
+
+		boost::thread slaveThread( slaveLoop, &slave, slaveValue, nSteps );
+
+		for ( int i = 0; i < nSteps; ++i ) {
+			master.signalToSlave();
+			master.waitForSlave();
+			BOOST_REQUIRE_EQUAL( *value, i + 1 );
+		}
+
+		slaveThread.join();
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( test_shm_scalar_layout )
+{
+	DummyIPCLogger logger;
+
+	SHMMaster master( "test_shm_scalar_layout", 65536, &logger );
+	BOOST_REQUIRE( master.isOperational() );
+
+	// Create metadata tables and dense arrays of values on the master side.
+	const unsigned int nReals = 3;
+	ScalarVariableMetadata* realMetadata = 0;
+	double* realValues = 0;
+	BOOST_REQUIRE( master.createScalars( "real_scalars", nReals, realMetadata, realValues ) );
+
+	ScalarVariableMetadata* stringMetadata = 0;
+	ScalarVariableString* stringValues = 0;
+	BOOST_REQUIRE( master.createScalars( "string_scalars", 2, stringMetadata, stringValues ) );
+
+	ScalarVariableMetadata* integerMetadata = 0;
+	int* integerValues = 0;
+	BOOST_REQUIRE( master.createScalars( "integer_scalars", 0, integerMetadata, integerValues ) );
+	BOOST_REQUIRE( 0 == integerMetadata );
+	BOOST_REQUIRE( 0 == integerValues );
+
+	for ( unsigned int i = 0; i < nReals; ++i ) {
+		std::stringstream name;
+		name << "x" << i;
+		BOOST_REQUIRE( realMetadata[i].setName( name.str() ) );
+		realMetadata[i].valueReference_ = 10 + i;
+		realMetadata[i].causality_ = ScalarVariableAttributes::output;
+		realMetadata[i].variability_ = ScalarVariableAttributes::continuous;
+		realValues[i] = 0.5*i;
+	}
+
+	BOOST_REQUIRE( stringMetadata[0].setName( "s" ) );
+	BOOST_REQUIRE( stringValues[0].set( "hello" ) );
+
+	// Strings exceeding the capacity of a slot are truncated.
+	const std::string longString( SCALAR_VARIABLE_MAX_STRING_LENGTH + 10, 'a' );
+	BOOST_REQUIRE( false == stringValues[1].set( longString ) );
+	BOOST_REQUIRE( std::string( stringValues[1].c_str() ) == longString.substr( 0, SCALAR_VARIABLE_MAX_STRING_LENGTH - 1 ) );
+
+	// Retrieve tables and arrays on the slave side.
+	SHMSlave slave( "test_shm_scalar_layout", &logger );
+	BOOST_REQUIRE( slave.isOperational() );
+
+	unsigned int n = 0;
+	const ScalarVariableMetadata* slaveRealMetadata = 0;
+	double* slaveRealValues = 0;
+	BOOST_REQUIRE( slave.retrieveScalars( "real_scalars", n, slaveRealMetadata, slaveRealValues ) );
+	BOOST_REQUIRE_EQUAL( n, nReals );
+
+	for ( unsigned int i = 0; i < nReals; ++i ) {
+		std::stringstream name;
+		name << "x" << i;
+		BOOST_REQUIRE( name.str() == slaveRealMetadata[i].name_ );
+		BOOST_REQUIRE( slaveRealMetadata[i].valueReference_ == 10 + i );
+		BOOST_REQUIRE( slaveRealMetadata[i].causality_ == ScalarVariableAttributes::output );
+		BOOST_REQUIRE( slaveRealValues[i] == 0.5*i );
+	}
+
+	// Values are stored contiguously, changes are visible on both sides.
+	slaveRealValues[nReals - 1] = 42.;
+	BOOST_REQUIRE( realValues[nReals - 1] == 42. );
+
+	const ScalarVariableMetadata* slaveStringMetadata = 0;
+	ScalarVariableString* slaveStringValues = 0;
+	BOOST_REQUIRE( slave.retrieveScalars( "string_scalars", n, slaveStringMetadata, slaveStringValues ) );
+	BOOST_REQUIRE_EQUAL( n, 2 );
+	BOOST_REQUIRE( std::string( "s" ) == slaveStringMetadata[0].name_ );
+	BOOST_REQUIRE( std::string( "hello" ) == slaveStringValues[0].c_str() );
+
+	// Scalars that have not been created (or with another value type) cannot be retrieved.
+	const ScalarVariableMetadata* slaveIntegerMetadata = 0;
+	int* slaveIntegerValues = 0;
+	BOOST_REQUIRE( false == slave.retrieveScalars( "integer_scalars", n, slaveIntegerMetadata, slaveIntegerValues ) );
+	BOOST_REQUIRE_EQUAL( n, 0 );
+
+	char* slaveBooleanValues = 0;
+	BOOST_REQUIRE( false == slave.retrieveScalars( "real_scalars", n, slaveIntegerMetadata, slaveBooleanValues ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_shm_segment_plan )
+{
+	DummyIPCLogger logger;
+
+	const std::string id( "test_shm_segment_plan" );
+	const unsigned int nReals = 1000;
+	const unsigned int nStrings = 5;
+
+	SHMSegmentPlan plan( id );
+	plan.addObject<double>( "time" );
+	plan.addObject<bool>( "flag" );
+	plan.addScalars<double>( "real_scalars", nReals );
+	plan.addScalars<int>( "integer_scalars", 0 );
+	plan.addScalars<ScalarVariableString>( "string_scalars", nStrings );
+	plan.addChangeLog( "real_scalars", nReals );
+	plan.addChangeLog( "integer_scalars", 0 );
+
+	BOOST_REQUIRE( plan.getPayloadSize() >= nReals*( sizeof( ScalarVariableMetadata ) + sizeof( double ) ) +
+		       nStrings*( sizeof( ScalarVariableMetadata ) + sizeof( ScalarVariableString ) ) );
+
+	const long unsigned int pageSize = boost::interprocess::mapped_region::get_page_size();
+	const long unsigned int segmentSize = plan.getSegmentSize();
+	BOOST_REQUIRE( 0 == segmentSize % pageSize );
+	BOOST_REQUIRE( segmentSize >= plan.getPayloadSize() );
+	BOOST_REQUIRE( 0 == plan.getSegmentSize( true ) % SHMSegmentPlan::getHugePageSize() );
+
+	// All planned objects fit into a segment of the planned size.
+	SHMMaster master( id, segmentSize, &logger );
+	BOOST_REQUIRE( master.isOperational() );
+
+	double* time = 0;
+	BOOST_REQUIRE( master.createVariable( "time", time, 0. ) );
+	bool* flag = 0;
+	BOOST_REQUIRE( master.createVariable( "flag", flag, false ) );
+
+	ScalarVariableMetadata* metadata = 0;
+	double* realValues = 0;
+	BOOST_REQUIRE( master.createScalars( "real_scalars", nReals, metadata, realValues ) );
+	int* integerValues = 0;
+	BOOST_REQUIRE( master.createScalars( "integer_scalars", 0, metadata, integerValues ) );
+	ScalarVariableString* stringValues = 0;
+	BOOST_REQUIRE( master.createScalars( "string_scalars", nStrings, metadata, stringValues ) );
+	unsigned int* log = 0;
+	BOOST_REQUIRE( master.createChangeLog( "real_scalars", nReals, log ) );
+	BOOST_REQUIRE( master.createChangeLog( "integer_scalars", 0, log ) );
+
+	// Apart from rounding to whole pages, no memory is wasted.
+	BOOST_REQUIRE( master.getFreeMemory() < pageSize );
+
+	// Locking the segment may fail due to resource limits, but must not break the segment.
+	master.lockMemory();
+	master.adviseHugePages();
+	BOOST_REQUIRE( master.isOperational() );
+	realValues[nReals - 1] = 1.;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_shm_segment_regions )
+{
+	DummyIPCLogger logger;
+
+	const std::string id( "test_shm_segment_regions" );
+	const unsigned int nRegions = 2;
+
+	SHMSegmentPlan plan( id, nRegions );
+	plan.addObject<int>( "value" );
+
+	// The master of region 0 creates the segment, the master of region 1 opens it.
+	SHMMaster master0( id, plan.getSegmentSize(), &logger, 0, nRegions );
+	SHMMaster master1( id, 0, &logger, 1, nRegions );
+	BOOST_REQUIRE( master0.isOperational() );
+	BOOST_REQUIRE( master1.isOperational() );
+	master0.setRemoveSegment( true );
+
+	// Objects with the same name exist once per region.
+	int* value0 = 0;
+	int* value1 = 0;
+	BOOST_REQUIRE( master0.createVariable( "value", value0, 10 ) );
+	BOOST_REQUIRE( master1.createVariable( "value", value1, 11 ) );
+	BOOST_REQUIRE( master0.getFreeMemory() < boost::interprocess::mapped_region::get_page_size() );
+
+	SHMSlave slave0( id, &logger, false, 0 );
+	SHMSlave slave1( id, &logger, false, 1 );
+	BOOST_REQUIRE( slave0.isOperational() );
+	BOOST_REQUIRE( slave1.isOperational() );
+
+	int* slaveValue = 0;
+	BOOST_REQUIRE( slave0.retrieveVariable( "value", slaveValue ) );
+	BOOST_REQUIRE_EQUAL( *slaveValue, 10 );
+	BOOST_REQUIRE( slave1.retrieveVariable( "value", slaveValue ) );
+	BOOST_REQUIRE_EQUAL( *slaveValue, 11 );
+
+	// A signal to any slave wakes up a slave serving several regions, the signal itself
+	// is only received in its region.
+	master1.signalToSlave();
+	slave0.waitForAnyMaster();
+	BOOST_REQUIRE( false == slave0.tryWaitForMaster() );
+	BOOST_REQUIRE( true == slave1.tryWaitForMaster() );
+	BOOST_REQUIRE( false == slave1.tryWaitForMaster() );
+
+	// Only the regions the segment has been created with exist.
+	SHMMaster master2( id, 0, &logger, 2, 3 );
+	BOOST_REQUIRE( false == master2.isOperational() );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_shm_change_log )
+{
+	DummyIPCLogger logger;
+
+	const std::string id( "test_shm_change_log" );
+	const unsigned int nReals = 10;
+
+	SHMMaster master( id, 65536, &logger );
+	BOOST_REQUIRE( master.isOperational() );
+
+	unsigned int* masterLog = 0;
+	BOOST_REQUIRE( master.createChangeLog( "real_scalars", nReals, masterLog ) );
+	ScalarVariableChangeLog masterChanges;
+	masterChanges.attach( nReals, masterLog );
+
+	SHMSlave slave( id, &logger );
+	BOOST_REQUIRE( slave.isOperational() );
+
+	unsigned int numObj = 0;
+	unsigned int* slaveLog = 0;
+	BOOST_REQUIRE( slave.retrieveChangeLog( "real_scalars", numObj, slaveLog ) );
+	BOOST_REQUIRE_EQUAL( numObj, nReals );
+	BOOST_REQUIRE( false == slave.retrieveChangeLog( "integer_scalars", numObj, slaveLog ) );
+	BOOST_REQUIRE( slave.retrieveChangeLog( "real_scalars", numObj, slaveLog ) );
+	ScalarVariableChangeLog slaveChanges;
+	slaveChanges.attach( numObj, slaveLog );
+
+	// Nothing has changed initially.
+	BOOST_REQUIRE_EQUAL( slaveChanges.getNumberOfChanges(), 0u );
+
+	// Each variable is recorded only once, in the order of the changes.
+	masterChanges.mark( 7 );
+	masterChanges.mark( 2 );
+	masterChanges.mark( 7 );
+	BOOST_REQUIRE_EQUAL( slaveChanges.getNumberOfChanges(), 2u );
+	BOOST_REQUIRE_EQUAL( slaveChanges.getChange( 0 ), 7u );
+	BOOST_REQUIRE_EQUAL( slaveChanges.getChange( 1 ), 2u );
+
+	// Variables can be marked again after the change log has been cleared.
+	slaveChanges.clear();
+	BOOST_REQUIRE_EQUAL( masterChanges.getNumberOfChanges(), 0u );
+	masterChanges.mark( 2 );
+	masterChanges.mark( nReals - 1 );
+	BOOST_REQUIRE_EQUAL( slaveChanges.getNumberOfChanges(), 2u );
+	BOOST_REQUIRE_EQUAL( slaveChanges.getChange( 0 ), 2u );
+	BOOST_REQUIRE_EQUAL( slaveChanges.getChange( 1 ), nReals - 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_slave_log_channel )
+{
+	DummyIPCLogger logger;
+
+	const std::string id( "test_slave_log_channel" );
+	const unsigned int nRecords = 2;
+
+	SHMMaster master( id, 65536, &logger );
+	BOOST_REQUIRE( master.isOperational() );
+
+	IPCLogRecord* masterRecords = 0;
+	unsigned int* masterCount = 0;
+	BOOST_REQUIRE( master.createLogChannel( "slave_log", nRecords, masterRecords, masterCount ) );
+	IPCLogChannel masterChannel;
+	masterChannel.attach( nRecords, masterRecords, masterCount );
+
+	SHMSlave slave( id, &logger );
+	BOOST_REQUIRE( slave.isOperational() );
+
+	unsigned int numRecords = 0;
+	IPCLogRecord* slaveRecords = 0;
+	unsigned int* slaveCount = 0;
+	BOOST_REQUIRE( slave.retrieveLogChannel( "slave_log", numRecords, slaveRecords, slaveCount ) );
+	BOOST_REQUIRE_EQUAL( numRecords, nRecords );
+	IPCLogChannel slaveChannel;
+	slaveChannel.attach( numRecords, slaveRecords, slaveCount );
+
+	boost::filesystem::path logFile = boost::filesystem::temp_directory_path() /
+		boost::filesystem::unique_path( "test_slave_log_channel-%%%%-%%%%.log" );
+
+	{
+		IPCSlaveLogger slaveLogger( logFile.string() );
+
+		// Messages logged before attaching the channel are only written to file.
+		slaveLogger.logger( fmiWarning, "WARNING", "not forwarded" );
+		slaveLogger.attachChannel( slaveChannel );
+
+		slaveLogger.logger( fmiOK, "DEBUG", "first" );
+		slaveLogger.logger( fmiError, "ERROR", std::string( 2*IPC_LOG_MAX_MESSAGE_LENGTH, 'x' ) );
+		slaveLogger.logger( fmiWarning, "WARNING", "third" );
+		BOOST_REQUIRE_EQUAL( masterChannel.getNumberOfRecords(), 0u );
+
+		// Records that do not fit into the channel are kept for the next synchronization.
+		slaveLogger.forwardRecords();
+		BOOST_REQUIRE_EQUAL( masterChannel.getNumberOfRecords(), 2u );
+		BOOST_REQUIRE_EQUAL( masterChannel.getRecord( 0 ).status_, fmiOK );
+		BOOST_REQUIRE_EQUAL( std::string( masterChannel.getRecord( 0 ).message_ ), "first" );
+		BOOST_REQUIRE_EQUAL( masterChannel.getRecord( 1 ).status_, fmiError );
+		BOOST_REQUIRE_EQUAL( std::string( masterChannel.getRecord( 1 ).message_ ).size(), IPC_LOG_MAX_MESSAGE_LENGTH - 1 );
+
+		masterChannel.clear();
+		slaveLogger.forwardRecords();
+		BOOST_REQUIRE_EQUAL( masterChannel.getNumberOfRecords(), 1u );
+		BOOST_REQUIRE_EQUAL( std::string( masterChannel.getRecord( 0 ).category_ ), "WARNING" );
+		BOOST_REQUIRE_EQUAL( std::string( masterChannel.getRecord( 0 ).message_ ), "third" );
+
+		// All messages are written to file by the background thread.
+		slaveLogger.flush();
+		BOOST_REQUIRE_EQUAL( slaveLogger.getNumberOfDroppedRecords(), 0u );
+	}
+
+	std::ifstream in( logFile.string().c_str() );
+	std::string line;
+	unsigned int nLines = 0;
+	while ( std::getline( in, line ) ) ++nLines;
+	in.close();
+	BOOST_REQUIRE_EQUAL( nLines, 4u );
+
+	boost::filesystem::remove( logFile );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_socket_loopback )
+{
+	DummyIPCLogger logger;
+
+	std::vector<std::string> addresses;
+	addresses.push_back( "tcp://127.0.0.1:0" );
+#ifndef WIN32
+	boost::filesystem::path socketPath = boost::filesystem::temp_directory_path() /
+		boost::filesystem::unique_path( "test_socket_loopback-%%%%-%%%%.sock" );
+	addresses.push_back( "unix://" + socketPath.string() );
+#endif
+
+	const unsigned int nReals = 100;
+	const std::size_t headerSize = 3*sizeof( boost::uint32_t );
+
+	for ( std::size_t i = 0; i < addresses.size(); ++i )
+	{
+		SocketMaster master( addresses[i], &logger );
+		BOOST_REQUIRE( master.isOperational() );
+
+		double* time = 0;
+		BOOST_REQUIRE( master.createVariable( "time", time, 1.5 ) );
+
+		ScalarVariableMetadata* metadata = 0;
+		double* realValues = 0;
+		BOOST_REQUIRE( master.createScalars( "real_scalars", nReals, metadata, realValues ) );
+		for ( unsigned int j = 0; j < nReals; ++j ) {
+			metadata[j].valueReference_ = j;
+			realValues[j] = 0.5*j;
+		}
+
+		// Messages are small enough to be buffered, hence master and slave can take turns in one thread.
+		SocketSlave slave( master.getAddress(), &logger );
+		BOOST_REQUIRE( slave.isOperational() );
+
+		master.waitForSlave(); // Accept connection.
+		master.signalToSlave(); // Announce all objects.
+		slave.waitForMaster();
+
+		double* slaveTime = 0;
+		BOOST_REQUIRE( slave.retrieveVariable( "time", slaveTime ) );
+		BOOST_REQUIRE( *slaveTime == 1.5 );
+
+		int* wrongType = 0;
+		BOOST_REQUIRE( false == slave.retrieveVariable( "time", wrongType ) );
+
+		unsigned int n = 0;
+		const ScalarVariableMetadata* slaveMetadata = 0;
+		double* slaveRealValues = 0;
+		BOOST_REQUIRE( slave.retrieveScalars( "real_scalars", n, slaveMetadata, slaveRealValues ) );
+		BOOST_REQUIRE_EQUAL( n, nReals );
+		BOOST_REQUIRE( slaveMetadata[nReals - 1].valueReference_ == nReals - 1 );
+		BOOST_REQUIRE( slaveRealValues[nReals - 1] == 0.5*( nReals - 1 ) );
+
+		// Changes of the slave are sent back to the master.
+		slaveRealValues[5] = -1.;
+		slave.signalToMaster();
+		master.waitForSlave();
+		BOOST_REQUIRE( realValues[5] == -1. );
+
+		// Values received from the other side are not sent back.
+		master.signalToSlave();
+		BOOST_REQUIRE_EQUAL( master.getLastMessageSize(), headerSize );
+		slave.waitForMaster();
+		slave.signalToMaster();
+		master.waitForSlave();
+
+		// Only changed elements are sent.
+		*time = 2.5;
+		realValues[10] = 3.;
+		realValues[11] = 4.;
+		master.signalToSlave();
+		BOOST_REQUIRE_EQUAL( master.getLastMessageSize(),
+				     headerSize + 2*( 3*sizeof( boost::uint32_t ) ) + 3*sizeof( double ) );
+		slave.waitForMaster();
+		BOOST_REQUIRE( *slaveTime == 2.5 );
+		BOOST_REQUIRE( slaveRealValues[10] == 3. );
+		BOOST_REQUIRE( slaveRealValues[11] == 4. );
+		BOOST_REQUIRE( slaveRealValues[5] == -1. );
+
+		// After re-initialization, the master listens at the same endpoint as before.
+		const std::string boundAddress = master.getAddress();
+		master.reinitialize();
+		BOOST_REQUIRE( master.isOperational() );
+		BOOST_REQUIRE_EQUAL( master.getAddress(), boundAddress );
+	}
+
+#ifndef WIN32
+	// The socket file is removed by the master.
+	BOOST_REQUIRE( false == boost::filesystem::exists( socketPath ) );
+#endif
+}
@@ -295,6 +295,39 @@ BOOST_AUTO_TEST_CASE( test_fmu_simulate_zigzag2 )
 }
 
 
+BOOST_AUTO_TEST_CASE( test_fmu_event_indicator_crossings )
+{
+	std::string MODELNAME( "zigzag2" );
+	FMUModelExchange fmu( FMU_URI_PRE + MODELNAME, MODELNAME, fmiTrue, fmiFalse, EPS_TIME );
+	fmiStatus status = fmu.instantiate( "zigzag21" );
+	BOOST_REQUIRE_EQUAL( status, fmiOK );
+
+	status = fmu.setValue( "k", 2.0 );
+	BOOST_REQUIRE( status == fmiOK );
+
+	status = fmu.initialize();
+	BOOST_REQUIRE( status == fmiOK );
+
+	std::vector<std::size_t> indices;
+	std::vector<int> directions;
+
+	// no state event has been detected yet
+	BOOST_REQUIRE_EQUAL( fmu.getEventIndicatorCrossings( indices, directions ), 0 );
+
+	// x reaches 1 at t = 0.5, the event indicator changes from negative to positive
+	fmu.integrate( 0.75 );
+	BOOST_REQUIRE_EQUAL( fmu.getEventIndicatorCrossings( indices, directions ), 1 );
+	BOOST_REQUIRE_EQUAL( indices[0], 0 );
+	BOOST_REQUIRE_EQUAL( directions[0], 1 );
+
+	// x reaches -1 at t = 1.5, the event indicator changes from positive to negative
+	fmu.integrate( 1.75 );
+	BOOST_REQUIRE_EQUAL( fmu.getEventIndicatorCrossings( indices, directions ), 1 );
+	BOOST_REQUIRE_EQUAL( indices[0], 0 );
+	BOOST_REQUIRE_EQUAL( directions[0], -1 );
+}
+
+
 BOOST_AUTO_TEST_CASE( test_fmu_log_buffer )
 {
 	// Retrieve the global instance of the log buffer.
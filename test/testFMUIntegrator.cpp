@@ -4,6 +4,7 @@
 // --------------------------------------------------------------
 
 #include <import/base/include/FMUModelExchange_v1.h>
+#include <import/integrators/include/DenseLU.h>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE testFMUIntegrator
@@ -89,6 +90,49 @@ BOOST_AUTO_TEST_CASE( test_asymptotic_sine ){
 	std::cout << "\n";
 }
 
+BOOST_AUTO_TEST_CASE( test_asymptotic_sine_in_slices ){
+	/*
+	 * integrate in many short slices ( like masters do ) with a small initial step size. The
+	 * steppers continue with their step size and history from one call of integrate to the next
+	 */
+	std::cout << "integrating asymptotic_sine from t = 0 to t = 1 in slices of 0.001.\n\n";
+
+	cout <<	format("%-20s %-20s %-20s %-20s\n")
+		% "Integrator" % "error" % "" % "CPU Time(clock ticks)";
+
+	string MODELNAME( "asymptotic_sine" );
+	fmiReal tstop = 1.0;
+	for ( int i = 0; i < IntegratorType::NSTEPPERS; i++ ){
+		IntegratorType type = (IntegratorType) i;
+		if ( type == IntegratorType::eu || type == IntegratorType::rk ||
+		     type == IntegratorType::lie || type == IntegratorType::abm )
+			continue; // only steppers with controlled step size
+
+		FMUModelExchange fmu( FMU_URI_PRE + fmuPath + MODELNAME, MODELNAME,
+				      fmiFalse, fmiFalse, EPS_TIME, type );
+		string integratorName = fmu.getIntegratorProperties().name;
+		fmu.instantiate( "asymptotic_euler1" );
+		fmu.initialize();
+		fmu.setValue( "lambda", 1.0e2 );
+
+		double time = clock();
+		for ( int k = 1; k <= 1000; k++ )
+			fmu.integrate( k*tstop/1000, 1.0e-6 );
+		time = clock() - time;
+
+		fmiReal x,y;
+		fmu.getValue( "x", x );
+		fmu.getValue( "y", y );
+		fmiReal error = fmax( fabs( x - sin( tstop ) ) , fabs( y - cos( tstop ) ) );
+
+		cout << format("%-20s %-20E %-20s %-20E\n")
+			% integratorName % error % "" % time;
+		BOOST_CHECK( error < 1.0e-4 );
+	}
+
+	std::cout << "\n";
+}
+
 int estimateOrder( IntegratorType integratorType, int nSteps = 1 )
 {
 	/*
@@ -344,3 +388,148 @@ BOOST_AUTO_TEST_CASE( test_linear_stiff_system )
 			simulate_linear_stiff( (IntegratorType)i, tol );
 	}
 }
+
+
+BOOST_AUTO_TEST_CASE( test_dense_lu )
+{
+	// use a dimension bigger than the panel size of the blocked factorization
+	const std::size_t n = 100;
+	DenseLU lu( n );
+
+	// diagonally dominant matrix with a zero on the diagonal (requires pivoting)
+	srand( 42 );
+	std::vector<fmiReal> a( n*n );
+	for ( std::size_t i = 0; i < n; i++ )
+		for ( std::size_t j = 0; j < n; j++ )
+			a[n*i + j] = ( i == j ) ? ( i == 0 ? 0.0 : n ) : ( rand()/( RAND_MAX + 1.0 ) - 0.5 );
+
+	std::copy( a.begin(), a.end(), lu.data() );
+	BOOST_REQUIRE( lu.factorize() );
+
+	// the factorization can be used for several right-hand sides
+	for ( int run = 0; run < 2; run++ ){
+		std::vector<fmiReal> x( n ), b( n );
+		for ( std::size_t i = 0; i < n; i++ ) x[i] = 1.0 + i*( run + 1 );
+		for ( std::size_t i = 0; i < n; i++ ){
+			b[i] = 0.0;
+			for ( std::size_t j = 0; j < n; j++ ) b[i] += a[n*i + j]*x[j];
+		}
+
+		lu.solve( &b[0] );
+		for ( std::size_t i = 0; i < n; i++ )
+			BOOST_CHECK_SMALL( b[i] - x[i], 1.0e-9*x[i] );
+	}
+
+	// singular matrices are detected
+	std::fill( lu.data(), lu.data() + n*n, 1.0 );
+	BOOST_CHECK( !lu.factorize() );
+}
+
+
+// analytical solution of the model zigzag: x moves with slope +/-k between -1 and 1, starting at 0
+fmiReal zigzag( fmiReal t, fmiReal k )
+{
+	fmiReal phase = fmod( k*t + 1.0, 4.0 );
+	return ( phase < 2.0 ) ? phase - 1.0 : 3.0 - phase;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_qss_events )
+{
+	// the quantized state steppers have to locate the state events of a model with a
+	// discontinuous right-hand side, the events happen whenever x reaches -1 or 1
+	const fmiReal k = 10.0;
+	const fmiTime tstop = 1.0;
+	const fmiTime stepsize = 0.025;
+	const fmiReal eventSearchPrecision = 1.0e-8;
+	const fmiTime eventTimes[] = { 0.1, 0.3, 0.5, 0.7, 0.9 };
+	const unsigned int nEvents = sizeof( eventTimes )/sizeof( eventTimes[0] );
+
+	IntegratorType types[] = { IntegratorType::qss, IntegratorType::liqss };
+
+	for ( int i = 0; i < 2; i++ ){
+		string MODELNAME( "zigzag" );
+		FMUModelExchange fmu( FMU_URI_PRE + MODELNAME, MODELNAME,
+				      fmiFalse, fmiFalse, eventSearchPrecision, types[i] );
+		string integratorName = fmu.getIntegratorProperties().name;
+		fmu.instantiate( "zigzag1" );
+		fmu.setValue( "k", k );
+		fmu.initialize();
+
+		fmiTime t = 0;
+		fmiReal x;
+		unsigned int iEvent = 0;
+
+		while ( t < tstop ){
+			t = fmu.integrate( fmin( t + stepsize, tstop ) );
+			fmu.getValue( "x", x );
+
+			if ( fmu.getEventFlag() ){
+				BOOST_REQUIRE_MESSAGE( iEvent < nEvents,
+						       integratorName << ": unexpected event at t = " << t );
+				BOOST_CHECK_MESSAGE( fabs( t - eventTimes[iEvent] ) < 1.0e-6,
+						     integratorName << ": event at t = " << t << ", expected at t = "
+						     << eventTimes[iEvent] );
+				BOOST_CHECK_MESSAGE( fabs( fabs( x ) - 1.0 ) < 1.0e-6,
+						     integratorName << ": x = " << x << " at the event at t = " << t );
+				iEvent++;
+				fmu.setEventFlag( fmiFalse );
+			} else {
+				// the trajectories are piecewise linear, QSS2 follows them exactly
+				BOOST_CHECK_MESSAGE( fabs( x - zigzag( t, k ) ) < 1.0e-6,
+						     integratorName << ": x = " << x << " at t = " << t
+						     << ", expected " << zigzag( t, k ) );
+			}
+		}
+
+		BOOST_CHECK_MESSAGE( iEvent == nEvents, integratorName << ": " << iEvent << " events instead of " << nEvents );
+		BOOST_CHECK( fabs( t - tstop ) < eventSearchPrecision );
+		fmu.getValue( "x", x );
+		BOOST_CHECK( fabs( x - zigzag( tstop, k ) ) < 1.0e-6 );
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( test_liqss_stiff )
+{
+	// the diagonal of the Jacobian of asymptotic_sine is -lambda. After the initial transient
+	// ( which decays with exp( -lambda*t ) ), the solution follows F(t) = ( sin(t), cos(t) ).
+	// The quantized states of the explicit QSS2 oscillate around this solution, while LIQSS2
+	// has to follow it with fewer requantizations
+	const fmiReal lambda = 1.0e4;
+	const fmiTime ttransient = 0.01;
+	const fmiTime tstop = 1.0;
+	const fmiTime stepsize = 0.01;
+	const fmiReal tolerance = 1.0e-3;
+
+	IntegratorType types[] = { IntegratorType::qss, IntegratorType::liqss };
+	unsigned long nSteps[2];
+
+	for ( int i = 0; i < 2; i++ ){
+		string MODELNAME( "asymptotic_sine" );
+		FMUModelExchange fmu( FMU_URI_PRE + fmuPath + MODELNAME, MODELNAME,
+				      fmiFalse, fmiFalse, EPS_TIME, types[i] );
+		string integratorName = fmu.getIntegratorProperties().name;
+		fmu.instantiate( "asymptotic_sine1" );
+		fmu.initialize();
+		fmu.setValue( "lambda", lambda );
+
+		fmiReal x, y, error, maxError = 0;
+		fmiTime t = fmu.integrate( ttransient );
+		while ( t < tstop ){
+			t = fmu.integrate( fmin( t + stepsize, tstop ) );
+			fmu.getValue( "x", x );
+			fmu.getValue( "y", y );
+			error = fmax( fabs( x - sin( t ) ), fabs( y - cos( t ) ) );
+			maxError = fmax( maxError, error );
+		}
+
+		nSteps[i] = fmu.getIntegratorStatistics().nAcceptedSteps;
+
+		cout << format( "%-20s %-20E %-20d\n" ) % integratorName % maxError % nSteps[i];
+		BOOST_CHECK_MESSAGE( maxError < tolerance, integratorName << ": maximum error " << maxError );
+	}
+
+	BOOST_CHECK_MESSAGE( nSteps[1] < nSteps[0],
+			     "LIQSS2 needs " << nSteps[1] << " requantizations, QSS2 " << nSteps[0] );
+}
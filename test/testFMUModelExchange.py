@@ -453,6 +453,52 @@ class testFMUModelExchange(unittest.TestCase):
     self.assertEqual( fmu.getLastStatus(), fmippim.fmiOK )
     self.assertTrue( abs( x - 0.0 ) < 1e-6 );
 
+  def test_fmi_2_0_array_buffers(self):
+    import array
+    fmu = fmippim.FMUModelExchangeV2( FMU_URI_PRE + "zigzag2", "zigzag2", False, False, EPS_TIME )
+    status = fmu.instantiate( "zigzag1" )
+    self.assertEqual( status, fmippim.fmiOK )
+    status = fmu.initialize()
+    self.assertEqual( status, fmippim.fmiOK )
+
+    # objects supporting the buffer protocol (e.g., NumPy arrays) are used without copying
+    refs = array.array( 'I', [ fmu.getValueRef( "x" ), fmu.getValueRef( "k" ) ] )
+    vals = array.array( 'd', [ 0.5, 2.0 ] )
+    status = fmu.setValue( refs, vals, 2 )
+    self.assertEqual( status, fmippim.fmiOK )
+
+    vals = array.array( 'd', [ 0.0, 0.0 ] )
+    status = fmu.getValue( refs, vals, 2 )
+    self.assertEqual( status, fmippim.fmiOK )
+    self.assertEqual( vals.tolist(), [ 0.5, 2.0 ] )
+
+    states = array.array( 'd', [ 0.0 ] * fmu.nStates() )
+    status = fmu.getContinuousStates( states )
+    self.assertEqual( status, fmippim.fmiOK )
+    self.assertEqual( states[0], 0.5 )
+
+    # the item type has to match
+    self.assertRaises( TypeError, fmu.getContinuousStates, array.array( 'f', [ 0.0 ] ) )
+
+  def test_fmi_2_0_integrate_in_threads(self):
+    import threading
+
+    # integrate() releases the GIL, every thread simulates its own FMU
+    results = {}
+    def simulate( k ):
+      fmu = fmippim.FMUModelExchangeV2( FMU_URI_PRE + "zigzag2", "zigzag2", False, False, EPS_TIME )
+      fmu.instantiate( "zigzag%d" % k )
+      fmu.setRealValue( "k", float( k ) )
+      fmu.initialize()
+      fmu.integrate( 0.2 )
+      results[k] = fmu.getRealValue( "x" )
+
+    threads = [ threading.Thread( target = simulate, args = ( k, ) ) for k in range( 1, 5 ) ]
+    for thread in threads: thread.start()
+    for thread in threads: thread.join()
+
+    for k in range( 1, 5 ):
+      self.assertTrue( abs( results[k] - 0.2*k ) < 1e-6 )
 
 
 if __name__ == '__main__':
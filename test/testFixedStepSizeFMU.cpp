@@ -120,3 +120,151 @@ BOOST_AUTO_TEST_CASE( test_fmu_run_simulation )
 				       "result mismatch: deltaResult = " << ( result[0] - reference ) );
 	}
 }
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_async )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	// Same FMU as "sine_standalone", but its doStep(...) returns fmiPending and finishes the steps
+	// asynchronously. No callback function stepFinished(...) is set, hence the steps are waited for.
+	std::string modelName( "sine_standalone" );
+	FixedStepSizeFMU fmu( std::string( FMU_URI_PRE ) + modelName + "_async", modelName );
+
+	std::string initRealInputNames[1] = { "omega" };
+	double initRealInputVals[1] = { 0.1 * M_PI };
+
+	const double startTime = 0.0;
+	const double stepSize = 1.0; // NB: fixed step size enforced by FMU!
+
+	std::string realOutputNames[1] = { "x" };
+
+	fmu.defineRealOutputs( realOutputNames, 1 );
+
+	int status = fmu.init( "test_sine", initRealInputNames, initRealInputVals, 1, startTime, stepSize );
+	BOOST_REQUIRE_MESSAGE( 1 == status, "init(...) FAILED" );
+
+	const double stopTime = 5.0;
+	const double deltaTime = 0.2;
+	double time = startTime;
+	double* result;
+	double reference;
+	while ( time <= stopTime )
+	{
+		fmu.sync( time, time + deltaTime );
+		time += deltaTime;
+
+		result = fmu.getRealOutputs();
+		reference = std::sin( 0.1 * M_PI * stepSize * std::floor( time/stepSize ) );
+
+		BOOST_REQUIRE_MESSAGE( std::fabs( result[0] - reference ) < 1e-8,
+				       "result mismatch: deltaResult = " << ( result[0] - reference ) );
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_adaptive )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	std::string modelName( "sine_standalone" );
+	FixedStepSizeFMU fmu( std::string( FMU_URI_PRE ) + modelName, modelName );
+
+	std::string initRealInputNames[1] = { "omega" };
+	double initRealInputVals[1] = { 0.1 * M_PI };
+
+	const double startTime = 0.0;
+	const double stepSize = 1.0; // NB: fixed step size enforced by FMU!
+
+	std::string realOutputNames[1] = { "x" };
+
+	fmu.defineRealOutputs( realOutputNames, 1 );
+
+	// The FMU enforces a fixed step size, hence the step size control must stay within [1,1].
+	fmu.enableAdaptiveStepSize( 1e-3, stepSize, stepSize );
+
+	int status = fmu.init( "test_sine", initRealInputNames, initRealInputVals, 1, startTime, 0.5 );
+	BOOST_REQUIRE_MESSAGE( 1 == status, "init(...) FAILED" );
+	BOOST_REQUIRE( fmu.getCommunicationStepSize() == stepSize );
+
+	const double stopTime = 5.0;
+	const double deltaTime = 0.2;
+	double time = startTime;
+	double* result;
+	double reference;
+	while ( time <= stopTime )
+	{
+		fmu.sync( time, time + deltaTime );
+		time += deltaTime;
+
+		BOOST_REQUIRE( fmu.getCommunicationStepSize() == stepSize );
+
+		result = fmu.getRealOutputs();
+		reference = std::sin( 0.1 * M_PI * stepSize * std::floor( time/stepSize ) );
+
+		BOOST_REQUIRE_MESSAGE( std::fabs( result[0] - reference ) < 1e-8,
+				       "result mismatch: deltaResult = " << ( result[0] - reference ) );
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_adaptive_variable )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	// Same FMU as "sine_standalone", but using the communication step size of the master.
+	std::string modelName( "sine_standalone" );
+	FixedStepSizeFMU fmu( std::string( FMU_URI_PRE ) + modelName + "_variable", modelName );
+
+	std::string initRealInputNames[1] = { "omega" };
+	double initRealInputVals[1] = { 0. }; // The output stays constant until omega is changed.
+
+	std::string realInputNames[1] = { "omega" };
+	std::string realOutputNames[1] = { "x" };
+
+	fmu.defineRealInputs( realInputNames, 1 );
+	fmu.defineRealOutputs( realOutputNames, 1 );
+
+	const double minStepSize = 0.01;
+	const double maxStepSize = 1.;
+	const double initialStepSize = 0.1;
+	fmu.enableAdaptiveStepSize( 1e-3, minStepSize, maxStepSize );
+
+	int status = fmu.init( "test_sine", initRealInputNames, initRealInputVals, 1, 0., initialStepSize );
+	BOOST_REQUIRE_MESSAGE( 1 == status, "init(...) FAILED" );
+	BOOST_REQUIRE( fmu.getCommunicationStepSize() == initialStepSize );
+
+	const double deltaTime = 0.01;
+	double time = 0.;
+
+	// Quiet period: the step size grows up to the maximum.
+	while ( time < 5. ) {
+		fmu.sync( time, time + deltaTime );
+		time += deltaTime;
+	}
+	BOOST_CHECK_EQUAL( fmu.getCommunicationStepSize(), maxStepSize );
+	BOOST_CHECK_SMALL( fmu.getRealOutputs()[0], 1e-12 );
+
+	// Transient: the output starts to oscillate, the step size shrinks.
+	double omega = 3.;
+	fmu.sync( time, time + deltaTime, &omega, 0, 0, 0 );
+	time += deltaTime;
+
+	double minObserved = fmu.getCommunicationStepSize();
+	while ( time < 8. ) {
+		fmu.sync( time, time + deltaTime );
+		time += deltaTime;
+		minObserved = std::min( minObserved, fmu.getCommunicationStepSize() );
+	}
+	BOOST_CHECK_LT( minObserved, 0.2*maxStepSize );
+	BOOST_CHECK_GE( minObserved, minStepSize );
+}
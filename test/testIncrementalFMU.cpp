@@ -14,6 +14,7 @@
 #include <cmath>
 #include <iostream>
 #include <algorithm>
+#include <vector>
 
 
 BOOST_AUTO_TEST_CASE( test_fmu_load )
@@ -533,3 +534,62 @@ BOOST_AUTO_TEST_CASE( test_fmu_check_sync_times_2 )
 	for ( int i = 0; i < 15; ++i )
 		BOOST_CHECK_CLOSE( sync_times[i], expected_sync_times[i], 1e-7 );
 }
+
+
+namespace {
+
+	// Run zigzag with sync intervals smaller than the look-ahead step size, such that the
+	// state has to be interpolated between predictions. Store the outputs after each sync.
+	void runZigzag( fmiBoolean lazy, std::vector<double>& x, std::vector<double>& derx )
+	{
+		std::string MODELNAME( "zigzag" );
+		IncrementalFMU fmu( FMU_URI_PRE + MODELNAME, MODELNAME, fmiFalse, EPS_TIME );
+		fmu.setLazyOutputRetrieval( lazy );
+		BOOST_REQUIRE( fmu.getLazyOutputRetrieval() == lazy );
+
+		std::string vars[2] = { "k", "x" };
+		double vals[2] = { 1.0, 0.0 };
+		const double starttime = 0.0;
+		const double stepsize = 0.01;
+
+		const double horizon = 2 * stepsize;
+		const double intstepsize = stepsize/2;
+
+		std::string outputs[2] = { "x", "der(x)" };
+
+		fmu.defineRealOutputs( outputs, 2 );
+
+		int status = fmu.init( "zigzag1", vars, vals, 2, starttime, horizon, stepsize, intstepsize );
+		BOOST_REQUIRE_EQUAL( status, 1 );
+
+		double time = starttime;
+		double next = fmu.sync( -42.0, time );
+
+		while ( time + 0.25*stepsize - 1.5 < EPS_TIME ) {
+			double t1 = std::min( time + 0.25*stepsize, next );
+			next = fmu.sync( time, t1 );
+			time = t1;
+			x.push_back( fmu.getRealOutputs()[0] );
+			derx.push_back( fmu.getRealOutputs()[1] );
+		}
+	}
+
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_lazy_outputs )
+{
+	std::vector<double> x, derx, xLazy, derxLazy;
+
+	runZigzag( fmiFalse, x, derx );
+	runZigzag( fmiTrue, xLazy, derxLazy );
+
+	BOOST_REQUIRE_EQUAL( x.size(), xLazy.size() );
+
+	for ( std::size_t i = 0; i < x.size(); ++i ) {
+		BOOST_REQUIRE_SMALL( x[i] - xLazy[i], 1e-9 );
+
+		// With lazy retrieval, der(x) is computed from the (interpolated) state by the FMU.
+		BOOST_REQUIRE_EQUAL( std::abs( derxLazy[i] ), 1.0 );
+	}
+}
@@ -69,6 +69,97 @@ class testIncrementalFMU(unittest.TestCase):
     self.assertEqual( fmippim.double_array_getitem( result, 1 ), 10.0 ) # check value
 
 
+  def test_fmi_1_0_getrealoutputs_view(self):
+    import array
+
+    model_name = 'zigzag'
+    fmu = fmippim.IncrementalFMU( FMU_URI_PRE + model_name, model_name, False, EPS_TIME )
+
+    # construct string array for init parameter names
+    vars = fmippim.new_string_array( 2 )
+    fmippim.string_array_setitem( vars, 0, 'k' )
+    fmippim.string_array_setitem( vars, 1, 'x' )
+
+    # init parameter values, passed without copying
+    vals = array.array( 'd', [ 10.0, 1.0 ] )
+
+    # construct string array with output names
+    outputs = fmippim.new_string_array( 2 )
+    fmippim.string_array_setitem( outputs, 0, 'x' )
+    fmippim.string_array_setitem( outputs, 1, 'der(x)' )
+
+    start_time = 0.0
+    step_size = 0.0025
+    horizon = 2*step_size
+    int_step_size = step_size/2
+
+    fmu.defineRealOutputs( outputs, 2 )
+
+    status = fmu.init( 'zigzag1', vars, vals, 2, start_time, horizon, step_size, int_step_size ) # initialize model
+    self.assertEqual( status, 1 ) # check status
+
+    # the view refers to the current outputs (e.g., use numpy.asarray( view ) for a NumPy array)
+    view = fmu.getRealOutputsView()
+    self.assertEqual( len( view ), 2 )
+    self.assertEqual( view[0], 0.0 ) # check value
+    self.assertEqual( view[1], 10.0 ) # check value
+
+    fmu.sync( start_time, start_time + step_size )
+    self.assertTrue( view[0] > 0.0 ) # updated in place
+
+
+  def test_fmi_1_0_getrealoutputs_view_lifetime(self):
+    import array
+    import gc
+    import weakref
+
+    model_name = 'zigzag'
+    fmu = fmippim.IncrementalFMU( FMU_URI_PRE + model_name, model_name, False, EPS_TIME )
+
+    # construct string array for init parameter names
+    vars = fmippim.new_string_array( 2 )
+    fmippim.string_array_setitem( vars, 0, 'k' )
+    fmippim.string_array_setitem( vars, 1, 'x' )
+
+    vals = array.array( 'd', [ 10.0, 1.0 ] )
+
+    # construct string array with output names
+    outputs = fmippim.new_string_array( 2 )
+    fmippim.string_array_setitem( outputs, 0, 'x' )
+    fmippim.string_array_setitem( outputs, 1, 'der(x)' )
+
+    start_time = 0.0
+    step_size = 0.0025
+    horizon = 2*step_size
+    int_step_size = step_size/2
+
+    fmu.defineRealOutputs( outputs, 2 )
+
+    status = fmu.init( 'zigzag1', vars, vals, 2, start_time, horizon, step_size, int_step_size ) # initialize model
+    self.assertEqual( status, 1 ) # check status
+
+    fmu.sync( start_time, start_time + step_size )
+
+    view = fmu.getRealOutputsView()
+    self.assertEqual( view.format, 'd' )
+    self.assertEqual( view.shape, ( 2, ) )
+    expected = view.tolist()
+    self.assertTrue( expected[0] > 0.0 )
+    self.assertEqual( expected[1], 10.0 )
+
+    # the view keeps the FMU alive, its memory stays valid
+    fmu_ref = weakref.ref( fmu )
+    del fmu
+    gc.collect()
+    self.assertTrue( fmu_ref() is not None )
+    self.assertEqual( view.tolist(), expected )
+
+    # the FMU is freed together with the last view
+    del view
+    gc.collect()
+    self.assertTrue( fmu_ref() is None )
+
+
   def test_fmi_1_0_run_simulation_1(self):
     import math
 
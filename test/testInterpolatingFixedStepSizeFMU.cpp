@@ -123,3 +123,112 @@ BOOST_AUTO_TEST_CASE( test_fmu_run_simulation )
 				       "result mismatch: deltaResult = " << ( result[0] - reference ) );
 	}
 }
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_zero_order_hold )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	std::string modelName( "sine_standalone" );
+	InterpolatingFixedStepSizeFMU fmu( std::string( FMU_URI_PRE ) + modelName, modelName );
+
+	fmu.setInterpolationMethod( InterpolatingFixedStepSizeFMU::zeroOrderHold );
+	BOOST_REQUIRE( fmu.getInterpolationMethod() == InterpolatingFixedStepSizeFMU::zeroOrderHold );
+
+	std::string initRealInputNames[1] = { "omega" };
+	double initRealInputVals[1] = { 0.1 * M_PI };
+
+	const double startTime = 0.0;
+	const double stepSize = 1.0; // NB: fixed step size enforced by FMU!
+
+	std::string realOutputNames[1] = { "x" };
+
+	fmu.defineRealOutputs( realOutputNames, 1 );
+
+	int status = fmu.init( "test_sine", initRealInputNames, initRealInputVals, 1, startTime, stepSize );
+	BOOST_REQUIRE_MESSAGE( 1 == status, "init(...) FAILED" );
+
+	const double stopTime = 5.0;
+	const double deltaTime = 0.2;
+	double time = startTime;
+	while ( time <= stopTime )
+	{
+		fmu.sync( time, time + deltaTime );
+		time += deltaTime;
+
+		double* result = fmu.getRealOutputs();
+
+		double t0 = stepSize * std::floor( time/stepSize );
+		double reference = std::sin( 0.1 * M_PI * t0 );
+
+		BOOST_REQUIRE_MESSAGE( std::fabs( result[0] - reference ) < 1e-8,
+				       "result mismatch: deltaResult = " << ( result[0] - reference ) );
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_cubic )
+{
+#ifndef WIN32
+	// Avoid that BOOST treats SIGCHLD signal as error.
+	BOOST_REQUIRE( signal( SIGCHLD, dummy_signal_handler ) != SIG_ERR );
+#endif
+
+	std::string modelName( "sine_standalone" );
+	InterpolatingFixedStepSizeFMU fmu( std::string( FMU_URI_PRE ) + modelName, modelName );
+
+	fmu.setInterpolationMethod( InterpolatingFixedStepSizeFMU::cubic );
+
+	std::string initRealInputNames[1] = { "omega" };
+	double initRealInputVals[1] = { 0.1 * M_PI };
+
+	const double startTime = 0.0;
+	const double stepSize = 1.0; // NB: fixed step size enforced by FMU!
+
+	std::string realOutputNames[1] = { "x" };
+
+	fmu.defineRealOutputs( realOutputNames, 1 );
+
+	int status = fmu.init( "test_sine", initRealInputNames, initRealInputVals, 1, startTime, stepSize );
+	BOOST_REQUIRE_MESSAGE( 1 == status, "init(...) FAILED" );
+
+	const double stopTime = 5.0;
+	const double deltaTime = 0.2;
+	double time = startTime;
+	while ( time <= stopTime )
+	{
+		fmu.sync( time, time + deltaTime );
+		time += deltaTime;
+
+		double* result = fmu.getRealOutputs();
+
+		double t0 = stepSize * std::floor( time/stepSize );
+		double t1 = t0 + stepSize;
+		double x0 = std::sin( 0.1 * M_PI * t0 );
+		double x1 = std::sin( 0.1 * M_PI * t1 );
+		double exact = std::sin( 0.1 * M_PI * time );
+
+		// The sine_standalone FMU does not provide output derivatives, i.e., they are estimated from
+		// the last three communication points. During the first step linear interpolation is used.
+		double reference = x0 + ( time - t0 )*( x1 - x0 )/( t1 - t0 );
+		if ( t0 >= startTime + stepSize ) {
+			double xm = std::sin( 0.1 * M_PI * ( t0 - stepSize ) );
+			double s = ( time - t0 )/stepSize;
+			double h00 = 2.*s*s*s - 3.*s*s + 1.;
+			double h10 = s*s*s - 2.*s*s + s;
+			double h01 = -2.*s*s*s + 3.*s*s;
+			double h11 = s*s*s - s*s;
+			reference = h00*x0 + h10*0.5*( x1 - xm ) + h01*x1 + h11*0.5*( 3.*x1 - 4.*x0 + xm );
+
+			// Cubic interpolation is more accurate than linear interpolation.
+			BOOST_REQUIRE_MESSAGE( std::fabs( result[0] - exact ) < 5e-3,
+					       "interpolation error too large: " << ( result[0] - exact ) );
+		}
+
+		BOOST_REQUIRE_MESSAGE( std::fabs( result[0] - reference ) < 1e-8,
+				       "result mismatch: deltaResult = " << ( result[0] - reference ) );
+	}
+}
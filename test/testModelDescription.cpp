@@ -123,6 +123,28 @@ BOOST_AUTO_TEST_CASE( test_model_description_me_2_0 )
 	BOOST_REQUIRE( md2.isValid() );
 
 	BOOST_CHECK_EQUAL( md2.providesJacobian(), true );
+
+	// no dependencies given, the derivative depends on the state
+	std::vector<bool> pattern;
+	BOOST_REQUIRE( md2.getDerivativeDependencies( pattern ) );
+	BOOST_REQUIRE_EQUAL( pattern.size(), 1 );
+	BOOST_CHECK( pattern[0] );
+
+	// dependencies given in the model structure
+	modelName = "numeric/robertson";
+	fileUrl = std::string( FMU_URI_PRE ) + modelName + std::string( "/modelDescription.xml" );
+	ModelDescription md3( getPathFromUrl( fileUrl ) );
+
+	BOOST_REQUIRE( md3.isValid() );
+	BOOST_REQUIRE( md3.getDerivativeDependencies( pattern ) );
+	BOOST_REQUIRE_EQUAL( pattern.size(), 9 );
+	const bool expected[9] = { true, true, true, true, true, true, false, true, false };
+	for ( int i = 0; i < 9; i++ )
+		BOOST_CHECK_EQUAL( pattern[i], expected[i] );
+
+	// not available for FMI 1.0
+	ModelDescription md4( getPathFromUrl( std::string( FMU_URI_PRE ) + "zigzag/modelDescription.xml" ) );
+	BOOST_CHECK( !md4.getDerivativeDependencies( pattern ) );
 }
 
 
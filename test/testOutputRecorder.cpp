@@ -0,0 +1,168 @@
+// --------------------------------------------------------------
+// Copyright (c) 2013, AIT Austrian Institute of Technology GmbH.
+// All rights reserved. See file FMIPP_LICENSE for details.
+// --------------------------------------------------------------
+
+#include <import/base/include/FMUModelExchange_v1.h>
+#include <import/utility/include/OutputRecorder.h>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE testOutputRecorder
+#include <boost/test/unit_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace fmi_1_0;
+
+
+BOOST_AUTO_TEST_CASE( test_record_fmu_binary )
+{
+	std::string MODELNAME( "zigzag" );
+	FMUModelExchange fmu( FMU_URI_PRE + MODELNAME, MODELNAME, fmiFalse, fmiFalse, EPS_TIME );
+	fmiStatus status = fmu.instantiate( "zigzag1" );
+	BOOST_REQUIRE( status == fmiOK );
+	status = fmu.setValue( "k", 1.0 );
+	BOOST_REQUIRE( status == fmiOK );
+	status = fmu.initialize();
+	BOOST_REQUIRE( status == fmiOK );
+
+	const std::string fileName( "testOutputRecorder.bin" );
+
+	// Small blocks, such that several blocks are written during the simulation.
+	OutputRecorder recorder( fileName, OutputRecorder::binary, 16, 2 );
+	recorder.attach( &fmu );
+	BOOST_REQUIRE( true == recorder.addVariable( "x" ) );
+	BOOST_REQUIRE( true == recorder.addVariable( "der(x)" ) );
+	BOOST_REQUIRE( false == recorder.addVariable( "xyz" ) );
+
+	fmiReal t = 0.0;
+	fmiReal stepsize = 0.0025;
+	fmiReal tstop = 1.0;
+
+	std::vector<fmiReal> expected;
+	status = recorder.record( t );
+	BOOST_REQUIRE( status == fmiOK );
+	expected.push_back( fmu.getRealValue( "x" ) );
+
+	while ( ( t + stepsize ) - tstop < EPS_TIME ) {
+		t = fmu.integrate( t + stepsize );
+		status = recorder.record( t );
+		BOOST_REQUIRE( status == fmiOK );
+		expected.push_back( fmu.getRealValue( "x" ) );
+	}
+
+	BOOST_REQUIRE( recorder.nRecords() == expected.size() );
+
+	recorder.close();
+	BOOST_REQUIRE( true == recorder.isOK() );
+	BOOST_REQUIRE( recorder.record( t ) == fmiError );
+
+	// Read back the binary file.
+	std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary );
+	BOOST_REQUIRE( file.is_open() );
+
+	char magic[8];
+	file.read( magic, 8 );
+	BOOST_REQUIRE( std::string( magic, 8 ) == "FMIPPREC" );
+
+	boost::uint32_t header[4];
+	file.read( reinterpret_cast<char*>( header ), sizeof( header ) );
+	BOOST_REQUIRE( header[1] == 2 );
+	BOOST_REQUIRE( header[2] == 0 );
+	BOOST_REQUIRE( header[3] == 0 );
+
+	for ( int i = 0; i < 2; ++i ) {
+		boost::uint32_t length;
+		file.read( reinterpret_cast<char*>( &length ), sizeof( length ) );
+		std::string name( length, ' ' );
+		file.read( &name[0], length );
+		BOOST_REQUIRE( name == ( ( 0 == i ) ? "x" : "der(x)" ) );
+	}
+
+	std::size_t nSamples = 0;
+	boost::uint32_t n;
+	while ( file.read( reinterpret_cast<char*>( &n ), sizeof( n ) ) ) {
+		BOOST_REQUIRE( n <= 16 );
+		std::vector<double> time( n ), x( n ), dx( n );
+		file.read( reinterpret_cast<char*>( &time[0] ), n*sizeof( double ) );
+		file.read( reinterpret_cast<char*>( &x[0] ), n*sizeof( double ) );
+		file.read( reinterpret_cast<char*>( &dx[0] ), n*sizeof( double ) );
+		for ( std::size_t i = 0; i < n; ++i ) {
+			BOOST_REQUIRE( std::abs( time[i] - ( nSamples + i )*stepsize ) < 1e-9 );
+			BOOST_REQUIRE( x[i] == expected[nSamples + i] );
+			BOOST_REQUIRE( std::abs( dx[i] ) == 1.0 );
+		}
+		nSamples += n;
+	}
+
+	BOOST_REQUIRE( nSamples == expected.size() );
+	BOOST_REQUIRE( std::abs( expected.back() - 1.0 ) < 1e-6 );
+
+	file.close();
+	std::remove( fileName.c_str() );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_record_values_csv )
+{
+	const std::string fileName( "testOutputRecorder.csv" );
+
+	OutputRecorder recorder( fileName, OutputRecorder::csv, 4, 2 );
+	BOOST_REQUIRE( true == recorder.addVariable( "y", fmiTypeReal ) );
+	BOOST_REQUIRE( true == recorder.addVariable( "n", fmiTypeInteger ) );
+	BOOST_REQUIRE( true == recorder.addVariable( "b", fmiTypeBoolean ) );
+	BOOST_REQUIRE( false == recorder.addVariable( "s", fmiTypeString ) );
+
+	// No FMU attached.
+	BOOST_REQUIRE( recorder.record( 0. ) == fmiError );
+
+	for ( int i = 0; i < 10; ++i ) {
+		fmiReal y = 0.5*i;
+		fmiInteger n = i;
+		fmiBoolean b = ( i % 2 ) ? fmiTrue : fmiFalse;
+		fmiStatus status = recorder.record( 0.1*i, &y, &n, &b );
+		BOOST_REQUIRE( status == fmiOK );
+
+		// Variables cannot be added after recording has started.
+		BOOST_REQUIRE( false == recorder.addVariable( "z", fmiTypeReal ) );
+	}
+
+	// Flushing makes all samples available in the file, recording continues afterwards.
+	recorder.flush();
+	BOOST_REQUIRE( true == recorder.isOK() );
+
+	std::ifstream file( fileName.c_str() );
+	BOOST_REQUIRE( file.is_open() );
+
+	std::string line;
+	std::getline( file, line );
+	BOOST_REQUIRE( line == "time,y,n,b" );
+
+	int nLines = 0;
+	while ( std::getline( file, line ) ) {
+		double t, y;
+		int n, b;
+		BOOST_REQUIRE( 4 == std::sscanf( line.c_str(), "%lf,%lf,%d,%d", &t, &y, &n, &b ) );
+		BOOST_REQUIRE( std::abs( t - 0.1*nLines ) < 1e-12 );
+		BOOST_REQUIRE( y == 0.5*nLines );
+		BOOST_REQUIRE( n == nLines );
+		BOOST_REQUIRE( b == nLines % 2 );
+		++nLines;
+	}
+	BOOST_REQUIRE( 10 == nLines );
+	file.close();
+
+	fmiReal y = 1.;
+	fmiInteger n = 1;
+	fmiBoolean b = fmiTrue;
+	BOOST_REQUIRE( recorder.record( 1., &y, &n, &b ) == fmiOK );
+	BOOST_REQUIRE( recorder.record( 1., &y, 0, &b ) == fmiError );
+	recorder.close();
+	BOOST_REQUIRE( 11 == recorder.nRecords() );
+
+	std::remove( fileName.c_str() );
+}
@@ -269,3 +269,61 @@ BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_with_rollback_21 )
 	BOOST_REQUIRE_MESSAGE( status == fmiOK, "status = " << status );
 	BOOST_REQUIRE_MESSAGE( std::abs( x - 0.5 ) < 1e-6, "x = " << x );
 }
+
+
+BOOST_AUTO_TEST_CASE( test_fmu_run_simulation_with_checkpoints )
+{
+	std::string MODELNAME( "zigzag" );
+	RollbackFMU fmu( FMU_URI_PRE + MODELNAME, MODELNAME );
+	fmiStatus status = fmu.instantiate( "zigzag1" );
+	BOOST_REQUIRE( status == fmiOK );
+
+	status = fmu.setValue( "k", 1.0 );
+	BOOST_REQUIRE( status == fmiOK );
+
+	status = fmu.initialize();
+	BOOST_REQUIRE( status == fmiOK );
+
+	const std::size_t maxCheckpoints = 8;
+	fmu.setMaxCheckpoints( maxCheckpoints );
+	BOOST_REQUIRE( fmu.getMaxCheckpoints() == maxCheckpoints );
+
+	fmiReal t = 0.0;
+	fmiReal stepsize = 0.0025;
+	fmiReal tstop = 0.5;
+	fmiReal x;
+
+	// Integrate.
+	while ( ( t + stepsize ) - tstop < EPS_TIME ) {
+		t = fmu.integrate( t + stepsize );
+	}
+
+	BOOST_REQUIRE( fmu.nCheckpoints() == maxCheckpoints );
+
+	// Rollback to times long before the previous update.
+	fmiReal rollbackTimes[3] = { 0.4, 0.1, 0.0125 };
+
+	for ( int i = 0; i < 3; ++i )
+	{
+		t = fmu.integrate( rollbackTimes[i] );
+		BOOST_REQUIRE_MESSAGE( std::abs( t - rollbackTimes[i] ) < EPS_TIME, "t = " << t );
+
+		status = fmu.getValue( "x", x );
+		BOOST_REQUIRE_MESSAGE( status == fmiOK, "status = " << status );
+		BOOST_REQUIRE_MESSAGE( std::abs( x - rollbackTimes[i] ) < 1e-6, "x = " << x );
+
+		// Outdated checkpoints have been removed.
+		BOOST_REQUIRE( fmu.nCheckpoints() <= maxCheckpoints );
+	}
+
+	// Redo integration.
+	while ( ( t + stepsize ) - tstop < EPS_TIME ) {
+		t = fmu.integrate( t + stepsize );
+	}
+
+	t = fmu.getTime();
+	BOOST_REQUIRE_MESSAGE( std::abs( t - tstop ) < stepsize/2, "t = " << t );
+	status = fmu.getValue( "x", x );
+	BOOST_REQUIRE_MESSAGE( status == fmiOK, "status = " << status );
+	BOOST_REQUIRE_MESSAGE( std::abs( x - 0.5 ) < 1e-6, "x = " << x );
+}